@@ -0,0 +1,221 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * Window, program, mesh, timing and teardown shared by the draw call demos.
+ */
+
+#include "draw_calls_common.h"
+
+draw_calls_t                    draw_calls;
+
+static  const draw_calls_demo_t *demo;
+static  openGL_viewport_t        viewport;
+static  openGL_rendering_t       rendering;
+static  const char              *win_name;
+static  const char             **diffuse_textures = NULL;
+static  double                   total_time;
+static  unsigned long            total_objects;
+
+void DrawCallsSetVertexAttributes(void)
+{
+    openGL_mesh_t    *mesh    = &draw_calls.mMesh;
+    openGL_program_t *program = &draw_calls.mProgram;
+
+    glBindBuffer              (GL_ARRAY_BUFFER, mesh->mVerticesVbo);
+    glEnableVertexAttribArray (program->mLocationPos);
+    glVertexAttribPointer     (program->mLocationPos, mesh->mVertexComponentsNum, GL_FLOAT, GL_FALSE, mesh->mVertexComponentsNum * sizeof(float), 0);
+
+    glBindBuffer              (GL_ARRAY_BUFFER, mesh->mColorsVbo);
+    glEnableVertexAttribArray (program->mLocationColor);
+    glVertexAttribPointer     (program->mLocationColor, mesh->mVertexComponentsNum, GL_FLOAT, GL_FALSE, mesh->mVertexComponentsNum * sizeof(float), 0);
+
+    glBindBuffer              (GL_ARRAY_BUFFER, 0);
+}
+
+bool InitGL()
+{
+    openGL_program_t *program = &draw_calls.mProgram;
+
+// Print GPU specifications
+    GpuViewer();
+
+// Initialize Shader Program
+    if(!LoadShader(demo->mVertexShader, &program->mVertexShader, GL_VERTEX_SHADER))
+        return false;
+    if(!LoadShader(demo->mFragmentShader, &program->mFragmentShader, GL_FRAGMENT_SHADER))
+        return false;
+    if(!LoadProgram(program->mVertexShader, program->mFragmentShader, &program->mID))
+        return false;
+
+// Free Shader Compiler Resources
+    glReleaseShaderCompiler();
+
+// Initialize Program
+    InitProgram(program);
+
+// Initialize Mesh
+    if(demo->mInitMesh) {
+        demo->mInitMesh(&draw_calls.mMesh);
+    } else {
+        InitMesh  (&draw_calls.mMesh, 3, 12, cube_vertex_buffer_data, sizeof(cube_vertex_buffer_data),
+                                             NULL                   , 0                              ,
+                                             cube_color_buffer_data , sizeof(cube_color_buffer_data) ,
+                                             NULL                   , 0                              ,
+                                             diffuse_textures, 0);
+    }
+
+// Initialize Camera
+    InitCamera    (&draw_calls.mCamera);
+
+// Basic Rendering Setup, (a) Init Depth & (b) Init Background Color
+    InitRendering (&rendering, COLOR_BLACK);
+
+// Depth Testing Setup
+    glEnable      (GL_DEPTH_TEST);
+    glDepthFunc   (GL_LEQUAL);
+    glClearDepthf (rendering.mDepth);
+
+// Set Clear Color
+    glClearColor  (rendering.mBackgroundColor[0], rendering.mBackgroundColor[1], rendering.mBackgroundColor[2], rendering.mBackgroundColor[3]);
+
+// Upload shader uniforms
+    glUseProgram(program->mID);
+    program->mLocationPos   = glGetAttribLocation (program->mID, "v_posCoord_in");
+    program->mLocationColor = glGetAttribLocation (program->mID, "v_colorCoord_in");
+    program->mLocationMVP   = glGetUniformLocation(program->mID, "uniform_mvp");
+
+// Mode Specific Setup
+    if(demo->mInit && !demo->mInit())
+        return false;
+
+#ifdef INFO_DISPLAY
+    printf("[%s] [%s] [Total Time] [%d sec]\n", demo->mModeName, demo->mModeTitles[draw_calls.mMode], KILL_APP_PERIOD);
+#endif
+
+// Check for opengGL-relate Errors
+    ASSERT_NO_GL_ERROR();
+
+    return true;
+}
+
+void DrawGL(void)
+{
+// Set Viewport
+    glViewport(0, 0, viewport.mWidth, viewport.mHeight);
+
+// Clear Depth & Color of Screen Buffer
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+// Rotate (model) around the Y axis
+    RotateMesh(&draw_calls.mMesh, ROT_AXIS_Y);
+
+// Compute transformation matrix = model * world * projection * view
+    TransformMesh(&draw_calls.mProgram, &draw_calls.mMesh, &draw_calls.mCamera);
+
+// Draw Scene
+    total_objects += demo->mDraw();
+
+// Check for opengGL-relate Errors
+    ASSERT_NO_GL_ERROR();
+}
+
+void IdleGL(void)
+{
+    double timePerFrame = GpuTimer(win_name);
+
+    total_time += timePerFrame;
+    if(total_time >= (float)KILL_APP_PERIOD)
+        KeyboardGL(ESC_KEY);
+
+// Redraw
+    eglutPostRedisplay();
+}
+
+void DestroyGL(void)
+{
+#ifdef INFO_DISPLAY
+    if(total_time > 0.0 && total_objects > 0) {
+        demo->mReport(total_time, total_objects);
+    }
+#endif
+// Delete Mode Specific Objects
+    if(demo->mDestroy) {
+        demo->mDestroy();
+    }
+// Delete Program
+    DeleteProgram (draw_calls.mProgram.mID);
+// Delete Mesh
+    DeleteMesh    (&draw_calls.mMesh);
+}
+
+void ReshapeGL(int width, int height)
+{
+    openGL_camera_t *camera = &draw_calls.mCamera;
+
+// Set viewport
+    SetViewport(&viewport, 0, 0, width, height);
+
+// Update the projection matrix since aspect ratio has been modified
+    mat4x4_perspective(camera->mProjectionMatrix, camera->mFov, viewport.mAspectRatio, camera->mNear, camera->mFar);
+}
+
+void KeyboardGL(unsigned char key)
+{
+// Close app
+   if      (key == ESC_KEY) // escape key
+   {
+      DestroyGL();
+
+       if (_eglut->current)
+          eglutDestroyWindow(_eglut->current->index);
+       _eglutFini();
+
+      exit(0);
+   }
+}
+
+int DrawCallsMain(int argc, char **argv, const draw_calls_demo_t *drawCallsDemo)
+{
+    demo     = drawCallsDemo;
+    win_name = EXECUTABLE_NAME(argv[0]);
+
+    for(int i = 1; i < argc; ++i) {
+        if(strcmp(argv[i], demo->mOption) == 0) {
+            draw_calls.mMode = true;
+        }
+    }
+
+    eglutInitWindowSize (WIDTH, HEIGHT);
+    eglutInitAPIMask    (EGLUT_OPENGL_ES2_BIT);
+    eglutInitNoError    (demo->mNoErrorMode && draw_calls.mMode);
+    eglutInit           (argc, (const char **)argv);
+
+    eglutCreateWindow   (win_name);
+
+    eglutIdleFunc       (IdleGL);
+    eglutDisplayFunc    (DrawGL);
+    eglutReshapeFunc    (ReshapeGL);
+    eglutKeyboardFunc   (KeyboardGL);
+
+    if(!InitGL()) {
+        return 1;
+    }
+
+    eglutMainLoop();
+#ifndef VK_USE_PLATFORM_MACOS_MVK
+    DestroyGL();
+#endif
+
+    return 0;
+}
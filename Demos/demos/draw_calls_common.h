@@ -0,0 +1,53 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __DRAW_CALLS_COMMON_H_
+#define __DRAW_CALLS_COMMON_H_
+
+#include "../engine/glcore/common.h"
+#include "../assets/geometry/cube.h"
+
+/**
+ * A draw call demo renders a rotating mesh with one of two modes, the
+ * second of which is selected with a command line option. The window,
+ * program, mesh, camera, timing and teardown are common; each demo only
+ * provides the callbacks below.
+ */
+typedef struct draw_calls_demo_t {
+    const char  *mOption;                           /**< Command line option that selects the second mode */
+    const char  *mModeName;                         /**< Printed along with the title of the selected mode */
+    const char **mModeTitles;
+    const char  *mVertexShader;
+    const char  *mFragmentShader;
+    bool         mNoErrorMode;                      /**< The second mode creates an EGL_KHR_create_context_no_error context */
+
+    void       (*mInitMesh)(openGL_mesh_t *mesh);   /**< Optional, a cube otherwise */
+    bool       (*mInit)(void);                      /**< Optional, after the program attributes and uniforms are located */
+    unsigned   (*mDraw)(void);                      /**< Returns the number of objects drawn */
+    void       (*mReport)(double totalTime, unsigned long totalObjects);
+    void       (*mDestroy)(void);                   /**< Optional */
+} draw_calls_demo_t;
+
+typedef struct draw_calls_t {
+    openGL_mesh_t      mMesh;
+    openGL_program_t   mProgram;
+    openGL_camera_t    mCamera;
+    bool               mMode;                       /**< Whether the second mode is measured */
+} draw_calls_t;
+
+extern draw_calls_t    draw_calls;
+
+void DrawCallsSetVertexAttributes(void);
+int  DrawCallsMain               (int argc, char **argv, const draw_calls_demo_t *demo);
+
+#endif // __DRAW_CALLS_COMMON_H_
@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * Object throughput for a grid of cubes, drawn either with one draw call
+ * per cube or with a single instanced draw call (GL_EXT_draw_instanced,
+ * GL_EXT_instanced_arrays). Run with --instanced to use the latter.
+ */
+
+#include "draw_calls_instanced.h"
+
+static  GLint              location_offset;
+static  GLint              location_scale;
+static  GLuint             offsets_vbo;
+static  float              offsets[OBJECTS_PER_FRAME * 3];
+
+static  PFNGLDRAWARRAYSINSTANCEDEXTPROC glDrawArraysInstancedEXT_;
+static  PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisorEXT_;
+
+static void InitOffsets(void)
+{
+    const float step = 2.0f / GRID_SIZE;
+
+    for(int y = 0; y < GRID_SIZE; ++y) {
+        for(int x = 0; x < GRID_SIZE; ++x) {
+            float *offset = &offsets[(y * GRID_SIZE + x) * 3];
+            offset[0] = -1.0f + (x + 0.5f) * step;
+            offset[1] = -1.0f + (y + 0.5f) * step;
+            offset[2] = 0.0f;
+        }
+    }
+}
+
+static bool InitInstanced(void)
+{
+    GLuint programID = draw_calls.mProgram.mID;
+
+    location_offset = glGetAttribLocation (programID, "v_offset_in");
+    location_scale  = glGetUniformLocation(programID, "uniform_scale");
+    glUniform1f(location_scale, OBJECT_SCALE);
+
+// Initialize Per-Object Offsets
+    InitOffsets();
+
+    DrawCallsSetVertexAttributes();
+
+    if(!draw_calls.mMode) {
+        glDisableVertexAttribArray(location_offset);
+        return true;
+    }
+
+    glDrawArraysInstancedEXT_ = (PFNGLDRAWARRAYSINSTANCEDEXTPROC)eglGetProcAddress("glDrawArraysInstancedEXT");
+    glVertexAttribDivisorEXT_ = (PFNGLVERTEXATTRIBDIVISOREXTPROC)eglGetProcAddress("glVertexAttribDivisorEXT");
+    if(!glDrawArraysInstancedEXT_ || !glVertexAttribDivisorEXT_) {
+        printf("GL_EXT_draw_instanced/GL_EXT_instanced_arrays are not supported\n");
+        return false;
+    }
+
+// One offset per cube, advanced once per instance
+    glGenBuffers              (1, &offsets_vbo);
+    glBindBuffer              (GL_ARRAY_BUFFER, offsets_vbo);
+    glBufferData              (GL_ARRAY_BUFFER, sizeof(offsets), offsets, GL_STATIC_DRAW);
+    glEnableVertexAttribArray (location_offset);
+    glVertexAttribPointer     (location_offset, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
+    glVertexAttribDivisorEXT_ (location_offset, 1);
+    glBindBuffer              (GL_ARRAY_BUFFER, 0);
+
+    return true;
+}
+
+static unsigned DrawInstanced(void)
+{
+    if(draw_calls.mMode) {
+        glDrawArraysInstancedEXT_(GL_TRIANGLES, 0, draw_calls.mMesh.mVerticesNum, OBJECTS_PER_FRAME);
+    } else {
+        for(int i = 0; i < OBJECTS_PER_FRAME; ++i) {
+            glVertexAttrib3fv(location_offset, &offsets[i * 3]);
+            glDrawArrays(GL_TRIANGLES, 0, draw_calls.mMesh.mVerticesNum);
+        }
+    }
+
+    return OBJECTS_PER_FRAME;
+}
+
+static void ReportInstanced(double totalTime, unsigned long totalObjects)
+{
+    printf("[Draw       Mode] [%s] [%.0f objects/sec]\n", draw_titles[draw_calls.mMode], totalObjects / totalTime);
+}
+
+static void DestroyInstanced(void)
+{
+// Delete Per-Instance Buffer
+    if(draw_calls.mMode) {
+        glDeleteBuffers(1, &offsets_vbo);
+    }
+}
+
+#ifdef VK_USE_PLATFORM_MACOS_MVK
+int macos_main(int argc, char **argv)
+#else
+int main(int argc, char **argv)
+#endif
+{
+    static const draw_calls_demo_t demo = {
+        INSTANCED_OPTION, "Draw       Mode", draw_titles, VERTEX_SHADER_NAME, FRAGMENT_SHADER_NAME, false,
+        NULL, InitInstanced, DrawInstanced, ReportInstanced, DestroyInstanced
+    };
+
+    return DrawCallsMain(argc, argv, &demo);
+}
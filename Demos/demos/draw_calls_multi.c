@@ -0,0 +1,102 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * Object throughput for a grid of cubes stored back to back in one vertex
+ * buffer, drawn either with one draw call per cube or with a single
+ * glMultiDrawArraysEXT call (GL_EXT_multi_draw_arrays) covering all of
+ * their ranges. Run with --multi to use the latter.
+ */
+
+#include "draw_calls_multi.h"
+
+static  GLfloat            grid_vertices[OBJECTS_PER_FRAME * CUBE_VERTICES * 3];
+static  GLfloat            grid_colors  [OBJECTS_PER_FRAME * CUBE_VERTICES * 3];
+static  GLint              firsts       [OBJECTS_PER_FRAME];
+static  GLsizei            counts       [OBJECTS_PER_FRAME];
+
+static  PFNGLMULTIDRAWARRAYSEXTPROC glMultiDrawArraysEXT_;
+
+static void InitGrid(openGL_mesh_t *mesh)
+{
+    const float step = 2.0f / GRID_SIZE;
+
+// Each cube is scaled and moved to its grid cell, so that all of them share one vertex buffer
+    for(int y = 0; y < GRID_SIZE; ++y) {
+        for(int x = 0; x < GRID_SIZE; ++x) {
+            const int   object   = y * GRID_SIZE + x;
+            const float offset[] = { -1.0f + (x + 0.5f) * step, -1.0f + (y + 0.5f) * step, 0.0f };
+
+            for(int v = 0; v < CUBE_VERTICES * 3; ++v) {
+                grid_vertices[object * CUBE_VERTICES * 3 + v] = cube_vertex_buffer_data[v] * OBJECT_SCALE + offset[v % 3];
+                grid_colors  [object * CUBE_VERTICES * 3 + v] = cube_color_buffer_data [v];
+            }
+
+            firsts[object] = object * CUBE_VERTICES;
+            counts[object] = CUBE_VERTICES;
+        }
+    }
+
+    InitMesh(mesh, 3, 12 * OBJECTS_PER_FRAME, grid_vertices, sizeof(grid_vertices),
+                                              NULL         , 0                    ,
+                                              grid_colors  , sizeof(grid_colors)  ,
+                                              NULL         , 0                    ,
+                                              NULL         , 0);
+}
+
+static bool InitMulti(void)
+{
+    if(draw_calls.mMode) {
+        glMultiDrawArraysEXT_ = (PFNGLMULTIDRAWARRAYSEXTPROC)eglGetProcAddress("glMultiDrawArraysEXT");
+        if(!glMultiDrawArraysEXT_) {
+            printf("GL_EXT_multi_draw_arrays is not supported\n");
+            return false;
+        }
+    }
+
+    DrawCallsSetVertexAttributes();
+
+    return true;
+}
+
+static unsigned DrawMulti(void)
+{
+    if(draw_calls.mMode) {
+        glMultiDrawArraysEXT_(GL_TRIANGLES, firsts, counts, OBJECTS_PER_FRAME);
+    } else {
+        for(int i = 0; i < OBJECTS_PER_FRAME; ++i) {
+            glDrawArrays(GL_TRIANGLES, firsts[i], counts[i]);
+        }
+    }
+
+    return OBJECTS_PER_FRAME;
+}
+
+static void ReportMulti(double totalTime, unsigned long totalObjects)
+{
+    printf("[Draw       Mode] [%s] [%.0f objects/sec]\n", draw_titles[draw_calls.mMode], totalObjects / totalTime);
+}
+
+#ifdef VK_USE_PLATFORM_MACOS_MVK
+int macos_main(int argc, char **argv)
+#else
+int main(int argc, char **argv)
+#endif
+{
+    static const draw_calls_demo_t demo = {
+        MULTI_OPTION, "Draw       Mode", draw_titles, VERTEX_SHADER_NAME, FRAGMENT_SHADER_NAME, false,
+        InitGrid, InitMulti, DrawMulti, ReportMulti, NULL
+    };
+
+    return DrawCallsMain(argc, argv, &demo);
+}
@@ -0,0 +1,31 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __DRAW_CALLS_MULTI_H_
+#define __DRAW_CALLS_MULTI_H_
+
+#include "draw_calls_common.h"
+
+#define VERTEX_SHADER_NAME          SOURCES_PATH SHADERS_PATH "geometry3d_vertexcolors.vert"
+#define FRAGMENT_SHADER_NAME        SOURCES_PATH SHADERS_PATH "geometry3d_vertexcolors.frag"
+#define BINARY_PROGRAM_SHADER_NAME  SOURCES_PATH SHADERS_PATH "geometry3d_vertexcolors.bin"
+
+#define GRID_SIZE                   24
+#define OBJECTS_PER_FRAME           (GRID_SIZE * GRID_SIZE)
+#define OBJECT_SCALE                0.03f
+#define CUBE_VERTICES               (int)(sizeof(cube_vertex_buffer_data) / (3 * sizeof(float)))
+#define MULTI_OPTION                "--multi"
+
+static const char* draw_titles      [] = { "DRAW_PER_OBJECT", "DRAW_MULTI" };
+
+#endif // __DRAW_CALLS_MULTI_H_
@@ -0,0 +1,101 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * CPU time spent in glUniformMatrix4fv and glDrawArrays for a grid of
+ * cubes, each of them drawn with its own transformation matrix. Run with
+ * --no-error to create the context with EGL_CONTEXT_OPENGL_NO_ERROR_KHR
+ * (EGL_KHR_create_context_no_error), which skips their validation.
+ */
+
+#include "draw_calls_no_error.h"
+
+static  mat4x4             object_mvps[OBJECTS_PER_FRAME];
+static  double             uniform_time;
+static  double             draw_time;
+
+static void TransformGrid(void)
+{
+    openGL_camera_t *camera = &draw_calls.mCamera;
+    const float step = 2.0f / GRID_SIZE;
+    mat4x4 VP, WVP, T, S, M;
+
+    mat4x4_mul(VP , camera->mProjectionMatrix, camera->mViewMatrix);
+    mat4x4_mul(WVP, VP                       , camera->mWorldMatrix);
+
+// Each cube is scaled and moved to its grid cell
+    for(int y = 0; y < GRID_SIZE; ++y) {
+        for(int x = 0; x < GRID_SIZE; ++x) {
+            mat4x4_translate  (T, -1.0f + (x + 0.5f) * step, -1.0f + (y + 0.5f) * step, 0.0f);
+            mat4x4_scale_aniso(S, T, OBJECT_SCALE, OBJECT_SCALE, OBJECT_SCALE);
+            mat4x4_mul        (M, S, draw_calls.mMesh.mModelMatrix);
+            mat4x4_mul        (object_mvps[y * GRID_SIZE + x], WVP, M);
+        }
+    }
+}
+
+static bool InitNoError(void)
+{
+    DrawCallsSetVertexAttributes();
+
+    return true;
+}
+
+static unsigned DrawNoError(void)
+{
+    const GLint location_mvp = draw_calls.mProgram.mLocationMVP;
+    double t0, t1, t2;
+
+// Compute transformation matrices = model * world * projection * view
+    TransformGrid();
+    glUseProgram(draw_calls.mProgram.mID);
+
+// Time the uniform updates on their own, then together with the draws that consume them
+    t0 = CpuTime();
+    for(int i = 0; i < OBJECTS_PER_FRAME; ++i) {
+        glUniformMatrix4fv(location_mvp, 1, GL_FALSE, (const float *)&object_mvps[i][0][0]);
+    }
+    t1 = CpuTime();
+    for(int i = 0; i < OBJECTS_PER_FRAME; ++i) {
+        glUniformMatrix4fv(location_mvp, 1, GL_FALSE, (const float *)&object_mvps[i][0][0]);
+        glDrawArrays(GL_TRIANGLES, 0, draw_calls.mMesh.mVerticesNum);
+    }
+    t2 = CpuTime();
+
+    uniform_time += t1 - t0;
+    draw_time    += (t2 - t1) - (t1 - t0);
+
+    return OBJECTS_PER_FRAME;
+}
+
+static void ReportNoError(double totalTime, unsigned long totalObjects)
+{
+    (void)totalTime;
+
+    printf("[Context    Mode] [%s] [%.3f us per glUniformMatrix4fv] [%.3f us per glDrawArrays]\n", context_titles[draw_calls.mMode],
+           uniform_time * 1000000.0 / totalObjects, draw_time * 1000000.0 / totalObjects);
+}
+
+#ifdef VK_USE_PLATFORM_MACOS_MVK
+int macos_main(int argc, char **argv)
+#else
+int main(int argc, char **argv)
+#endif
+{
+    static const draw_calls_demo_t demo = {
+        NO_ERROR_OPTION, "Context    Mode", context_titles, VERTEX_SHADER_NAME, FRAGMENT_SHADER_NAME, true,
+        NULL, InitNoError, DrawNoError, ReportNoError, NULL
+    };
+
+    return DrawCallsMain(argc, argv, &demo);
+}
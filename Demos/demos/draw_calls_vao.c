@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * Draw call throughput, with the vertex attributes either re-specified
+ * before each draw or captured once in a vertex array object
+ * (GL_OES_vertex_array_object). Run with --vao to use the latter.
+ */
+
+#include "draw_calls_vao.h"
+
+static  GLuint             vao;
+
+static  PFNGLBINDVERTEXARRAYOESPROC    glBindVertexArrayOES_;
+static  PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOES_;
+static  PFNGLGENVERTEXARRAYSOESPROC    glGenVertexArraysOES_;
+
+static bool InitVao(void)
+{
+    if(!draw_calls.mMode) {
+        return true;
+    }
+
+// Capture the vertex attributes once
+    glBindVertexArrayOES_    = (PFNGLBINDVERTEXARRAYOESPROC)   eglGetProcAddress("glBindVertexArrayOES");
+    glDeleteVertexArraysOES_ = (PFNGLDELETEVERTEXARRAYSOESPROC)eglGetProcAddress("glDeleteVertexArraysOES");
+    glGenVertexArraysOES_    = (PFNGLGENVERTEXARRAYSOESPROC)   eglGetProcAddress("glGenVertexArraysOES");
+    if(!glBindVertexArrayOES_ || !glDeleteVertexArraysOES_ || !glGenVertexArraysOES_) {
+        printf("GL_OES_vertex_array_object is not supported\n");
+        return false;
+    }
+
+    glGenVertexArraysOES_(1, &vao);
+    glBindVertexArrayOES_(vao);
+    DrawCallsSetVertexAttributes();
+    glBindVertexArrayOES_(0);
+
+    return true;
+}
+
+static unsigned DrawVao(void)
+{
+    for(int i = 0; i < DRAW_CALLS_PER_FRAME; ++i) {
+        if(draw_calls.mMode) {
+            glBindVertexArrayOES_(vao);
+        } else {
+            DrawCallsSetVertexAttributes();
+        }
+        glDrawArrays(GL_TRIANGLES, 0, draw_calls.mMesh.mVerticesNum);
+    }
+
+    if(draw_calls.mMode) {
+        glBindVertexArrayOES_(0);
+    }
+
+    return DRAW_CALLS_PER_FRAME;
+}
+
+static void ReportVao(double totalTime, unsigned long totalDrawCalls)
+{
+    printf("[Binding    Mode] [%s] [%.0f draws/sec]\n", binding_titles[draw_calls.mMode], totalDrawCalls / totalTime);
+}
+
+static void DestroyVao(void)
+{
+// Delete Vertex Array Object
+    if(draw_calls.mMode) {
+        glDeleteVertexArraysOES_(1, &vao);
+    }
+}
+
+#ifdef VK_USE_PLATFORM_MACOS_MVK
+int macos_main(int argc, char **argv)
+#else
+int main(int argc, char **argv)
+#endif
+{
+    static const draw_calls_demo_t demo = {
+        VAO_OPTION, "Binding    Mode", binding_titles, VERTEX_SHADER_NAME, FRAGMENT_SHADER_NAME, false,
+        NULL, InitVao, DrawVao, ReportVao, DestroyVao
+    };
+
+    return DrawCallsMain(argc, argv, &demo);
+}
@@ -0,0 +1,28 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __DRAW_CALLS_VAO_H_
+#define __DRAW_CALLS_VAO_H_
+
+#include "draw_calls_common.h"
+
+#define VERTEX_SHADER_NAME          SOURCES_PATH SHADERS_PATH "geometry3d_vertexcolors.vert"
+#define FRAGMENT_SHADER_NAME        SOURCES_PATH SHADERS_PATH "geometry3d_vertexcolors.frag"
+#define BINARY_PROGRAM_SHADER_NAME  SOURCES_PATH SHADERS_PATH "geometry3d_vertexcolors.bin"
+
+#define DRAW_CALLS_PER_FRAME        500
+#define VAO_OPTION                  "--vao"
+
+static const char* binding_titles   [] = { "VERTEX_ATTRIB_POINTER", "VERTEX_ARRAY_OBJECT" };
+
+#endif // __DRAW_CALLS_VAO_H_
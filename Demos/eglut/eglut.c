@@ -129,7 +129,7 @@ static struct eglut_window *
 _eglutCreateWindow(const char *title, int x, int y, int w, int h)
 {
    struct eglut_window *win;
-   EGLint context_attribs[4];
+   EGLint context_attribs[6];
    EGLint api, i;
 
    win = calloc(1, sizeof(*win));
@@ -155,6 +155,11 @@ _eglutCreateWindow(const char *title, int x, int y, int w, int h)
       context_attribs[i++] = 2;
    }
 
+   if (_eglut->no_error) {
+      context_attribs[i++] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+      context_attribs[i++] = EGL_TRUE;
+   }
+
    context_attribs[i] = EGL_NONE;
 
    eglBindAPI(api);
@@ -195,6 +200,12 @@ eglutInitAPIMask(int mask)
    _eglut->api_mask = mask;
 }
 
+void
+eglutInitNoError(int no_error)
+{
+   _eglut->no_error = no_error;
+}
+
 void
 eglutInitWindowSize(int width, int height)
 {
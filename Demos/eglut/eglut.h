@@ -71,6 +71,7 @@ typedef void (*EGLUTkeyboardCB)(unsigned char);
 typedef void (*EGLUTspecialCB)(int);
 
 void eglutInitAPIMask(int mask);
+void eglutInitNoError(int no_error);
 void eglutInitWindowSize(int width, int height);
 void eglutInit(int argc, const char **argv);
 
@@ -66,6 +66,7 @@ struct eglut_window {
 
 struct eglut_state {
    int api_mask;
+   int no_error;
    int window_width, window_height;
    const char *display_name;
    int verbose;
@@ -34,6 +34,19 @@ void GpuViewer()
 #endif
 }
 
+double CpuTime(void)
+{
+#ifdef WIN32
+    SYSTEMTIME tim;
+    GetLocalTime(&tim);
+    return tim.wSecond + (tim.wMilliseconds / 1000.0);
+#else
+    struct timeval tim;
+    gettimeofday(&tim, NULL);
+    return tim.tv_sec + (tim.tv_usec / 1000000.0);
+#endif
+}
+
 double GpuTimer(const char *title)
 {
 #ifdef WIN32
@@ -21,6 +21,7 @@
 #include <sys/time.h>
 #endif
 
+double CpuTime(void);
 double GpuTimer(const char *title);
 void GpuViewer(void);
 
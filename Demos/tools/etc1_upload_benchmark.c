@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * ETC1 upload benchmark. A set of ETC1 textures is uploaded with
+ * glCompressedTexImage2D once with the blocks copied to ETC2 images, which
+ * sample them natively, and once with GLOVE_ETC1_DECODE set, which decodes
+ * them to RGBA8 images at upload. Each case runs in its own process, as the
+ * variable is read when the Vulkan device is created, and prints its upload
+ * time and resident memory. Devices without ETC2 support take the decode path
+ * in both cases.
+ */
+
+// setenv
+#define _POSIX_C_SOURCE 200809L
+
+#include <unistd.h>
+#include <getopt.h>
+#include <ctype.h>
+#include <sys/wait.h>
+
+#include "../engine/glcore/common.h"
+
+#define DEFAULT_TEXTURES     64
+#define DEFAULT_TEXTURE_SIZE 512
+#define MAX_TEXTURES         1024
+#define SURFACE_SIZE         16
+#define ETC1_DECODE_ENV      "GLOVE_ETC1_DECODE"
+
+static int           texture_count = DEFAULT_TEXTURES;
+static int           texture_size  = DEFAULT_TEXTURE_SIZE;
+
+static void
+PrintUsage()
+{
+    printf("Correct Usage: ./etc1_upload_benchmark [-n <textures>] [-s <texture size>]\n");
+}
+
+static bool
+ReadArguments(int argc, char *argv[])
+{
+    signed char c;
+
+    while ((c = getopt(argc, argv, "n:s:")) != -1) {
+        switch (c) {
+        case 'n':
+            texture_count = atoi(optarg);
+            break;
+        case 's':
+            texture_size = atoi(optarg);
+            break;
+        case '?':
+            if (isprint (optopt))
+                printf ("Unknown option `-%c'.\n", optopt);
+            PrintUsage();
+
+            return false;
+        default:
+            abort ();
+        }
+    }
+
+    if(texture_count < 1 || texture_count > MAX_TEXTURES || texture_size < 4 || texture_size > 4096 || texture_size % 4) {
+        PrintUsage();
+        return false;
+    }
+
+    return true;
+}
+
+/// Resident set size of the process in KB, which includes the device memory of integrated and software drivers
+static long
+ResidentMemory(void)
+{
+    char  line[128];
+    long  rss  = 0;
+    FILE *file = fopen("/proc/self/status", "r");
+
+    if(!file) {
+        return 0;
+    }
+
+    while(fgets(line, sizeof(line), file)) {
+        if(sscanf(line, "VmRSS: %ld kB", &rss) == 1) {
+            break;
+        }
+    }
+    fclose(file);
+
+    return rss;
+}
+
+static int
+RunCase(bool decode)
+{
+    const EGLint config_attribs[]  = { EGL_SURFACE_TYPE   , EGL_PBUFFER_BIT,
+                                       EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+                                       EGL_RED_SIZE       , 8,
+                                       EGL_GREEN_SIZE     , 8,
+                                       EGL_BLUE_SIZE      , 8,
+                                       EGL_ALPHA_SIZE     , 8,
+                                       EGL_NONE };
+    const EGLint surface_attribs[] = { EGL_WIDTH, SURFACE_SIZE, EGL_HEIGHT, SURFACE_SIZE, EGL_NONE };
+    const EGLint context_attribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+
+    EGLConfig config;
+    EGLint    num_configs = 0;
+    GLuint    textures[MAX_TEXTURES];
+
+    if(decode) {
+        setenv(ETC1_DECODE_ENV, "1", 1);
+    }
+
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if(!eglInitialize(display, NULL, NULL) ||
+       !eglChooseConfig(display, config_attribs, &config, 1, &num_configs) || num_configs == 0) {
+        printf("No pbuffer configuration found [EGL error 0x%x]\n", eglGetError());
+        return 1;
+    }
+
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surface_attribs);
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attribs);
+    if(context == EGL_NO_CONTEXT || eglMakeCurrent(display, surface, surface, context) != EGL_TRUE) {
+        printf("Context creation failed [EGL error 0x%x]\n", eglGetError());
+        return 1;
+    }
+
+    // every 8 byte block is a valid ETC1 block
+    GLsizei  imageSize = (texture_size / 4) * (texture_size / 4) * 8;
+    GLubyte *blocks    = (GLubyte *)malloc(imageSize);
+    srand(texture_size);
+    for(GLsizei i = 0; i < imageSize; ++i) {
+        blocks[i] = (GLubyte)rand();
+    }
+
+    long   rss0 = ResidentMemory();
+    double t0   = CpuTime();
+
+    glGenTextures(texture_count, textures);
+    for(int i = 0; i < texture_count; ++i) {
+        glBindTexture         (GL_TEXTURE_2D, textures[i]);
+        glTexParameteri       (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri       (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glCompressedTexImage2D(GL_TEXTURE_2D, 0, GL_ETC1_RGB8_OES, texture_size, texture_size, 0, imageSize, blocks);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glFinish();
+
+    double uploadTime = CpuTime() - t0;
+    long   rss1       = ResidentMemory();
+    int    failures   = glGetError() != GL_NO_ERROR;
+
+    glDeleteTextures(texture_count, textures);
+    free(blocks);
+
+    eglMakeCurrent   (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglDestroySurface(display, surface);
+    eglTerminate     (display);
+
+    printf("[%-6s] [Upload Time] [%8.3f ms] [Resident Memory] [%+8ld KB] [Compressed Data] [%8ld KB] [Failures] [%d]\n",
+           decode ? "Decode" : "Native", uploadTime * 1000.0, rss1 - rss0,
+           (long)imageSize * texture_count / 1024, failures);
+
+    return failures;
+}
+
+int
+main(int argc, char **argv)
+{
+    if(!ReadArguments(argc, argv))
+        return 1;
+
+    printf("[Textures] [%d] [Size] [%dx%d]\n", texture_count, texture_size, texture_size);
+    fflush(stdout);
+
+    // each case gets a fresh process, so that its resident memory and Vulkan device are its own
+    int failures = 0;
+    for(int decode = 0; decode < 2; ++decode) {
+        pid_t pid = fork();
+        if(pid == 0) {
+            int result = RunCase(decode != 0);
+            fflush(stdout);
+            _exit(result);
+        }
+
+        int status = 0;
+        if(pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * EGL fence sync checks (EGL_KHR_fence_sync). A pbuffer context renders a few
+ * frames, a fence sync is created after them and client waits are checked for
+ * their status and errors: with EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, with a zero
+ * timeout, with invalid flags and on a destroyed sync. Each check prints its
+ * result and the exit status is the number of failed checks.
+ */
+
+#include "../engine/glcore/common.h"
+#include "EGL/eglext.h"
+
+#define SURFACE_SIZE         256
+#define FRAMES               16
+
+static PFNEGLCREATESYNCKHRPROC      pfnCreateSyncKHR;
+static PFNEGLDESTROYSYNCKHRPROC     pfnDestroySyncKHR;
+static PFNEGLCLIENTWAITSYNCKHRPROC  pfnClientWaitSyncKHR;
+static PFNEGLGETSYNCATTRIBKHRPROC   pfnGetSyncAttribKHR;
+
+static int
+Check(const char *name, bool passed)
+{
+    printf("[%-28s] [%s]\n", name, passed ? "PASS" : "FAIL");
+
+    return passed ? 0 : 1;
+}
+
+static void
+Render(void)
+{
+    for(int frame = 0; frame < FRAMES; ++frame) {
+        glClearColor((frame % 2) * 1.0f, 0.5f, 0.25f, 1.0f);
+        glClear     (GL_COLOR_BUFFER_BIT);
+    }
+}
+
+static int
+RunChecks(EGLDisplay display)
+{
+    int     failures = 0;
+    EGLint  status   = 0;
+
+    // the flush bit submits the commands recorded after the sync, the wait is for the sync only
+    Render();
+    EGLSyncKHR sync = pfnCreateSyncKHR(display, EGL_SYNC_FENCE_KHR, NULL);
+    failures += Check("Create", sync != EGL_NO_SYNC_KHR);
+    if(sync == EGL_NO_SYNC_KHR) {
+        return failures;
+    }
+    Render();
+
+    failures += Check("Wait with flush",
+                      pfnClientWaitSyncKHR(display, sync, EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, EGL_FOREVER_KHR) == EGL_CONDITION_SATISFIED_KHR);
+    failures += Check("Signaled status",
+                      pfnGetSyncAttribKHR(display, sync, EGL_SYNC_STATUS_KHR, &status) == EGL_TRUE && status == EGL_SIGNALED_KHR);
+    failures += Check("Wait signaled, no timeout",
+                      pfnClientWaitSyncKHR(display, sync, 0, 0) == EGL_CONDITION_SATISFIED_KHR);
+
+    failures += Check("Wait with invalid flags",
+                      pfnClientWaitSyncKHR(display, sync, ~EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, 0) == EGL_FALSE &&
+                      eglGetError() == EGL_BAD_PARAMETER);
+
+    pfnDestroySyncKHR(display, sync);
+    failures += Check("Wait destroyed sync",
+                      pfnClientWaitSyncKHR(display, sync, 0, 0) == EGL_FALSE && eglGetError() == EGL_BAD_PARAMETER);
+
+    // the commands may or may not have completed, but the wait returns without an error either way
+    Render();
+    sync = pfnCreateSyncKHR(display, EGL_SYNC_FENCE_KHR, NULL);
+    EGLint result = pfnClientWaitSyncKHR(display, sync, EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, 0);
+    failures += Check("Wait pending, no timeout",
+                      (result == EGL_CONDITION_SATISFIED_KHR || result == EGL_TIMEOUT_EXPIRED_KHR) && eglGetError() == EGL_SUCCESS);
+    pfnClientWaitSyncKHR(display, sync, 0, EGL_FOREVER_KHR);
+    pfnDestroySyncKHR(display, sync);
+
+    return failures;
+}
+
+int
+main(int argc, char **argv)
+{
+    const EGLint config_attribs[]  = { EGL_SURFACE_TYPE   , EGL_PBUFFER_BIT,
+                                       EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+                                       EGL_RED_SIZE       , 8,
+                                       EGL_GREEN_SIZE     , 8,
+                                       EGL_BLUE_SIZE      , 8,
+                                       EGL_ALPHA_SIZE     , 8,
+                                       EGL_NONE };
+    const EGLint surface_attribs[] = { EGL_WIDTH, SURFACE_SIZE, EGL_HEIGHT, SURFACE_SIZE, EGL_NONE };
+    const EGLint context_attribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+
+    EGLConfig config;
+    EGLint    num_configs = 0;
+
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if(!eglInitialize(display, NULL, NULL) ||
+       !eglChooseConfig(display, config_attribs, &config, 1, &num_configs) || num_configs == 0) {
+        printf("No pbuffer configuration found [EGL error 0x%x]\n", eglGetError());
+        return 1;
+    }
+
+    pfnCreateSyncKHR     = (PFNEGLCREATESYNCKHRPROC)    eglGetProcAddress("eglCreateSyncKHR");
+    pfnDestroySyncKHR    = (PFNEGLDESTROYSYNCKHRPROC)   eglGetProcAddress("eglDestroySyncKHR");
+    pfnClientWaitSyncKHR = (PFNEGLCLIENTWAITSYNCKHRPROC)eglGetProcAddress("eglClientWaitSyncKHR");
+    pfnGetSyncAttribKHR  = (PFNEGLGETSYNCATTRIBKHRPROC) eglGetProcAddress("eglGetSyncAttribKHR");
+    if(!pfnCreateSyncKHR || !pfnDestroySyncKHR || !pfnClientWaitSyncKHR || !pfnGetSyncAttribKHR) {
+        printf("EGL_KHR_fence_sync is not supported\n");
+        return 1;
+    }
+
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surface_attribs);
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attribs);
+    if(context == EGL_NO_CONTEXT || eglMakeCurrent(display, surface, surface, context) != EGL_TRUE) {
+        printf("Context creation failed [EGL error 0x%x]\n", eglGetError());
+        return 1;
+    }
+
+    int failures = RunChecks(display);
+
+    eglMakeCurrent   (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglDestroySurface(display, surface);
+    eglTerminate     (display);
+
+    return failures;
+}
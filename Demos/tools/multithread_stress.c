@@ -0,0 +1,316 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * Multi-threaded stress test. Every thread creates its own context and
+ * pbuffer on a shared display and repeatedly uploads a texture, clears, draws
+ * the texture over the left half of the surface and reads back the result,
+ * while the other threads do the same. Pbuffers need no window system, so it
+ * also runs on a headless software Vulkan driver. Any pixel that does not
+ * match the texture or clear color of its own thread, or any GL/EGL error, is
+ * counted as a failure. With -s the contexts join one share group and all
+ * threads draw concurrently with a single program linked up front.
+ */
+
+#include <unistd.h>
+#include <getopt.h>
+#include <ctype.h>
+#include <pthread.h>
+
+#include "../engine/glcore/common.h"
+
+#define DEFAULT_THREADS    4
+#define DEFAULT_ITERATIONS 500
+#define MAX_THREADS        64
+#define SURFACE_SIZE       64
+#define TEXTURE_SIZE       16
+
+#define VERTEX_SHADER_NAME   SOURCES_PATH SHADERS_PATH "full_screen.vert"
+#define FRAGMENT_SHADER_NAME SOURCES_PATH SHADERS_PATH "texture2d_color.frag"
+
+/// Triangle strip over the left half of the surface: positions, then texture coordinates
+static const GLfloat quad_data[] = { -1.0f, -1.0f,  0.0f, -1.0f, -1.0f,  1.0f,  0.0f,  1.0f,
+                                      0.0f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f };
+
+typedef struct thread_data_t {
+    int           mIndex;
+    int           mIterations;
+    int           mFailures;
+    double        mTime;
+} thread_data_t;
+
+static EGLDisplay    display;
+static EGLConfig     config;
+static int           thread_count  = DEFAULT_THREADS;
+static int           iterations    = DEFAULT_ITERATIONS;
+static bool          share         = false;
+static EGLContext    share_context = EGL_NO_CONTEXT;
+static GLuint        share_program = 0;
+
+static void
+PrintUsage()
+{
+    printf("Correct Usage: ./multithread_stress [-t <threads>] [-i <iterations>] [-s]\n");
+}
+
+static bool
+ReadArguments(int argc, char *argv[])
+{
+    signed char c;
+
+    while ((c = getopt(argc, argv, "t:i:s")) != -1) {
+        switch (c) {
+        case 't':
+            thread_count = atoi(optarg);
+            break;
+        case 'i':
+            iterations = atoi(optarg);
+            break;
+        case 's':
+            share = true;
+            break;
+        case '?':
+            if (isprint (optopt))
+                printf ("Unknown option `-%c'.\n", optopt);
+            PrintUsage();
+
+            return false;
+        default:
+            abort ();
+        }
+    }
+
+    if(thread_count < 1 || thread_count > MAX_THREADS || iterations < 1) {
+        PrintUsage();
+        return false;
+    }
+
+    return true;
+}
+
+static void
+ThreadColor(int index, GLubyte color[4])
+{
+    color[0] = (GLubyte)(37  * (index + 1));
+    color[1] = (GLubyte)(91  * (index + 1));
+    color[2] = (GLubyte)(157 * (index + 1));
+    color[3] = 255;
+}
+
+static void
+ClearColor(int index, GLubyte color[4])
+{
+    ThreadColor(index, color);
+    color[0] = 255 - color[0];
+    color[1] = 255 - color[1];
+    color[2] = 255 - color[2];
+}
+
+/// The left half holds the drawn texture, the right half the clear color
+static int
+CheckPixels(const GLubyte *pixels, const GLubyte textureColor[4], const GLubyte clearColor[4])
+{
+    for(int y = 0; y < SURFACE_SIZE; ++y) {
+        for(int x = 0; x < SURFACE_SIZE; ++x) {
+            const GLubyte *color = x < SURFACE_SIZE / 2 ? textureColor : clearColor;
+            if(memcmp(&pixels[4 * (y * SURFACE_SIZE + x)], color, 4) != 0) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static GLuint
+CreateProgram(void)
+{
+    GLuint vs, fs, program = 0;
+
+    if(!LoadShader(VERTEX_SHADER_NAME  , &vs, GL_VERTEX_SHADER)   ||
+       !LoadShader(FRAGMENT_SHADER_NAME, &fs, GL_FRAGMENT_SHADER) ||
+       !LoadProgram(vs, fs, &program)) {
+        return 0;
+    }
+    DeleteShader(vs);
+    DeleteShader(fs);
+
+    glUseProgram(program);
+    glUniform1i (glGetUniformLocation(program, "uniform_texture"), 0);
+
+    return program;
+}
+
+static void *
+RenderThread(void *arg)
+{
+    thread_data_t *data = (thread_data_t *)arg;
+
+    const EGLint surface_attribs[] = { EGL_WIDTH, SURFACE_SIZE, EGL_HEIGHT, SURFACE_SIZE, EGL_NONE };
+    const EGLint context_attribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surface_attribs);
+    EGLContext context = eglCreateContext(display, config, share_context, context_attribs);
+    if(surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT ||
+       eglMakeCurrent(display, surface, surface, context) != EGL_TRUE) {
+        printf("[Thread %2d] context creation failed [EGL error 0x%x]\n", data->mIndex, eglGetError());
+        data->mFailures = data->mIterations;
+        return NULL;
+    }
+
+    // without a share group every thread links its own program, so that pipelines are created concurrently
+    GLuint program = share ? share_program : CreateProgram();
+    if(!program) {
+        printf("[Thread %2d] program creation failed\n", data->mIndex);
+        data->mFailures = data->mIterations;
+        return NULL;
+    }
+
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad_data), quad_data, GL_STATIC_DRAW);
+
+    GLint posLocation = glGetAttribLocation(program, "v_posCoord_in");
+    GLint texLocation = glGetAttribLocation(program, "v_texCoord_in");
+    glVertexAttribPointer    (posLocation, 2, GL_FLOAT, GL_FALSE, 0, (const void *)0);
+    glVertexAttribPointer    (texLocation, 2, GL_FLOAT, GL_FALSE, 0, (const void *)(8 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(posLocation);
+    glEnableVertexAttribArray(texLocation);
+    glUseProgram             (program);
+
+    GLubyte  textureColor[4];
+    GLubyte  clearColor[4];
+    GLubyte  texels[TEXTURE_SIZE * TEXTURE_SIZE * 4];
+    GLubyte *pixels = (GLubyte *)malloc(SURFACE_SIZE * SURFACE_SIZE * 4);
+
+    ThreadColor(data->mIndex, textureColor);
+    ClearColor (data->mIndex, clearColor);
+    for(int i = 0; i < TEXTURE_SIZE * TEXTURE_SIZE; ++i) {
+        memcpy(&texels[4 * i], textureColor, 4);
+    }
+
+    double t0 = CpuTime();
+    for(int i = 0; i < data->mIterations; ++i) {
+        // short-lived textures exercise the resources shared by all contexts,
+        // and the alternating filters the sampler cache
+        GLuint texture;
+        glGenTextures  (1, &texture);
+        glBindTexture  (GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (i & 1) ? GL_NEAREST : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (i & 1) ? GL_NEAREST : GL_LINEAR);
+        glTexImage2D   (GL_TEXTURE_2D, 0, GL_RGBA, TEXTURE_SIZE, TEXTURE_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels);
+
+        glClearColor(clearColor[0] / 255.0f, clearColor[1] / 255.0f, clearColor[2] / 255.0f, clearColor[3] / 255.0f);
+        glClear     (GL_COLOR_BUFFER_BIT);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+        memset(pixels, 0, SURFACE_SIZE * SURFACE_SIZE * 4);
+        glReadPixels(0, 0, SURFACE_SIZE, SURFACE_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+        glDeleteTextures(1, &texture);
+
+        data->mFailures += CheckPixels(pixels, textureColor, clearColor) || glGetError() != GL_NO_ERROR;
+    }
+    data->mTime = CpuTime() - t0;
+
+    free(pixels);
+
+    glDeleteBuffers(1, &buffer);
+    if(!share) {
+        DeleteProgram(program);
+    }
+
+    eglMakeCurrent   (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglDestroySurface(display, surface);
+
+    if(eglGetError() != EGL_SUCCESS) {
+        ++data->mFailures;
+    }
+
+    return NULL;
+}
+
+int
+main(int argc, char **argv)
+{
+    if(!ReadArguments(argc, argv))
+        return 1;
+
+    const EGLint config_attribs[] = { EGL_SURFACE_TYPE   , EGL_PBUFFER_BIT,
+                                      EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+                                      EGL_RED_SIZE       , 8,
+                                      EGL_GREEN_SIZE     , 8,
+                                      EGL_BLUE_SIZE      , 8,
+                                      EGL_ALPHA_SIZE     , 8,
+                                      EGL_NONE };
+    EGLint num_configs = 0;
+
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if(!eglInitialize(display, NULL, NULL) ||
+       !eglChooseConfig(display, config_attribs, &config, 1, &num_configs) || num_configs == 0) {
+        printf("No pbuffer configuration found [EGL error 0x%x]\n", eglGetError());
+        return 1;
+    }
+
+    const EGLint surface_attribs[] = { EGL_WIDTH, SURFACE_SIZE, EGL_HEIGHT, SURFACE_SIZE, EGL_NONE };
+    const EGLint context_attribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+    EGLSurface   share_surface     = EGL_NO_SURFACE;
+
+    if(share) {
+        share_surface = eglCreatePbufferSurface(display, config, surface_attribs);
+        share_context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attribs);
+        if(share_surface == EGL_NO_SURFACE || share_context == EGL_NO_CONTEXT ||
+           eglMakeCurrent(display, share_surface, share_surface, share_context) != EGL_TRUE ||
+           !(share_program = CreateProgram())) {
+            printf("Shared program creation failed [EGL error 0x%x]\n", eglGetError());
+            return 1;
+        }
+        glFinish();
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+
+    pthread_t     threads[MAX_THREADS];
+    thread_data_t data[MAX_THREADS];
+
+    for(int t = 0; t < thread_count; ++t) {
+        data[t].mIndex      = t;
+        data[t].mIterations = iterations;
+        data[t].mFailures   = 0;
+        data[t].mTime       = 0.0;
+        pthread_create(&threads[t], NULL, RenderThread, &data[t]);
+    }
+
+    int failures = 0;
+    for(int t = 0; t < thread_count; ++t) {
+        pthread_join(threads[t], NULL);
+        failures += data[t].mFailures;
+        printf("[Thread %2d] [Iterations] [%d] [Failures] [%d] [%.3f ms per iteration]\n",
+               t, data[t].mIterations, data[t].mFailures, data[t].mTime * 1000.0 / data[t].mIterations);
+    }
+
+    if(share) {
+        eglMakeCurrent   (display, share_surface, share_surface, share_context);
+        DeleteProgram    (share_program);
+        eglMakeCurrent   (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, share_context);
+        eglDestroySurface(display, share_surface);
+    }
+
+    eglTerminate(display);
+
+    printf("[Threads] [%d] [Shared Program] [%s] [Total Failures] [%d]\n", thread_count, share ? "Yes" : "No", failures);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * Window resize storm. The native window is resized every few frames while
+ * frames are cleared and presented back to back, so that the swapchain is
+ * recreated over and over. The time of every frame, from its first command to
+ * the return of eglSwapBuffers, is recorded and the average, p99 and worst
+ * frame times are printed.
+ */
+
+#include <unistd.h>
+#include <getopt.h>
+#include <ctype.h>
+
+#include "../engine/glcore/common.h"
+
+#ifdef VK_USE_PLATFORM_XCB_KHR
+#include <X11/Xlib.h>
+#endif
+
+#define DEFAULT_FRAMES       600
+#define DEFAULT_RESIZE_EVERY 10
+#define MAX_FRAMES           100000
+#define WINDOW_SIZE          512
+
+static int           frame_count  = DEFAULT_FRAMES;
+static int           resize_every = DEFAULT_RESIZE_EVERY;
+
+/// Sizes the window cycles through, as fractions of its initial size
+static const float   size_scales[] = { 1.0f, 0.5f, 0.75f, 0.25f, 0.875f };
+
+static void
+PrintUsage()
+{
+    printf("Correct Usage: ./resize_storm [-f <frames>] [-n <frames between resizes>]\n");
+}
+
+static bool
+ReadArguments(int argc, char *argv[])
+{
+    signed char c;
+
+    while ((c = getopt(argc, argv, "f:n:")) != -1) {
+        switch (c) {
+        case 'f':
+            frame_count = atoi(optarg);
+            break;
+        case 'n':
+            resize_every = atoi(optarg);
+            break;
+        case '?':
+            if (isprint (optopt))
+                printf ("Unknown option `-%c'.\n", optopt);
+            PrintUsage();
+
+            return false;
+        default:
+            abort ();
+        }
+    }
+
+    if(frame_count < 1 || frame_count > MAX_FRAMES || resize_every < 1) {
+        PrintUsage();
+        return false;
+    }
+
+    return true;
+}
+
+static int
+CompareTimes(const void *a, const void *b)
+{
+    double ta = *(const double *)a;
+    double tb = *(const double *)b;
+
+    return (ta > tb) - (ta < tb);
+}
+
+#ifdef VK_USE_PLATFORM_XCB_KHR
+static void
+ResizeWindow(int width, int height)
+{
+    XResizeWindow(_eglut->native_dpy, _eglut->current->native.u.window, width, height);
+    XFlush(_eglut->native_dpy);
+}
+
+static void
+ProcessEvents(void)
+{
+    XEvent event;
+
+    while(XPending(_eglut->native_dpy)) {
+        XNextEvent(_eglut->native_dpy, &event);
+        if(event.type == ConfigureNotify) {
+            _eglut->current->native.width  = event.xconfigure.width;
+            _eglut->current->native.height = event.xconfigure.height;
+        }
+    }
+}
+#endif // VK_USE_PLATFORM_XCB_KHR
+
+int
+main(int argc, char **argv)
+{
+    if(!ReadArguments(argc, argv))
+        return 1;
+
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    eglutInitWindowSize(WINDOW_SIZE, WINDOW_SIZE);
+    eglutInitAPIMask(EGLUT_OPENGL_ES2_BIT);
+    eglutInit(argc, (const char **)argv);
+
+    if(_eglut->surface_type != EGL_WINDOW_BIT) {
+        printf("A native window is needed to resize\n");
+        return 1;
+    }
+    eglutCreateWindow("Resize Storm");
+
+    double *times   = (double *)malloc(frame_count * sizeof(double));
+    int     resizes = 0;
+    int     size    = 0;
+    int     width   = WINDOW_SIZE;
+    int     height  = WINDOW_SIZE;
+
+    for(int frame = 0; frame < frame_count; ++frame) {
+        if(frame > 0 && frame % resize_every == 0) {
+            size   = (size + 1) % (int)(sizeof(size_scales) / sizeof(size_scales[0]));
+            width  = (int)(WINDOW_SIZE * size_scales[size]);
+            height = (int)(WINDOW_SIZE * size_scales[size]);
+            ResizeWindow(width, height);
+            ++resizes;
+        }
+        ProcessEvents();
+
+        double t0 = CpuTime();
+
+        glViewport  (0, 0, width, height);
+        glClearColor((frame % 3) / 2.0f, size_scales[size], 1.0f - size_scales[size], 1.0f);
+        glClear     (GL_COLOR_BUFFER_BIT);
+        eglSwapBuffers(_eglut->dpy, _eglut->current->surface);
+
+        times[frame] = CpuTime() - t0;
+    }
+
+    int failures = glGetError() != GL_NO_ERROR;
+
+    double total = 0.0;
+    for(int frame = 0; frame < frame_count; ++frame) {
+        total += times[frame];
+    }
+    qsort(times, frame_count, sizeof(double), CompareTimes);
+
+    int p99 = (frame_count * 99 + 99) / 100 - 1;
+
+    printf("[Frames] [%d] [Resizes] [%d] [Average] [%8.3f ms] [p99] [%8.3f ms] [Worst] [%8.3f ms] [Failures] [%d]\n",
+           frame_count, resizes, total * 1000.0 / frame_count, times[p99] * 1000.0, times[frame_count - 1] * 1000.0, failures);
+
+    free(times);
+    eglutDestroyWindow(_eglut->current->index);
+    _eglutFini();
+
+    return failures == 0 ? 0 : 1;
+#else
+    printf("Resizing is implemented for X11 windows only\n");
+
+    return 0;
+#endif // VK_USE_PLATFORM_XCB_KHR
+}
@@ -0,0 +1,320 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ * Loader/render thread pair. A loader thread uploads a set of textures and a
+ * vertex buffer in its own context and hands them over to the render context
+ * with an EGL fence sync (EGL_KHR_fence_sync). The render context is created
+ * once with its own objects, which have to be uploaded again, and once with
+ * the loader context as share_context, which uses the objects of the loader.
+ * The load time and the resident memory of each case are printed, and every
+ * texture is read back in the render context to check its contents.
+ */
+
+#include <unistd.h>
+#include <getopt.h>
+#include <ctype.h>
+#include <pthread.h>
+
+#include "../engine/glcore/common.h"
+#include "EGL/eglext.h"
+
+#define DEFAULT_TEXTURES     64
+#define DEFAULT_TEXTURE_SIZE 256
+#define MAX_TEXTURES         1024
+#define SURFACE_SIZE         16
+#define VERTEX_COUNT         65536
+
+typedef struct loader_data_t {
+    EGLContext        mContext;
+    EGLSurface        mSurface;
+    GLuint           *mTextures;
+    GLuint            mBuffer;
+    EGLSyncKHR        mSync;
+    bool              mDone;
+    pthread_mutex_t   mMutex;
+    pthread_cond_t    mCond;
+} loader_data_t;
+
+static EGLDisplay    display;
+static EGLConfig     config;
+static int           texture_count = DEFAULT_TEXTURES;
+static int           texture_size  = DEFAULT_TEXTURE_SIZE;
+
+static PFNEGLCREATESYNCKHRPROC      pfnCreateSyncKHR;
+static PFNEGLDESTROYSYNCKHRPROC     pfnDestroySyncKHR;
+static PFNEGLCLIENTWAITSYNCKHRPROC  pfnClientWaitSyncKHR;
+
+static void
+PrintUsage()
+{
+    printf("Correct Usage: ./shared_context_loader [-n <textures>] [-s <texture size>]\n");
+}
+
+static bool
+ReadArguments(int argc, char *argv[])
+{
+    signed char c;
+
+    while ((c = getopt(argc, argv, "n:s:")) != -1) {
+        switch (c) {
+        case 'n':
+            texture_count = atoi(optarg);
+            break;
+        case 's':
+            texture_size = atoi(optarg);
+            break;
+        case '?':
+            if (isprint (optopt))
+                printf ("Unknown option `-%c'.\n", optopt);
+            PrintUsage();
+
+            return false;
+        default:
+            abort ();
+        }
+    }
+
+    if(texture_count < 1 || texture_count > MAX_TEXTURES || texture_size < 1 || texture_size > 4096) {
+        PrintUsage();
+        return false;
+    }
+
+    return true;
+}
+
+/// Resident set size of the process in KB, which includes the device memory of integrated and software drivers
+static long
+ResidentMemory(void)
+{
+    char  line[128];
+    long  rss  = 0;
+    FILE *file = fopen("/proc/self/status", "r");
+
+    if(!file) {
+        return 0;
+    }
+
+    while(fgets(line, sizeof(line), file)) {
+        if(sscanf(line, "VmRSS: %ld kB", &rss) == 1) {
+            break;
+        }
+    }
+    fclose(file);
+
+    return rss;
+}
+
+static GLubyte
+TextureValue(int index)
+{
+    return (GLubyte)(17 * (index + 1));
+}
+
+static void
+UploadObjects(GLuint *textures, GLuint *buffer)
+{
+    GLubyte *texels   = (GLubyte *)malloc(texture_size * texture_size * 4);
+    GLfloat *vertices = (GLfloat *)calloc(VERTEX_COUNT * 4, sizeof(GLfloat));
+
+    glGenTextures(texture_count, textures);
+    for(int i = 0; i < texture_count; ++i) {
+        memset(texels, TextureValue(i), texture_size * texture_size * 4);
+
+        glBindTexture  (GL_TEXTURE_2D, textures[i]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D   (GL_TEXTURE_2D, 0, GL_RGBA, texture_size, texture_size, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenBuffers(1, buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, *buffer);
+    glBufferData(GL_ARRAY_BUFFER, VERTEX_COUNT * 4 * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    free(vertices);
+    free(texels);
+}
+
+static void
+DeleteObjects(GLuint *textures, GLuint buffer)
+{
+    glDeleteTextures(texture_count, textures);
+    glDeleteBuffers (1, &buffer);
+}
+
+static int
+CheckTextures(const GLuint *textures)
+{
+    GLubyte pixel[4];
+    GLuint  fbo;
+    int     failures = 0;
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    for(int i = 0; i < texture_count; ++i) {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textures[i], 0);
+
+        memset(pixel, 0, sizeof(pixel));
+        glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        failures += pixel[0] != TextureValue(i) || pixel[3] != TextureValue(i);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+
+    return failures + (glGetError() != GL_NO_ERROR);
+}
+
+static void *
+LoaderThread(void *arg)
+{
+    loader_data_t *data = (loader_data_t *)arg;
+
+    eglMakeCurrent(display, data->mSurface, data->mSurface, data->mContext);
+
+    UploadObjects(data->mTextures, &data->mBuffer);
+
+    // the render thread waits for the uploads through the fence instead of a glFinish here
+    EGLSyncKHR sync = pfnCreateSyncKHR(display, EGL_SYNC_FENCE_KHR, NULL);
+    glFlush();
+
+    pthread_mutex_lock(&data->mMutex);
+    data->mSync = sync;
+    data->mDone = true;
+    pthread_cond_signal(&data->mCond);
+    pthread_mutex_unlock(&data->mMutex);
+
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    return NULL;
+}
+
+static int
+RunCase(bool share)
+{
+    const EGLint surface_attribs[] = { EGL_WIDTH, SURFACE_SIZE, EGL_HEIGHT, SURFACE_SIZE, EGL_NONE };
+    const EGLint context_attribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+
+    GLuint        loaderTextures[MAX_TEXTURES];
+    GLuint        renderTextures[MAX_TEXTURES];
+    GLuint        renderBuffer = 0;
+    loader_data_t loader;
+    pthread_t     thread;
+
+    memset(&loader, 0, sizeof(loader));
+    pthread_mutex_init(&loader.mMutex, NULL);
+    pthread_cond_init (&loader.mCond , NULL);
+    loader.mTextures = loaderTextures;
+
+    long   rss0 = ResidentMemory();
+    double t0   = CpuTime();
+
+    loader.mSurface = eglCreatePbufferSurface(display, config, surface_attribs);
+    loader.mContext = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attribs);
+
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surface_attribs);
+    EGLContext context = eglCreateContext(display, config, share ? loader.mContext : EGL_NO_CONTEXT, context_attribs);
+    if(loader.mContext == EGL_NO_CONTEXT || context == EGL_NO_CONTEXT ||
+       eglMakeCurrent(display, surface, surface, context) != EGL_TRUE) {
+        printf("Context creation failed [EGL error 0x%x]\n", eglGetError());
+        return 1;
+    }
+
+    pthread_create(&thread, NULL, LoaderThread, &loader);
+
+    pthread_mutex_lock(&loader.mMutex);
+    while(!loader.mDone) {
+        pthread_cond_wait(&loader.mCond, &loader.mMutex);
+    }
+    pthread_mutex_unlock(&loader.mMutex);
+
+    int failures = 0;
+    if(loader.mSync == EGL_NO_SYNC_KHR ||
+       pfnClientWaitSyncKHR(display, loader.mSync, EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, EGL_FOREVER_KHR) != EGL_CONDITION_SATISFIED_KHR) {
+        ++failures;
+    }
+
+    const GLuint *textures = loaderTextures;
+    if(!share) {
+        UploadObjects(renderTextures, &renderBuffer);
+        textures = renderTextures;
+    }
+
+    double loadTime = CpuTime() - t0;
+    long   rss1     = ResidentMemory();
+
+    failures += CheckTextures(textures);
+
+    pthread_join(thread, NULL);
+
+    if(!share) {
+        DeleteObjects(renderTextures, renderBuffer);
+    }
+    if(loader.mSync != EGL_NO_SYNC_KHR) {
+        pfnDestroySyncKHR(display, loader.mSync);
+    }
+
+    eglMakeCurrent   (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglDestroySurface(display, surface);
+    eglDestroyContext(display, loader.mContext);
+    eglDestroySurface(display, loader.mSurface);
+
+    pthread_cond_destroy (&loader.mCond);
+    pthread_mutex_destroy(&loader.mMutex);
+
+    printf("[%-8s] [Load Time] [%8.3f ms] [Resident Memory] [%+8ld KB] [Failures] [%d]\n",
+           share ? "Shared" : "Separate", loadTime * 1000.0, rss1 - rss0, failures);
+
+    return failures;
+}
+
+int
+main(int argc, char **argv)
+{
+    if(!ReadArguments(argc, argv))
+        return 1;
+
+    const EGLint config_attribs[] = { EGL_SURFACE_TYPE   , EGL_PBUFFER_BIT,
+                                      EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+                                      EGL_RED_SIZE       , 8,
+                                      EGL_GREEN_SIZE     , 8,
+                                      EGL_BLUE_SIZE      , 8,
+                                      EGL_ALPHA_SIZE     , 8,
+                                      EGL_NONE };
+    EGLint num_configs = 0;
+
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if(!eglInitialize(display, NULL, NULL) ||
+       !eglChooseConfig(display, config_attribs, &config, 1, &num_configs) || num_configs == 0) {
+        printf("No pbuffer configuration found [EGL error 0x%x]\n", eglGetError());
+        return 1;
+    }
+
+    pfnCreateSyncKHR     = (PFNEGLCREATESYNCKHRPROC)    eglGetProcAddress("eglCreateSyncKHR");
+    pfnDestroySyncKHR    = (PFNEGLDESTROYSYNCKHRPROC)   eglGetProcAddress("eglDestroySyncKHR");
+    pfnClientWaitSyncKHR = (PFNEGLCLIENTWAITSYNCKHRPROC)eglGetProcAddress("eglClientWaitSyncKHR");
+    if(!pfnCreateSyncKHR || !pfnDestroySyncKHR || !pfnClientWaitSyncKHR) {
+        printf("EGL_KHR_fence_sync is not supported\n");
+        return 1;
+    }
+
+    printf("[Textures] [%d] [Size] [%dx%d]\n", texture_count, texture_size, texture_size);
+
+    int failures = RunCase(false) + RunCase(true);
+
+    eglTerminate(display);
+
+    return failures == 0 ? 0 : 1;
+}
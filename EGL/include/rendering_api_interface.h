@@ -35,19 +35,44 @@ extern "C" {
 #include "EGL/egl.h"
 #include "vulkan/vulkan.h"
 
+typedef struct vkSyncItems_t {
+    VkSemaphore                         vkAcquireSemaphore;
+    bool                                acquireSemaphoreFlag;
+    VkSemaphore                         vkDrawSemaphore;
+    bool                                drawSemaphoreFlag;
+    // owned by EGL, signaled by the last submission of the frame instead of vkDrawSemaphore when presentPending is set
+    VkSemaphore                         vkPresentSemaphore;
+    bool                                presentSemaphoreFlag;
+    bool                                presentPending;
+} vkSyncItems_t;
+
 typedef struct EGLSurfaceInterface_t {
     void    *surface;
     void    *images;
     void    *depthBuffer;
+    void    *displayDriver;
+    bool   (*acquire_image_cb)(struct EGLSurfaceInterface_t *eglSurfaceInterface);
     int32_t  contextRef;
     uint32_t imageCount;
     uint32_t nextImageIndex;
+    bool     nextImageAcquired;
     uint32_t surfaceColorFormat;
     uint32_t type;
     uint32_t width;
     uint32_t height;
     uint32_t depthSize;
     uint32_t stencilSize;
+    // EGL_KHR_partial_update bounding box of the damage region, with a lower left origin
+    bool     damageEnabled;
+    bool     damagePending;
+    int32_t  damageX;
+    int32_t  damageY;
+    uint32_t damageWidth;
+    uint32_t damageHeight;
+    // set when the buffer age of the current frame was queried, so the previous contents must be kept
+    bool     bufferAgeQueried;
+    // semaphores of the rendering to the surface, owned by the client API and waited by presentation
+    vkSyncItems_t *vkSyncItems;
 } EGLSurfaceInterface;
 
 typedef void * api_state_t;
@@ -56,7 +81,7 @@ typedef void (*GLPROC)(void);
 
 typedef api_state_t (*init_API_cb_t)();
 typedef void (*terminate_API_cb_t)();
-typedef api_context_t (*create_context_cb_t)();
+typedef api_context_t (*create_context_cb_t)(bool no_error, api_context_t share_context);
 typedef void (*set_read_write_surface_cb_t)(api_context_t api_context, EGLSurfaceInterface *eglReadSurfaceInterface, EGLSurfaceInterface *eglWriteSurfaceInterface);
 typedef void (*delete_shared_surface_data_cb_t)(EGLSurfaceInterface *eglSurfaceInterface);
 typedef void (*delete_context_cb_t)(api_context_t api_context);
@@ -64,7 +89,9 @@ typedef void (*release_system_fbo_cb_t)(api_context_t api_context);
 typedef GLPROC (*get_proc_addr_cb_t)(const char* procname);
 typedef void (*flush_cb_t)(api_context_t api_context);
 typedef void (*finish_cb_t)(api_context_t api_context);
-typedef void (*bind_to_texture_cb_t)(api_context_t api_context, uint32_t bind);
+typedef void (*bind_to_texture_cb_t)(api_context_t api_context, EGLSurfaceInterface *eglSurfaceInterface, uint32_t bind);
+typedef bool (*insert_fence_cb_t)(api_context_t api_context, VkFence fence);
+typedef void (*wait_fence_cb_t)(api_context_t api_context);
 
 typedef struct rendering_api_interface {
     api_state_t state;
@@ -79,6 +106,8 @@ typedef struct rendering_api_interface {
     flush_cb_t flush_cb;
     finish_cb_t finish_cb;
     bind_to_texture_cb_t bind_to_texture_cb;
+    insert_fence_cb_t insert_fence_cb;
+    wait_fence_cb_t wait_fence_cb;
 } rendering_api_interface_t;
 
 extern rendering_api_interface_t GLES2Interface;
@@ -93,12 +122,8 @@ extern "C" {
 #endif
 #endif
 
-typedef struct vkSyncItems_t {
-    VkSemaphore                         vkAcquireSemaphore;
-    bool                                acquireSemaphoreFlag;
-    VkSemaphore                         vkDrawSemaphore;
-    bool                                drawSemaphoreFlag;
-} vkSyncItems_t;
+// the queue is shared by EGL and all client API contexts, so its use is externally synchronized
+typedef void (*lock_queue_cb_t)(bool lock);
 
 typedef struct vkInterface {
     VkInstance                          vkInstance;
@@ -107,7 +132,10 @@ typedef struct vkInterface {
     uint32_t                            vkGraphicsQueueNodeIndex;
     VkDevice                            vkDevice;
     VkPhysicalDeviceMemoryProperties    vkDeviceMemoryProperties;
-    vkSyncItems_t                       *vkSyncItems;
+    lock_queue_cb_t                     vkLockQueue;
+    bool                                vkWSISupported;
+    bool                                vkIncrementalPresentSupported;
+    bool                                vkDisplayTimingSupported;
 } vkInterface_t;
 
 #endif // __RENDERING_API_INTERFACE_H__
@@ -34,7 +34,8 @@
 #endif // DEBUG_DEPTH
 #define DEBUG_DEPTH                          EGL_LOG_INFO
 
-RenderingThread currentThread;
+// current context, API and error are per thread, display state is locked by its owner
+thread_local RenderingThread currentThread;
 EGLGlobalResourceManager eglGlobalResourceManager;
 
 #define THREAD_EXEC_RETURN(func)             FUN_ENTRY(DEBUG_DEPTH);                                                      \
@@ -65,6 +66,11 @@ EGLGlobalResourceManager eglGlobalResourceManager;
                                              if(eglDriverPtr->CheckBadContext(eglContextPtr) == EGL_FALSE)                \
                                              { return erroRetValue; }
 
+#define CHECK_BAD_SYNC(eglDriverPtr, eglSyncPtr, eglSync, erroRetValue)                                                   \
+                                             EGLSync_t *eglSyncPtr = static_cast<EGLSync_t*>(eglSync);                    \
+                                             if(eglDriverPtr->CheckBadSync(eglSyncPtr) == EGL_FALSE)                      \
+                                             { return erroRetValue; }
+
 EGLDisplay EGLAPIENTRY
 eglGetDisplay(EGLNativeDisplayType display_id)
 {
@@ -131,7 +137,9 @@ eglCreateContext(EGLDisplay dpy, EGLConfig config, EGLContext share_context, con
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_CONTEXT)
     CHECK_BAD_CONFIG(eglDriver, eglConfig, config, EGL_NO_CONTEXT)
     EGLContext_t* eglShareContext = static_cast<EGLContext_t*>(share_context);
-    // TODO::check for valid context
+    if(eglShareContext != EGL_NO_CONTEXT && eglDriver->CheckBadContext(eglShareContext) == EGL_FALSE) {
+        return EGL_NO_CONTEXT;
+    }
     THREAD_EXEC_RETURN(CreateContext(eglDriver, eglConfig, eglShareContext, attrib_list));
 }
 
@@ -192,6 +200,7 @@ eglInitialize(EGLDisplay dpy, EGLint *major, EGLint *minor)
     FUN_ENTRY(DEBUG_DEPTH);
 
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
+    std::lock_guard<std::recursive_mutex> lock(eglGlobalResourceManager.GetMutex());
     // TODO:: EGLDisplay and DisplayDriver could be fused together, as they are 1-1
     DisplayDriver *eglDriver = eglGlobalResourceManager.AddDriver(eglDisplay);
     EGLBoolean res = eglDriver->Initialize(major, minor);
@@ -207,6 +216,7 @@ eglTerminate(EGLDisplay dpy)
     FUN_ENTRY(DEBUG_DEPTH);
 
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
+    std::lock_guard<std::recursive_mutex> lock(eglGlobalResourceManager.GetMutex());
     DisplayDriver *eglDriver = eglGlobalResourceManager.FindDriver(eglDisplay);
     if(eglDriver == nullptr || !eglDriver->Initialized()) {
         return EGL_FALSE;
@@ -422,6 +432,9 @@ eglGetProcAddress(const char *procname)
     // get GL function pointers
     EGLenum enumAPI = currentThread.QueryAPI();
     if(enumAPI == EGL_OPENGL_ES_API) {
+        // the library reference counter is shared by all threads
+        std::lock_guard<std::recursive_mutex> lock(eglGlobalResourceManager.GetMutex());
+
         // Assuming only GLES2 for now
         rendering_api_interface_t* api = nullptr;
         rendering_api_return_e ret = RENDERING_API_load_api(EGL_OPENGL_ES_API, EGL_GL_VERSION_2, &api);
@@ -458,7 +471,6 @@ eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image)
     return eglDriver->DestroyImageKHR(image);
 }
 
-//TODO: Implement the KHR_fence_sync extension
 EGLSyncKHR EGLAPIENTRY
 eglCreateSyncKHR(EGLDisplay dpy, EGLenum type, const EGLint *attrib_list)
 {
@@ -476,7 +488,8 @@ eglDestroySyncKHR(EGLDisplay dpy, EGLSyncKHR sync)
 
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
-    return eglDriver->DestroySyncKHR(sync);
+    CHECK_BAD_SYNC(eglDriver, eglSync, sync, EGL_FALSE)
+    return eglDriver->DestroySyncKHR(eglSync);
 }
 
 EGLint EGLAPIENTRY
@@ -486,5 +499,50 @@ eglClientWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags, EGLTimeKHR t
 
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
-    return eglDriver->ClientWaitSyncKHR(sync, flags, timeout);
+    CHECK_BAD_SYNC(eglDriver, eglSync, sync, EGL_FALSE)
+    return eglDriver->ClientWaitSyncKHR(eglSync, flags, timeout);
+}
+
+EGLint EGLAPIENTRY
+eglWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
+    CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
+    CHECK_BAD_SYNC(eglDriver, eglSync, sync, EGL_FALSE)
+    return eglDriver->WaitSyncKHR(eglSync, flags);
+}
+
+EGLBoolean EGLAPIENTRY
+eglGetSyncAttribKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint attribute, EGLint *value)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
+    CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
+    CHECK_BAD_SYNC(eglDriver, eglSync, sync, EGL_FALSE)
+    return eglDriver->GetSyncAttribKHR(eglSync, attribute, value);
+}
+
+EGLBoolean EGLAPIENTRY
+eglSwapBuffersWithDamageKHR(EGLDisplay dpy, EGLSurface surface, EGLint *rects, EGLint n_rects)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
+    CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
+    CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
+    return eglDriver->SwapBuffersWithDamageKHR(eglSurface, rects, n_rects);
+}
+
+EGLBoolean EGLAPIENTRY
+eglSetDamageRegionKHR(EGLDisplay dpy, EGLSurface surface, EGLint *rects, EGLint n_rects)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
+    CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
+    CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
+    return eglDriver->SetDamageRegionKHR(eglSurface, rects, n_rects);
 }
@@ -57,7 +57,7 @@ const EGLConfig_t EglConfigs[1] = {
                              EGL_FALSE,   // BindToTextureRGB
                               EGL_TRUE,   // BindToTextureRGBA
                                      0,   // MinSwapInterval
-                                     1,   // MaxSwapInterval
+                                     4,   // MaxSwapInterval
                                      0,   // LuminanceSize
                                      0,   // AlphaMaskSize
                         EGL_RGB_BUFFER,   // ColorBufferType
@@ -28,12 +28,12 @@
 #include "thread/renderingThread.h"
 #include <algorithm>
 
-EGLContext_t::EGLContext_t(EGLDisplay_t* display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList):
+EGLContext_t::EGLContext_t(EGLDisplay_t* display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList):
 EGLRefObject(),
 mAPIContext(nullptr), mRenderingAPI(rendering_api), mAPIInterface(nullptr),
-mDisplay(display), mReadSurface(nullptr), mDrawSurface(nullptr),
+mDisplay(display), mReadSurface(nullptr), mDrawSurface(nullptr), mShareContext(shareContext),
 mConfig(config), mAttribList(attribList), mClientVersion(1),
-mIsCurrent(false)
+mNoError(false), mIsCurrent(false)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
@@ -100,7 +100,13 @@ EGLContext_t::Validate()
         return EGL_FALSE;
     }
 
-    // TODO:: generate EGL_BAD_MATCH for incompatible share_contets
+    // objects can only be shared with a context of the same client API, version and error mode
+    if(mShareContext && (mShareContext->GetRenderingAPI()   != mRenderingAPI  ||
+                         mShareContext->GetClientVersion()  != mClientVersion ||
+                         mShareContext->IsNoError()         != mNoError)) {
+        currentThread.RecordError(EGL_BAD_MATCH);
+        return EGL_FALSE;
+    }
 
     return EGL_TRUE;
 }
@@ -122,7 +128,10 @@ EGLContext_t::Create()
         return EGL_FALSE;
     }
 
-    mAPIContext = mAPIInterface->create_context_cb();
+    mAPIContext = mAPIInterface->create_context_cb(mNoError, mShareContext ? mShareContext->mAPIContext : nullptr);
+
+    // the share group is owned by the client API, so the share context is not needed after creation
+    mShareContext = nullptr;
 
     return mAPIContext != nullptr ? EGL_TRUE : EGL_FALSE;
 }
@@ -151,8 +160,8 @@ EGLContext_t::MakeCurrent(EGLDisplay_t *dpy, EGLSurface_t *draw, EGLSurface_t *r
     mDrawSurface = draw;
     mReadSurface = read;
 
-    // TODO: support pbuffers/pixmaps
-    if (draw && draw->GetType() != EGL_WINDOW_BIT) {
+    // TODO: support pixmaps
+    if (draw && draw->GetType() == EGL_PIXMAP_BIT) {
         return EGL_TRUE;
     }
 
@@ -190,11 +199,27 @@ EGLContext_t::Finish()
 }
 
 void
-EGLContext_t::BindToTexture(EGLint bind)
+EGLContext_t::BindToTexture(EGLSurface_t *surface, EGLint bind)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
-    mAPIInterface->bind_to_texture_cb(mAPIContext, bind);
+    mAPIInterface->bind_to_texture_cb(mAPIContext, surface->GetEGLSurfaceInterface(), bind);
+}
+
+EGLBoolean
+EGLContext_t::InsertFence(VkFence vkFence)
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    return mAPIInterface->insert_fence_cb(mAPIContext, vkFence) ? EGL_TRUE : EGL_FALSE;
+}
+
+void
+EGLContext_t::WaitFence()
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    mAPIInterface->wait_fence_cb(mAPIContext);
 }
 
 EGLBoolean
@@ -210,8 +235,9 @@ EGLContext_t::ParseAttributeList(const EGLint* attrib_list)
         return EGL_FALSE;
     }
 
-    // EGL_BAD_ATTRIBUTE is also generated if
-    // attribute is not EGL_CONTEXT_CLIENT_VERSION  with values 1 or 2
+    // EGL_BAD_ATTRIBUTE is also generated if attribute is not
+    // EGL_CONTEXT_CLIENT_VERSION with values 1 or 2 or
+    // EGL_CONTEXT_OPENGL_NO_ERROR_KHR with a boolean value
     for(int i = 0; attrib_list[i] != EGL_NONE; i++) {
         EGLint attr = attrib_list[i++];
         EGLint val = attrib_list[i];
@@ -220,6 +246,8 @@ EGLContext_t::ParseAttributeList(const EGLint* attrib_list)
            mClientVersion = EGL_GL_VERSION_1;
         } else if(attr == EGL_CONTEXT_CLIENT_VERSION && val == 2) {
             mClientVersion = EGL_GL_VERSION_2;
+        } else if(attr == EGL_CONTEXT_OPENGL_NO_ERROR_KHR && (val == EGL_TRUE || val == EGL_FALSE)) {
+            mNoError = val == EGL_TRUE;
         } else {
             currentThread.RecordError(EGL_BAD_ATTRIBUTE);
             return EGL_FALSE;
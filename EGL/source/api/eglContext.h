@@ -40,9 +40,11 @@ private:
     struct EGLDisplay_t          *mDisplay;
     class EGLSurface_t          *mReadSurface;
     class EGLSurface_t          *mDrawSurface;
+    EGLContext_t                *mShareContext;
     struct EGLConfig_t          *mConfig;
     const EGLint                *mAttribList;
     EGLenum                      mClientVersion;
+    bool                         mNoError;
     bool                         mIsCurrent;
 
     EGLBoolean                   GetAPIRenderableType();
@@ -50,7 +52,7 @@ private:
     EGLBoolean                   Validate();
 
 public:
-    EGLContext_t(struct EGLDisplay_t * display, EGLenum rendering_api, EGLConfig_t* config, const EGLint *attribList);
+    EGLContext_t(struct EGLDisplay_t * display, EGLenum rendering_api, EGLConfig_t* config, EGLContext_t *shareContext, const EGLint *attribList);
     ~EGLContext_t();
 
     EGLBoolean                   Create();
@@ -59,7 +61,9 @@ public:
     //void                         SetNextImageIndex(uint32_t index);
     void                         Flush();
     void                         Finish();
-    void                         BindToTexture(EGLint bind);
+    void                         BindToTexture(class EGLSurface_t *surface, EGLint bind);
+    EGLBoolean                   InsertFence(VkFence vkFence);
+    void                         WaitFence();
     void                         ReleaseSurfaceResources();
 
     inline void                  SetNotCurrent()                                { FUN_ENTRY(EGL_LOG_TRACE); mIsCurrent = false; }
@@ -70,6 +74,8 @@ public:
     inline EGLSurface_t         *GetDrawSurface()                         const { FUN_ENTRY(EGL_LOG_TRACE); return mDrawSurface; }
     inline EGLint                GetConfigID()                            const { FUN_ENTRY(EGL_LOG_TRACE); return GetConfigKey(mConfig, EGL_CONFIG_ID); }
     inline EGLint                GetClientVersion()                       const { FUN_ENTRY(EGL_LOG_TRACE); return mClientVersion; }
+    inline bool                  IsNoError()                              const { FUN_ENTRY(EGL_LOG_TRACE); return mNoError; }
+    inline VkDevice              GetVkDevice()                            const { FUN_ENTRY(EGL_LOG_TRACE); return reinterpret_cast<const vkInterface_t *>(mAPIInterface->state)->vkDevice; }
            EGLint                GetRenderBuffer()                        const;
     inline bool                  IsCurrent()                              const  { FUN_ENTRY(EGL_LOG_TRACE); return mIsCurrent; }
 
@@ -26,8 +26,19 @@
 #endif //  EGL_FUNC_PTR
 
 #include "EGL/egl.h"
+#include "EGL/eglext.h"
 #include <string>
 #include <unordered_map>
+#ifndef EGL_EGLEXT_PROTOTYPES
+EGLSyncKHR EGLAPIENTRY eglCreateSyncKHR(EGLDisplay dpy, EGLenum type, const EGLint *attrib_list);
+EGLBoolean EGLAPIENTRY eglDestroySyncKHR(EGLDisplay dpy, EGLSyncKHR sync);
+EGLint     EGLAPIENTRY eglClientWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags, EGLTimeKHR timeout);
+EGLint     EGLAPIENTRY eglWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags);
+EGLBoolean EGLAPIENTRY eglGetSyncAttribKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint attribute, EGLint *value);
+EGLBoolean EGLAPIENTRY eglSwapBuffersWithDamageKHR(EGLDisplay dpy, EGLSurface surface, EGLint *rects, EGLint n_rects);
+EGLBoolean EGLAPIENTRY eglSetDamageRegionKHR(EGLDisplay dpy, EGLSurface surface, EGLint *rects, EGLint n_rects);
+#endif // EGL_EGLEXT_PROTOTYPES
+
 static const std::unordered_map<std::string, __eglMustCastToProperFunctionPointerType> eglFPMap = {
 #ifdef EGL_VERSION_1_0
 EGL_FUNC_PTR(eglChooseConfig),
@@ -71,8 +82,23 @@ EGL_FUNC_PTR(eglWaitClient),
 #ifdef EGL_VERSION_1_3
 #endif /* EGL_VERSION_1_3 */
 #ifdef EGL_VERSION_1_4
-EGL_FUNC_PTR(eglGetCurrentContext)
+EGL_FUNC_PTR(eglGetCurrentContext),
 #endif /* EGL_VERSION_1_4 */
+#ifdef EGL_KHR_fence_sync
+EGL_FUNC_PTR(eglCreateSyncKHR),
+EGL_FUNC_PTR(eglDestroySyncKHR),
+EGL_FUNC_PTR(eglClientWaitSyncKHR),
+EGL_FUNC_PTR(eglGetSyncAttribKHR),
+#endif /* EGL_KHR_fence_sync */
+#ifdef EGL_KHR_wait_sync
+EGL_FUNC_PTR(eglWaitSyncKHR),
+#endif /* EGL_KHR_wait_sync */
+#ifdef EGL_KHR_swap_buffers_with_damage
+EGL_FUNC_PTR(eglSwapBuffersWithDamageKHR),
+#endif /* EGL_KHR_swap_buffers_with_damage */
+#ifdef EGL_KHR_partial_update
+EGL_FUNC_PTR(eglSetDamageRegionKHR)
+#endif /* EGL_KHR_partial_update */
 };
 #undef EGL_FUNC_PTR
 
@@ -32,6 +32,7 @@
 #include "eglContext.h"
 #include "eglDisplay.h"
 #include "vector"
+#include <mutex>
 
 class EGLGlobalResourceManager
 {
@@ -41,12 +42,15 @@ protected:
     DisplayDriversContainer     mDisplayDriversContainer;
 
     struct EGLDisplay_t         mEGLDisplayList[MAX_NUM_DISPLAYS];
+    std::recursive_mutex        mMutex;
     EGLDisplay_t                *FindDisplayByID(EGLNativeDisplayType display_id);
 
 public:
     EGLGlobalResourceManager();
     ~EGLGlobalResourceManager();
 
+    inline std::recursive_mutex &GetMutex(void)                                    { FUN_ENTRY(EGL_LOG_TRACE); return mMutex; }
+
     // EGLDisplay resources
     EGLBoolean                  InitializeDisplay(EGLDisplay dpy, void* displayDriver);
     EGLDisplay_t               *FindDisplay(EGLDisplay display);
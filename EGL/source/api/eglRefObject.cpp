@@ -44,7 +44,11 @@ EGLRefObject::UpdateRef(bool increaseRef)
 
     if(increaseRef) {
         mRefCounter++;
-    } else {
-        mRefCounter = std::max(mRefCounter - 1, 0);
+        return;
+    }
+
+    // the counter never drops below zero, even if another thread releases the object concurrently
+    int32_t refCounter = mRefCounter.load();
+    while(refCounter > 0 && !mRefCounter.compare_exchange_weak(refCounter, refCounter - 1)) {
     }
 }
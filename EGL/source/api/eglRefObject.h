@@ -29,6 +29,7 @@
 #include "utils/eglLogger.h"
 #include "eglConfig.h"
 #include "vector"
+#include <atomic>
 
 class EGLRefObject
 {
@@ -36,7 +37,8 @@ protected:
     bool                             misMarkedForDeletion;
 
 public:
-    int32_t                          mRefCounter;
+    // surfaces may be current to contexts of different threads
+    std::atomic<int32_t>             mRefCounter;
     EGLRefObject();
     virtual ~EGLRefObject() = 0;
 
@@ -33,8 +33,9 @@ DepthSize(0), StencilSize(0), RedSize(0), GreenSize(0), BlueSize(0), AlphaSize(0
 TextureFormat(0), TextureTarget(0), MipmapTexture(EGL_FALSE),
 LargestPbuffer(EGL_FALSE), RenderBuffer(0), VGAlphaFormat(0), VGColorspace(0),
 MipmapLevel(0), MultisampleResolve(0), SwapBehavior(0), HorizontalResolution(0),
-VerticalResolution(0), AspectRatio(0), SwapInterval(1), BindToTexture(EGL_FALSE), PostSubBufferSupportedNV(0),
-CurrentImageIndex(0), mPlatformResources(nullptr)
+VerticalResolution(0), AspectRatio(0), SwapInterval(1), BindToTexture(EGL_FALSE),
+DamageRegionSet(EGL_FALSE), PresentInterval(0.0), UndamagedPixels(0), PostSubBufferSupportedNV(0),
+CurrentImageIndex(0), mPlatformResources(nullptr), mCurrentContext(nullptr)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
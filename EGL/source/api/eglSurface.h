@@ -74,6 +74,13 @@ private:
     /* True if the surface is bound to an OpenGL ES texture */
     EGLBoolean                       BindToTexture;
 
+    /* EGL_KHR_partial_update state of the current frame */
+    EGLBoolean                       DamageRegionSet;
+
+    /* present statistics of window surfaces, updated by the platform on every present */
+    double                           PresentInterval;
+    uint64_t                         UndamagedPixels;
+
     EGLBoolean                       PostSubBufferSupportedNV;
     EGLint                           CurrentImageIndex;
     EGLint                           ColorFormat;
@@ -81,6 +88,9 @@ private:
 
     PlatformResources               *mPlatformResources;
 
+    /* The context the surface is bound to while that context is current, guarded by the display lock */
+    EGLContext_t                    *mCurrentContext;
+
 public:
     EGLSurface_t();
     ~EGLSurface_t();
@@ -103,10 +113,15 @@ public:
     inline void                      SetHeight(EGLint height)                                   { FUN_ENTRY(EGL_LOG_TRACE); Height = height; }
     inline void                      SetColorFormat(EGLint colorFormat)                         { FUN_ENTRY(EGL_LOG_TRACE); ColorFormat = colorFormat; }
     inline void                      SetPlatformResources(PlatformResources *platformResources) { FUN_ENTRY(EGL_LOG_TRACE); mPlatformResources = platformResources; }
+    inline void                      SetCurrentContext(EGLContext_t *eglContext)                { FUN_ENTRY(EGL_LOG_TRACE); mCurrentContext = eglContext; }
            void                      SetMipmapLevel(EGLint mipmapLevel);
     inline void                      SetMultisampleResolve(EGLint multisampleResolve)           { FUN_ENTRY(EGL_LOG_TRACE); MultisampleResolve = multisampleResolve; }
     inline void                      SetSwapBehavior(EGLint swapBehavior)                       { FUN_ENTRY(EGL_LOG_TRACE); SwapBehavior = swapBehavior; }
     inline void                      SetBindToTexture(EGLint bindToTexture)                     { FUN_ENTRY(EGL_LOG_TRACE); BindToTexture = bindToTexture; }
+    inline void                      SetBufferAgeQueried(EGLBoolean queried)                    { FUN_ENTRY(EGL_LOG_TRACE); SurfaceInterface.bufferAgeQueried = (queried == EGL_TRUE); }
+    inline void                      SetDamageRegionSet(EGLBoolean set)                         { FUN_ENTRY(EGL_LOG_TRACE); DamageRegionSet = set; }
+    inline void                      SetPresentInterval(double presentInterval)                 { FUN_ENTRY(EGL_LOG_TRACE); PresentInterval = presentInterval; }
+    inline void                      AddUndamagedPixels(uint64_t pixels)                        { FUN_ENTRY(EGL_LOG_TRACE); UndamagedPixels += pixels; }
            void                      ClampSwapInterval(EGLint swapInterval);
            void                      UpdateRef(bool increaseRef) override;
 
@@ -115,11 +130,15 @@ public:
     inline EGLint                    GetHeight()                                          const { FUN_ENTRY(EGL_LOG_TRACE); return Height; }
     inline EGLint                    GetDepthSize()                                       const { FUN_ENTRY(EGL_LOG_TRACE); return DepthSize; }
     inline EGLint                    GetStencilSize()                                     const { FUN_ENTRY(EGL_LOG_TRACE); return StencilSize; }
+    inline EGLint                    GetRedSize()                                         const { FUN_ENTRY(EGL_LOG_TRACE); return RedSize; }
+    inline EGLint                    GetGreenSize()                                       const { FUN_ENTRY(EGL_LOG_TRACE); return GreenSize; }
+    inline EGLint                    GetBlueSize()                                        const { FUN_ENTRY(EGL_LOG_TRACE); return BlueSize; }
     inline EGLint                    GetCurrentImageIndex()                               const { FUN_ENTRY(EGL_LOG_TRACE); return CurrentImageIndex; }
     inline EGLint                    GetColorFormat()                                     const { FUN_ENTRY(EGL_LOG_TRACE); return ColorFormat; }
     inline EGLSurfaceInterface_t    *GetEGLSurfaceInterface()                                   { FUN_ENTRY(EGL_LOG_TRACE); return &SurfaceInterface; }
     inline const PlatformResources  *GetPlatformResources()                               const { FUN_ENTRY(EGL_LOG_TRACE); return mPlatformResources; }
     inline PlatformResources        *GetPlatformResources()                                     { FUN_ENTRY(EGL_LOG_TRACE); return mPlatformResources; }
+    inline EGLContext_t             *GetCurrentContext()                                  const { FUN_ENTRY(EGL_LOG_TRACE); return mCurrentContext; }
     inline uint32_t                  GetPlatformSurfaceImageCount()                             { FUN_ENTRY(EGL_LOG_TRACE); return mPlatformResources->GetSwapchainImageCount(); }
     inline void                     *GetPlatformSurfaceImages()                                 { FUN_ENTRY(EGL_LOG_TRACE); return mPlatformResources->GetSwapchainImages(); }
 
@@ -127,7 +146,16 @@ public:
     inline EGLint                    GetBindToTextureRGBA()                               const { FUN_ENTRY(EGL_LOG_TRACE); return BindToTextureRGBA; }
     inline EGLint                    GetSwapInterval()                                    const { FUN_ENTRY(EGL_LOG_TRACE); return SwapInterval; }
     inline EGLBoolean                GetBindToTexture()                                   const { FUN_ENTRY(EGL_LOG_TRACE); return BindToTexture; }
+    inline EGLBoolean                GetBufferAgeQueried()                                const { FUN_ENTRY(EGL_LOG_TRACE); return SurfaceInterface.bufferAgeQueried ? EGL_TRUE : EGL_FALSE; }
+    inline EGLBoolean                GetDamageRegionSet()                                 const { FUN_ENTRY(EGL_LOG_TRACE); return DamageRegionSet; }
+    /// Smoothed present-to-present latency in milliseconds, 0 until the surface has been presented twice
+    inline double                    GetPresentInterval()                                 const { FUN_ENTRY(EGL_LOG_TRACE); return PresentInterval; }
+    /// Pixels that damage regions kept from being rendered and presented, summed over all presents of the surface
+    inline uint64_t                  GetUndamagedPixels()                                 const { FUN_ENTRY(EGL_LOG_TRACE); return UndamagedPixels; }
     inline EGLenum                   GetRenderBuffer()                                    const { FUN_ENTRY(EGL_LOG_TRACE); return RenderBuffer; }
+    inline EGLenum                   GetTextureFormat()                                   const { FUN_ENTRY(EGL_LOG_TRACE); return TextureFormat; }
+    inline EGLenum                   GetTextureTarget()                                   const { FUN_ENTRY(EGL_LOG_TRACE); return TextureTarget; }
+    inline EGLBoolean                GetLargestPbuffer()                                  const { FUN_ENTRY(EGL_LOG_TRACE); return LargestPbuffer; }
 };
 
 #endif // __EGL_SURFACE_H__
@@ -0,0 +1,109 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       eglSync.cpp
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      EGL Fence Sync container (EGL_KHR_fence_sync). It is backed by a Vulkan fence.
+ *
+ *  @scope
+ *
+ *  A fence sync is submitted to the queue right after the commands that the
+ *  client API has recorded so far, so that it is signaled once they complete.
+ *  Client waits map to vkWaitForFences, which lets applications reuse resources
+ *  without having to finish the whole context.
+ *
+ */
+
+#include "eglSync.h"
+
+EGLSync_t::EGLSync_t(EGLenum type)
+: EGLRefObject(),
+mType(type), mVkDevice(VK_NULL_HANDLE), mVkFence(VK_NULL_HANDLE)
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+}
+
+EGLSync_t::~EGLSync_t()
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+
+    if(mVkFence != VK_NULL_HANDLE) {
+        vkDestroyFence(mVkDevice, mVkFence, nullptr);
+        mVkFence = VK_NULL_HANDLE;
+    }
+}
+
+EGLBoolean
+EGLSync_t::Create(EGLContext_t *eglContext)
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    mVkDevice = eglContext->GetVkDevice();
+
+    VkFenceCreateInfo fenceInfo;
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.pNext = nullptr;
+    fenceInfo.flags = 0;
+
+    if(vkCreateFence(mVkDevice, &fenceInfo, nullptr, &mVkFence) != VK_SUCCESS) {
+        mVkFence = VK_NULL_HANDLE;
+        return EGL_FALSE;
+    }
+
+    return eglContext->InsertFence(mVkFence);
+}
+
+EGLint
+EGLSync_t::ClientWait(EGLTimeKHR timeout)
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    // EGL_FOREVER_KHR and UINT64_MAX are the same value
+    VkResult err = vkWaitForFences(mVkDevice, 1, &mVkFence, VK_TRUE, static_cast<uint64_t>(timeout));
+
+    if(err == VK_SUCCESS) {
+        return EGL_CONDITION_SATISFIED_KHR;
+    }
+    if(err == VK_TIMEOUT) {
+        return EGL_TIMEOUT_EXPIRED_KHR;
+    }
+
+    return EGL_FALSE;
+}
+
+EGLBoolean
+EGLSync_t::GetAttrib(EGLint attribute, EGLint *value) const
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    switch(attribute) {
+        case EGL_SYNC_TYPE_KHR:         *value = mType; break;
+        case EGL_SYNC_STATUS_KHR:       *value = IsSignaled() ? EGL_SIGNALED_KHR : EGL_UNSIGNALED_KHR; break;
+        case EGL_SYNC_CONDITION_KHR:    *value = EGL_SYNC_PRIOR_COMMANDS_COMPLETE_KHR; break;
+        default:                        return EGL_FALSE;
+    }
+
+    return EGL_TRUE;
+}
+
+bool
+EGLSync_t::IsSignaled() const
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+
+    return vkGetFenceStatus(mVkDevice, mVkFence) == VK_SUCCESS;
+}
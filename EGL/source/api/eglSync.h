@@ -0,0 +1,49 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       eglSync.h
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      EGL Fence Sync container (EGL_KHR_fence_sync). It is backed by a Vulkan fence.
+ *
+ */
+
+#ifndef __EGL_SYNC_H__
+#define __EGL_SYNC_H__
+
+#include "EGL/egl.h"
+#include "EGL/eglext.h"
+#include "eglRefObject.h"
+#include "eglContext.h"
+
+class EGLSync_t : public EGLRefObject
+{
+private:
+    EGLenum                      mType;
+    VkDevice                     mVkDevice;
+    VkFence                      mVkFence;
+
+public:
+    EGLSync_t(EGLenum type);
+    ~EGLSync_t();
+
+    EGLBoolean                   Create(EGLContext_t *eglContext);
+    EGLint                       ClientWait(EGLTimeKHR timeout);
+    EGLBoolean                   GetAttrib(EGLint attribute, EGLint *value) const;
+    bool                         IsSignaled()                             const;
+};
+
+#endif // __EGL_SYNC_H__
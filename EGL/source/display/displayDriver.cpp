@@ -35,13 +35,16 @@
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 #include "system/window.h"
 #endif
+/// Times the swapchain of a window surface is recreated before its image acquire gives up
+#define MAX_ACQUIRE_RETRIES                          3
+
 RenderingThread *callingThread = nullptr;
 
 void setCallingThread(RenderingThread *thread) { callingThread = thread; }
 
 DisplayDriver::DisplayDriver(EGLDisplay_t* eglDisplay)
 : mEGLDisplay(eglDisplay),
-  mActiveContext(nullptr), mWindowInterface(nullptr),
+  mWindowInterface(nullptr),
   mInitialized(false)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
@@ -86,6 +89,23 @@ DisplayDriver::CheckBadSurface(const EGLSurface_t *eglSurface) const
     return EGL_TRUE;
 }
 
+EGLBoolean
+DisplayDriver::CheckBadSync(const EGLSync_t* eglSync) const
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    if(eglSync == nullptr) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
+    if(mDisplayDriverResourceManager.FindEGLSync(eglSync) == EGL_FALSE) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+    return EGL_TRUE;
+}
+
 EGLBoolean
 DisplayDriver::CheckBadContext(const EGLContext_t* eglContext) const
 {
@@ -148,11 +168,11 @@ DisplayDriver::Terminate()
 }
 
 EGLContext
-DisplayDriver::CreateContext(EGLenum rendering_api, EGLConfig_t* config, const EGLint* attribList)
+DisplayDriver::CreateContext(EGLenum rendering_api, EGLConfig_t* config, EGLContext_t* shareContext, const EGLint* attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t *eglContext = mDisplayDriverResourceManager.AddEGLContext(mEGLDisplay, rendering_api, config, attribList);
+    EGLContext_t *eglContext = mDisplayDriverResourceManager.AddEGLContext(mEGLDisplay, rendering_api, config, shareContext, attribList);
     return static_cast<EGLContext>(eglContext);
 }
 
@@ -275,9 +295,7 @@ DisplayDriver::CreateWindowSurface(EGLConfig_t* eglConfig, EGLNativeWindowType w
 
     mWindowInterface->AllocateSurfaceImages(eglSurface);
 
-    uint32_t imageNext = 0;
-    mWindowInterface->AcquireNextImage(eglSurface, &imageNext);
-
+    // the first image is acquired once it is rendered to
     CreateEGLSurfaceInterface(eglSurface);
 
     return static_cast<EGLSurface>(eglSurface);
@@ -288,7 +306,7 @@ DisplayDriver::CreatePbufferSurface(EGLConfig_t* eglConfig, const EGLint *attrib
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLSurface_t *eglSurface = new EGLSurface_t();
+    EGLSurface_t *eglSurface = mDisplayDriverResourceManager.AddEGLSurface();
     if(!eglSurface) {
         currentThread.RecordError(EGL_BAD_ALLOC);
         return EGL_NO_SURFACE;
@@ -297,7 +315,21 @@ DisplayDriver::CreatePbufferSurface(EGLConfig_t* eglConfig, const EGLint *attrib
     EGLint eglError = EGL_SUCCESS;
     if(eglSurface->InitSurface(EGL_PBUFFER_BIT, eglConfig, attrib_list, &eglError) != EGL_TRUE) {
         currentThread.RecordError(eglError);
-        delete eglSurface;
+        mDisplayDriverResourceManager.RemoveEGLSurface(mWindowInterface, eglSurface);
+        return EGL_NO_SURFACE;
+    }
+
+    // EGL_TEXTURE_FORMAT and EGL_TEXTURE_TARGET have to be either both set or both unset
+    if((eglSurface->GetTextureFormat() == EGL_NO_TEXTURE) != (eglSurface->GetTextureTarget() == EGL_NO_TEXTURE)) {
+        currentThread.RecordError(EGL_BAD_MATCH);
+        mDisplayDriverResourceManager.RemoveEGLSurface(mWindowInterface, eglSurface);
+        return EGL_NO_SURFACE;
+    }
+
+    if((eglSurface->GetTextureFormat() == EGL_TEXTURE_RGBA && !eglSurface->GetBindToTextureRGBA()) ||
+       (eglSurface->GetTextureFormat() == EGL_TEXTURE_RGB  && !eglSurface->GetBindToTextureRGB())) {
+        currentThread.RecordError(EGL_BAD_ATTRIBUTE);
+        mDisplayDriverResourceManager.RemoveEGLSurface(mWindowInterface, eglSurface);
         return EGL_NO_SURFACE;
     }
 
@@ -306,10 +338,32 @@ DisplayDriver::CreatePbufferSurface(EGLConfig_t* eglConfig, const EGLint *attrib
         eglSurface->SetHeight(EglConfigs[0].MaxPbufferHeight);
     }
 
-    //TODO: Pbuffer is not supported
-    NOT_IMPLEMENTED();
+    if(eglSurface->GetWidth()  > EglConfigs[0].MaxPbufferWidth ||
+       eglSurface->GetHeight() > EglConfigs[0].MaxPbufferHeight) {
+        if(!eglSurface->GetLargestPbuffer()) {
+            currentThread.RecordError(EGL_BAD_ALLOC);
+            mDisplayDriverResourceManager.RemoveEGLSurface(mWindowInterface, eglSurface);
+            return EGL_NO_SURFACE;
+        }
+        eglSurface->SetWidth (std::min(eglSurface->GetWidth() , EglConfigs[0].MaxPbufferWidth));
+        eglSurface->SetHeight(std::min(eglSurface->GetHeight(), EglConfigs[0].MaxPbufferHeight));
+    }
 
-    return EGL_NO_SURFACE;
+    PlatformResources *platformResources = PlatformFactory::GetResources();
+    eglSurface->SetPlatformResources(platformResources);
+
+    // pbuffers are backed by a single device image, so there is no WSI surface or swapchain to create
+    mWindowInterface->AllocateSurfaceImages(eglSurface);
+
+    CreateEGLSurfaceInterface(eglSurface);
+
+    if(!eglSurface->GetPlatformSurfaceImageCount()) {
+        currentThread.RecordError(EGL_BAD_ALLOC);
+        mDisplayDriverResourceManager.RemoveEGLSurface(mWindowInterface, eglSurface);
+        return EGL_NO_SURFACE;
+    }
+
+    return static_cast<EGLSurface>(eglSurface);
 }
 
 EGLSurface
@@ -333,7 +387,7 @@ DisplayDriver::CreateEGLSurfaceInterface(EGLSurface_t *eglSurface)
     memset(surfaceInterface, 0, sizeof(*surfaceInterface));
 
     surfaceInterface->surface = reinterpret_cast<void *>(eglSurface);
-    if(eglSurface->GetType() == EGL_WINDOW_BIT) {
+    if(eglSurface->GetType() == EGL_WINDOW_BIT || eglSurface->GetType() == EGL_PBUFFER_BIT) {
         surfaceInterface->images            = eglSurface->GetPlatformSurfaceImages();
         surfaceInterface->imageCount        = eglSurface->GetPlatformSurfaceImageCount();
         surfaceInterface->depthBuffer       = 0;
@@ -346,6 +400,106 @@ DisplayDriver::CreateEGLSurfaceInterface(EGLSurface_t *eglSurface)
     surfaceInterface->stencilSize           = eglSurface->GetStencilSize();
     surfaceInterface->surfaceColorFormat    = eglSurface->GetColorFormat();
     surfaceInterface->nextImageIndex        = eglSurface->GetCurrentImageIndex();
+
+    // window images are acquired by the client API on the first draw or clear of each frame
+    surfaceInterface->displayDriver         = reinterpret_cast<void *>(this);
+    surfaceInterface->acquire_image_cb      = eglSurface->GetType() == EGL_WINDOW_BIT ? &DisplayDriver::AcquireSurfaceImageCb : nullptr;
+    surfaceInterface->nextImageAcquired     = eglSurface->GetType() != EGL_WINDOW_BIT;
+
+    ResetDamageRegion(eglSurface);
+}
+
+void
+DisplayDriver::UpdateEGLSurfaceInterface(EGLSurface_t *eglSurface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // only the image related state changes, the depth buffer and context references shared with the client API are kept
+    EGLSurfaceInterface_t *surfaceInterface = eglSurface->GetEGLSurfaceInterface();
+    surfaceInterface->images                = eglSurface->GetPlatformSurfaceImages();
+    surfaceInterface->imageCount            = eglSurface->GetPlatformSurfaceImageCount();
+    surfaceInterface->width                 = eglSurface->GetWidth();
+    surfaceInterface->height                = eglSurface->GetHeight();
+    surfaceInterface->surfaceColorFormat    = eglSurface->GetColorFormat();
+    surfaceInterface->nextImageIndex        = 0;
+    surfaceInterface->nextImageAcquired     = eglSurface->GetType() != EGL_WINDOW_BIT;
+
+    ResetDamageRegion(eglSurface);
+}
+
+void
+DisplayDriver::ResetDamageRegion(EGLSurface_t *eglSurface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // each frame starts with the whole surface damaged, until eglSetDamageRegionKHR restricts it
+    EGLSurfaceInterface_t *surfaceInterface = eglSurface->GetEGLSurfaceInterface();
+    surfaceInterface->damageEnabled         = false;
+    surfaceInterface->damagePending         = true;
+
+    eglSurface->SetBufferAgeQueried(EGL_FALSE);
+    eglSurface->SetDamageRegionSet(EGL_FALSE);
+}
+
+bool
+DisplayDriver::AcquireSurfaceImageCb(EGLSurfaceInterface *eglSurfaceInterface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    DisplayDriver *displayDriver = reinterpret_cast<DisplayDriver *>(eglSurfaceInterface->displayDriver);
+    EGLSurface_t  *eglSurface    = reinterpret_cast<EGLSurface_t *>(eglSurfaceInterface->surface);
+
+    // called on the first draw or clear of the frame, so nothing has been rendered to the surface images yet and an out
+    // of date swapchain is recreated here, the client API updates its framebuffer once the image is acquired
+    acquireResult_t result = displayDriver->AcquireSurfaceImage(eglSurface);
+    for(uint32_t retries = 0; result == ACQUIRE_OUT_OF_DATE && retries < MAX_ACQUIRE_RETRIES; ++retries) {
+        displayDriver->RecreateSurfaceImages(eglSurface);
+        result = displayDriver->AcquireSurfaceImage(eglSurface);
+    }
+
+    return result == ACQUIRE_SUCCESS;
+}
+
+acquireResult_t
+DisplayDriver::AcquireSurfaceImage(EGLSurface_t *eglSurface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    uint32_t imageIndex;
+    acquireResult_t result = mWindowInterface->AcquireNextImage(eglSurface, &imageIndex);
+    if(result != ACQUIRE_SUCCESS) {
+        return result;
+    }
+
+    EGLSurfaceInterface *surfaceInterface = eglSurface->GetEGLSurfaceInterface();
+    surfaceInterface->nextImageIndex    = imageIndex;
+    surfaceInterface->nextImageAcquired = true;
+
+    return ACQUIRE_SUCCESS;
+}
+
+EGLBoolean
+DisplayDriver::PrepareSurfaceImage(EGLSurface_t *eglSurface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    if(eglSurface->GetEGLSurfaceInterface()->nextImageAcquired) {
+        return EGL_TRUE;
+    }
+
+    // only a swapchain that is out of date is recreated, any other failure would repeat on every retry
+    acquireResult_t result = AcquireSurfaceImage(eglSurface);
+    for(uint32_t retries = 0; result == ACQUIRE_OUT_OF_DATE && retries < MAX_ACQUIRE_RETRIES; ++retries) {
+        UpdateSurface(eglSurface);
+        result = AcquireSurfaceImage(eglSurface);
+    }
+
+    if(result != ACQUIRE_SUCCESS) {
+        currentThread.RecordError(result == ACQUIRE_DEVICE_LOST ? EGL_CONTEXT_LOST : EGL_BAD_SURFACE);
+        return EGL_FALSE;
+    }
+
+    return EGL_TRUE;
 }
 
 EGLBoolean
@@ -367,6 +521,10 @@ DisplayDriver::QuerySurface(EGLSurface_t* eglSurface, EGLint attribute, EGLint *
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    if(attribute == EGL_BUFFER_AGE_KHR) {
+        return QueryBufferAge(eglSurface, value);
+    }
+
     if(eglSurface->QuerySurface(attribute, value) == EGL_FALSE) {
         currentThread.RecordError(EGL_BAD_ATTRIBUTE);
         return EGL_FALSE;
@@ -375,6 +533,30 @@ DisplayDriver::QuerySurface(EGLSurface_t* eglSurface, EGLint attribute, EGLint *
     return EGL_TRUE;
 }
 
+EGLBoolean
+DisplayDriver::QueryBufferAge(EGLSurface_t* eglSurface, EGLint *value)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    if(eglSurface->GetType() == EGL_WINDOW_BIT) {
+        EGLContext_t *activeContext = currentThread.GetCurrentContext();
+        if(activeContext == nullptr || activeContext->GetDrawSurface() != eglSurface) {
+            currentThread.RecordError(EGL_BAD_SURFACE);
+            return EGL_FALSE;
+        }
+
+        // the age is that of the image rendered next, so it is acquired now rather than on the first draw or clear
+        if(PrepareSurfaceImage(eglSurface) == EGL_FALSE) {
+            return EGL_FALSE;
+        }
+    }
+
+    *value = mWindowInterface->GetBufferAge(eglSurface);
+    eglSurface->SetBufferAgeQueried(EGL_TRUE);
+
+    return EGL_TRUE;
+}
+
 EGLSurface
 DisplayDriver::CreatePbufferFromClientBuffer(EGLenum buftype, EGLClientBuffer buffer, EGLConfig_t* eglConfig, const EGLint *attrib_list)
 {
@@ -431,7 +613,6 @@ DisplayDriver::BindTexImage(EGLSurface_t* eglSurface, EGLint buffer)
         currentThread.RecordError(EGL_BAD_MATCH);
         return EGL_FALSE;
     }
-    //TODO: EGL_BAD_ACCESS is generated if buffer is already bound to a texture.
     if (buffer != EGL_BACK_BUFFER) {
         currentThread.RecordError(EGL_BAD_MATCH);
         return EGL_FALSE;
@@ -447,11 +628,21 @@ DisplayDriver::BindTexImage(EGLSurface_t* eglSurface, EGLint buffer)
         return EGL_FALSE;
     }
 
-    //TODO: We are assuming that the BindTexImage refers to the surface that is currently active for GLOVE.
-    //If we have multiple surfaces for GLES, additional information may need to be passed to GLOVE.
-    mActiveContext->BindToTexture(EGL_TRUE);
-    //If display and surface are the display and surface for the calling thread's current context, eglBindTexImage performs an implicit glFlush
-    mActiveContext->Finish();
+    if(eglSurface->GetBindToTexture() == EGL_TRUE) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
+        return EGL_FALSE;
+    }
+
+    // without a current context the call is silently ignored
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(activeContext == nullptr) {
+        return EGL_TRUE;
+    }
+
+    // the client API flushes the pbuffer rendering and copies its color buffer
+    // into the texture bound to the active unit
+    activeContext->BindToTexture(eglSurface, EGL_TRUE);
+    eglSurface->SetBindToTexture(EGL_TRUE);
 
     return EGL_TRUE;
 }
@@ -471,7 +662,15 @@ DisplayDriver::ReleaseTexImage(EGLSurface_t* eglSurface, EGLint buffer)
         currentThread.RecordError(EGL_BAD_MATCH);
         return EGL_FALSE;
     }
-    mActiveContext->BindToTexture(EGL_FALSE);
+    if(eglSurface->GetBindToTexture() == EGL_FALSE) {
+        return EGL_TRUE;
+    }
+
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(activeContext != nullptr) {
+        activeContext->BindToTexture(eglSurface, EGL_FALSE);
+    }
+    eglSurface->SetBindToTexture(EGL_FALSE);
 
     return EGL_TRUE;
 }
@@ -481,12 +680,13 @@ DisplayDriver::SwapInterval(EGLint interval)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    if(currentThread.GetCurrentContext() == nullptr) {
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(activeContext == nullptr) {
         currentThread.RecordError(EGL_BAD_CONTEXT);
         return EGL_FALSE;
     }
 
-    EGLSurface_t* surface = static_cast<EGLSurface_t*>(mActiveContext->GetDrawSurface());
+    EGLSurface_t* surface = static_cast<EGLSurface_t*>(activeContext->GetDrawSurface());
     if(surface == nullptr) {
         currentThread.RecordError(EGL_BAD_SURFACE);
         return EGL_FALSE;
@@ -495,8 +695,11 @@ DisplayDriver::SwapInterval(EGLint interval)
     //If the interval remains the same, there is no need to update the surface
     if(interval != surface->GetSwapInterval()) {
         surface->ClampSwapInterval(interval);
-        mActiveContext->Finish();
-        UpdateSurface(surface);
+        // intervals that map to the same present mode only change the pacing of the next presents
+        if(mWindowInterface->SwapIntervalRequiresRecreation(surface)) {
+            activeContext->Finish();
+            UpdateSurface(surface);
+        }
     }
     return EGL_TRUE;
 }
@@ -507,6 +710,20 @@ DisplayDriver::SwapBuffers(EGLSurface_t* eglSurface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    return SwapBuffersWithDamageKHR(eglSurface, nullptr, 0);
+}
+
+EGLBoolean
+DisplayDriver::SwapBuffersWithDamageKHR(EGLSurface_t* eglSurface, const EGLint *rects, EGLint n_rects)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    if(n_rects < 0 || (n_rects > 0 && rects == nullptr)) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
+    // pbuffers have a single color buffer and nothing to present
     if(eglSurface->GetType() != EGL_WINDOW_BIT) {
         return EGL_TRUE;
     }
@@ -515,18 +732,86 @@ DisplayDriver::SwapBuffers(EGLSurface_t* eglSurface)
         return EGL_TRUE;
     }
 
-    mActiveContext->Finish();
+    // only the thread whose context draws to the surface may present it
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(activeContext == nullptr || activeContext->GetDrawSurface() != eglSurface) {
+        currentThread.RecordError(EGL_BAD_SURFACE);
+        return EGL_FALSE;
+    }
 
-    if(mWindowInterface->PresentImage(eglSurface) == EGL_FALSE) {
-        UpdateSurface(eglSurface);
+    // nothing has been rendered to this frame, an image is still presented to keep the application paced
+    if(PrepareSurfaceImage(eglSurface) == EGL_FALSE) {
+        return EGL_FALSE;
     }
 
-    uint32_t imageIndex;
-    while(mWindowInterface->AcquireNextImage(eglSurface, &imageIndex) == EGL_FALSE) {
+    // the last submission of the frame signals the semaphore that the presentation waits on
+    vkSyncItems_t *syncItems = eglSurface->GetEGLSurfaceInterface()->vkSyncItems;
+    if(syncItems != nullptr) {
+        syncItems->presentPending = true;
+    }
+    activeContext->Finish();
+
+    EGLBoolean presented = mWindowInterface->PresentImage(eglSurface, rects, n_rects);
+
+    // the next image is not acquired here, but on the first draw or clear of the next frame,
+    // so that the application builds it while the presentation engine releases an image
+    eglSurface->GetEGLSurfaceInterface()->nextImageAcquired = false;
+    ResetDamageRegion(eglSurface);
+
+    if(presented == EGL_FALSE) {
         UpdateSurface(eglSurface);
     }
 
-    eglSurface->GetEGLSurfaceInterface()->nextImageIndex = imageIndex;
+    return EGL_TRUE;
+}
+
+EGLBoolean
+DisplayDriver::SetDamageRegionKHR(EGLSurface_t* eglSurface, const EGLint *rects, EGLint n_rects)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(eglSurface->GetType() != EGL_WINDOW_BIT || activeContext == nullptr || activeContext->GetDrawSurface() != eglSurface) {
+        currentThread.RecordError(EGL_BAD_MATCH);
+        return EGL_FALSE;
+    }
+
+    // the damage region is set once per frame, after the buffer age is known and before rendering to the surface starts
+    EGLSurfaceInterface_t *surfaceInterface = eglSurface->GetEGLSurfaceInterface();
+    if(!eglSurface->GetBufferAgeQueried() || eglSurface->GetDamageRegionSet() || !surfaceInterface->damagePending) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
+        return EGL_FALSE;
+    }
+
+    if(n_rects < 0 || (n_rects > 0 && rects == nullptr)) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
+    // the client API clips rendering to the bounding box of the rectangles within the surface
+    EGLint width  = eglSurface->GetWidth();
+    EGLint height = eglSurface->GetHeight();
+    EGLint left   = width;
+    EGLint bottom = height;
+    EGLint right  = 0;
+    EGLint top    = 0;
+    for(EGLint i = 0; i < n_rects; ++i) {
+        const EGLint *rect = &rects[4 * i];
+        left   = std::min(left  , std::max(rect[0], 0));
+        bottom = std::min(bottom, std::max(rect[1], 0));
+        right  = std::max(right , std::min(rect[0] + rect[2], width));
+        top    = std::max(top   , std::min(rect[1] + rect[3], height));
+    }
+
+    // no rectangles, or none within the surface, leave the whole surface damaged
+    bool enabled = left < right && bottom < top && (right - left < width || top - bottom < height);
+
+    surfaceInterface->damageEnabled = enabled;
+    surfaceInterface->damageX       = enabled ? left : 0;
+    surfaceInterface->damageY       = enabled ? bottom : 0;
+    surfaceInterface->damageWidth   = enabled ? static_cast<uint32_t>(right - left) : 0;
+    surfaceInterface->damageHeight  = enabled ? static_cast<uint32_t>(top - bottom) : 0;
+    eglSurface->SetDamageRegionSet(EGL_TRUE);
 
     return EGL_TRUE;
 }
@@ -536,14 +821,24 @@ DisplayDriver::UpdateSurface(EGLSurface_t* eglSurface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    assert(mActiveContext != nullptr);
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    assert(activeContext != nullptr);
     assert(mWindowInterface != nullptr);
 
-    mActiveContext->ReleaseSurfaceResources();
-    mWindowInterface->DestroySurfaceImages(eglSurface);
-    mWindowInterface->AllocateSurfaceImages(eglSurface);
-    CreateEGLSurfaceInterface(eglSurface);
-    mActiveContext->MakeCurrent(mEGLDisplay, eglSurface, eglSurface);
+    // the swapchain is recreated in place and the client API updates only the framebuffers of this surface
+    RecreateSurfaceImages(eglSurface);
+    activeContext->MakeCurrent(mEGLDisplay, eglSurface, eglSurface);
+}
+
+void
+DisplayDriver::RecreateSurfaceImages(EGLSurface_t* eglSurface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    assert(mWindowInterface != nullptr);
+
+    mWindowInterface->RecreateSurfaceImages(eglSurface);
+    UpdateEGLSurfaceInterface(eglSurface);
 }
 
 EGLBoolean
@@ -660,29 +955,112 @@ EGLSyncKHR
 DisplayDriver::CreateSyncKHR(EGLenum type, const EGLint *attrib_list)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
-    uintptr_t sync = 0xFE4CE000;
-    return ((EGLSyncKHR)sync);
+
+    // only fence syncs are supported and they accept no attributes
+    if(type != EGL_SYNC_FENCE_KHR || (attrib_list != nullptr && attrib_list[0] != EGL_NONE)) {
+        currentThread.RecordError(EGL_BAD_ATTRIBUTE);
+        return EGL_NO_SYNC_KHR;
+    }
+
+    EGLContext_t *eglContext = currentThread.GetCurrentContext();
+    if(eglContext == nullptr || eglContext->GetDisplay() != mEGLDisplay) {
+        currentThread.RecordError(EGL_BAD_MATCH);
+        return EGL_NO_SYNC_KHR;
+    }
+
+    mDisplayDriverResourceManager.CleanMarkedSyncs();
+
+    EGLSync_t *eglSync = mDisplayDriverResourceManager.AddEGLSync(eglContext, type);
+    if(eglSync == nullptr) {
+        currentThread.RecordError(EGL_BAD_ALLOC);
+        return EGL_NO_SYNC_KHR;
+    }
+
+    return static_cast<EGLSyncKHR>(eglSync);
 }
 
 EGLBoolean
-DisplayDriver::DestroySyncKHR(EGLSyncKHR sync)
+DisplayDriver::DestroySyncKHR(EGLSync_t *eglSync)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
-    return EGL_TRUE;
+    return mDisplayDriverResourceManager.RemoveEGLSync(eglSync);
 }
 
 EGLint
-DisplayDriver::ClientWaitSyncKHR(EGLSyncKHR sync, EGLint flags, EGLTimeKHR timeout)
+DisplayDriver::ClientWaitSyncKHR(EGLSync_t *eglSync, EGLint flags, EGLTimeKHR timeout)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
-    return EGL_CONDITION_SATISFIED_KHR;
+    if(flags & ~EGL_SYNC_FLUSH_COMMANDS_BIT_KHR) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
+    // the fence is already submitted when the sync is created, the flush submits the commands that the current
+    // context has recorded since then, as requested by the application
+    if(flags & EGL_SYNC_FLUSH_COMMANDS_BIT_KHR) {
+        EGLContext_t *eglContext = currentThread.GetCurrentContext();
+        if(eglContext != nullptr && eglContext->GetDisplay() == mEGLDisplay) {
+            eglContext->Flush();
+        }
+    }
+
+    // the fence can no longer be waited on, e.g., its device has been lost
+    EGLint status = eglSync->ClientWait(timeout);
+    if(status == EGL_FALSE) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
+    }
+
+    return status;
+}
+
+EGLint
+DisplayDriver::WaitSyncKHR(EGLSync_t *eglSync, EGLint flags)
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+
+    if(flags != 0) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
+    EGLContext_t *eglContext = currentThread.GetCurrentContext();
+    if(eglContext == nullptr || eglContext->GetDisplay() != mEGLDisplay) {
+        currentThread.RecordError(EGL_BAD_MATCH);
+        return EGL_FALSE;
+    }
+
+    // the server wait is needed only while the fence is still pending
+    if(!eglSync->IsSignaled()) {
+        eglContext->WaitFence();
+    }
+
+    return EGL_TRUE;
+}
+
+EGLBoolean
+DisplayDriver::GetSyncAttribKHR(EGLSync_t *eglSync, EGLint attribute, EGLint *value)
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+
+    if(value == nullptr) {
+        currentThread.RecordError(EGL_BAD_PARAMETER);
+        return EGL_FALSE;
+    }
+
+    if(eglSync->GetAttrib(attribute, value) == EGL_FALSE) {
+        currentThread.RecordError(EGL_BAD_ATTRIBUTE);
+        return EGL_FALSE;
+    }
+
+    return EGL_TRUE;
 }
 
 const char *DisplayDriver::GetExtensions()
 {
-    return "";
+    return "EGL_KHR_create_context_no_error EGL_KHR_fence_sync EGL_KHR_wait_sync "
+           "EGL_KHR_swap_buffers_with_damage EGL_KHR_partial_update EGL_EXT_buffer_age\0";
 }
 
 EGLBoolean
@@ -46,21 +46,28 @@ void setCallingThread(RenderingThread *thread);
 class DisplayDriver {
 private:
     EGLDisplay_t                *mEGLDisplay;
-    EGLContext_t                *mActiveContext;
     PlatformWindowInterface     *mWindowInterface;
     DisplayDriverResourceManager mDisplayDriverResourceManager;
     bool                         mInitialized;
 
     EGLImageKHR                  CreateImageNativeBufferAndroid(EGLContext ctx, EGLenum target, EGLClientBuffer buffer, const EGLint *attrib_list);
     void                         CreateEGLSurfaceInterface(EGLSurface_t *eglSurface);
+    void                         UpdateEGLSurfaceInterface(EGLSurface_t *eglSurface);
+    void                         ResetDamageRegion(EGLSurface_t *eglSurface);
+    EGLBoolean                   QueryBufferAge(EGLSurface_t *eglSurface, EGLint *value);
     void                         UpdateSurface(EGLSurface_t *eglSurface);
+    void                         RecreateSurfaceImages(EGLSurface_t *eglSurface);
+    acquireResult_t              AcquireSurfaceImage(EGLSurface_t *eglSurface);
+    EGLBoolean                   PrepareSurfaceImage(EGLSurface_t *eglSurface);
+
+    static bool                  AcquireSurfaceImageCb(EGLSurfaceInterface *eglSurfaceInterface);
 
 public:
 
     DisplayDriver(EGLDisplay_t *eglDisplay);
     ~DisplayDriver(void);
 
-    inline void                  SetActiveContext(EGLContext ctx)               { FUN_ENTRY(EGL_LOG_TRACE); mActiveContext = static_cast<EGLContext_t *>(ctx); }
+    inline std::recursive_mutex &GetMutex(void)                            const { FUN_ENTRY(EGL_LOG_TRACE); return mDisplayDriverResourceManager.GetMutex(); }
     inline bool                  Initialized()                            const { FUN_ENTRY(EGL_LOG_TRACE); return mInitialized; }
     void                         CleanMarkedResources(void);
 
@@ -68,12 +75,13 @@ public:
     EGLBoolean                   CheckBadConfig(const EGLConfig_t *eglConfig) const;
     EGLBoolean                   CheckBadSurface(const EGLSurface_t *eglSurface) const;
     EGLBoolean                   CheckBadContext(const EGLContext_t* eglContext) const;
+    EGLBoolean                   CheckBadSync(const EGLSync_t* eglSync) const;
     static EGLBoolean            CheckNonInitializedDisplay(const DisplayDriver* displayDriver);
 
     /// EGL API core functions
     EGLBoolean                   Initialize(EGLint *major, EGLint *minor);
     EGLBoolean                   Terminate(void);
-    EGLContext                   CreateContext(EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext                   CreateContext(EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   DestroyContext(EGLContext_t *eglContext);
     EGLBoolean                   GetConfigs(EGLConfig *configs, EGLint config_size, EGLint *num_config);
     EGLBoolean                   ChooseConfig(const EGLint *attrib_list, EGLConfig *configs, EGLint config_size, EGLint *num_config);
@@ -96,8 +104,12 @@ public:
     EGLImageKHR                  CreateImageKHR(EGLContext ctx, EGLenum target, EGLClientBuffer buffer, const EGLint *attrib_list);
     EGLBoolean                   DestroyImageKHR(EGLImageKHR image);
     EGLSyncKHR                   CreateSyncKHR(EGLenum type, const EGLint *attrib_list);
-    EGLBoolean                   DestroySyncKHR(EGLSyncKHR sync);
-    EGLint                       ClientWaitSyncKHR(EGLSyncKHR sync, EGLint flags, EGLTimeKHR timeout);
+    EGLBoolean                   DestroySyncKHR(EGLSync_t *eglSync);
+    EGLint                       ClientWaitSyncKHR(EGLSync_t *eglSync, EGLint flags, EGLTimeKHR timeout);
+    EGLint                       WaitSyncKHR(EGLSync_t *eglSync, EGLint flags);
+    EGLBoolean                   GetSyncAttribKHR(EGLSync_t *eglSync, EGLint attribute, EGLint *value);
+    EGLBoolean                   SwapBuffersWithDamageKHR(EGLSurface_t* eglSurface, const EGLint *rects, EGLint n_rects);
+    EGLBoolean                   SetDamageRegionKHR(EGLSurface_t* eglSurface, const EGLint *rects, EGLint n_rects);
 };
 
 #endif // __DISPLAY_DRIVER_H__
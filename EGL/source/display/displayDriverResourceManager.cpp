@@ -32,6 +32,8 @@ DisplayDriverResourceManager::FindEGLConfig(const EGLConfig_t* eglConfig) const
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     const auto iter = std::find(mConfigList.begin(), mConfigList.end(), eglConfig);
     if(iter == mConfigList.end()) {
         return EGL_FALSE;
@@ -44,6 +46,8 @@ DisplayDriverResourceManager::AddEGLConfig(EGLConfig_t* eglConfig)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     if(FindEGLConfig(eglConfig) == EGL_FALSE) {
         mConfigList.push_back(eglConfig);
     }
@@ -55,6 +59,8 @@ DisplayDriverResourceManager::FindEGLSurface(const EGLSurface_t* eglSurface) con
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     const auto iter = std::find(mSurfaceList.begin(), mSurfaceList.end(), eglSurface);
     if(iter == mSurfaceList.end()) {
         return EGL_FALSE;
@@ -93,6 +99,8 @@ DisplayDriverResourceManager::AddEGLSurface()
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     EGLSurface_t *eglSurface = CreateEGLSurface();
 
     if(eglSurface) {
@@ -107,6 +115,8 @@ DisplayDriverResourceManager::RemoveEGLSurface(PlatformWindowInterface *windowIn
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     const auto iter = std::find(mSurfaceList.begin(), mSurfaceList.end(), eglSurface);
     if(iter != mSurfaceList.end()) {
         mSurfaceList.erase(iter);
@@ -121,6 +131,8 @@ DisplayDriverResourceManager::FindEGLContext(const EGLContext_t* eglContext) con
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     const auto iter = std::find(mContextList.begin(), mContextList.end(), eglContext);
     if(iter == mContextList.end()) {
         return EGL_FALSE;
@@ -129,11 +141,11 @@ DisplayDriverResourceManager::FindEGLContext(const EGLContext_t* eglContext) con
 }
 
 EGLContext_t*
-DisplayDriverResourceManager::CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList)
+DisplayDriverResourceManager::CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t * eglContext = new EGLContext_t(display, rendering_api, config, attribList);
+    EGLContext_t * eglContext = new EGLContext_t(display, rendering_api, config, shareContext, attribList);
 
     if(eglContext->Create() == EGL_FALSE) {
         delete eglContext;
@@ -156,11 +168,13 @@ DisplayDriverResourceManager::DeleteEGLContext(EGLContext_t* eglContext)
 }
 
 EGLContext_t*
-DisplayDriverResourceManager::AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList)
+DisplayDriverResourceManager::AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t *eglContext = CreateEGLContext(display, rendering_api, config, attribList);
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    EGLContext_t *eglContext = CreateEGLContext(display, rendering_api, config, shareContext, attribList);
 
     if(eglContext) {
         mContextList.push_back(eglContext);
@@ -174,6 +188,8 @@ DisplayDriverResourceManager::RemoveEGLContext(EGLContext_t* eglContext)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     const auto iter = std::find(mContextList.begin(), mContextList.end(), eglContext);
     if(iter != mContextList.end()) {
         mContextList.erase(iter);
@@ -182,11 +198,102 @@ DisplayDriverResourceManager::RemoveEGLContext(EGLContext_t* eglContext)
     return EGL_FALSE;
 }
 
+EGLBoolean
+DisplayDriverResourceManager::FindEGLSync(const EGLSync_t* eglSync) const
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    // syncs waiting for their fence before being deleted are no longer valid handles
+    const auto iter = std::find(mSyncList.begin(), mSyncList.end(), eglSync);
+    if(iter == mSyncList.end() || (*iter)->IsMarkedForDeletion()) {
+        return EGL_FALSE;
+    }
+    return EGL_TRUE;
+}
+
+EGLSync_t*
+DisplayDriverResourceManager::AddEGLSync(EGLContext_t *eglContext, EGLenum type)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    EGLSync_t *eglSync = new EGLSync_t(type);
+
+    if(eglSync->Create(eglContext) == EGL_FALSE) {
+        delete eglSync;
+        return nullptr;
+    }
+
+    mSyncList.push_back(eglSync);
+
+    return eglSync;
+}
+
+EGLBoolean
+DisplayDriverResourceManager::DeleteEGLSync(EGLSync_t* eglSync)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // a fence cannot be destroyed while the queue may still signal it
+    if(!eglSync->IsSignaled()) {
+        eglSync->ClientWait(EGL_FOREVER_KHR);
+    }
+    delete eglSync;
+
+    return EGL_TRUE;
+}
+
+EGLBoolean
+DisplayDriverResourceManager::RemoveEGLSync(EGLSync_t* eglSync)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    const auto iter = std::find(mSyncList.begin(), mSyncList.end(), eglSync);
+    if(iter == mSyncList.end()) {
+        return EGL_FALSE;
+    }
+
+    // pending syncs are deleted in CleanMarkedResources, once the GPU has signaled them
+    if(eglSync->IsSignaled()) {
+        mSyncList.erase(iter);
+        return DeleteEGLSync(eglSync);
+    }
+
+    eglSync->MarkForDeletion();
+    return EGL_TRUE;
+}
+
+void
+DisplayDriverResourceManager::CleanMarkedSyncs(void)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    auto syncIter = mSyncList.begin();
+    while(syncIter != mSyncList.end()) {
+        EGLSync_t* eglSync = *syncIter;
+        if(eglSync->IsMarkedForDeletion() && eglSync->IsSignaled()) {
+            DeleteEGLSync(eglSync);
+            syncIter = mSyncList.erase(syncIter);
+        } else {
+            syncIter++;
+        }
+    }
+}
+
 void
 DisplayDriverResourceManager::CleanMarkedResources(PlatformWindowInterface *windowInterface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     // clear surfaces
     auto surfaceIter = mSurfaceList.begin();
     while (surfaceIter != mSurfaceList.end()) {
@@ -210,6 +317,9 @@ DisplayDriverResourceManager::CleanMarkedResources(PlatformWindowInterface *wind
             contextIter++;
         }
     }
+
+    // clear syncs
+    CleanMarkedSyncs();
 }
 
 void
@@ -217,6 +327,14 @@ DisplayDriverResourceManager::CleanResources(PlatformWindowInterface *windowInte
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    // clear syncs
+    for (auto syncIter : mSyncList) {
+        DeleteEGLSync(syncIter);
+    }
+    mSyncList.clear();
+
     // clear surfaces
     for (auto surfaceIter : mSurfaceList) {
         DeleteEGLSurface(windowInterface, surfaceIter);
@@ -29,7 +29,9 @@
 #include "api/eglContext.h"
 #include "api/eglConfig.h"
 #include "api/eglSurface.h"
+#include "api/eglSync.h"
 #include "vector"
+#include <mutex>
 
 class DisplayDriverResourceManager
 {
@@ -38,11 +40,18 @@ protected:
     std::vector<EGLSurface_t*>   mSurfaceList;
     std::vector<EGLConfig_t*>    mConfigList;
     std::vector<EGLContext_t*>   mContextList;
+    std::vector<EGLSync_t*>      mSyncList;
+
+    // guards the lists above, as EGL calls may come from any thread
+    mutable std::recursive_mutex mMutex;
 
     // EGLContext resources
-    EGLContext_t                *CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext_t                *CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   DeleteEGLContext(EGLContext_t* eglContext);
 
+    // EGLSync resources
+    EGLBoolean                   DeleteEGLSync(EGLSync_t* eglSync);
+
     // EGLSurface resources
     EGLSurface_t                *CreateEGLSurface(void);
     EGLBoolean                   DeleteEGLSurface(class PlatformWindowInterface *windowInterface, EGLSurface_t *eglSurface);
@@ -51,6 +60,8 @@ public:
     DisplayDriverResourceManager() = default;
     ~DisplayDriverResourceManager() = default;
 
+    inline std::recursive_mutex &GetMutex(void)                    const { FUN_ENTRY(EGL_LOG_TRACE); return mMutex; }
+
     // EGLConfig resources
     EGLBoolean                   AddEGLConfig(EGLConfig_t* eglConfig);
     EGLBoolean                   FindEGLConfig(const EGLConfig_t* eglConfig) const;
@@ -61,12 +72,18 @@ public:
     EGLBoolean                   FindEGLSurface(const EGLSurface_t* eglSurface) const;
 
     // EGLContext resources
-    EGLContext_t                *AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext_t                *AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   RemoveEGLContext(EGLContext_t* eglContext);
     EGLBoolean                   FindEGLContext(const EGLContext_t* eglContext) const;
 
+    // EGLSync resources
+    EGLSync_t                   *AddEGLSync(EGLContext_t *eglContext, EGLenum type);
+    EGLBoolean                   RemoveEGLSync(EGLSync_t* eglSync);
+    EGLBoolean                   FindEGLSync(const EGLSync_t* eglSync) const;
+
     void                         CleanResources(class PlatformWindowInterface *windowInterface);
     void                         CleanMarkedResources(class PlatformWindowInterface *windowInterface);
+    void                         CleanMarkedSyncs(void);
 
 };
 
@@ -44,6 +44,8 @@ DisplayDriversContainer::FindDriver(EGLDisplay_t* display)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     auto it = mDriverMap.find(display);
     return (it != mDriverMap.end()) ? it->second : nullptr;
 }
@@ -53,6 +55,8 @@ DisplayDriversContainer::AddDriver(EGLDisplay_t* display)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     DisplayDriver *driver = FindDriver(display);
 
     if(driver) {
@@ -70,6 +74,8 @@ DisplayDriversContainer::RemoveDriver(EGLDisplay_t* display)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     DisplayDriver *removedDriver = nullptr;
 
     auto it = mDriverMap.find(display);
@@ -88,5 +94,7 @@ DisplayDriversContainer::IsEmpty()
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     return mDriverMap.size() == 0 ? EGL_TRUE : EGL_FALSE;
 }
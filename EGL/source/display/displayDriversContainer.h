@@ -25,6 +25,7 @@
 #define __DISPLAY_DRIVERS_CONTAINER_H__
 
 #include <unordered_map>
+#include <mutex>
 #include <stdint.h>
 #include "EGL/egl.h"
 #include "displayDriver.h"
@@ -39,6 +40,7 @@ private:
     using EGLDriverMap     = std::unordered_map<EGLDisplay_t*, DisplayDriver *>;
 
     EGLDriverMap                       mDriverMap;
+    std::recursive_mutex               mMutex;
 
 public:
     DisplayDriversContainer();
@@ -30,6 +30,14 @@
 #include "api/eglSurface.h"
 #include "api/eglDisplay.h"
 
+/// Outcome of acquiring the next image of a window surface
+typedef enum {
+    ACQUIRE_SUCCESS,
+    ACQUIRE_OUT_OF_DATE,                /**< The window has changed, the images have to be recreated before acquiring again */
+    ACQUIRE_SURFACE_LOST,
+    ACQUIRE_DEVICE_LOST
+} acquireResult_t;
+
 class PlatformWindowInterface
 {
 public:
@@ -40,10 +48,13 @@ public:
     virtual EGLBoolean           Terminate() = 0;
     virtual EGLBoolean           CreateSurface(EGLDisplay_t* dpy, EGLNativeWindowType win, EGLSurface_t *surface) = 0;
     virtual void                 AllocateSurfaceImages(EGLSurface_t *surface) = 0;
+    virtual void                 RecreateSurfaceImages(EGLSurface_t *surface) = 0;
+    virtual bool                 SwapIntervalRequiresRecreation(EGLSurface_t *surface) = 0;
     virtual void                 DestroySurfaceImages(EGLSurface_t *eglSurface) = 0;
     virtual void                 DestroySurface(EGLSurface_t *eglSurface) = 0;
-    virtual EGLBoolean           AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex) = 0;
-    virtual EGLBoolean           PresentImage(EGLSurface_t *eglSurface) = 0;
+    virtual acquireResult_t      AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex) = 0;
+    virtual EGLBoolean           PresentImage(EGLSurface_t *eglSurface, const EGLint *rects, EGLint nRects) = 0;
+    virtual EGLint               GetBufferAge(EGLSurface_t *eglSurface) = 0;
 };
 
 #endif // __PLATFORM_WINDOW_INTERFACE_H__
@@ -193,14 +193,14 @@ VulkanAPI::GetPhysicalDevSurfaceCapabilities(const VulkanResources *vkResources,
 }
 
 VkResult
-VulkanAPI::AcquireNextImage(const VulkanResources *vkResources, uint32_t *imageIndex)
+VulkanAPI::AcquireNextImage(const VulkanResources *vkResources, VkSemaphore vkSemaphore, uint32_t *imageIndex)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
     VkResult res = mWsiCallbacks->fpAcquireNextImageKHR(mVkInterface->vkDevice,
                                                         vkResources->GetSwapchain(),
                                                         UINT64_MAX,
-                                                        mVkInterface->vkSyncItems->vkAcquireSemaphore,
+                                                        vkSemaphore,
                                                         VK_NULL_HANDLE,
                                                         imageIndex);
 
@@ -209,15 +209,65 @@ VulkanAPI::AcquireNextImage(const VulkanResources *vkResources, uint32_t *imageI
     return res;
 }
 
+EGLBoolean
+VulkanAPI::GetRefreshCycleDuration(const VulkanResources *vkResources, double *refreshPeriod)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    if(mWsiCallbacks->fpGetRefreshCycleDurationGOOGLE == nullptr) {
+        return EGL_FALSE;
+    }
+
+    VkRefreshCycleDurationGOOGLE refreshCycle;
+    VkResult res = mWsiCallbacks->fpGetRefreshCycleDurationGOOGLE(mVkInterface->vkDevice, vkResources->GetSwapchain(), &refreshCycle);
+    if(res != VK_SUCCESS || refreshCycle.refreshDuration == 0) {
+        return EGL_FALSE;
+    }
+
+    // the duration is reported in nanoseconds
+    *refreshPeriod = static_cast<double>(refreshCycle.refreshDuration) / 1000000.0;
+
+    return EGL_TRUE;
+}
+
 VkResult
-VulkanAPI::PresentImage(const VulkanResources *vkResources, uint32_t imageIndex, std::vector<VkSemaphore> &vkSemaphores)
+VulkanAPI::PresentImage(const VulkanResources *vkResources, uint32_t imageIndex, std::vector<VkSemaphore> &vkSemaphores,
+                        const std::vector<VkRectLayerKHR> &vkRegions, uint32_t presentID, uint64_t desiredPresentTime)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    // with VK_GOOGLE_display_timing the image is held back by the presentation engine rather than by the caller
+    VkPresentTimeGOOGLE presentTime;
+    presentTime.presentID           = presentID;
+    presentTime.desiredPresentTime  = desiredPresentTime;
+
+    VkPresentTimesInfoGOOGLE presentTimes;
+    presentTimes.sType              = VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE;
+    presentTimes.pNext              = nullptr;
+    presentTimes.swapchainCount     = 1;
+    presentTimes.pTimes             = &presentTime;
+
+    const void *presentNext         = (mVkInterface->vkDisplayTimingSupported && desiredPresentTime != 0) ? &presentTimes : nullptr;
+
+    // the changed rectangles are a hint that lets the presentation engine update only a part of the image
+    VkPresentRegionKHR presentRegion;
+    presentRegion.rectangleCount    = static_cast<uint32_t>(vkRegions.size());
+    presentRegion.pRectangles       = vkRegions.data();
+
+    VkPresentRegionsKHR presentRegions;
+    presentRegions.sType            = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR;
+    presentRegions.pNext            = presentNext;
+    presentRegions.swapchainCount   = 1;
+    presentRegions.pRegions         = &presentRegion;
+
+    if(mVkInterface->vkIncrementalPresentSupported && !vkRegions.empty()) {
+        presentNext = &presentRegions;
+    }
+
     VkPresentInfoKHR presentInfo;
     VkSwapchainKHR swapchain        = vkResources->GetSwapchain();
     presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.pNext               = nullptr;
+    presentInfo.pNext               = presentNext;
     presentInfo.waitSemaphoreCount  = static_cast<uint32_t>(vkSemaphores.size());
     presentInfo.pWaitSemaphores     = vkSemaphores.data();
     presentInfo.swapchainCount      = 1;
@@ -225,17 +275,210 @@ VulkanAPI::PresentImage(const VulkanResources *vkResources, uint32_t imageIndex,
     presentInfo.pImageIndices       = &imageIndex;
     presentInfo.pResults            = nullptr;
 
+    // the queue is shared with the client API contexts of other threads
+    mVkInterface->vkLockQueue(true);
     VkResult res = mWsiCallbacks->fpQueuePresentKHR(mVkInterface->vkQueue, &presentInfo);
+    mVkInterface->vkLockQueue(false);
+
+    return res;
+}
+
+VkResult
+VulkanAPI::SubmitSemaphores(std::vector<VkSemaphore> &vkWaitSemaphores, VkSemaphore vkSignalSemaphore)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    std::vector<VkPipelineStageFlags> waitStages(vkWaitSemaphores.size(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+    // an empty submission, it only forwards the wait semaphores to the signal semaphore
+    VkSubmitInfo submitInfo;
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext                = nullptr;
+    submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(vkWaitSemaphores.size());
+    submitInfo.pWaitSemaphores      = vkWaitSemaphores.data();
+    submitInfo.pWaitDstStageMask    = waitStages.data();
+    submitInfo.commandBufferCount   = 0;
+    submitInfo.pCommandBuffers      = nullptr;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = &vkSignalSemaphore;
+
+    mVkInterface->vkLockQueue(true);
+    VkResult res = vkQueueSubmit(mVkInterface->vkQueue, 1, &submitInfo, VK_NULL_HANDLE);
+    mVkInterface->vkLockQueue(false);
 
     return res;
 }
 
+VkSemaphore
+VulkanAPI::CreateVkSemaphore(void)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VkSemaphoreCreateInfo semaphoreInfo;
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = nullptr;
+    semaphoreInfo.flags = 0;
+
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    if(vkCreateSemaphore(mVkInterface->vkDevice, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    return semaphore;
+}
+
 void
-VulkanAPI::DestroySwapchain(const VulkanResources *vkResources)
+VulkanAPI::DestroyVkSemaphore(VkSemaphore vkSemaphore)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    vkDestroySwapchainKHR(mVkInterface->vkDevice, vkResources->GetSwapchain(), nullptr);
+    if(vkSemaphore != VK_NULL_HANDLE) {
+        vkDestroySemaphore(mVkInterface->vkDevice, vkSemaphore, nullptr);
+    }
+}
+
+VkFence
+VulkanAPI::SubmitFence(void)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VkFenceCreateInfo fenceInfo;
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.pNext = nullptr;
+    fenceInfo.flags = 0;
+
+    VkFence fence = VK_NULL_HANDLE;
+    if(vkCreateFence(mVkInterface->vkDevice, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    // an empty submission, the fence is signaled once all previous submissions to the queue complete
+    mVkInterface->vkLockQueue(true);
+    VkResult res = vkQueueSubmit(mVkInterface->vkQueue, 0, nullptr, fence);
+    mVkInterface->vkLockQueue(false);
+
+    if(res != VK_SUCCESS) {
+        vkDestroyFence(mVkInterface->vkDevice, fence, nullptr);
+        return VK_NULL_HANDLE;
+    }
+
+    return fence;
+}
+
+VkResult
+VulkanAPI::WaitFence(VkFence vkFence, uint64_t timeout)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    return vkWaitForFences(mVkInterface->vkDevice, 1, &vkFence, VK_TRUE, timeout);
+}
+
+void
+VulkanAPI::DestroyFence(VkFence vkFence)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    if(vkFence != VK_NULL_HANDLE) {
+        vkDestroyFence(mVkInterface->vkDevice, vkFence, nullptr);
+    }
+}
+
+VkImage
+VulkanAPI::CreateImage(VkFormat format, uint32_t width, uint32_t height, VkImageUsageFlags usage)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VkImageCreateInfo imageInfo;
+    imageInfo.sType                 = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.pNext                 = nullptr;
+    imageInfo.flags                 = 0;
+    imageInfo.imageType             = VK_IMAGE_TYPE_2D;
+    imageInfo.format                = format;
+    imageInfo.extent                = {width, height, 1};
+    imageInfo.mipLevels             = 1;
+    imageInfo.arrayLayers           = 1;
+    imageInfo.samples               = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling                = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage                 = usage;
+    imageInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.queueFamilyIndexCount = 0;
+    imageInfo.pQueueFamilyIndices   = nullptr;
+    imageInfo.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkImage image = VK_NULL_HANDLE;
+    if(vkCreateImage(mVkInterface->vkDevice, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    return image;
+}
+
+VkDeviceMemory
+VulkanAPI::AllocateImageMemory(VkImage image)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(mVkInterface->vkDevice, image, &memoryRequirements);
+
+    // prefer device local memory, as the image is only accessed by the device
+    const VkPhysicalDeviceMemoryProperties *memoryProperties = &mVkInterface->vkDeviceMemoryProperties;
+    uint32_t memoryTypeIndex = UINT32_MAX;
+    for(uint32_t i = 0; i < memoryProperties->memoryTypeCount; ++i) {
+        if(!(memoryRequirements.memoryTypeBits & (1u << i))) {
+            continue;
+        }
+        if(memoryProperties->memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+            memoryTypeIndex = i;
+            break;
+        }
+        if(memoryTypeIndex == UINT32_MAX) {
+            memoryTypeIndex = i;
+        }
+    }
+
+    if(memoryTypeIndex == UINT32_MAX) {
+        return VK_NULL_HANDLE;
+    }
+
+    VkMemoryAllocateInfo allocateInfo;
+    allocateInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.pNext           = nullptr;
+    allocateInfo.allocationSize  = memoryRequirements.size;
+    allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if(vkAllocateMemory(mVkInterface->vkDevice, &allocateInfo, nullptr, &memory) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    if(vkBindImageMemory(mVkInterface->vkDevice, image, memory, 0) != VK_SUCCESS) {
+        vkFreeMemory(mVkInterface->vkDevice, memory, nullptr);
+        return VK_NULL_HANDLE;
+    }
+
+    return memory;
+}
+
+void
+VulkanAPI::DestroyImage(VkImage image, VkDeviceMemory memory)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    if(image != VK_NULL_HANDLE) {
+        vkDestroyImage(mVkInterface->vkDevice, image, nullptr);
+    }
+    if(memory != VK_NULL_HANDLE) {
+        vkFreeMemory(mVkInterface->vkDevice, memory, nullptr);
+    }
+}
+
+void
+VulkanAPI::DestroySwapchain(VkSwapchainKHR vkSwapchain)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    vkDestroySwapchainKHR(mVkInterface->vkDevice, vkSwapchain, nullptr);
 }
 
 void
@@ -245,3 +488,16 @@ VulkanAPI::DestroyPlatformSurface(const VulkanResources *vkResources)
 
     vkDestroySurfaceKHR(mVkInterface->vkInstance, vkResources->GetSurface(), nullptr);
 }
+
+VkResult
+VulkanAPI::DeviceWaitIdle(void)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // waiting for the device to become idle requires exclusive access to all of its queues
+    mVkInterface->vkLockQueue(true);
+    VkResult res = vkDeviceWaitIdle(mVkInterface->vkDevice);
+    mVkInterface->vkLockQueue(false);
+
+    return res;
+}
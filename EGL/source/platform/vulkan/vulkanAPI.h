@@ -61,14 +61,28 @@ public:
     EGLBoolean                   GetPhysicalDevPresentModes(const VulkanResources *vkResources, uint32_t presentModeCount, VkPresentModeKHR *presentModes);
     uint32_t                     GetPhysicalDevPresentModesCount(const VulkanResources *vkResources);
     EGLBoolean                   GetPhysicalDevSurfaceCapabilities(const VulkanResources *vkResources, VkSurfaceCapabilitiesKHR *surfCapabilities);
-    VkResult                     AcquireNextImage(const VulkanResources *vkResources, uint32_t *imageIndex);
-    VkResult                     PresentImage(const VulkanResources *vkResources, uint32_t imageIndex, std::vector<VkSemaphore> &vkSemaphores);
+    VkResult                     AcquireNextImage(const VulkanResources *vkResources, VkSemaphore vkSemaphore, uint32_t *imageIndex);
+    EGLBoolean                   GetRefreshCycleDuration(const VulkanResources *vkResources, double *refreshPeriod);
+    VkResult                     PresentImage(const VulkanResources *vkResources, uint32_t imageIndex, std::vector<VkSemaphore> &vkSemaphores,
+                                              const std::vector<VkRectLayerKHR> &vkRegions, uint32_t presentID, uint64_t desiredPresentTime);
+    VkResult                     SubmitSemaphores(std::vector<VkSemaphore> &vkWaitSemaphores, VkSemaphore vkSignalSemaphore);
 
-    void                         DestroySwapchain(const VulkanResources *vkResources);
+    VkSemaphore                  CreateVkSemaphore(void);
+    void                         DestroyVkSemaphore(VkSemaphore vkSemaphore);
+
+    VkFence                      SubmitFence(void);
+    VkResult                     WaitFence(VkFence vkFence, uint64_t timeout);
+    void                         DestroyFence(VkFence vkFence);
+
+    VkImage                      CreateImage(VkFormat format, uint32_t width, uint32_t height, VkImageUsageFlags usage);
+    VkDeviceMemory               AllocateImageMemory(VkImage image);
+    void                         DestroyImage(VkImage image, VkDeviceMemory memory);
+
+    void                         DestroySwapchain(VkSwapchainKHR vkSwapchain);
     void                         DestroyPlatformSurface(const VulkanResources *vkResources);
 
     void                         SetWSICallbacks(const VulkanWSI::wsiCallbacks_t *wsiCallbacks) { mWsiCallbacks = wsiCallbacks; }
-    VkResult                     DeviceWaitIdle(void)                                           { return vkDeviceWaitIdle(mVkInterface->vkDevice); }
+    VkResult                     DeviceWaitIdle(void);
 };
 
 
@@ -24,10 +24,21 @@
 #include "vulkanResources.h"
 
 VulkanResources::VulkanResources()
-    : mSurface(VK_NULL_HANDLE), mSwapchain(VK_NULL_HANDLE),
-      mSwapChainImageCount(0), mSwapChainImages(nullptr)
+    : mSurface(VK_NULL_HANDLE), mSwapchain(VK_NULL_HANDLE), mPresentMode(VK_PRESENT_MODE_FIFO_KHR),
+      mSwapChainImageCount(0), mSwapChainImages(nullptr), mImageMemory(VK_NULL_HANDLE),
+      mAcquireSemaphoreIndex(0)
 {
     FUN_ENTRY(DEBUG_DEPTH);
+
+    // until it is measured, the display is assumed to refresh at 60Hz
+    mPresentTiming.presentInterval = 0.0;
+    mPresentTiming.refreshPeriod   = 1000.0 / 60.0;
+    mPresentTiming.refreshSamples  = 0;
+    mPresentTiming.refreshQueried  = false;
+    mPresentTiming.presentWait     = 0.0;
+    mPresentTiming.presentCount    = 0;
+    mPresentTiming.surfacePixels   = 0;
+    mPresentTiming.damagedPixels   = 0;
 }
 
 VulkanResources::~VulkanResources()
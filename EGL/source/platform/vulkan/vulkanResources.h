@@ -26,14 +26,52 @@
 
 #include "platform/platformResources.h"
 #include <vulkan/vulkan.h>
+#include <vector>
+#include <chrono>
 
 class VulkanResources : public PlatformResources
 {
+public:
+    // a swapchain replaced on recreation, it is destroyed along with its semaphores once
+    // the fence submitted after its last frame is signaled
+    typedef struct retiredSwapchain {
+        VkSwapchainKHR               swapchain;
+        VkFence                      fence;
+        std::vector<VkSemaphore>     semaphores;
+    } retiredSwapchain_t;
+
+    // present-to-present timing, used to pace swap intervals above 1 that Vulkan cannot express
+    typedef struct presentTiming {
+        std::chrono::steady_clock::time_point lastPresent;
+        double                       presentInterval;
+        double                       refreshPeriod;
+        uint32_t                     refreshSamples;
+        bool                         refreshQueried;    // reported by VK_GOOGLE_display_timing rather than measured
+        double                       presentWait;       // time the current frame blocked in acquire and present
+        uint32_t                     presentCount;
+        uint64_t                     surfacePixels;
+        uint64_t                     damagedPixels;
+    } presentTiming_t;
+
 private:
     VkSurfaceKHR                     mSurface;
     VkSwapchainKHR                   mSwapchain;
+    VkPresentModeKHR                 mPresentMode;
     uint32_t                         mSwapChainImageCount;
     VkImage                         *mSwapChainImages;
+    VkDeviceMemory                   mImageMemory;
+
+    // one acquire and one present semaphore per swapchain image, so that a frame
+    // never reuses a semaphore that the presentation engine may still wait on
+    std::vector<VkSemaphore>         mAcquireSemaphores;
+    std::vector<VkSemaphore>         mPresentSemaphores;
+    uint32_t                         mAcquireSemaphoreIndex;
+
+    std::vector<retiredSwapchain_t>  mRetiredSwapchains;
+    presentTiming_t                  mPresentTiming;
+
+    // the present count at which each swapchain image was last presented, 0 if never, for EGL_BUFFER_AGE_KHR
+    std::vector<uint32_t>            mImagePresentCounts;
 
 public:
     VulkanResources();
@@ -44,14 +82,26 @@ public:
     // Get Functions
     inline VkSurfaceKHR              GetSurface()                                   const { return mSurface; }
     inline VkSwapchainKHR            GetSwapchain()                                 const { return mSwapchain; }
+    inline VkPresentModeKHR          GetPresentMode()                               const { return mPresentMode; }
     inline uint32_t                  GetSwapchainImageCount()                    override { return mSwapChainImageCount; }
     inline void *                    GetSwapchainImages()                        override { return reinterpret_cast<void *>(mSwapChainImages); }
+    inline VkDeviceMemory            GetImageMemory()                               const { return mImageMemory; }
+    inline std::vector<VkSemaphore> &GetAcquireSemaphores()                               { return mAcquireSemaphores; }
+    inline std::vector<VkSemaphore> &GetPresentSemaphores()                               { return mPresentSemaphores; }
+    inline std::vector<retiredSwapchain_t> &GetRetiredSwapchains()                        { return mRetiredSwapchains; }
+    inline presentTiming_t          &GetPresentTiming()                                   { return mPresentTiming; }
+    inline std::vector<uint32_t>    &GetImagePresentCounts()                              { return mImagePresentCounts; }
+    inline VkSemaphore               GetPresentSemaphore(uint32_t imageIndex)       const { return mPresentSemaphores[imageIndex]; }
+    inline VkSemaphore               GetNextAcquireSemaphore()                            { mAcquireSemaphoreIndex = (mAcquireSemaphoreIndex + 1) % mAcquireSemaphores.size();
+                                                                                            return mAcquireSemaphores[mAcquireSemaphoreIndex]; }
 
     // Set Functions
     inline void                      SetSurface(VkSurfaceKHR surface)                     { mSurface              = surface; }
     inline void                      SetSwapchain(VkSwapchainKHR swapchain)               { mSwapchain            = swapchain; }
+    inline void                      SetPresentMode(VkPresentModeKHR presentMode)         { mPresentMode          = presentMode; }
     inline void                      SetSwapChainImageCount(uint32_t swapChainImageCount) { mSwapChainImageCount  = swapChainImageCount; }
     inline void                      SetSwapChainImages(VkImage *swapChainImages)         { mSwapChainImages      = swapChainImages; }
+    inline void                      SetImageMemory(VkDeviceMemory imageMemory)           { mImageMemory          = imageMemory; }
 };
 
 #endif // #define __VULKAN_RESOURCES_H__
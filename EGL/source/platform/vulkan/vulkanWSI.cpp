@@ -57,5 +57,10 @@ VulkanWSI::SetWSICallbacks()
     GET_WSI_FUNCTION_PTR(mWsiCallbacks, AcquireNextImageKHR);
     GET_WSI_FUNCTION_PTR(mWsiCallbacks, QueuePresentKHR);
 
+    // VK_GOOGLE_display_timing functions
+    if(mVkInterface->vkDisplayTimingSupported) {
+        mWsiCallbacks.fpGetRefreshCycleDurationGOOGLE = (PFN_vkGetRefreshCycleDurationGOOGLE) vkGetInstanceProcAddr(mVkInterface->vkInstance, "vkGetRefreshCycleDurationGOOGLE");
+    }
+
     return EGL_TRUE;
 }
@@ -53,6 +53,8 @@ typedef struct wsiCallbacks {
     PFN_vkGetSwapchainImagesKHR                     fpGetSwapchainImagesKHR;
     PFN_vkAcquireNextImageKHR                       fpAcquireNextImageKHR;
     PFN_vkQueuePresentKHR                           fpQueuePresentKHR;
+    // VK_GOOGLE_display_timing functions, null if the extension is not enabled
+    PFN_vkGetRefreshCycleDurationGOOGLE             fpGetRefreshCycleDurationGOOGLE;
 } wsiCallbacks_t;
 
 protected:
@@ -22,9 +22,12 @@
  */
 
 #include "vulkanWindowInterface.h"
+#include <algorithm>
+#include <thread>
 
 VulkanWindowInterface::VulkanWindowInterface(void)
-: mVkInitialized(false), mGLES2Interface(nullptr), mVkAPI(nullptr), mVkWSI(nullptr)
+: mVkInitialized(false), mGLES2Interface(nullptr), mVkAPI(nullptr), mVkWSI(nullptr),
+  mPresentStats(getenv(EGL_PRESENT_STATS_ENV) != nullptr)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 }
@@ -51,13 +54,16 @@ VulkanWindowInterface::InitializeVulkanAPI()
 
         mVkAPI = new VulkanAPI(mVkInterface);
 
-        mVkWSI->SetVkInterface(mVkInterface);
+        // without WSI support, e.g. a software driver with no display server, only pbuffers are available
+        if(mVkInterface->vkWSISupported) {
+            mVkWSI->SetVkInterface(mVkInterface);
 
-        if(mVkWSI->Initialize() == EGL_FALSE) {
-            return EGL_FALSE;
-        }
+            if(mVkWSI->Initialize() == EGL_FALSE) {
+                return EGL_FALSE;
+            }
 
-        mVkAPI->SetWSICallbacks(mVkWSI->GetWsiCallbacks());
+            mVkAPI->SetWSICallbacks(mVkWSI->GetWsiCallbacks());
+        }
 
         mVkInitialized = true;
     }
@@ -140,12 +146,43 @@ VulkanWindowInterface::SetSwapchainPresentMode(EGLSurface_t* surface)
                 swapchainPresentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
             }
         }
+    } else if(surface->GetSwapInterval() == 1) {
+        //VK_PRESENT_MODE_FIFO_RELAXED_KHR, if supported, provides adaptive vsync: a late image is presented without waiting for the next vertical blank
+        for(size_t i = 0; i < presentModeCount; i++) {
+            if(presentModes[i] == VK_PRESENT_MODE_FIFO_RELAXED_KHR) {
+                swapchainPresentMode = VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+                break;
+            }
+        }
     }
+    // longer intervals use VK_PRESENT_MODE_FIFO_KHR, paced in PresentImage
     delete[] presentModes;
 
     return swapchainPresentMode;
 }
 
+uint32_t
+VulkanWindowInterface::GetSwapchainImageCount(VkPresentModeKHR swapchainPresentMode, const VkSurfaceCapabilitiesKHR &surfCapabilities)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // double buffering keeps the latency low, mailbox needs a third image so that rendering never waits for presentation
+    uint32_t imageCount = swapchainPresentMode == VK_PRESENT_MODE_MAILBOX_KHR ? 3 : 2;
+
+    // the number of images trades latency for throughput, so it can be tuned per application
+    const char *envImageCount = getenv(EGL_SWAPCHAIN_IMAGE_COUNT_ENV);
+    if(envImageCount != nullptr && atoi(envImageCount) > 0) {
+        imageCount = static_cast<uint32_t>(atoi(envImageCount));
+    }
+
+    imageCount = std::max(imageCount, surfCapabilities.minImageCount);
+    if(surfCapabilities.maxImageCount > 0) {
+        imageCount = std::min(imageCount, surfCapabilities.maxImageCount);
+    }
+
+    return imageCount;
+}
+
 void
 VulkanWindowInterface::SetSurfaceColorFormat(EGLSurface_t *surface)
 {
@@ -212,21 +249,31 @@ VulkanWindowInterface::CreateVkSwapchain(EGLSurface_t* surface,
     EGLBoolean ASSERT_ONLY wsiSuccess;
     /// Determine number of buffers
     assert(surfCapabilities.minImageCount >= 1);
-    uint32_t desiredNumberOfSwapChainImages = 2;
+    uint32_t desiredNumberOfSwapChainImages = GetSwapchainImageCount(swapchainPresentMode, surfCapabilities);
 
     VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
     assert(vkResources);
 
+    // on recreation the old swapchain is handed over, so that the presentation engine can reuse its resources
     VkSwapchainKHR vkSwapchain = mVkAPI->CreateSwapchain(vkResources,
                                                          desiredNumberOfSwapChainImages,
                                                          surfCapabilities,
                                                          swapChainExtent,
                                                          swapchainPresentMode,
                                                          static_cast<VkFormat>(surface->GetColorFormat()),
-                                                         VK_NULL_HANDLE);
+                                                         vkResources->GetSwapchain());
     assert(vkSwapchain != VK_NULL_HANDLE);
 
     vkResources->SetSwapchain(vkSwapchain);
+    vkResources->SetPresentMode(swapchainPresentMode);
+
+    // with VK_GOOGLE_display_timing the refresh period of the display is known, otherwise it is measured while presenting
+    VulkanResources::presentTiming_t &timing = vkResources->GetPresentTiming();
+    double refreshPeriod;
+    if(mVkAPI->GetRefreshCycleDuration(vkResources, &refreshPeriod) == EGL_TRUE) {
+        timing.refreshPeriod  = refreshPeriod;
+        timing.refreshQueried = true;
+    }
 }
 
 EGLBoolean
@@ -234,6 +281,10 @@ VulkanWindowInterface::CreateSurface(EGLDisplay_t* dpy, EGLNativeWindowType win,
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    if(!mVkInterface->vkWSISupported) {
+        return EGL_FALSE;
+    }
+
     VkSurfaceKHR newSurface = mVkWSI->CreateSurface(dpy, win, surface);
 
     if(VK_NULL_HANDLE == newSurface) {
@@ -266,11 +317,91 @@ VulkanWindowInterface::CreateSwapchain(EGLSurface_t *surface)
     CreateVkSwapchain(surface, swapchainPresentMode, swapChainExtent, surfCapabilities);
 }
 
+void
+VulkanWindowInterface::AllocatePbufferImage(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    assert(vkResources);
+
+    SetPbufferColorFormat(surface);
+    VkFormat format = static_cast<VkFormat>(surface->GetColorFormat());
+    if(format == VK_FORMAT_UNDEFINED) {
+        return;
+    }
+
+    // a plain device image, rendered to and copied from by eglBindTexImage, no presentation is involved
+    VkImage image = mVkAPI->CreateImage(format, surface->GetWidth(), surface->GetHeight(),
+                                        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    if(image == VK_NULL_HANDLE) {
+        return;
+    }
+
+    VkDeviceMemory memory = mVkAPI->AllocateImageMemory(image);
+    if(memory == VK_NULL_HANDLE) {
+        mVkAPI->DestroyImage(image, VK_NULL_HANDLE);
+        return;
+    }
+
+    VkImage *images = new VkImage[1];
+    images[0] = image;
+
+    vkResources->SetImageMemory(memory);
+    vkResources->SetSwapChainImageCount(1);
+    vkResources->SetSwapChainImages(images);
+    surface->SetCurrentImageIndex(0);
+}
+
+void
+VulkanWindowInterface::DestroyPbufferImage(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    if(vkResources == nullptr) {
+        return;
+    }
+
+    if(vkResources->GetSwapchainImageCount()) {
+        VkImage *images = reinterpret_cast<VkImage *>(vkResources->GetSwapchainImages());
+        mVkAPI->DestroyImage(images[0], vkResources->GetImageMemory());
+        vkResources->SetImageMemory(VK_NULL_HANDLE);
+    }
+
+    vkResources->Release();
+}
+
+void
+VulkanWindowInterface::SetPbufferColorFormat(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+    if(surface->GetRedSize() == 5 && surface->GetGreenSize() == 6 && surface->GetBlueSize() == 5) {
+        format = VK_FORMAT_R5G6B5_UNORM_PACK16;
+    }
+
+    VkFormatProperties formatDeviceProps;
+    mVkAPI->GetPhysicalDevFormatProperties(format, &formatDeviceProps);
+
+    if(!(formatDeviceProps.optimalTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT)) {
+        format = VK_FORMAT_UNDEFINED;
+    }
+
+    surface->SetColorFormat(static_cast<EGLint>(format));
+}
+
 void
 VulkanWindowInterface::AllocateSurfaceImages(EGLSurface_t* surface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    if(surface->GetType() == EGL_PBUFFER_BIT) {
+        AllocatePbufferImage(surface);
+        return;
+    }
+
     CreateSwapchain(surface);
 
     EGLBoolean ASSERT_ONLY wsiSuccess;
@@ -290,28 +421,199 @@ VulkanWindowInterface::AllocateSurfaceImages(EGLSurface_t* surface)
 
     vkResources->SetSwapChainImageCount(swapChainImageCount);
     vkResources->SetSwapChainImages(swapChainImages);
+    vkResources->GetImagePresentCounts().assign(swapChainImageCount, 0);
+
+    CreateSwapchainSemaphores(vkResources);
 }
 
-EGLBoolean
-VulkanWindowInterface::AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex)
+void
+VulkanWindowInterface::ReleaseAcquireSemaphore(EGLSurface_t *surface, VkSemaphore semaphore)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // the client API must not wait on an acquire semaphore that is destroyed or retired
+    vkSyncItems_t *syncItems = surface->GetEGLSurfaceInterface()->vkSyncItems;
+    if(syncItems != nullptr && syncItems->vkAcquireSemaphore == semaphore) {
+        syncItems->vkAcquireSemaphore   = VK_NULL_HANDLE;
+        syncItems->acquireSemaphoreFlag = false;
+    }
+}
+
+void
+VulkanWindowInterface::ReleasePresentSemaphore(EGLSurface_t *surface, VkSemaphore semaphore)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    // the client API must not signal a present semaphore that is destroyed or retired
+    vkSyncItems_t *syncItems = surface->GetEGLSurfaceInterface()->vkSyncItems;
+    if(syncItems != nullptr && syncItems->vkPresentSemaphore == semaphore) {
+        syncItems->vkPresentSemaphore   = VK_NULL_HANDLE;
+        syncItems->presentSemaphoreFlag = false;
+        syncItems->presentPending       = false;
+    }
+}
+
+void
+VulkanWindowInterface::CreateSwapchainSemaphores(VulkanResources *vkResources)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    for(uint32_t i = 0; i < vkResources->GetSwapchainImageCount(); ++i) {
+        vkResources->GetAcquireSemaphores().push_back(mVkAPI->CreateVkSemaphore());
+        vkResources->GetPresentSemaphores().push_back(mVkAPI->CreateVkSemaphore());
+    }
+}
+
+void
+VulkanWindowInterface::DestroySwapchainSemaphores(EGLSurface_t *surface, VulkanResources *vkResources)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    for(VkSemaphore semaphore : vkResources->GetAcquireSemaphores()) {
+        ReleaseAcquireSemaphore(surface, semaphore);
+        mVkAPI->DestroyVkSemaphore(semaphore);
+    }
+    for(VkSemaphore semaphore : vkResources->GetPresentSemaphores()) {
+        ReleasePresentSemaphore(surface, semaphore);
+        mVkAPI->DestroyVkSemaphore(semaphore);
+    }
+    vkResources->GetAcquireSemaphores().clear();
+    vkResources->GetPresentSemaphores().clear();
+}
+
+void
+VulkanWindowInterface::RecreateSurfaceImages(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // pbuffers are not tied to a window, so they never go out of date
+    if(surface->GetType() != EGL_WINDOW_BIT) {
+        return;
+    }
+
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    assert(vkResources);
+
+    ReleaseRetiredSwapchains(vkResources, false);
+
+    // the old swapchain is still valid until the new one is created from it, so it is only retired here
+    VulkanResources::retiredSwapchain_t retired;
+    retired.swapchain = vkResources->GetSwapchain();
+    retired.fence     = VK_NULL_HANDLE;
+    for(VkSemaphore semaphore : vkResources->GetAcquireSemaphores()) {
+        ReleaseAcquireSemaphore(surface, semaphore);
+        retired.semaphores.push_back(semaphore);
+    }
+    for(VkSemaphore semaphore : vkResources->GetPresentSemaphores()) {
+        ReleasePresentSemaphore(surface, semaphore);
+        retired.semaphores.push_back(semaphore);
+    }
+    vkResources->GetAcquireSemaphores().clear();
+    vkResources->GetPresentSemaphores().clear();
+
+    vkResources->Release();
+    AllocateSurfaceImages(surface);
+
+    // the retired resources may still be used by the last presentation, a fence tells when the queue is past it
+    retired.fence = mVkAPI->SubmitFence();
+    vkResources->GetRetiredSwapchains().push_back(retired);
+    if(retired.fence == VK_NULL_HANDLE) {
+        ReleaseRetiredSwapchains(vkResources, true);
+    }
+}
+
+bool
+VulkanWindowInterface::SwapIntervalRequiresRecreation(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    if(surface->GetType() != EGL_WINDOW_BIT) {
+        return false;
+    }
+
+    // intervals above 1 share VK_PRESENT_MODE_FIFO_KHR and are paced while presenting, without a new swapchain
     const VulkanResources *vkResources = dynamic_cast<const VulkanResources *>(surface->GetPlatformResources());
+    return vkResources == nullptr || SetSwapchainPresentMode(surface) != vkResources->GetPresentMode();
+}
+
+void
+VulkanWindowInterface::ReleaseRetiredSwapchains(VulkanResources *vkResources, bool wait)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    std::vector<VulkanResources::retiredSwapchain_t> &retiredSwapchains = vkResources->GetRetiredSwapchains();
+    if(retiredSwapchains.empty()) {
+        return;
+    }
+
+    auto iter = retiredSwapchains.begin();
+    while(iter != retiredSwapchains.end()) {
+        VkResult res;
+        if(iter->fence != VK_NULL_HANDLE) {
+            res = mVkAPI->WaitFence(iter->fence, wait ? UINT64_MAX : 0);
+        } else {
+            // without a fence, only an idle device tells that the swapchain is not in use anymore
+            res = wait ? mVkAPI->DeviceWaitIdle() : VK_NOT_READY;
+        }
+
+        if(res != VK_SUCCESS) {
+            ++iter;
+            continue;
+        }
+
+        mVkAPI->DestroyFence(iter->fence);
+        for(VkSemaphore semaphore : iter->semaphores) {
+            mVkAPI->DestroyVkSemaphore(semaphore);
+        }
+        mVkAPI->DestroySwapchain(iter->swapchain);
+        iter = retiredSwapchains.erase(iter);
+    }
+}
+
+acquireResult_t
+VulkanWindowInterface::AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
     if(vkResources == nullptr) {
-        return EGL_FALSE;
+        return ACQUIRE_SURFACE_LOST;
     }
 
-    VkResult res = mVkAPI->AcquireNextImage(vkResources, imageIndex);
-    if(res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR) {
-        mVkAPI->DeviceWaitIdle();
+    // the sync items are set by the client API once a context renders to the surface
+    vkSyncItems_t *syncItems = surface->GetEGLSurfaceInterface()->vkSyncItems;
+    if(syncItems == nullptr) {
+        return ACQUIRE_SURFACE_LOST;
+    }
 
-        return EGL_FALSE;
+    // no swapchain can be created while the window has a zero extent, e.g., when it is minimized
+    if(vkResources->GetSwapchain() == VK_NULL_HANDLE) {
+        return ACQUIRE_OUT_OF_DATE;
+    }
+
+    VkSemaphore acquireSemaphore = vkResources->GetNextAcquireSemaphore();
+    std::chrono::steady_clock::time_point acquireStart = std::chrono::steady_clock::now();
+    VkResult res = mVkAPI->AcquireNextImage(vkResources, acquireSemaphore, imageIndex);
+    vkResources->GetPresentTiming().presentWait += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - acquireStart).count();
+
+    // a suboptimal image is still acquired and can be presented, the swapchain is recreated once presenting reports it
+    switch(res) {
+    case VK_SUCCESS:
+    case VK_SUBOPTIMAL_KHR:             break;
+    case VK_ERROR_OUT_OF_DATE_KHR:      return ACQUIRE_OUT_OF_DATE;
+    case VK_ERROR_DEVICE_LOST:          return ACQUIRE_DEVICE_LOST;
+    default:                            return ACQUIRE_SURFACE_LOST;
     }
 
     surface->SetCurrentImageIndex(*imageIndex);
 
-    return EGL_TRUE;
+    // the next submission has to wait until the acquired image is available
+    syncItems->vkAcquireSemaphore   = acquireSemaphore;
+    syncItems->acquireSemaphoreFlag = true;
+    syncItems->vkPresentSemaphore   = vkResources->GetPresentSemaphore(*imageIndex);
+    syncItems->presentSemaphoreFlag = false;
+
+    return ACQUIRE_SUCCESS;
 }
 
 void
@@ -320,9 +622,14 @@ VulkanWindowInterface::DestroySwapchain(EGLSurface_t *surface)
     FUN_ENTRY(DEBUG_DEPTH);
 
     VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    if(vkResources) {
+        ReleaseRetiredSwapchains(vkResources, true);
+    }
+
     if(vkResources && vkResources->GetSwapchain() != VK_NULL_HANDLE) {
-        mVkAPI->DestroySwapchain(vkResources);
+        mVkAPI->DestroySwapchain(vkResources->GetSwapchain());
         vkResources->SetSwapchain(VK_NULL_HANDLE);
+        DestroySwapchainSemaphores(surface, vkResources);
     }
 
     if(vkResources) {
@@ -340,6 +647,8 @@ VulkanWindowInterface::DestroySurface(EGLSurface_t *surface)
         mVkAPI->DestroyPlatformSurface(vkResources);
         vkResources->SetSurface(VK_NULL_HANDLE);
         mGLES2Interface->delete_shared_surface_data_cb(surface->GetEGLSurfaceInterface());
+    } else if(surface->GetType() == EGL_PBUFFER_BIT) {
+        mGLES2Interface->delete_shared_surface_data_cb(surface->GetEGLSurfaceInterface());
     }
 }
 
@@ -348,35 +657,202 @@ VulkanWindowInterface::DestroySurfaceImages(EGLSurface_t *surface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    if(surface->GetType() == EGL_PBUFFER_BIT) {
+        DestroyPbufferImage(surface);
+        return;
+    }
+
     DestroySwapchain(surface);
 }
 
 EGLBoolean
-VulkanWindowInterface::PresentImage(EGLSurface_t *surface)
+VulkanWindowInterface::PresentImage(EGLSurface_t *surface, const EGLint *rects, EGLint nRects)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    uint32_t imageIndex = surface->GetCurrentImageIndex();
+
+    ReleaseRetiredSwapchains(vkResources, false);
+
     std::vector<VkSemaphore> pSems;
-    if(mVkInterface->vkSyncItems->drawSemaphoreFlag) {
-        pSems.push_back(mVkInterface->vkSyncItems->vkDrawSemaphore);
-    } else {
-        pSems.push_back(mVkInterface->vkSyncItems->vkAcquireSemaphore);
+    bool presentSignaled = false;
+    vkSyncItems_t *syncItems = surface->GetEGLSurfaceInterface()->vkSyncItems;
+    if(syncItems != nullptr) {
+        presentSignaled = syncItems->presentSemaphoreFlag;
+        if(!presentSignaled && syncItems->drawSemaphoreFlag) {
+            pSems.push_back(syncItems->vkDrawSemaphore);
+        }
+        if(!presentSignaled && syncItems->acquireSemaphoreFlag) {
+            pSems.push_back(syncItems->vkAcquireSemaphore);
+        }
+
+        syncItems->acquireSemaphoreFlag = false;
+        syncItems->drawSemaphoreFlag    = false;
+        syncItems->presentSemaphoreFlag = false;
+        syncItems->presentPending       = false;
     }
 
-    mVkInterface->vkSyncItems->acquireSemaphoreFlag = true;
-    mVkInterface->vkSyncItems->drawSemaphoreFlag = false;
+    // the semaphore of the presented image is normally signaled by the last draw submission of the frame. Only when
+    // nothing was left to submit at the swap, the rendering is handed over to it by an empty submission, as the
+    // draw semaphore is signaled again by the next frame while presentation may still wait on it
+    VkSemaphore presentSemaphore = vkResources->GetPresentSemaphore(imageIndex);
+    if(!presentSignaled && mVkAPI->SubmitSemaphores(pSems, presentSemaphore) != VK_SUCCESS) {
+        return EGL_FALSE;
+    }
 
-    uint32_t imageIndex = surface->GetCurrentImageIndex();
-    VkResult res = mVkAPI->PresentImage(dynamic_cast<const VulkanResources *>(surface->GetPlatformResources()), imageIndex, pSems);
-    if(res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR) {
-        mVkAPI->DeviceWaitIdle();
+    std::vector<VkSemaphore> presentSems(1, presentSemaphore);
+    std::vector<VkRectLayerKHR> presentRegions;
+    uint64_t damagedPixels = GetPresentRegions(surface, rects, nRects, presentRegions);
+    uint64_t desiredPresentTime = PacePresent(surface, vkResources);
+
+    // the swapchain is recreated by the caller, without waiting for the device to become idle
+    std::chrono::steady_clock::time_point presentStart = std::chrono::steady_clock::now();
+    VkResult res = mVkAPI->PresentImage(vkResources, imageIndex, presentSems, presentRegions,
+                                        vkResources->GetPresentTiming().presentCount + 1, desiredPresentTime);
+    vkResources->GetPresentTiming().presentWait += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - presentStart).count();
+    UpdatePresentTiming(surface, vkResources, damagedPixels);
+
+    std::vector<uint32_t> &imagePresentCounts = vkResources->GetImagePresentCounts();
+    if(imageIndex < imagePresentCounts.size()) {
+        imagePresentCounts[imageIndex] = vkResources->GetPresentTiming().presentCount;
+    }
 
+    if(res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR) {
         return EGL_FALSE;
     }
 
     return EGL_TRUE;
 }
 
+EGLint
+VulkanWindowInterface::GetBufferAge(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    if(surface->GetType() != EGL_WINDOW_BIT || vkResources == nullptr) {
+        return 0;
+    }
+
+    // an image that has not been presented since the swapchain was created has undefined contents
+    const std::vector<uint32_t> &imagePresentCounts = vkResources->GetImagePresentCounts();
+    uint32_t imageIndex = surface->GetCurrentImageIndex();
+    if(imageIndex >= imagePresentCounts.size() || imagePresentCounts[imageIndex] == 0) {
+        return 0;
+    }
+
+    return static_cast<EGLint>(vkResources->GetPresentTiming().presentCount - imagePresentCounts[imageIndex] + 1);
+}
+
+uint64_t
+VulkanWindowInterface::GetPresentRegions(EGLSurface_t *surface, const EGLint *rects, EGLint nRects, std::vector<VkRectLayerKHR> &regions)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    const EGLSurfaceInterface *surfaceInterface = surface->GetEGLSurfaceInterface();
+    EGLint width  = surface->GetWidth();
+    EGLint height = surface->GetHeight();
+
+    // with EGL_KHR_partial_update only the damage region has been rendered
+    uint64_t renderedPixels = surfaceInterface->damageEnabled ?
+                              static_cast<uint64_t>(surfaceInterface->damageWidth) * surfaceInterface->damageHeight :
+                              static_cast<uint64_t>(width) * height;
+    if(rects == nullptr || nRects <= 0) {
+        return renderedPixels;
+    }
+
+    // EGL rectangles are clipped to the surface and their origin is flipped from the lower to the upper left
+    uint64_t damagedPixels = 0;
+    for(EGLint i = 0; i < nRects; ++i) {
+        const EGLint *rect = &rects[4 * i];
+        EGLint left   = std::max(rect[0], 0);
+        EGLint bottom = std::max(rect[1], 0);
+        EGLint right  = std::min(rect[0] + rect[2], width);
+        EGLint top    = std::min(rect[1] + rect[3], height);
+        if(left >= right || bottom >= top) {
+            continue;
+        }
+
+        VkRectLayerKHR region;
+        region.offset = { left, height - top };
+        region.extent = { static_cast<uint32_t>(right - left), static_cast<uint32_t>(top - bottom) };
+        region.layer  = 0;
+        regions.push_back(region);
+
+        damagedPixels += static_cast<uint64_t>(region.extent.width) * region.extent.height;
+    }
+
+    return std::min(damagedPixels, renderedPixels);
+}
+
+uint64_t
+VulkanWindowInterface::PacePresent(EGLSurface_t *surface, VulkanResources *vkResources)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // FIFO presents at most once per vertical blank, so longer swap intervals hold the present back until the
+    // previous image has been displayed for the remaining refreshes; half a refresh is left for the snap to the blank
+    const VulkanResources::presentTiming_t &timing = vkResources->GetPresentTiming();
+    EGLint interval = surface->GetSwapInterval();
+    if(interval <= 1 || timing.presentCount == 0) {
+        return 0;
+    }
+
+    std::chrono::duration<double, std::milli> delay((interval - 0.5) * timing.refreshPeriod);
+    std::chrono::steady_clock::time_point presentTime = timing.lastPresent + std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay);
+
+    // VK_GOOGLE_display_timing takes the time in nanoseconds of the monotonic clock, which steady_clock is based on;
+    // the presentation engine then holds the image back and the caller is not put to sleep
+    if(mVkInterface->vkDisplayTimingSupported && timing.refreshQueried) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(presentTime.time_since_epoch()).count());
+    }
+
+    std::this_thread::sleep_until(presentTime);
+
+    return 0;
+}
+
+void
+VulkanWindowInterface::UpdatePresentTiming(EGLSurface_t *surface, VulkanResources *vkResources, uint64_t damagedPixels)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VulkanResources::presentTiming_t &timing = vkResources->GetPresentTiming();
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if(timing.presentCount > 0) {
+        double interval = std::chrono::duration<double, std::milli>(now - timing.lastPresent).count();
+        timing.presentInterval = timing.presentCount > 1 ? 0.9 * timing.presentInterval + 0.1 * interval : interval;
+
+        // at a swap interval of 1 the frames that blocked on the presentation engine are throttled to the refresh
+        // rate of the display, the rest are bound by the application and say nothing about the display
+        if(!timing.refreshQueried && surface->GetSwapInterval() == 1 && timing.presentWait >= EGL_PRESENT_BOUND_WAIT) {
+            timing.refreshPeriod = timing.refreshSamples > 0 ? 0.9 * timing.refreshPeriod + 0.1 * interval : interval;
+            ++timing.refreshSamples;
+        }
+    }
+    timing.presentWait = 0.0;
+    timing.lastPresent = now;
+    ++timing.presentCount;
+    surface->SetPresentInterval(timing.presentInterval);
+
+    // the share of the surface that damage regions kept the client API and the presentation engine from updating
+    uint64_t surfacePixels = static_cast<uint64_t>(surface->GetWidth()) * surface->GetHeight();
+    surface->AddUndamagedPixels(surfacePixels - std::min(damagedPixels, surfacePixels));
+    timing.surfacePixels += surfacePixels;
+    timing.damagedPixels += damagedPixels;
+
+    if(mPresentStats && timing.presentCount % EGL_PRESENT_STATS_PERIOD == 0) {
+        double damageSaved = timing.surfacePixels ? 100.0 * (1.0 - static_cast<double>(timing.damagedPixels) / timing.surfacePixels) : 0.0;
+        EGLLogger::Log(EGL_LOG_INFO, "surface %p: present-to-present %.2f ms, refresh period %.2f ms, swap interval %d, %u swapchain images, %.1f%% of pixels undamaged",
+                       static_cast<void *>(surface), timing.presentInterval, timing.refreshPeriod, surface->GetSwapInterval(),
+                       vkResources->GetSwapchainImageCount(), damageSaved);
+        timing.surfacePixels = 0;
+        timing.damagedPixels = 0;
+    }
+}
+
 EGLBoolean
 VulkanWindowInterface::Initialize()
 {
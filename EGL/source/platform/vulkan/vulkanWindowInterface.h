@@ -41,6 +41,7 @@ private:
     VulkanAPI                   *mVkAPI;
     VulkanWSI                   *mVkWSI;
     vkInterface_t *              mVkInterface;
+    bool                         mPresentStats;
 
     const VkFormat               mVkDefaultFormat = VK_FORMAT_B8G8R8A8_UNORM;
 
@@ -53,8 +54,22 @@ private:
     void                         DestroySwapchain(EGLSurface_t *surface);
 
     VkPresentModeKHR             SetSwapchainPresentMode(EGLSurface_t* surface);
+    uint32_t                     GetSwapchainImageCount(VkPresentModeKHR swapchainPresentMode, const VkSurfaceCapabilitiesKHR &surfCapabilities);
+    uint64_t                     PacePresent(EGLSurface_t *surface, VulkanResources *vkResources);
+    void                         UpdatePresentTiming(EGLSurface_t *surface, VulkanResources *vkResources, uint64_t damagedPixels);
+    uint64_t                     GetPresentRegions(EGLSurface_t *surface, const EGLint *rects, EGLint nRects, std::vector<VkRectLayerKHR> &regions);
     void                         SetSurfaceColorFormat(EGLSurface_t *surface);
 
+    void                         CreateSwapchainSemaphores(VulkanResources *vkResources);
+    void                         DestroySwapchainSemaphores(EGLSurface_t *surface, VulkanResources *vkResources);
+    void                         ReleaseAcquireSemaphore(EGLSurface_t *surface, VkSemaphore semaphore);
+    void                         ReleasePresentSemaphore(EGLSurface_t *surface, VkSemaphore semaphore);
+    void                         ReleaseRetiredSwapchains(VulkanResources *vkResources, bool wait);
+
+    void                         AllocatePbufferImage(EGLSurface_t *surface);
+    void                         DestroyPbufferImage(EGLSurface_t *surface);
+    void                         SetPbufferColorFormat(EGLSurface_t *surface);
+
     void                         CreateVkSwapchain(EGLSurface_t* surface,
                                                    VkPresentModeKHR swapchainPresentMode,
                                                    VkExtent2D swapChainExtent,
@@ -68,10 +83,13 @@ public:
     EGLBoolean                   Terminate() override;
     EGLBoolean                   CreateSurface(EGLDisplay_t* dpy, EGLNativeWindowType win, EGLSurface_t *surface) override;
     void                         AllocateSurfaceImages(EGLSurface_t *surface) override;
+    void                         RecreateSurfaceImages(EGLSurface_t *surface) override;
+    bool                         SwapIntervalRequiresRecreation(EGLSurface_t *surface) override;
     void                         DestroySurfaceImages(EGLSurface_t *surface) override;
     void                         DestroySurface(EGLSurface_t *surface) override;
-    EGLBoolean                   AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex) override;
-    EGLBoolean                   PresentImage(EGLSurface_t *surface) override;
+    acquireResult_t              AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex) override;
+    EGLBoolean                   PresentImage(EGLSurface_t *surface, const EGLint *rects, EGLint nRects) override;
+    EGLint                       GetBufferAge(EGLSurface_t *surface) override;
 
     /// Set Functions
     inline void                  SetWSI(VulkanWSI *vkWSI)                       { mVkWSI = vkWSI; }
@@ -26,6 +26,7 @@
 #include "display/displayDriver.h"
 #include "utils/eglLogger.h"
 #include "api/eglGlobalResourceManager.h"
+#include <mutex>
 
 const char * const RenderingThread::EGLErrors[] = {   "EGL_SUCCESS",
                                                       "EGL_NOT_INITIALIZED",
@@ -44,7 +45,7 @@ const char * const RenderingThread::EGLErrors[] = {   "EGL_SUCCESS",
                                                       "EGL_CONTEXT_LOST"};
 
 RenderingThread::RenderingThread()
-: mCurrentAPI(EGL_OPENGL_ES_API), mLastError(EGL_SUCCESS)
+: mCurrentAPI(EGL_OPENGL_ES_API), mGLESCurrentContext(nullptr), mVGCurrentContext(nullptr), mLastError(EGL_SUCCESS)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 }
@@ -154,12 +155,40 @@ RenderingThread::UpdateCurrentContextResourcesRef(EGLContext_t *eglContext, bool
 
     if(eglContext->GetDrawSurface()) {
         eglContext->GetDrawSurface()->UpdateRef(incrementCounters);
+        UpdateSurfaceCurrentContext(eglContext->GetDrawSurface(), eglContext, incrementCounters);
     }
     if(eglContext->GetReadSurface()) {
         eglContext->GetReadSurface()->UpdateRef(incrementCounters);
+        UpdateSurfaceCurrentContext(eglContext->GetReadSurface(), eglContext, incrementCounters);
     }
 }
 
+void
+RenderingThread::UpdateSurfaceCurrentContext(EGLSurface_t *eglSurface, EGLContext_t *eglContext, bool bind)
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+
+    if(bind) {
+        eglSurface->SetCurrentContext(eglContext);
+    } else if(eglSurface->GetCurrentContext() == eglContext) {
+        eglSurface->SetCurrentContext(nullptr);
+    }
+}
+
+bool
+RenderingThread::IsSurfaceCurrentToOtherThread(EGLSurface_t *eglSurface)
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+
+    if(eglSurface == EGL_NO_SURFACE) {
+        return false;
+    }
+
+    // a surface keeps its context only while that context is current, so any context other than ours is current to another thread
+    EGLContext_t *surfaceContext = eglSurface->GetCurrentContext();
+    return surfaceContext != nullptr && surfaceContext != GetCurrentContext();
+}
+
 EGLSurface
 RenderingThread::GetCurrentSurface(EGLint readdraw)
 {
@@ -202,7 +231,7 @@ RenderingThread::CreateContext(DisplayDriver* eglDriver, EGLConfig_t* eglConfig,
         return EGL_NO_CONTEXT;
     }
 
-    return eglDriver->CreateContext(mCurrentAPI, eglConfig, attrib_list);
+    return eglDriver->CreateContext(mCurrentAPI, eglConfig, eglShareContext, attrib_list);
 }
 
 EGLBoolean
@@ -220,10 +249,15 @@ RenderingThread::DestroyContext(DisplayDriver* eglDriver, EGLContext_t* eglConte
 
     // delete if not current to any thread
     if(eglContext->FreeForDeletion()) {
+        // the current context of other threads is not touched, as it is not free for deletion
+        bool isCurrent = GetCurrentContext() == eglContext;
+
         result = eglDriver->DestroyContext(eglContext);
 
         // reset the current context for the rendering API
-        SetCurrentContext(renderingAPI, nullptr);
+        if(isCurrent) {
+            SetCurrentContext(renderingAPI, nullptr);
+        }
     }
 
     return result;
@@ -291,8 +325,18 @@ RenderingThread::ValidateCurrentContext(DisplayDriver* eglDriver, EGLSurface_t*
         return EGL_FALSE;
     }
 
-    // TODO:: If ctx is current to some other thread, or if either draw or read are bound to
-    // contexts in another thread, an EGL_BAD_ACCESS error is generated.
+    // generate EGL_BAD_ACCESS if ctx is current to some other thread
+    if(eglContext != EGL_NO_CONTEXT && eglContext->IsCurrent() && eglContext != GetCurrentContext()) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
+        return EGL_FALSE;
+    }
+
+    // generate EGL_BAD_ACCESS if either draw or read are bound to contexts in another thread,
+    // surfaces are bound and released under the display lock held by MakeCurrent
+    if(IsSurfaceCurrentToOtherThread(drawSurface) || IsSurfaceCurrentToOtherThread(readSurface)) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
+        return EGL_FALSE;
+    }
 
     // TODO:: If binding ctx would exceed the number of current contexts of that client
     // API type supported by the implementation, an EGL_BAD_ACCESS error is generated
@@ -321,6 +365,13 @@ RenderingThread::MakeCurrent(DisplayDriver* eglDriver, EGLDisplay_t* dpy, EGLSur
     EGLContext_t* eglContext = static_cast<EGLContext_t*>(ctx);
     EGLSurface_t *eglDrawSurface = static_cast<EGLSurface_t*>(draw);
     EGLSurface_t *eglReadSurface = static_cast<EGLSurface_t*>(read);
+
+    // contexts are claimed under the display lock, so that a context can be current to a single thread only
+    std::unique_lock<std::recursive_mutex> lock;
+    if(eglDriver != nullptr) {
+        lock = std::unique_lock<std::recursive_mutex>(eglDriver->GetMutex());
+    }
+
     if(ValidateCurrentContext(eglDriver, eglDrawSurface, eglReadSurface, eglContext) == EGL_FALSE) {
         return EGL_FALSE;
     }
@@ -347,10 +398,10 @@ RenderingThread::MakeCurrent(DisplayDriver* eglDriver, EGLDisplay_t* dpy, EGLSur
     currentContext = GetCurrentContext();
     UpdateCurrentContextResourcesRef(currentContext, true);
 
-    eglDriver->SetActiveContext(currentContext);
-
     // clean any marked resources that may have been released after the current call to MakeCurrent
-    eglDriver->CleanMarkedResources();
+    if(eglDriver != nullptr) {
+        eglDriver->CleanMarkedResources();
+    }
 
     return EGL_TRUE;
 }
@@ -41,6 +41,8 @@ private:
     void                    SetCurrentContext(EGLenum renderingAPI, EGLContext_t* eglContext);
     EGLBoolean              ValidateCurrentContext(class DisplayDriver* eglDriver, class EGLSurface_t* drawSurface, class EGLSurface_t* readSurface, EGLContext_t* eglContext);
     void                    UpdateCurrentContextResourcesRef(EGLContext_t *eglContext, bool incrementCounters);
+    void                    UpdateSurfaceCurrentContext(class EGLSurface_t *eglSurface, EGLContext_t *eglContext, bool bind);
+    bool                    IsSurfaceCurrentToOtherThread(class EGLSurface_t *eglSurface);
 
 public:
     RenderingThread(void);
@@ -64,6 +66,6 @@ public:
     EGLBoolean              WaitNative(EGLint engine);
 };
 
-extern RenderingThread currentThread;
+extern thread_local RenderingThread currentThread;
 
 #endif // __RENDERINGTHREAD_H__
@@ -34,6 +34,7 @@
     #include "simpleLoggerImpl.h"
 #endif //VK_USE_PLATFORM_ANDROID_KHR
 #include <string.h>
+#include <stdarg.h>
 
 EGLLogger *EGLLogger::mInstance = nullptr;
 EGLLoggerImpl *EGLLogger::mLoggerImpl = nullptr;
@@ -82,6 +83,7 @@ EGLLogger::DestroyInstance()
 
     if(mLoggerImpl) {
         delete mLoggerImpl;
+        mLoggerImpl = nullptr;
     }
 }
 
@@ -113,8 +115,16 @@ EGLLogger::FunEntry(eglLogLevel_e level, const char* filename, const char *func,
 }
 
 void
-EGLLogger::Log(eglLogLevel_e level, const char* log)
+EGLLogger::Log(eglLogLevel_e level, const char *format, ...)
 {
+    char log[200];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(log, 200, format, args);
+    va_end(args);
+
+    // the logger may be used before any function entry has been traced
+    EGLLogger::GetInstance();
     mLoggerImpl->WriteLog(level, log);
 }
 
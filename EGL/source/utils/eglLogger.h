@@ -71,7 +71,7 @@ private:
 public:
     static void           Shutdown();
     static void           FunEntry(eglLogLevel_e level, const char* filename, const char *func, int line);
-    static void           Log(eglLogLevel_e level, const char* log);
+    static void           Log(eglLogLevel_e level, const char *format, ...);
 };
 
 #endif //__EGLLOGGER_H__
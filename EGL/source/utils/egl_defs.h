@@ -37,6 +37,13 @@
 
 #define EGL_FENCE_WAIT_TIMEOUT                         UINT64_MAX
 
+// Environment variables for tuning presentation
+#define EGL_SWAPCHAIN_IMAGE_COUNT_ENV                  "GLOVE_SWAPCHAIN_IMAGE_COUNT"
+#define EGL_PRESENT_STATS_ENV                          "GLOVE_PRESENT_STATS"
+#define EGL_PRESENT_STATS_PERIOD                       256
+// a frame that blocked at least this long (ms) in acquire and present was paced by the display
+#define EGL_PRESENT_BOUND_WAIT                         1.0
+
 #ifndef EGL_SUPPORT_ONLY_PBUFFER_SURFACE
 #   define EGL_SUPPORT_ONLY_PBUFFER_SURFACE            0
 #else
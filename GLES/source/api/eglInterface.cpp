@@ -30,7 +30,7 @@ static api_state_t    gles2_state = nullptr;
 
 api_state_t           init_API();
           void        terminate_API();
-api_context_t         create_context();
+api_context_t         create_context(bool no_error, api_context_t share_context);
 void                  set_read_write_surface(api_context_t api_context, EGLSurfaceInterface *eglReadSurfaceInterface, EGLSurfaceInterface *eglWriteSurfaceInterface);
 void                  delete_shared_surface_data(EGLSurfaceInterface *eglSurfaceInterface);
 void                  delete_context(api_context_t api_context);
@@ -38,9 +38,12 @@ void                  release_system_fbo(api_context_t api_context);
 GLPROC                get_proc_addr(const char* procname);
 void                  flush(api_context_t api_context);
 void                  finish(api_context_t api_context);
-void                  bind_to_texture(api_context_t api_context, uint32_t bind);
+void                  bind_to_texture(api_context_t api_context, EGLSurfaceInterface *eglSurfaceInterface, uint32_t bind);
+bool                  insert_fence(api_context_t api_context, VkFence fence);
+void                  wait_fence(api_context_t api_context);
 
 static void           FillInVkInterface(vulkanAPI::vkContext_t* vkContext);
+static void           LockVkQueue(bool lock);
 
 rendering_api_interface_t GLES2Interface = {
     gles2_state,
@@ -54,7 +57,9 @@ rendering_api_interface_t GLES2Interface = {
     get_proc_addr,
     flush,
     finish,
-    bind_to_texture
+    bind_to_texture,
+    insert_fence,
+    wait_fence
 };
 
 #ifdef WIN32
@@ -72,7 +77,21 @@ static void FillInVkInterface(vulkanAPI::vkContext_t* vkContext)
     vkInterface.vkGraphicsQueueNodeIndex = vkContext->vkGraphicsQueueNodeIndex;
     vkInterface.vkDeviceMemoryProperties = vkContext->vkDeviceMemoryProperties;
     vkInterface.vkDevice = vkContext->vkDevice;
-    vkInterface.vkSyncItems = vkContext->vkSyncItems;
+    vkInterface.vkLockQueue = LockVkQueue;
+    vkInterface.vkWSISupported = vkContext->mIsWSIExtSupported;
+    vkInterface.vkIncrementalPresentSupported = vkContext->mIsIncrementalPresentExtSupported;
+    vkInterface.vkDisplayTimingSupported = vkContext->mIsDisplayTimingExtSupported;
+}
+
+static void LockVkQueue(bool lock)
+{
+    vulkanAPI::vkContext_t *vkContext = vulkanAPI::GetContext();
+
+    if(lock) {
+        vkContext->vkQueueMutex.lock();
+    } else {
+        vkContext->vkQueueMutex.unlock();
+    }
 }
 
 api_state_t init_API()
@@ -94,11 +113,11 @@ void terminate_API()
     GLLogger::Shutdown();
 }
 
-api_context_t create_context()
+api_context_t create_context(bool no_error, api_context_t share_context)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    Context *ctx = new Context();
+    Context *ctx = new Context(no_error, reinterpret_cast<Context *>(share_context));
     return ctx;
 }
 
@@ -158,10 +177,26 @@ void finish(api_context_t api_context)
     ctx->Finish();
 }
 
-void bind_to_texture(api_context_t api_context, uint32_t bind)
+void bind_to_texture(api_context_t api_context, EGLSurfaceInterface *eglSurfaceInterface, uint32_t bind)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Context *ctx = reinterpret_cast<Context *>(api_context);
+    ctx->BindTexImage(eglSurfaceInterface, bind != 0);
+}
+
+bool insert_fence(api_context_t api_context, VkFence fence)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Context *ctx = reinterpret_cast<Context *>(api_context);
+    return ctx->InsertFence(fence);
+}
+
+void wait_fence(api_context_t api_context)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     Context *ctx = reinterpret_cast<Context *>(api_context);
-    ctx->BindToTexture(bind);
+    ctx->WaitFence();
 }
@@ -924,3 +924,111 @@ void GL_APIENTRY glProgramBinaryOES(GLuint program, GLenum binaryFormat, const v
 {
     CONTEXT_EXEC(ProgramBinaryOES(program, binaryFormat, binary, length));
 }
+
+void GL_APIENTRY
+glBindVertexArrayOES(GLuint array)
+{
+    CONTEXT_EXEC(BindVertexArrayOES(array));
+}
+
+void GL_APIENTRY
+glDeleteVertexArraysOES(GLsizei n, const GLuint *arrays)
+{
+    CONTEXT_EXEC(DeleteVertexArraysOES(n, arrays));
+}
+
+void GL_APIENTRY
+glGenVertexArraysOES(GLsizei n, GLuint *arrays)
+{
+    CONTEXT_EXEC(GenVertexArraysOES(n, arrays));
+}
+
+GLboolean GL_APIENTRY
+glIsVertexArrayOES(GLuint array)
+{
+    CONTEXT_EXEC_RETURN(IsVertexArrayOES(array));
+}
+
+void GL_APIENTRY
+glDrawArraysInstancedEXT(GLenum mode, GLint first, GLsizei count, GLsizei primcount)
+{
+    CONTEXT_EXEC(DrawArraysInstancedEXT(mode, first, count, primcount));
+}
+
+void GL_APIENTRY
+glDrawElementsInstancedEXT(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei primcount)
+{
+    CONTEXT_EXEC(DrawElementsInstancedEXT(mode, count, type, indices, primcount));
+}
+
+void GL_APIENTRY
+glVertexAttribDivisorEXT(GLuint index, GLuint divisor)
+{
+    CONTEXT_EXEC(VertexAttribDivisorEXT(index, divisor));
+}
+
+void GL_APIENTRY
+glDrawArraysInstancedANGLE(GLenum mode, GLint first, GLsizei count, GLsizei primcount)
+{
+    CONTEXT_EXEC(DrawArraysInstancedEXT(mode, first, count, primcount));
+}
+
+void GL_APIENTRY
+glDrawElementsInstancedANGLE(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei primcount)
+{
+    CONTEXT_EXEC(DrawElementsInstancedEXT(mode, count, type, indices, primcount));
+}
+
+void GL_APIENTRY
+glVertexAttribDivisorANGLE(GLuint index, GLuint divisor)
+{
+    CONTEXT_EXEC(VertexAttribDivisorEXT(index, divisor));
+}
+
+void * GL_APIENTRY
+glMapBufferOES(GLenum target, GLenum access)
+{
+    CONTEXT_EXEC_RETURN(MapBufferOES(target, access));
+}
+
+GLboolean GL_APIENTRY
+glUnmapBufferOES(GLenum target)
+{
+    CONTEXT_EXEC_RETURN(UnmapBufferOES(target));
+}
+
+void GL_APIENTRY
+glGetBufferPointervOES(GLenum target, GLenum pname, void **params)
+{
+    CONTEXT_EXEC(GetBufferPointervOES(target, pname, params));
+}
+
+void * GL_APIENTRY
+glMapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    CONTEXT_EXEC_RETURN(MapBufferRangeEXT(target, offset, length, access));
+}
+
+void GL_APIENTRY
+glFlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    CONTEXT_EXEC(FlushMappedBufferRangeEXT(target, offset, length));
+}
+
+void GL_APIENTRY
+glMultiDrawArraysEXT(GLenum mode, const GLint *first, const GLsizei *count, GLsizei primcount)
+{
+    CONTEXT_EXEC(MultiDrawArraysEXT(mode, first, count, primcount));
+}
+
+void GL_APIENTRY
+glMultiDrawElementsEXT(GLenum mode, const GLsizei *count, GLenum type, const void *const *indices, GLsizei primcount)
+{
+    CONTEXT_EXEC(MultiDrawElementsEXT(mode, count, type, indices, primcount));
+}
+
+void GL_APIENTRY
+glTexStorage2DEXT(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    CONTEXT_EXEC(TexStorage2DEXT(target, levels, internalformat, width, height));
+}
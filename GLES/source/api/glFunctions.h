@@ -185,6 +185,40 @@ GL_FUNC_PTR(glPopGroupMarkerEXT)
 ,GL_FUNC_PTR(glGetProgramBinaryOES),
 GL_FUNC_PTR(glProgramBinaryOES)
 #endif /* GL_OES_get_program_binary */
+#ifdef GL_OES_vertex_array_object
+,GL_FUNC_PTR(glBindVertexArrayOES),
+GL_FUNC_PTR(glDeleteVertexArraysOES),
+GL_FUNC_PTR(glGenVertexArraysOES),
+GL_FUNC_PTR(glIsVertexArrayOES)
+#endif // GL_OES_vertex_array_object
+#ifdef GL_EXT_draw_instanced
+,GL_FUNC_PTR(glDrawArraysInstancedEXT),
+GL_FUNC_PTR(glDrawElementsInstancedEXT)
+#endif // GL_EXT_draw_instanced
+#ifdef GL_EXT_instanced_arrays
+,GL_FUNC_PTR(glVertexAttribDivisorEXT)
+#endif // GL_EXT_instanced_arrays
+#ifdef GL_ANGLE_instanced_arrays
+,GL_FUNC_PTR(glDrawArraysInstancedANGLE),
+GL_FUNC_PTR(glDrawElementsInstancedANGLE),
+GL_FUNC_PTR(glVertexAttribDivisorANGLE)
+#endif // GL_ANGLE_instanced_arrays
+#ifdef GL_OES_mapbuffer
+,GL_FUNC_PTR(glMapBufferOES),
+GL_FUNC_PTR(glUnmapBufferOES),
+GL_FUNC_PTR(glGetBufferPointervOES)
+#endif // GL_OES_mapbuffer
+#ifdef GL_EXT_map_buffer_range
+,GL_FUNC_PTR(glMapBufferRangeEXT),
+GL_FUNC_PTR(glFlushMappedBufferRangeEXT)
+#endif // GL_EXT_map_buffer_range
+#ifdef GL_EXT_multi_draw_arrays
+,GL_FUNC_PTR(glMultiDrawArraysEXT),
+GL_FUNC_PTR(glMultiDrawElementsEXT)
+#endif // GL_EXT_multi_draw_arrays
+#ifdef GL_EXT_texture_storage
+,GL_FUNC_PTR(glTexStorage2DEXT)
+#endif // GL_EXT_texture_storage
 };
 #undef GL_FUNC_PTR
 
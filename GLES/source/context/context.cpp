@@ -23,8 +23,10 @@
 
 #include "context.h"
 #include "utils/VkToGlConverter.h"
+#include <algorithm>
 
-static Context *currentContext = nullptr;
+// each rendering thread has its own current context
+static thread_local Context *currentContext = nullptr;
 
 Context *GetCurrentContext()
 {
@@ -40,17 +42,17 @@ void SetCurrentContext(Context *ctx)
     currentContext = ctx;
 }
 
-Context::Context()
+Context::Context(bool noError, Context *shareContext)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
     mVkContext            = vulkanAPI::GetContext();
     mCommandBufferManager = new vulkanAPI::CommandBufferManager(mVkContext);
 
-    mResourceManager = new ResourceManager(mVkContext);
-    mShaderCompiler  = new GlslangShaderCompiler();
+    mResourceManager = new ResourceManager(mVkContext, shareContext ? shareContext->GetResourceManager() : nullptr);
     mPipeline        = new vulkanAPI::Pipeline(mVkContext);
     mCacheManager    = new CacheManager(mVkContext);
+    mVertexInputCache = new vulkanAPI::VertexInputCache();
 
     mStateManager.InitVkPipelineStates(mPipeline);
 
@@ -58,18 +60,24 @@ Context::Context()
 
     mPipeline->SetCacheManager(mCacheManager);
     mResourceManager->SetCacheManager(mCacheManager);
+    mStateManager.GetActiveObjectsState()->SetActiveVertexArray(mResourceManager->GetDefaultVertexArray());
 
     mWriteSurface = nullptr;
     mReadSurface  = nullptr;
     mWriteFBO     = nullptr;
     mSystemFBO    = nullptr;
 
+    mIndirectBuffer             = nullptr;
+    mIndirectBufferOffset       = 0;
+
     //If VK_KHR_maintenance1 is supported, then there is no need to invert the Y
     mIsYInverted        = !(vulkanAPI::GetContext()->mIsMaintenanceExtSupported);
     mIsModeLineLoop     = false;
+    mNoError            = noError;
 
     mScreenSpacePass = new ScreenSpacePass(mVkContext);
     mScreenSpacePass->SetCacheManager(mCacheManager);
+    mScreenSpacePass->SetRetireList(mResourceManager->GetRetireList());
     mStateManager.InitVkPipelineStates(mScreenSpacePass->GetPipeline());
 }
 
@@ -79,24 +87,26 @@ Context::~Context()
 
     ReleaseSystemFBO();
 
-    if(mShaderCompiler != nullptr) {
-        delete mShaderCompiler;
-        mShaderCompiler = nullptr;
+    if(mIndirectBuffer != nullptr) {
+        delete mIndirectBuffer;
+        mIndirectBuffer = nullptr;
+    }
+
+    // the screen space pass retires its buffers to the share group, which may be deleted along with the resource manager
+    if(mScreenSpacePass != nullptr) {
+        delete mScreenSpacePass;
+        mScreenSpacePass = nullptr;
     }
 
     delete mResourceManager;
     delete mCacheManager;
+    delete mVertexInputCache;
 
     if(mPipeline != nullptr) {
         delete mPipeline;
         mPipeline = nullptr;
     }
 
-    if(mScreenSpacePass != nullptr) {
-        delete mScreenSpacePass;
-        mScreenSpacePass = nullptr;
-    }
-
     delete mCommandBufferManager;
 }
 
@@ -145,13 +155,13 @@ Context::CreateFBOFromEGLSurface(EGLSurfaceInterface *eglSurfaceInterface)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    // TODO: Pbuffer/pixmaps are not properly supported
-    assert(eglSurfaceInterface->type == EGL_WINDOW_BIT);
+    // TODO: Pixmaps are not properly supported
+    assert(eglSurfaceInterface->type == EGL_WINDOW_BIT || eglSurfaceInterface->type == EGL_PBUFFER_BIT);
 
     Framebuffer *fbo = InitializeFrameBuffer(eglSurfaceInterface);
-    fbo->CreateVkRenderPass(false, false, false, true, true, false);
+    fbo->CreateVkRenderPass(false, false, false, true, true, false, false);
     fbo->Create();
-    fbo->SetSurfaceType(GLOVE_SURFACE_WINDOW);
+    fbo->SetSurfaceType(eglSurfaceInterface->type == EGL_PBUFFER_BIT ? GLOVE_SURFACE_PBUFFER : GLOVE_SURFACE_WINDOW);
 
     return fbo;
 }
@@ -166,31 +176,7 @@ Context::InitializeFrameBuffer(EGLSurfaceInterface *eglSurfaceInterface)
 
     // color images
     for(uint32_t i = 0; i < eglSurfaceInterface->imageCount; ++i) {
-        Texture *tex = new Texture(mVkContext);
-
-        VkFormat surfaceColorFormat = static_cast<VkFormat>(eglSurfaceInterface->surfaceColorFormat);
-        GLenum glformat = VkFormatToGlInternalformat(surfaceColorFormat);
-        GLenum glType = GlInternalFormatToGlType(glformat);
-
-        tex->SetTarget(GL_TEXTURE_2D);
-        tex->SetWidth(eglSurfaceInterface->width);
-        tex->SetHeight(eglSurfaceInterface->height);
-        tex->SetInternalFormat(glformat);
-        tex->SetExplicitInternalFormat(glformat);
-        tex->SetFormat(GlInternalFormatToGlFormat(glformat));
-        tex->SetType(glType);
-        tex->SetExplicitType(glType);
-
-        tex->SetVkFormat(surfaceColorFormat);
-        tex->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT));
-        tex->SetVkImageTiling();
-        tex->SetVkImageTarget(vulkanAPI::Image::VK_IMAGE_TARGET_2D);
-        tex->SetVkImage(vkImages[i]);
-        tex->CreateVkImageSubResourceRange();
-        tex->CreateVkImageView();
-        
-        fbo->AddColorAttachment(tex);
-        mSystemTextures.push_back(tex);
+        fbo->AddColorAttachment(CreateSurfaceColorTexture(eglSurfaceInterface, vkImages[i]));
     }
 
     // depth/stencil images
@@ -203,6 +189,37 @@ Context::InitializeFrameBuffer(EGLSurfaceInterface *eglSurfaceInterface)
     return fbo;
 }
 
+Texture *
+Context::CreateSurfaceColorTexture(EGLSurfaceInterface *eglSurfaceInterface, VkImage vkImage)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Texture *tex = new Texture(mVkContext);
+
+    VkFormat surfaceColorFormat = static_cast<VkFormat>(eglSurfaceInterface->surfaceColorFormat);
+    GLenum glformat = VkFormatToGlInternalformat(surfaceColorFormat);
+    GLenum glType = GlInternalFormatToGlType(glformat);
+
+    tex->SetTarget(GL_TEXTURE_2D);
+    tex->SetWidth(eglSurfaceInterface->width);
+    tex->SetHeight(eglSurfaceInterface->height);
+    tex->SetInternalFormat(glformat);
+    tex->SetExplicitInternalFormat(glformat);
+    tex->SetFormat(GlInternalFormatToGlFormat(glformat));
+    tex->SetType(glType);
+    tex->SetExplicitType(glType);
+
+    tex->SetVkFormat(surfaceColorFormat);
+    tex->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
+    tex->SetVkImageTiling();
+    tex->SetVkImageTarget(vulkanAPI::Image::VK_IMAGE_TARGET_2D);
+    tex->SetVkImage(vkImage);
+    tex->CreateVkImageSubResourceRange();
+    tex->CreateVkImageView();
+
+    mSystemTextures.push_back(tex);
+    return tex;
+}
 
 Texture *
 Context::CreateDepthStencil(EGLSurfaceInterface *eglSurfaceInterface)
@@ -249,6 +266,95 @@ Context::CreateDepthStencil(EGLSurfaceInterface *eglSurfaceInterface)
     return tex;
 }
 
+bool
+Context::IsSystemFBOOutdated(const Framebuffer *fbo, const EGLSurfaceInterface *eglSurfaceInterface) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(eglSurfaceInterface->width  != static_cast<uint32_t>(fbo->GetWidth())  ||
+       eglSurfaceInterface->height != static_cast<uint32_t>(fbo->GetHeight()) ||
+       eglSurfaceInterface->imageCount != fbo->GetColorAttachmentCount()) {
+        return true;
+    }
+
+    // a recreated swapchain may keep the size of the old one, but not its images
+    const VkImage *vkImages = static_cast<const VkImage *>(eglSurfaceInterface->images);
+    for(uint32_t i = 0; i < eglSurfaceInterface->imageCount; ++i) {
+        if(fbo->GetColorAttachmentTexture(i)->GetImage()->GetImage() != vkImages[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+Context::UpdateSystemFBO(Framebuffer *fbo, EGLSurfaceInterface *eglSurfaceInterface)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the old images may still be referenced by submitted command buffers
+    Finish();
+
+    bool sizeUpdated = eglSurfaceInterface->width  != static_cast<uint32_t>(fbo->GetWidth()) ||
+                       eglSurfaceInterface->height != static_cast<uint32_t>(fbo->GetHeight());
+
+    for(uint32_t i = 0; i < fbo->GetColorAttachmentCount(); ++i) {
+        ReleaseSystemTexture(fbo->GetColorAttachmentTexture(i));
+    }
+
+    VkImage *vkImages = static_cast<VkImage *>(eglSurfaceInterface->images);
+    vector<Texture *> colorTextures;
+    for(uint32_t i = 0; i < eglSurfaceInterface->imageCount; ++i) {
+        colorTextures.push_back(CreateSurfaceColorTexture(eglSurfaceInterface, vkImages[i]));
+    }
+
+    // the depth buffer is shared by all contexts rendering to the surface, the first of them to be updated replaces it
+    Texture *depthStencilTexture = fbo->GetDepthStencilAttachmentTexture();
+    if(sizeUpdated) {
+        if(depthStencilTexture != nullptr) {
+            VkImage vkImage = depthStencilTexture->GetImage()->GetImage();
+            ReleaseSystemTexture(depthStencilTexture);
+            if(eglSurfaceInterface->depthBuffer == reinterpret_cast<void *>(vkImage)) {
+                vkDestroyImage(mVkContext->vkDevice, vkImage, nullptr);
+                eglSurfaceInterface->depthBuffer = 0;
+            }
+        }
+        depthStencilTexture = CreateDepthStencil(eglSurfaceInterface);
+    }
+
+    fbo->UpdateSystemAttachments(colorTextures, depthStencilTexture);
+}
+
+bool
+Context::AcquireSurfaceImage(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!mWriteFBO->AcquireSurfaceImage()) {
+        return false;
+    }
+
+    // an out of date swapchain is recreated by the acquire, before anything is rendered to its image in this frame
+    if(mWriteFBO == mSystemFBO && mWriteSurface != nullptr && IsSystemFBOOutdated(mWriteFBO, mWriteSurface)) {
+        UpdateSystemFBO(mWriteFBO, mWriteSurface);
+    }
+
+    return true;
+}
+
+void
+Context::ReleaseSystemTexture(Texture *tex)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    auto texIter = std::find(mSystemTextures.begin(), mSystemTextures.end(), tex);
+    if(texIter != mSystemTextures.end()) {
+        mSystemTextures.erase(texIter);
+    }
+    delete tex;
+}
+
 void
 Context::DestroyAPISurfaceData(const vulkanAPI::vkContext_t *vkContext,
                                EGLSurfaceInterface *eglSurfaceInterface)
@@ -263,6 +369,11 @@ Context::DestroyAPISurfaceData(const vulkanAPI::vkContext_t *vkContext,
         }
         eglSurfaceInterface->depthBuffer = 0;
     }
+
+    if(eglSurfaceInterface) {
+        vulkanAPI::DestroyVkSyncItems(eglSurfaceInterface->vkSyncItems);
+        eglSurfaceInterface->vkSyncItems = nullptr;
+    }
 }
 
 void
@@ -270,6 +381,15 @@ Context::SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLS
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    // submissions that render to the surface are chained by its own semaphores, so that
+    // contexts of different threads, or other surfaces of this context, do not interfere
+    if(eglWriteSurfaceInterface->vkSyncItems == nullptr) {
+        eglWriteSurfaceInterface->vkSyncItems = vulkanAPI::CreateVkSyncItems();
+    }
+    if(eglReadSurfaceInterface->vkSyncItems == nullptr) {
+        eglReadSurfaceInterface->vkSyncItems = vulkanAPI::CreateVkSyncItems();
+    }
+
     // TODO:: TBD as we do not take into account read surface!
     if(mWriteSurface && mWriteSurface == eglWriteSurfaceInterface->surface) {
         return;
@@ -280,20 +400,14 @@ Context::SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLS
     auto fboIter = mSystemFBOMap.find(readWritePair);
     if(fboIter != mSystemFBOMap.end()) {
         mWriteSurface = fboIter->first.first;
-        mReadSurface = fboIter->first.second;
-
-        // if surface has been invalidated, recreate the FBO (e.g., resized on another context)
-        bool surfaceUpdated =
-                (eglWriteSurfaceInterface->width != static_cast<uint32_t>(mWriteFBO->GetWidth())) ||
-                (eglWriteSurfaceInterface->height != static_cast<uint32_t>(mWriteFBO->GetHeight()));
-        if(!surfaceUpdated) {
-            mWriteFBO = fboIter->second;
-        } else {
-            ReleaseSystemFBO();
-            mWriteFBO = CreateFBOFromEGLSurface(eglWriteSurfaceInterface);
-            mSystemFBOMap[readWritePair] = mWriteFBO;
-        }
+        mReadSurface  = fboIter->first.second;
+        mWriteFBO     = fboIter->second;
 
+        // the surface images have been replaced since this context last rendered to it (e.g., resized), the FBO
+        // is kept and only its attachments are updated, so that other surfaces and caches are left intact
+        if(IsSystemFBOOutdated(mWriteFBO, eglWriteSurfaceInterface)) {
+            UpdateSystemFBO(mWriteFBO, eglWriteSurfaceInterface);
+        }
     } else {
         mWriteSurface = eglWriteSurfaceInterface;
         mReadSurface  = eglReadSurfaceInterface;
@@ -304,6 +418,43 @@ Context::SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLS
     SetSystemFramebuffer(mWriteFBO);
 }
 
+void
+Context::BindTexImage(EGLSurfaceInterface *eglSurfaceInterface, bool bind)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Framebuffer *fbo = nullptr;
+    for(auto iter : mSystemFBOMap) {
+        if(iter.first.first == eglSurfaceInterface || iter.first.second == eglSurfaceInterface) {
+            fbo = iter.second;
+            break;
+        }
+    }
+
+    // the pbuffer has not been rendered by this context, so its contents are undefined
+    if(fbo == nullptr) {
+        return;
+    }
+
+    fbo->SetBindToTexture(bind);
+    if(!bind) {
+        return;
+    }
+
+    // eglBindTexImage performs an implicit flush of the pbuffer rendering. The copy is submitted to the same queue
+    // after it and its barrier waits for the color attachment writes, so the host does not have to wait here
+    Flush();
+
+    Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(GL_TEXTURE_2D);
+    if(activeTexture->IsImmutable() || !activeTexture->UpdateFromSurfaceTexture(fbo->GetColorAttachmentTexture())) {
+        return;
+    }
+
+    if(mStateManager.GetActiveShaderProgram() != nullptr) {
+        mStateManager.GetActiveShaderProgram()->EnableUpdateOfDescriptorSets();
+    }
+}
+
 void
 Context::SetSystemFramebuffer(Framebuffer *FBO)
 {
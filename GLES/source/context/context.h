@@ -34,6 +34,7 @@
 #include "vulkan/clearPass.h"
 #include "resources/screenSpacePass.h"
 #include "vulkan/commandBufferManager.h"
+#include "vulkan/vertexInputCache.h"
 #include "rendering_api_interface.h"
 #include <utility>
 #include <map>
@@ -56,17 +57,20 @@ private:
     StateManager                                mStateManager;
     ResourceManager                            *mResourceManager;
     CacheManager                               *mCacheManager;
-    ShaderCompiler                             *mShaderCompiler;
     vulkanAPI::Pipeline                        *mPipeline;
     ScreenSpacePass                            *mScreenSpacePass;
     vulkanAPI::CommandBufferManager            *mCommandBufferManager;
+    vulkanAPI::VertexInputCache                *mVertexInputCache;
 // ------------
     bool                                        mIsYInverted;
     bool                                        mIsModeLineLoop;
+    bool                                        mNoError;
 // ------------
     EGLSurfaceInterface                        *mWriteSurface;
     EGLSurfaceInterface                        *mReadSurface;
     BufferObject                               *mExplicitIbo;
+    BufferObject                               *mIndirectBuffer;
+    size_t                                      mIndirectBufferOffset;
     Framebuffer                                *mWriteFBO;
 
     Framebuffer                                *mSystemFBO;
@@ -82,7 +86,12 @@ private:
 
     Framebuffer   *CreateFBOFromEGLSurface(EGLSurfaceInterface *eglSurfaceInterface);
     Framebuffer   *InitializeFrameBuffer(EGLSurfaceInterface *eglSurfaceInterface);
+    Texture       *CreateSurfaceColorTexture(EGLSurfaceInterface *eglSurfaceInterface, VkImage vkImage);
     Texture       *CreateDepthStencil(EGLSurfaceInterface *eglSurfaceInterface);
+    bool           IsSystemFBOOutdated(const Framebuffer *fbo, const EGLSurfaceInterface *eglSurfaceInterface) const;
+    void           UpdateSystemFBO(Framebuffer *fbo, EGLSurfaceInterface *eglSurfaceInterface);
+    bool           AcquireSurfaceImage(void);
+    void           ReleaseSystemTexture(Texture *tex);
 
     void           PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
     void           CreateShaderCompiler(void);
@@ -91,48 +100,68 @@ private:
 
     void UpdateViewportState(vulkanAPI::Pipeline* pipeline);
     void BeginRendering(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
-    void PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GLenum type, const void *indices);
-    void UpdateVertexAttributes(uint32_t vertCount, uint32_t firstVertex);
+    bool BeginGeometry(void);
+    VkCommandBuffer *RecordGeometryState(bool indexed, uint32_t indexOffset, GLenum type);
+    void SubmitGeometry(VkCommandBuffer *secondaryCmdBuffer);
+    void PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GLenum type, const void *indices, uint32_t instanceCount);
+    void PushMultiGeometry(const GLint *first, const GLsizei *count, bool indexed, GLenum type, const void *const *indices, GLsizei drawCount);
+    bool StreamIndirectCommands(const void *commands, size_t size, size_t *offset);
+    void UpdateVertexAttributes(uint32_t vertCount, uint32_t firstVertex, uint32_t instanceCount);
     void UpdateIndices(uint32_t* offset, uint32_t* maxIndex, uint32_t indexCount, GLenum type, const void* indices, BufferObject* ibo);
     void BindUniformDescriptors(VkCommandBuffer *CmdBuffer);
     void BindVertexBuffers(VkCommandBuffer *CmdBuffer);
     void BindIndexBuffer(VkCommandBuffer *CmdBuffer, uint32_t offset, VkIndexType type);
-    void DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t firstVertex, uint32_t vertCount);
+    void DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t firstVertex, uint32_t vertCount, uint32_t instanceCount);
+    void DrawIndirectGeometry(VkCommandBuffer *CmdBuffer, bool indexed, VkDeviceSize offset, uint32_t drawCount);
     void SetCapability(GLenum cap, GLboolean enable);
 
     void InitializeDefaultTextures(void);
+    void SetTextureVkFormat(Texture *texture, GLenum format, GLenum type);
 
     void SetClearRect(void);
+    bool GetSurfaceDamageRect(Rect *rect);
     bool SetPipelineProgramShaderStages(ShaderProgram *progPtr);
     void SetSystemFramebuffer(Framebuffer *FBO);
+    void SetActiveVertexArray(VertexArrayObject *vao);
+    void SetBufferObjectsUsed(bool indexed);
+    void *MapBufferObject(GLenum target, BufferObject *bo, size_t offset, size_t length, GLbitfield access);
 
 // Get Functions
            uint32_t         GetProgramId(const ShaderProgram *progPtr)           { FUN_ENTRY(GL_LOG_TRACE); return (progPtr)   ? mResourceManager->FindShaderProgramID(progPtr) : 0; }
            uint32_t         GetShaderId(const Shader *shaderPtr)                 { FUN_ENTRY(GL_LOG_TRACE); return (shaderPtr) ? mResourceManager->FindShaderID(shaderPtr)      : 0; }
+    inline GenericVertexAttribute *GetGenericVertexAttribute(GLuint index)      { FUN_ENTRY(GL_LOG_TRACE); return mStateManager.GetActiveObjectsState()->GetActiveVertexArray()->GetGenericVertexAttribute(index); }
 
 // Is/Has Functions
     inline bool             IsDrawModeTriangle(GLenum mode)                const { FUN_ENTRY(GL_LOG_TRACE); return (mode == GL_TRIANGLE_STRIP || mode  == GL_TRIANGLE_FAN || mode == GL_TRIANGLES); }
 // Other Functions
-    inline void             RecordError(GLenum error)                            { FUN_ENTRY(GL_LOG_TRACE); if (mStateManager.GetError() == GL_NO_ERROR) { mStateManager.SetError(error); } }
+    /// KHR_no_error contexts only report GL_OUT_OF_MEMORY
+    inline void             RecordError(GLenum error)                            { FUN_ENTRY(GL_LOG_TRACE); if ((!mNoError || error == GL_OUT_OF_MEMORY) &&
+                                                                                                                mStateManager.GetError() == GL_NO_ERROR) { mStateManager.SetError(error); } }
 
 public:
-    Context();
+    explicit Context(bool noError = false, Context *shareContext = nullptr);
     ~Context();
 
     static void             DestroyAPISurfaceData(const vulkanAPI::vkContext_t *vkContext, EGLSurfaceInterface *eglSurfaceInterface);
 
     void                    ReleaseSystemFBO(void);
 
+// Sync Functions
+    bool                    InsertFence(VkFence vkFence);
+    void                    WaitFence(void);
+
 // Get Functions
     inline  vulkanAPI::CommandBufferManager *GetVkCommandBufferManager(void)      { FUN_ENTRY(GL_LOG_TRACE); return mCommandBufferManager; }
+    inline  vulkanAPI::VertexInputCache *GetVertexInputCache(void)                { FUN_ENTRY(GL_LOG_TRACE); return mVertexInputCache; }
     inline  StateManager    *GetStateManager(void)                                { FUN_ENTRY(GL_LOG_TRACE); return &mStateManager; }
     inline  ResourceManager *GetResourceManager(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mResourceManager; }
+    inline  CacheManager    *GetCacheManager(void)                                { FUN_ENTRY(GL_LOG_TRACE); return mCacheManager; }
     inline  bool            IsYInverted(void)                              const  { FUN_ENTRY(GL_LOG_TRACE); return mIsYInverted; }
     inline  bool            IsModeLineLoop(void)                           const  { FUN_ENTRY(GL_LOG_TRACE); return mIsModeLineLoop; }
 
 // Set Functions
             void            SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLSurfaceInterface *eglWriteSurfaceInterface);
-    inline  void            BindToTexture(GLuint bind)                            { FUN_ENTRY(GL_LOG_DEBUG); mSystemFBO->SetBindToTexture(bind); }
+            void            BindTexImage(EGLSurfaceInterface *eglSurfaceInterface, bool bind);
 
     inline  bool            HasShaderCompiler(void);
 
@@ -288,6 +317,21 @@ public:
     void            PopGroupMarkerEXT(void);
     void            GetProgramBinaryOES(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
     void            ProgramBinaryOES(GLuint program, GLenum binaryFormat, const void *binary, GLint length);
+    void            BindVertexArrayOES(GLuint array);
+    void            DeleteVertexArraysOES(GLsizei n, const GLuint *arrays);
+    void            GenVertexArraysOES(GLsizei n, GLuint *arrays);
+    GLboolean       IsVertexArrayOES(GLuint array);
+    void            DrawArraysInstancedEXT(GLenum mode, GLint first, GLsizei count, GLsizei primcount);
+    void            DrawElementsInstancedEXT(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei primcount);
+    void            VertexAttribDivisorEXT(GLuint index, GLuint divisor);
+    void           *MapBufferOES(GLenum target, GLenum access);
+    GLboolean       UnmapBufferOES(GLenum target);
+    void            GetBufferPointervOES(GLenum target, GLenum pname, void **params);
+    void           *MapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+    void            FlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length);
+    void            MultiDrawArraysEXT(GLenum mode, const GLint *first, const GLsizei *count, GLsizei primcount);
+    void            MultiDrawElementsEXT(GLenum mode, const GLsizei *count, GLenum type, const void *const *indices, GLsizei primcount);
+    void            TexStorage2DEXT(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
 
 };
 
@@ -80,12 +80,32 @@ Context::BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usa
         return;
     }
 
+    if(bo->IsMapped()) {
+        bo->Unmap();
+    }
+
     bo->SetUsage(usage);
-    if((data && bo->HasData()) || (data == nullptr && bo->GetSize() && (size_t)size != bo->GetSize())) {
-        bo->Release();
+
+    /// A buffer read by pending commands of any context is given a new version of its storage.
+    /// Otherwise, storage of the same size is reused and only its contents are replaced.
+    bool allocated = true;
+    if(bo->IsInUse()) {
+        allocated = bo->Orphan(size, false);
+        if(allocated) {
+            bo->UpdateData(size, 0, data);
+        }
+    } else if(bo->HasData() && (size_t)size == bo->GetSize()) {
+        bo->ReleaseCompletedStorages();
+        bo->UpdateData(size, 0, data);
+    } else {
+        bo->ReleaseCompletedStorages();
+        if(bo->HasData()) {
+            bo->Release();
+        }
+        allocated = bo->Allocate(size, data);
     }
 
-    if(!bo->Allocate(size, data)) {
+    if(!allocated) {
         RecordError(GL_OUT_OF_MEMORY);
         return;
     }
@@ -116,6 +136,23 @@ Context::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const vo
         return;
     }
 
+    if(bo->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    /// Pending commands keep reading the previous version of a buffer in use.
+    /// The rest of its contents are carried over, unless the update covers all of it.
+    if(bo->IsInUse()) {
+        bool wholeBuffer = !offset && (size_t)size == bo->GetSize();
+        if(!bo->Orphan(bo->GetSize(), !wholeBuffer)) {
+            RecordError(GL_OUT_OF_MEMORY);
+            return;
+        }
+    } else {
+        bo->ReleaseCompletedStorages();
+    }
+
     bo->UpdateData(size, offset, data);
 
     if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
@@ -169,7 +206,7 @@ Context::GetBufferParameteriv(GLenum target, GLenum pname, GLint* params)
         return;
     }
 
-    if(pname != GL_BUFFER_SIZE && pname != GL_BUFFER_USAGE) {
+    if(pname != GL_BUFFER_SIZE && pname != GL_BUFFER_USAGE && pname != GL_BUFFER_ACCESS_OES && pname != GL_BUFFER_MAPPED_OES) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -183,6 +220,8 @@ Context::GetBufferParameteriv(GLenum target, GLenum pname, GLint* params)
     switch(pname) {
     case GL_BUFFER_SIZE:  *params = static_cast<GLint>(bo->GetSize());  break;
     case GL_BUFFER_USAGE: *params = static_cast<GLint>(bo->GetUsage()); break;
+    case GL_BUFFER_ACCESS_OES: *params = GL_WRITE_ONLY_OES; break;
+    case GL_BUFFER_MAPPED_OES: *params = bo->IsMapped() ? GL_TRUE : GL_FALSE; break;
     }
 }
 
@@ -213,3 +252,159 @@ Context::IsBuffer(GLuint buffer)
 
     return (buffer != 0 && mResourceManager->BufferExists(buffer)) ? GL_TRUE : GL_FALSE;
 }
+
+void *
+Context::MapBufferObject(GLenum target, BufferObject *bo, size_t offset, size_t length, GLbitfield access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// Pending commands of any context may still read a buffer whose last use has not completed.
+    /// Instead of waiting for them, the map gets a new version of the storage, which is a copy of the
+    /// previous one unless the buffer is invalidated.
+    if(!(access & GL_MAP_UNSYNCHRONIZED_BIT_EXT) && bo->IsInUse()) {
+        if(!bo->Orphan(bo->GetSize(), !(access & GL_MAP_INVALIDATE_BUFFER_BIT_EXT))) {
+            RecordError(GL_OUT_OF_MEMORY);
+            return nullptr;
+        }
+    } else {
+        bo->ReleaseCompletedStorages();
+    }
+
+    void *ptr = bo->Map(offset, length, access);
+    if(!ptr) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return nullptr;
+    }
+
+    if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
+        mPipeline->SetUpdateIndexBuffer(true);
+    }
+
+    return ptr;
+}
+
+void *
+Context::MapBufferOES(GLenum target, GLenum access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if((target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) || access != GL_WRITE_ONLY_OES) {
+        RecordError(GL_INVALID_ENUM);
+        return nullptr;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->HasData() || bo->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+
+    return MapBufferObject(target, bo, 0, bo->GetSize(), GL_MAP_WRITE_BIT_EXT);
+}
+
+void *
+Context::MapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+        RecordError(GL_INVALID_ENUM);
+        return nullptr;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo) {
+        RecordError(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+
+    const GLbitfield validAccess = GL_MAP_READ_BIT_EXT | GL_MAP_WRITE_BIT_EXT | GL_MAP_INVALIDATE_RANGE_BIT_EXT |
+                                   GL_MAP_INVALIDATE_BUFFER_BIT_EXT | GL_MAP_FLUSH_EXPLICIT_BIT_EXT | GL_MAP_UNSYNCHRONIZED_BIT_EXT;
+    if(offset < 0 || length <= 0 || (size_t)offset + (size_t)length > bo->GetSize() || (access & ~validAccess)) {
+        RecordError(GL_INVALID_VALUE);
+        return nullptr;
+    }
+
+    const GLbitfield readExclusive = GL_MAP_INVALIDATE_RANGE_BIT_EXT | GL_MAP_INVALIDATE_BUFFER_BIT_EXT | GL_MAP_UNSYNCHRONIZED_BIT_EXT;
+    if(bo->IsMapped()                                                                    ||
+       !(access & (GL_MAP_READ_BIT_EXT | GL_MAP_WRITE_BIT_EXT))                          ||
+       ((access & GL_MAP_READ_BIT_EXT) && (access & readExclusive))                      ||
+       ((access & GL_MAP_FLUSH_EXPLICIT_BIT_EXT) && !(access & GL_MAP_WRITE_BIT_EXT))) {
+        RecordError(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+
+    // invalidating a range that covers the whole buffer is the same as invalidating the buffer
+    if((access & GL_MAP_INVALIDATE_RANGE_BIT_EXT) && offset == 0 && (size_t)length == bo->GetSize()) {
+        access |= GL_MAP_INVALIDATE_BUFFER_BIT_EXT;
+    }
+
+    return MapBufferObject(target, bo, offset, length, access);
+}
+
+void
+Context::FlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->IsMapped() || !(bo->GetMapAccess() & GL_MAP_FLUSH_EXPLICIT_BIT_EXT)) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    if(offset < 0 || length < 0 || (size_t)offset + (size_t)length > bo->GetMapLength()) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    bo->FlushMappedRange();
+}
+
+GLboolean
+Context::UnmapBufferOES(GLenum target)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+        RecordError(GL_INVALID_ENUM);
+        return GL_FALSE;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return GL_FALSE;
+    }
+
+    // the indices may have been modified, so the maximum index has to be computed again
+    if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
+        mPipeline->SetUpdateIndexBuffer(true);
+    }
+
+    return bo->Unmap() ? GL_TRUE : GL_FALSE;
+}
+
+void
+Context::GetBufferPointervOES(GLenum target, GLenum pname, void **params)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if((target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) || pname != GL_BUFFER_MAP_POINTER_OES) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    *params = bo->GetMapPointer();
+}
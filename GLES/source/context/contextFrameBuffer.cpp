@@ -39,7 +39,6 @@ Context::BindFramebuffer(GLenum target, GLuint framebuffer)
         if(fbo->GetTarget() == GL_INVALID_VALUE) {
             fbo->SetTarget(target);
             fbo->SetVkContext(mVkContext);
-            fbo->SetResources(mResourceManager->GetTextureArray(), mResourceManager->GetRenderbufferArray());
         }
     }
 
@@ -150,26 +149,30 @@ Context::FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum render
     }
 
     mWriteFBO->UnrefAttachment(attachment);
-    //If there is a renderbuffer attached to this framebuffer that has been deleted
-    mWriteFBO->CleanCachedAttachment(attachment);
     mResourceManager->CleanPurgeList();
 
+    // the renderbuffer is resolved once here, so that draws do not look up its name in the share group
+    Renderbuffer *rendbuff = renderbuffer ? mResourceManager->GetRenderbuffer(renderbuffer) : nullptr;
+
     switch(attachment) {
     case GL_COLOR_ATTACHMENT0: {
-        int width  = renderbuffer ? mResourceManager->GetRenderbuffer(renderbuffer)->GetTexture()->GetWidth()  : -1;
-        int height = renderbuffer ? mResourceManager->GetRenderbuffer(renderbuffer)->GetTexture()->GetHeight() : -1;
+        int width  = rendbuff ? rendbuff->GetTexture()->GetWidth()  : -1;
+        int height = rendbuff ? rendbuff->GetTexture()->GetHeight() : -1;
         mWriteFBO->SetColorAttachment(width, height);
         mWriteFBO->SetColorAttachmentType(renderbuffer ? GL_RENDERBUFFER : GL_NONE);
         mWriteFBO->SetColorAttachmentName(renderbuffer);
+        mWriteFBO->SetColorAttachmentRenderbuffer(rendbuff);
         mPipeline->SetUpdateViewportState(true);
         break; }
     case GL_DEPTH_ATTACHMENT:
         mWriteFBO->SetDepthAttachmentType(renderbuffer ? GL_RENDERBUFFER : GL_NONE);
         mWriteFBO->SetDepthAttachmentName(renderbuffer);
+        mWriteFBO->SetDepthAttachmentRenderbuffer(rendbuff);
         break;
     case GL_STENCIL_ATTACHMENT:
         mWriteFBO->SetStencilAttachmentType(renderbuffer ? GL_RENDERBUFFER : GL_NONE);
         mWriteFBO->SetStencilAttachmentName(renderbuffer);
+        mWriteFBO->SetStencilAttachmentRenderbuffer(rendbuff);
         break;
     }
     mWriteFBO->RefAttachment(attachment);
@@ -222,31 +225,35 @@ Context::FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget
     }
 
     mWriteFBO->UnrefAttachment(attachment);
-    //If there is a texture attached to this framebuffer that has been deleted
-    mWriteFBO->CleanCachedAttachment(attachment);
     mResourceManager->CleanPurgeList();
 
+    // the texture is resolved once here, so that draws do not look up its name in the share group
+    Texture *tex = texture ? mResourceManager->GetTexture(texture) : nullptr;
+
     switch(attachment) {
     case GL_COLOR_ATTACHMENT0: {
-        int width  = texture ? mResourceManager->GetTexture(texture)->GetWidth()  : -1;
-        int height = texture ? mResourceManager->GetTexture(texture)->GetHeight() : -1;
+        int width  = tex ? tex->GetWidth()  : -1;
+        int height = tex ? tex->GetHeight() : -1;
         mWriteFBO->SetColorAttachment(width, height);
         mWriteFBO->SetColorAttachmentType(texture ? GL_TEXTURE : GL_NONE);
         mWriteFBO->SetColorAttachmentName(texture);
-        mWriteFBO->SetColorAttachmentLayer(texture && mResourceManager->GetTexture(texture)->IsCubeMap() ? textarget : 0);
+        mWriteFBO->SetColorAttachmentTexture(tex);
+        mWriteFBO->SetColorAttachmentLayer(tex && tex->IsCubeMap() ? textarget : 0);
         mWriteFBO->SetColorAttachmentLevel(0);
         mPipeline->SetUpdateViewportState(true);
         break; }
     case GL_DEPTH_ATTACHMENT:
         mWriteFBO->SetDepthAttachmentType(texture ? GL_TEXTURE : GL_NONE);
         mWriteFBO->SetDepthAttachmentName(texture);
-        mWriteFBO->SetDepthAttachmentLayer(texture && mResourceManager->GetTexture(texture)->IsCubeMap() ? textarget : 0);
+        mWriteFBO->SetDepthAttachmentTexture(tex);
+        mWriteFBO->SetDepthAttachmentLayer(tex && tex->IsCubeMap() ? textarget : 0);
         mWriteFBO->SetDepthAttachmentLevel(0);
         break;
     case GL_STENCIL_ATTACHMENT:
         mWriteFBO->SetStencilAttachmentType(texture ? GL_TEXTURE : GL_NONE);
         mWriteFBO->SetStencilAttachmentName(texture);
-        mWriteFBO->SetStencilAttachmentLayer(texture && mResourceManager->GetTexture(texture)->IsCubeMap() ? textarget : 0);
+        mWriteFBO->SetStencilAttachmentTexture(tex);
+        mWriteFBO->SetStencilAttachmentLayer(tex && tex->IsCubeMap() ? textarget : 0);
         mWriteFBO->SetStencilAttachmentLevel(0);
         break;
     }
@@ -113,7 +113,6 @@ Context::DeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
                 rendbuff->Unbind();
                 mStateManager.GetActiveObjectsState()->SetActiveRenderbufferObjectID(0);
             }
-            mResourceManager->FramebufferCacheAttachement(rendbuff, index);
             mResourceManager->AddToPurgeList(rendbuff);
             mResourceManager->RemoveFromListRenderbuffer(index);
         }
@@ -204,6 +203,7 @@ Context::RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width
 
     if(internalformat != GL_RGB8_OES          && internalformat != GL_RGBA8_OES &&
        internalformat != GL_RGBA4             && internalformat != GL_RGB565 && internalformat != GL_RGB5_A1 &&
+       internalformat != GL_RGB16F_EXT        && internalformat != GL_RGBA16F_EXT &&
        internalformat != GL_DEPTH_COMPONENT16 && internalformat != GL_DEPTH_COMPONENT24_OES && internalformat != GL_DEPTH_COMPONENT32_OES &&
        internalformat != GL_STENCIL_INDEX8    && internalformat != GL_STENCIL_INDEX4_OES) {
         RecordError(GL_INVALID_ENUM);
@@ -22,6 +22,21 @@
  */
 
 #include "context.h"
+#include <algorithm>
+
+static void
+IntersectRect(Rect *rect, int x, int y, int width, int height)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    int right  = std::min(rect->x + rect->width , x + width);
+    int bottom = std::min(rect->y + rect->height, y + height);
+
+    rect->x      = std::max(rect->x, x);
+    rect->y      = std::max(rect->y, y);
+    rect->width  = std::max(right  - rect->x, 0);
+    rect->height = std::max(bottom - rect->y, 0);
+}
 
 void
 Context::PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
@@ -48,11 +63,17 @@ Context::PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool
         clearStencilEnabled = false;
     }
 
+    // the previous color of the surface is loaded only when the frame relies on it, i.e. the application
+    // has queried the buffer age or restricted rendering to a damage region
+    bool loadColorEnabled = mWriteFBO == mSystemFBO && mWriteSurface != nullptr &&
+                            (mWriteSurface->bufferAgeQueried || mWriteSurface->damageEnabled);
+
     // perform a screen-space pass
     mWriteFBO->CreateRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled,
                                 stateFramebufferOperations->IsColorWriteEnabled(),
                                 stateFramebufferOperations->IsDepthWriteEnabled(),
                                 stateFramebufferOperations->IsStencilWriteEnabled(),
+                                loadColorEnabled,
                                  clearColorValue, clearDepthValue, clearStencilValue,
                                  &mClearRect);
     mWriteFBO->PrepareVkImage(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
@@ -83,6 +104,11 @@ Context::Clear(GLbitfield mask)
         return;
     }
 
+    // the default framebuffer cannot be rendered to before its image is acquired
+    if(!AcquireSurfaceImage()) {
+        return;
+    }
+
     SetClearRect();
 
     // color masks are executed implicitly through a screen-space pass (i.e., need an explicit VkPipeline object)
@@ -200,6 +226,12 @@ Context::UpdateViewportState(vulkanAPI::Pipeline* pipeline)
         Rect scissorRect = stateFragmentOperations->GetScissorTestEnabled() ?
                     stateFragmentOperations->GetScissorRect() : viewportRect;
 
+        // with EGL_KHR_partial_update, rendering outside the damage region may be discarded
+        Rect damageRect;
+        if(GetSurfaceDamageRect(&damageRect)) {
+            IntersectRect(&scissorRect, damageRect.x, damageRect.y, damageRect.width, damageRect.height);
+        }
+
         pipeline->ComputeScissor(mWriteFBO->GetWidth(), mWriteFBO->GetHeight(),
                                  scissorRect.x, scissorRect.y,
                                  scissorRect.width, scissorRect.height);
@@ -207,11 +239,15 @@ Context::UpdateViewportState(vulkanAPI::Pipeline* pipeline)
     }
 }
 
-void
-Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GLenum type, const void *indices)
+bool
+Context::BeginGeometry(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    if(!AcquireSurfaceImage()) {
+        return false;
+    }
+
     SetClearRect();
 
     if(mWriteFBO->IsInClearState()) {
@@ -225,22 +261,13 @@ Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GL
         mWriteFBO->SetStateDraw();
     }
 
-    //If the primitives are rendered with GL_LINE_LOOP we have to increment the vertCount.
-    //TODO: In future this functionality may be better to stay hidden.
-    if(mStateManager.GetInputAssemblyState()->GetPrimitiveMode() == GL_LINE_LOOP) {
-        mIsModeLineLoop = true;
-        ++vertCount;
-    } else {
-        mIsModeLineLoop = false;
-    }
-
-    uint32_t indexOffset = 0;
-    uint32_t maxIndex = 0;
-    if(indexed) {
-        UpdateIndices(&indexOffset, &maxIndex, vertCount, type, indices, mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER));
-    }
+    return true;
+}
 
-    UpdateVertexAttributes(indexed ? maxIndex + 1 : vertCount, firstVertex);
+VkCommandBuffer *
+Context::RecordGeometryState(bool indexed, uint32_t indexOffset, GLenum type)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
 
     if(mWriteFBO->GetColorAttachmentTexture() && mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
         GLboolean colormask[4];
@@ -252,7 +279,7 @@ Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GL
     if(SetPipelineProgramShaderStages(mStateManager.GetActiveShaderProgram())) {
         if(!mPipeline->Create(mWriteFBO->GetVkRenderPass())) {
             Finish();
-            return;
+            return nullptr;
         }
     }
 
@@ -273,13 +300,169 @@ Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GL
 
     mPipeline->UpdateDynamicState(secondaryCmdBuffer, mStateManager.GetRasterizationState()->GetLineWidth());
 
-    DrawGeometry(secondaryCmdBuffer, indexed, firstVertex, vertCount);
+    return secondaryCmdBuffer;
+}
+
+void
+Context::SubmitGeometry(VkCommandBuffer *secondaryCmdBuffer)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
     mCommandBufferManager->EndVkSecondaryCommandBuffer(secondaryCmdBuffer);
 
     VkCommandBuffer activeCmdBuffer = mCommandBufferManager->GetActiveCommandBuffer();
     vkCmdExecuteCommands(activeCmdBuffer, 1, secondaryCmdBuffer);
 }
 
+void
+Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GLenum type, const void *indices, uint32_t instanceCount)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!BeginGeometry()) {
+        return;
+    }
+
+    // the per-draw state of the program is kept in the program itself, which other contexts of the share group may draw with
+    std::lock_guard<std::recursive_mutex> lock(mResourceManager->GetShareGroupMutex());
+
+    //If the primitives are rendered with GL_LINE_LOOP we have to increment the vertCount.
+    //TODO: In future this functionality may be better to stay hidden.
+    if(mStateManager.GetInputAssemblyState()->GetPrimitiveMode() == GL_LINE_LOOP) {
+        mIsModeLineLoop = true;
+        ++vertCount;
+    } else {
+        mIsModeLineLoop = false;
+    }
+
+    uint32_t indexOffset = 0;
+    uint32_t maxIndex = 0;
+    if(indexed) {
+        UpdateIndices(&indexOffset, &maxIndex, vertCount, type, indices, mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER));
+    }
+
+    UpdateVertexAttributes(indexed ? maxIndex + 1 : vertCount, firstVertex, instanceCount);
+    SetBufferObjectsUsed(indexed);
+
+    VkCommandBuffer *secondaryCmdBuffer = RecordGeometryState(indexed, indexOffset, type);
+    if(secondaryCmdBuffer == nullptr) {
+        return;
+    }
+
+    DrawGeometry(secondaryCmdBuffer, indexed, firstVertex, vertCount, instanceCount);
+    SubmitGeometry(secondaryCmdBuffer);
+}
+
+void
+Context::PushMultiGeometry(const GLint *first, const GLsizei *count, bool indexed, GLenum type, const void *const *indices, GLsizei drawCount)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    uint32_t rangeCount = 0;
+    for(GLsizei i = 0; i < drawCount; ++i) {
+        if(count[i]) {
+            ++rangeCount;
+        }
+    }
+    if(!rangeCount) {
+        return;
+    }
+
+    if(!BeginGeometry()) {
+        return;
+    }
+    mIsModeLineLoop = false;
+
+    // the per-draw state of the program is kept in the program itself, which other contexts of the share group may draw with
+    std::lock_guard<std::recursive_mutex> lock(mResourceManager->GetShareGroupMutex());
+
+    // All ranges are turned into indirect draw commands, so that they are recorded
+    // against a single pipeline and vertex/index buffer binding.
+    uint32_t vertCount     = 0;
+    size_t   commandOffset = 0;
+    bool     streamed      = false;
+    if(indexed) {
+        std::vector<uint32_t> firstIndices(drawCount);
+        uint32_t maxIndex = 0;
+        bool prepared = mStateManager.GetActiveShaderProgram()->PrepareMultiIndexBufferObject(firstIndices.data(), &maxIndex, count, type, indices, drawCount,
+                                                                                              mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER));
+        // the index buffer of a single draw has to be prepared again
+        mPipeline->SetUpdateIndexBuffer(true);
+        if(!prepared) {
+            return;
+        }
+
+        std::vector<VkDrawIndexedIndirectCommand> commands;
+        commands.reserve(rangeCount);
+        for(GLsizei i = 0; i < drawCount; ++i) {
+            if(count[i]) {
+                commands.push_back({static_cast<uint32_t>(count[i]), 1, firstIndices[i], 0, 0});
+            }
+        }
+        vertCount = maxIndex + 1;
+        streamed  = StreamIndirectCommands(commands.data(), commands.size() * sizeof(VkDrawIndexedIndirectCommand), &commandOffset);
+    } else {
+        std::vector<VkDrawIndirectCommand> commands;
+        commands.reserve(rangeCount);
+        for(GLsizei i = 0; i < drawCount; ++i) {
+            if(count[i]) {
+                commands.push_back({static_cast<uint32_t>(count[i]), 1, static_cast<uint32_t>(first[i]), 0});
+                vertCount = std::max(vertCount, static_cast<uint32_t>(first[i] + count[i]));
+            }
+        }
+        streamed = StreamIndirectCommands(commands.data(), commands.size() * sizeof(VkDrawIndirectCommand), &commandOffset);
+    }
+
+    if(!streamed) {
+        return;
+    }
+
+    UpdateVertexAttributes(vertCount, 0, 1);
+    SetBufferObjectsUsed(indexed);
+
+    // unsigned byte indices have been widened to uint16
+    VkCommandBuffer *secondaryCmdBuffer = RecordGeometryState(indexed, 0, type == GL_UNSIGNED_INT ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT);
+    if(secondaryCmdBuffer == nullptr) {
+        return;
+    }
+
+    DrawIndirectGeometry(secondaryCmdBuffer, indexed, commandOffset, rangeCount);
+    SubmitGeometry(secondaryCmdBuffer);
+}
+
+bool
+Context::StreamIndirectCommands(const void *commands, size_t size, size_t *offset)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // once the draws that source the buffer have completed, it is refilled from its start
+    if(mIndirectBuffer != nullptr && !mIndirectBuffer->IsInUse()) {
+        mIndirectBufferOffset = 0;
+    }
+
+    if(mIndirectBuffer == nullptr) {
+        mIndirectBuffer = new IndirectBufferObject(mVkContext);
+        if(!mIndirectBuffer->Allocate(std::max(size, static_cast<size_t>(GLOVE_INDIRECT_BUFFER_SIZE)), nullptr)) {
+            delete mIndirectBuffer;
+            mIndirectBuffer = nullptr;
+            return false;
+        }
+    } else if(mIndirectBufferOffset + size > mIndirectBuffer->GetSize()) {
+        // pending draws still source the current storage, so a larger version takes its place
+        if(!mIndirectBuffer->Orphan(std::max(2 * mIndirectBuffer->GetSize(), size), false)) {
+            return false;
+        }
+        mIndirectBufferOffset = 0;
+    }
+
+    mIndirectBuffer->UpdateData(size, mIndirectBufferOffset, commands);
+    mIndirectBuffer->SetUsed(mCommandBufferManager->GetUseEpoch());
+    *offset                = mIndirectBufferOffset;
+    mIndirectBufferOffset += size;
+
+    return true;
+}
+
 void
 Context::UpdateIndices(uint32_t* offset, uint32_t* maxIndex, uint32_t indexCount, GLenum type, const void* indices, BufferObject* ibo)
 {
@@ -292,18 +475,38 @@ Context::UpdateIndices(uint32_t* offset, uint32_t* maxIndex, uint32_t indexCount
 }
 
 void
-Context::UpdateVertexAttributes(uint32_t vertCount, uint32_t firstVertex)
+Context::UpdateVertexAttributes(uint32_t vertCount, uint32_t firstVertex, uint32_t instanceCount)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    /// A glVertexAttrib related function has been called. Check to see if mVkPipelineVertexInput needs to be updated.
+    /// A glVertexAttrib related function has been called. Check to see if the vertex input layout has changed.
     /// If this is true then VkPipeline needs to be updated too.
     /// Otherwise only the buffer that will be bound with vkCmdBindVertexBuffers need to be updated
-    if(mStateManager.GetActiveShaderProgram()->PrepareVertexAttribBufferObjects(vertCount, firstVertex,
-                                                                                mResourceManager->GetGenericVertexAttributes(),
+    if(mStateManager.GetActiveShaderProgram()->PrepareVertexAttribBufferObjects(vertCount, firstVertex, instanceCount,
+                                                                                mStateManager.GetActiveObjectsState()->GetActiveVertexArray(),
                                                                                 mPipeline->GetUpdateVertexAttribVBOs())) {
         mPipeline->SetUpdatePipeline(true);
-        mPipeline->SetUpdateVertexAttribVBOs(false);
+    }
+    mPipeline->SetUpdateVertexAttribVBOs(false);
+}
+
+void
+Context::SetBufferObjectsUsed(bool indexed)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// Buffer objects read by this draw may not be written in place until the queue has completed it
+    const uint64_t useEpoch = mCommandBufferManager->GetUseEpoch();
+    const ShaderProgram *program = mStateManager.GetActiveShaderProgram();
+
+    BufferObject * const *vbos = program->GetActiveVertexBufferObjects();
+    for(uint32_t i = 0; i < program->GetActiveVertexVkBuffersCount(); ++i) {
+        vbos[i]->SetUsed(useEpoch);
+    }
+
+    BufferObject *ibo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER);
+    if(indexed && ibo) {
+        ibo->SetUsed(useEpoch);
     }
 }
 
@@ -312,11 +515,11 @@ Context::BindUniformDescriptors(VkCommandBuffer *CmdBuffer)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(*mStateManager.GetActiveShaderProgram()->GetVkDescSet()) {
+    if(mStateManager.GetActiveShaderProgram()->HasUniformBlocks()) {
         mStateManager.GetActiveShaderProgram()->UpdateBuiltInUniformData(mStateManager.GetViewportTransformationState()->GetMinDepthRange(),
                                                                          mStateManager.GetViewportTransformationState()->GetMaxDepthRange());
         mStateManager.GetActiveShaderProgram()->UpdateDescriptorSet();
-        vkCmdBindDescriptorSets(*CmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mStateManager.GetActiveShaderProgram()->GetVkPipelineLayout(), 0, 1, mStateManager.GetActiveShaderProgram()->GetVkDescSet(), 0, nullptr);
+        mStateManager.GetActiveShaderProgram()->BindDescriptorSet(*CmdBuffer);
     }
 }
 
@@ -325,11 +528,9 @@ Context::BindVertexBuffers(VkCommandBuffer *CmdBuffer)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mStateManager.GetActiveShaderProgram()->GetActiveVertexVkBuffersCount()) {
-        VkDeviceSize *offsets = new VkDeviceSize[mStateManager.GetActiveShaderProgram()->GetActiveVertexVkBuffersCount()];
-        memset(offsets, 0, sizeof(VkDeviceSize) * mStateManager.GetActiveShaderProgram()->GetActiveVertexVkBuffersCount());
-        vkCmdBindVertexBuffers(*CmdBuffer, 0, mStateManager.GetActiveShaderProgram()->GetActiveVertexVkBuffersCount(), mStateManager.GetActiveShaderProgram()->GetActiveVertexVkBuffers(), offsets);
-        delete[] offsets;
+    const ShaderProgram *program = mStateManager.GetActiveShaderProgram();
+    if(program->GetActiveVertexVkBuffersCount()) {
+        vkCmdBindVertexBuffers(*CmdBuffer, 0, program->GetActiveVertexVkBuffersCount(), program->GetActiveVertexVkBuffers(), program->GetActiveVertexVkBufferOffsets());
     }
 }
 
@@ -344,14 +545,36 @@ Context::BindIndexBuffer(VkCommandBuffer *CmdBuffer, uint32_t offset, VkIndexTyp
 }
 
 void
-Context::DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t firstVertex, uint32_t vertCount)
+Context::DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t firstVertex, uint32_t vertCount, uint32_t instanceCount)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     if(indexed == false) {
-        vkCmdDraw(*CmdBuffer, vertCount, 1, firstVertex, 0);
+        vkCmdDraw(*CmdBuffer, vertCount, instanceCount, firstVertex, 0);
     } else {
-        vkCmdDrawIndexed(*CmdBuffer, vertCount, 1, 0, 0, 0);
+        vkCmdDrawIndexed(*CmdBuffer, vertCount, instanceCount, 0, 0, 0);
+    }
+}
+
+void
+Context::DrawIndirectGeometry(VkCommandBuffer *CmdBuffer, bool indexed, VkDeviceSize offset, uint32_t drawCount)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    const uint32_t stride = indexed ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand);
+
+    // without multiDrawIndirect each call consumes a single command
+    const uint32_t maxDrawCount = mVkContext->mIsMultiDrawIndirectSupported ? mVkContext->vkMaxDrawIndirectCount : 1;
+
+    while(drawCount) {
+        uint32_t batchCount = std::min(drawCount, maxDrawCount);
+        if(indexed == false) {
+            vkCmdDrawIndirect(*CmdBuffer, mIndirectBuffer->GetVkBuffer(), offset, batchCount, stride);
+        } else {
+            vkCmdDrawIndexedIndirect(*CmdBuffer, mIndirectBuffer->GetVkBuffer(), offset, batchCount, stride);
+        }
+        offset    += batchCount * stride;
+        drawCount -= batchCount;
     }
 }
 
@@ -360,26 +583,83 @@ Context::DrawArrays(GLenum mode, GLint first, GLsizei count)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mode > GL_TRIANGLE_FAN) {
-        RecordError(GL_INVALID_ENUM);
-        return;
+    DrawArraysInstancedEXT(mode, first, count, 1);
+}
+
+void
+Context::DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    DrawElementsInstancedEXT(mode, count, type, indices, 1);
+}
+
+void
+Context::DrawArraysInstancedEXT(GLenum mode, GLint first, GLsizei count, GLsizei primcount)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // KHR_no_error contexts skip the argument and framebuffer completeness checks
+    if(!mNoError) {
+        if(mode > GL_TRIANGLE_FAN) {
+            RecordError(GL_INVALID_ENUM);
+            return;
+        }
+
+        if(count < 0 || primcount < 0) {
+            RecordError(GL_INVALID_VALUE);
+            return;
+        }
+
+        if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
+            return;
+        }
     }
-    
-    if(count < 0) {
-        RecordError(GL_INVALID_VALUE);
+
+    if(mStateManager.GetRasterizationState()->GetCullFace() == GL_FRONT_AND_BACK && IsDrawModeTriangle(mode)) {
         return;
     }
 
-    if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
+    if(!mStateManager.GetActiveShaderProgram() || !count || !primcount) {
         return;
     }
 
+    if(mStateManager.GetInputAssemblyState()->UpdatePrimitiveMode(mode)) {
+        mPipeline->SetInputAssemblyTopology(GlPrimitiveTopologyToVkPrimitiveTopology(mStateManager.GetInputAssemblyState()->GetPrimitiveMode()));
+    }
+
+    PushGeometry(count, first, false, GL_INVALID_ENUM, nullptr, primcount);
+}
+
+void
+Context::DrawElementsInstancedEXT(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei primcount)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // KHR_no_error contexts skip the argument and framebuffer completeness checks
+    if(!mNoError) {
+        if( (mode > GL_TRIANGLE_FAN)  || !(type == GL_UNSIGNED_BYTE || type == GL_UNSIGNED_SHORT || type == GL_UNSIGNED_INT) ) {
+            RecordError(GL_INVALID_ENUM);
+            return;
+        }
+
+        if(count < 0 || primcount < 0) {
+            RecordError(GL_INVALID_VALUE);
+            return;
+        }
+
+        if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
+            return;
+        }
+    }
+
     if(mStateManager.GetRasterizationState()->GetCullFace() == GL_FRONT_AND_BACK && IsDrawModeTriangle(mode)) {
         return;
     }
 
-    if(!mStateManager.GetActiveShaderProgram() || !count) {
+    if(!mStateManager.GetActiveShaderProgram() || !count || !primcount) {
         return;
     }
 
@@ -387,34 +667,105 @@ Context::DrawArrays(GLenum mode, GLint first, GLsizei count)
         mPipeline->SetInputAssemblyTopology(GlPrimitiveTopologyToVkPrimitiveTopology(mStateManager.GetInputAssemblyState()->GetPrimitiveMode()));
     }
 
-    PushGeometry(count, first, false, GL_INVALID_ENUM, nullptr);
+    PushGeometry(count, 0, true, type, indices, primcount);
 }
 
 void
-Context::DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+Context::MultiDrawArraysEXT(GLenum mode, const GLint *first, const GLsizei *count, GLsizei primcount)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if( (mode > GL_TRIANGLE_FAN)  || !(type == GL_UNSIGNED_BYTE || type == GL_UNSIGNED_SHORT) ) {
-        RecordError(GL_INVALID_ENUM);
+    // KHR_no_error contexts skip the argument and framebuffer completeness checks
+    if(!mNoError) {
+        if(mode > GL_TRIANGLE_FAN) {
+            RecordError(GL_INVALID_ENUM);
+            return;
+        }
+
+        if(primcount < 0) {
+            RecordError(GL_INVALID_VALUE);
+            return;
+        }
+
+        for(GLsizei i = 0; i < primcount; ++i) {
+            if(count[i] < 0) {
+                RecordError(GL_INVALID_VALUE);
+                return;
+            }
+        }
+
+        if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
+            return;
+        }
+    }
+
+    if(mStateManager.GetRasterizationState()->GetCullFace() == GL_FRONT_AND_BACK && IsDrawModeTriangle(mode)) {
         return;
     }
 
-    if(count < 0) {
-        RecordError(GL_INVALID_VALUE);
+    if(!mStateManager.GetActiveShaderProgram() || !primcount) {
         return;
     }
 
-    if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
+    // line loops are closed by rewriting the vertex data of each range
+    if(mode == GL_LINE_LOOP) {
+        for(GLsizei i = 0; i < primcount; ++i) {
+            DrawArraysInstancedEXT(mode, first[i], count[i], 1);
+        }
         return;
     }
 
+    if(mStateManager.GetInputAssemblyState()->UpdatePrimitiveMode(mode)) {
+        mPipeline->SetInputAssemblyTopology(GlPrimitiveTopologyToVkPrimitiveTopology(mStateManager.GetInputAssemblyState()->GetPrimitiveMode()));
+    }
+
+    PushMultiGeometry(first, count, false, GL_INVALID_ENUM, nullptr, primcount);
+}
+
+void
+Context::MultiDrawElementsEXT(GLenum mode, const GLsizei *count, GLenum type, const void *const *indices, GLsizei primcount)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // KHR_no_error contexts skip the argument and framebuffer completeness checks
+    if(!mNoError) {
+        if( (mode > GL_TRIANGLE_FAN)  || !(type == GL_UNSIGNED_BYTE || type == GL_UNSIGNED_SHORT || type == GL_UNSIGNED_INT) ) {
+            RecordError(GL_INVALID_ENUM);
+            return;
+        }
+
+        if(primcount < 0) {
+            RecordError(GL_INVALID_VALUE);
+            return;
+        }
+
+        for(GLsizei i = 0; i < primcount; ++i) {
+            if(count[i] < 0) {
+                RecordError(GL_INVALID_VALUE);
+                return;
+            }
+        }
+
+        if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
+            return;
+        }
+    }
+
     if(mStateManager.GetRasterizationState()->GetCullFace() == GL_FRONT_AND_BACK && IsDrawModeTriangle(mode)) {
         return;
     }
 
-    if(!mStateManager.GetActiveShaderProgram() || !count) {
+    if(!mStateManager.GetActiveShaderProgram() || !primcount) {
+        return;
+    }
+
+    // line loops are closed by rewriting the index data of each range
+    if(mode == GL_LINE_LOOP) {
+        for(GLsizei i = 0; i < primcount; ++i) {
+            DrawElementsInstancedEXT(mode, count[i], type, indices[i], 1);
+        }
         return;
     }
 
@@ -422,7 +773,7 @@ Context::DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indic
         mPipeline->SetInputAssemblyTopology(GlPrimitiveTopologyToVkPrimitiveTopology(mStateManager.GetInputAssemblyState()->GetPrimitiveMode()));
     }
 
-    PushGeometry(count, 0, true, type, indices);
+    PushMultiGeometry(nullptr, count, true, type, indices, primcount);
 }
 
 void
@@ -451,6 +802,7 @@ Context::Finish(void)
             }
         } else {
             mWriteFBO->PrepareVkImage(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            mWriteFBO->UpdateDepthTexture();
         }
     }
     mWriteFBO->SetStateIdle();
@@ -470,12 +822,34 @@ Context::Flush(void)
 
     if(mWriteFBO->EndVkRenderPass()) {
         mCommandBufferManager->EndVkDrawCommandBuffer();
-        mCommandBufferManager->SubmitVkDrawCommandBuffer();
+        mCommandBufferManager->SubmitVkDrawCommandBuffer(mWriteSurface ? mWriteSurface->vkSyncItems : nullptr);
     }
 
     return true;
 }
 
+bool
+Context::InsertFence(VkFence vkFence)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // The fence is signaled once the commands recorded so far have completed
+    Flush();
+
+    return mCommandBufferManager->SubmitVkFence(vkFence);
+}
+
+void
+Context::WaitFence(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // Commands recorded from now on wait for everything submitted before them, fences included
+    Flush();
+
+    mCommandBufferManager->WaitPreviousSubmissions();
+}
+
 void
 Context::SetClearRect(void)
 {
@@ -522,4 +896,39 @@ Context::SetClearRect(void)
     mClearRect.y      = std::max(mWriteFBO->GetY()     , y);
     mClearRect.width  = std::min(mWriteFBO->GetWidth() , w);
     mClearRect.height = std::min(mWriteFBO->GetHeight(), h);
+
+    // the render area shrinks to the damage region, with its origin flipped to the upper left
+    Rect damageRect;
+    if(GetSurfaceDamageRect(&damageRect)) {
+        IntersectRect(&mClearRect, damageRect.x, mWriteFBO->GetHeight() - damageRect.y - damageRect.height,
+                                   damageRect.width, damageRect.height);
+    }
+}
+
+bool
+Context::GetSurfaceDamageRect(Rect *rect)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mWriteFBO != mSystemFBO || mWriteSurface == nullptr) {
+        return false;
+    }
+
+    // EGL sets the damage region before the first clear or draw of each frame, so that
+    // the scissor is computed again only when the damage region changes
+    if(mWriteSurface->damagePending) {
+        mWriteSurface->damagePending = false;
+        mPipeline->SetUpdateViewportState(true);
+    }
+
+    if(!mWriteSurface->damageEnabled) {
+        return false;
+    }
+
+    rect->x      = mWriteSurface->damageX;
+    rect->y      = mWriteSurface->damageY;
+    rect->width  = static_cast<int>(mWriteSurface->damageWidth);
+    rect->height = static_cast<int>(mWriteSurface->damageHeight);
+
+    return true;
 }
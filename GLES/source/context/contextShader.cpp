@@ -37,6 +37,9 @@ Context::CompileShader(GLuint shader)
         return;
     }
 
+    // the compiler is shared by the contexts of the share group
+    std::lock_guard<std::recursive_mutex> lock(mResourceManager->GetShareGroupMutex());
+
     CreateShaderCompiler();
 
     shaderPtr->CompileShader();
@@ -56,7 +59,7 @@ Context::CreateShader(GLenum type)
     Shader *shader = mResourceManager->GetShader(res);
     shader->SetShaderType(type == GL_VERTEX_SHADER ? SHADER_TYPE_VERTEX : SHADER_TYPE_FRAGMENT);
     shader->SetVkContext(mVkContext);
-    shader->SetShaderCompiler(mShaderCompiler);
+    shader->SetShaderCompiler(mResourceManager->GetShaderCompiler());
 
     return mResourceManager->PushShadingObject({SHADER_ID, res});
 }
@@ -328,10 +331,7 @@ Context::ReleaseShaderCompiler(void)
         return;
     }
 
-    if(mShaderCompiler != nullptr) {
-        delete mShaderCompiler;
-        mShaderCompiler = nullptr;
-    }
+    mResourceManager->ReleaseShaderCompiler();
 }
 
 void
@@ -339,19 +339,5 @@ Context::CreateShaderCompiler(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mShaderCompiler == nullptr) {
-        mShaderCompiler = new GlslangShaderCompiler();
-
-        ObjectArray<Shader> *shaderArray = mResourceManager->GetShaderArray();
-        for(typename map<uint32_t, Shader *>::const_iterator it =
-        shaderArray->GetObjects()->begin(); it != shaderArray->GetObjects()->end(); it++) {
-            it->second->SetShaderCompiler(mShaderCompiler);
-        }
-
-        ObjectArray<ShaderProgram> *shaderProgramArray = mResourceManager->GetShaderProgramArray();
-        for(typename map<uint32_t, ShaderProgram *>::const_iterator it =
-        shaderProgramArray->GetObjects()->begin(); it != shaderProgramArray->GetObjects()->end(); it++) {
-            it->second->SetShaderCompiler(mShaderCompiler);
-        }
-    }
+    mResourceManager->CreateShaderCompiler();
 }
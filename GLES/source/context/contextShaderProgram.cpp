@@ -84,8 +84,9 @@ Context::CreateProgram(void)
     GLuint         res     = mResourceManager->AllocateShaderProgram();
     ShaderProgram *progPtr = mResourceManager->GetShaderProgram(res);
     progPtr->SetVkContext(mVkContext);
-    progPtr->SetShaderCompiler(mShaderCompiler);
-    progPtr->SetCacheManager(mCacheManager);
+    progPtr->SetShaderCompiler(mResourceManager->GetShaderCompiler());
+    // set once, the objects a program replaces may still be read by any context of the share group
+    progPtr->SetRetireList(mResourceManager->GetRetireList());
 
     return mResourceManager->PushShadingObject({SHADER_PROGRAM_ID, res});
 }
@@ -106,7 +107,7 @@ Context::DeleteProgram(GLuint program)
 
     progPtr->SetMarkForDeletion(true);
 
-    if(progPtr->FreeForDeletion()) {
+    if(progPtr->FreeForDeletion() && !mResourceManager->IsShared()) {
         // Flush in case the shader is part of the pipeline
         // Optimization: perform this only when needed or defer deletion
         if(mWriteFBO->IsInDrawState()) {
@@ -118,6 +119,14 @@ Context::DeleteProgram(GLuint program)
     } else {
         ResourceManager* resourceManager = GetCurrentContext()->GetResourceManager();
         resourceManager->AddToPurgeList(progPtr);
+
+        // other contexts may still use the program, so it is deleted once the purge fence signals
+        if(resourceManager->IsShared()) {
+            if(mWriteFBO->IsInDrawState()) {
+                Flush();
+            }
+            resourceManager->CleanPurgeList();
+        }
     }
 }
 
@@ -621,12 +630,14 @@ Context::LinkProgram(GLuint program)
         Finish();
     }
 
+    std::lock_guard<std::recursive_mutex> lock(mResourceManager->GetShareGroupMutex());
+
     progPtr->LinkProgram();
     progPtr->SetShaderModules();
 
     mPipeline->SetUpdatePipeline(progPtr->IsLinked());
     if(SetPipelineProgramShaderStages(progPtr)) {
-        progPtr->PrepareVertexAttribBufferObjects(0, 0, mResourceManager->GetGenericVertexAttributes(), true);
+        progPtr->PrepareVertexAttribBufferObjects(0, 0, 1, mStateManager.GetActiveObjectsState()->GetActiveVertexArray(), true);
         mPipeline->Create(mSystemFBO->GetVkRenderPass());
         // rebuild the pipeline next time
         mPipeline->SetUpdatePipeline(true);
@@ -649,7 +660,7 @@ Context::Uniform1f(GLint location, GLfloat x)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT && uniform->type != GL_BOOL)) {
+       (!mNoError && (uniform->type != GL_FLOAT && uniform->type != GL_BOOL))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -683,8 +694,8 @@ Context::Uniform1fv(GLint location, GLsizei count, const GLfloat *v)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT && uniform->type != GL_BOOL) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_FLOAT && uniform->type != GL_BOOL) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -722,9 +733,8 @@ Context::Uniform1i(GLint location, GLint x)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_INT        && uniform->type != GL_BOOL &&
-        uniform->type != GL_SAMPLER_2D && uniform->type != GL_SAMPLER_CUBE)
-      ) {
+       (!mNoError && (uniform->type != GL_INT        && uniform->type != GL_BOOL &&
+                      uniform->type != GL_SAMPLER_2D && uniform->type != GL_SAMPLER_CUBE))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -759,10 +769,10 @@ Context::Uniform1iv(GLint location, GLsizei count, const GLint *v)
     }
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
-    if((!uniform ) ||
-       (uniform->type != GL_INT && uniform->type != GL_BOOL &&
-        uniform->type != GL_SAMPLER_2D && uniform->type != GL_SAMPLER_CUBE) ||
-       (uniform->arraySize == 1 && count > 1)) {
+    if((!uniform) ||
+       (!mNoError && ((uniform->type != GL_INT && uniform->type != GL_BOOL &&
+                       uniform->type != GL_SAMPLER_2D && uniform->type != GL_SAMPLER_CUBE) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -802,7 +812,7 @@ Context::Uniform2f(GLint location, GLfloat x, GLfloat y)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_VEC2 && uniform->type != GL_BOOL_VEC2)) {
+       (!mNoError && (uniform->type != GL_FLOAT_VEC2 && uniform->type != GL_BOOL_VEC2))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -837,8 +847,8 @@ Context::Uniform2fv(GLint location, GLsizei count, const GLfloat *v)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_VEC2 && uniform->type != GL_BOOL_VEC2) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_FLOAT_VEC2 && uniform->type != GL_BOOL_VEC2) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -876,7 +886,7 @@ Context::Uniform2i(GLint location, GLint x, GLint y)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-        (uniform->type != GL_INT_VEC2 && uniform->type != GL_BOOL_VEC2)) {
+       (!mNoError && (uniform->type != GL_INT_VEC2 && uniform->type != GL_BOOL_VEC2))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -911,8 +921,8 @@ Context::Uniform2iv(GLint location, GLsizei count, const GLint *v)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_INT_VEC2 && uniform->type != GL_BOOL_VEC2) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_INT_VEC2 && uniform->type != GL_BOOL_VEC2) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -950,7 +960,7 @@ Context::Uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_VEC3 && uniform->type != GL_BOOL_VEC3)) {
+       (!mNoError && (uniform->type != GL_FLOAT_VEC3 && uniform->type != GL_BOOL_VEC3))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -985,8 +995,8 @@ Context::Uniform3fv(GLint location, GLsizei count, const GLfloat *v)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_VEC3 && uniform->type != GL_BOOL_VEC3) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_FLOAT_VEC3 && uniform->type != GL_BOOL_VEC3) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1024,7 +1034,7 @@ Context::Uniform3i(GLint location, GLint x, GLint y, GLint z)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_INT_VEC3 && uniform->type != GL_BOOL_VEC3)) {
+       (!mNoError && (uniform->type != GL_INT_VEC3 && uniform->type != GL_BOOL_VEC3))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1059,8 +1069,8 @@ Context::Uniform3iv(GLint location, GLsizei count, const GLint *v)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_INT_VEC3 && uniform->type != GL_BOOL_VEC3) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_INT_VEC3 && uniform->type != GL_BOOL_VEC3) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1098,7 +1108,7 @@ Context::Uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_VEC4 && uniform->type != GL_BOOL_VEC4)) {
+       (!mNoError && (uniform->type != GL_FLOAT_VEC4 && uniform->type != GL_BOOL_VEC4))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1133,8 +1143,8 @@ Context::Uniform4fv(GLint location, GLsizei count, const GLfloat *v)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_VEC4 && uniform->type != GL_BOOL_VEC4) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_FLOAT_VEC4 && uniform->type != GL_BOOL_VEC4) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1172,7 +1182,7 @@ Context::Uniform4i(GLint location, GLint x, GLint y, GLint z, GLint w)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_INT_VEC4 && uniform->type != GL_BOOL_VEC4)) {
+       (!mNoError && (uniform->type != GL_INT_VEC4 && uniform->type != GL_BOOL_VEC4))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1207,8 +1217,8 @@ Context::Uniform4iv(GLint location, GLsizei count, const GLint *v)
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_INT_VEC4 && uniform->type != GL_BOOL_VEC4) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_INT_VEC4 && uniform->type != GL_BOOL_VEC4) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1256,8 +1266,8 @@ Context::UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, co
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_MAT2) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_FLOAT_MAT2) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1307,8 +1317,8 @@ Context::UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, co
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_MAT3) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_FLOAT_MAT3) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1357,8 +1367,8 @@ Context::UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, co
 
     const ShaderResourceInterface::uniform *uniform = mStateManager.GetActiveShaderProgram()->GetUniformAtLocation(location);
     if((!uniform) ||
-       (uniform->type != GL_FLOAT_MAT4) ||
-       (uniform->arraySize == 1 && count > 1)) {
+       (!mNoError && ((uniform->type != GL_FLOAT_MAT4) ||
+                      (uniform->arraySize == 1 && count > 1)))) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -1422,6 +1432,8 @@ Context::ValidateProgram(GLuint program)
         }
     }
 
+    std::lock_guard<std::recursive_mutex> lock(mResourceManager->GetShareGroupMutex());
+
     progPtr->Validate();
 
     if(!progPtr->IsValidated()){
@@ -1457,6 +1469,8 @@ Context::ProgramBinaryOES(GLuint program, GLenum binaryFormat, const void *binar
     AttachShader(program, vs);
     AttachShader(program, fs);
 
+    std::lock_guard<std::recursive_mutex> lock(mResourceManager->GetShareGroupMutex());
+
     progPtr->UsePrecompiledBinary(binary, length);
     progPtr->SetShaderModules();
 }
@@ -62,14 +62,15 @@ Context::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum form
     }
 
     if(type != GL_UNSIGNED_BYTE          && type != GL_UNSIGNED_SHORT_5_6_5 &&
-       type != GL_UNSIGNED_SHORT_4_4_4_4 && type != GL_UNSIGNED_SHORT_5_5_5_1) {
+       type != GL_UNSIGNED_SHORT_4_4_4_4 && type != GL_UNSIGNED_SHORT_5_5_5_1 && type != GL_HALF_FLOAT_OES) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
 
     if( (type == GL_UNSIGNED_SHORT_5_6_5                                          && format != GL_RGB)  ||
        ((type == GL_UNSIGNED_SHORT_5_5_5_1 || type == GL_UNSIGNED_SHORT_4_4_4_4)  && format != GL_RGBA) ||
-        (type == GL_UNSIGNED_BYTE                                                 && format != GL_RGBA)) {
+        (type == GL_UNSIGNED_BYTE                                                 && format != GL_RGBA) ||
+        (type == GL_HALF_FLOAT_OES                                                && format != GL_RGBA)) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -79,6 +80,11 @@ Context::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum form
         return;
     }
 
+    // the default framebuffer is read from the image of the current frame, which may not have been acquired yet
+    if(!AcquireSurfaceImage()) {
+        return;
+    }
+
     if(mWriteFBO->IsInDrawState()) {
         Finish();
     }
@@ -88,6 +94,12 @@ Context::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum form
         return;
     }
 
+    // half-float pixels can be read only from a half-float color buffer
+    if(type == GL_HALF_FLOAT_OES && activeTexture->GetExplicitType() != GL_HALF_FLOAT_OES) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
     GLenum srcInternalFormat = activeTexture->GetExplicitInternalFormat();
     GLenum dstInternalFormat = GlFormatToGlInternalFormat(format, type);
 
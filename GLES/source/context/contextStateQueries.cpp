@@ -45,9 +45,10 @@ Context::GetBooleanv(GLenum pname, GLboolean* params)
     case GL_CURRENT_PROGRAM:                    *params = GetProgramId(mStateManager.GetActiveShaderProgram()) == 0 ? GL_FALSE : GL_TRUE; break;
     case GL_ARRAY_BUFFER_BINDING:               *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)         ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)        ) == 0 ? GL_FALSE : GL_TRUE : GL_FALSE; break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER)) == 0 ? GL_FALSE : GL_TRUE : GL_FALSE; break;
+    case GL_VERTEX_ARRAY_BINDING_OES:           *params = mResourceManager->GetVertexArrayID(mStateManager.GetActiveObjectsState()->GetActiveVertexArray()) == 0 ? GL_FALSE : GL_TRUE; break;
     case GL_NUM_SHADER_BINARY_FORMATS:          *params = GLOVE_NUM_SHADER_BINARY_FORMATS == 0 ? GL_FALSE : GL_TRUE; break;
-    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = GL_FALSE; break;
-    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = GL_FALSE; break;
+    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = GL_TRUE; break;
+    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = GL_TRUE; break;
     case GL_BLEND_COLOR:                        mStateManager.GetFragmentOperationsState()->GetBlendingColor(params); break;
     case GL_BLEND_DST_ALPHA:                    *params = mStateManager.GetFragmentOperationsState()->GetBlendingFactorDestinationAlpha() == 0 ? GL_FALSE : GL_TRUE; break;
     case GL_BLEND_DST_RGB:                      *params = mStateManager.GetFragmentOperationsState()->GetBlendingFactorDestinationRGB() == 0 ? GL_FALSE : GL_TRUE; break;
@@ -157,6 +158,7 @@ Context::GetIntegerv(GLenum pname, GLint* params)
     case GL_IMPLEMENTATION_COLOR_READ_TYPE:     *params = GL_UNSIGNED_BYTE; break;
     case GL_ARRAY_BUFFER_BINDING:               *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)         ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER))   : 0; break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER)) : 0; break;
+    case GL_VERTEX_ARRAY_BINDING_OES:           *params = mResourceManager->GetVertexArrayID(mStateManager.GetActiveObjectsState()->GetActiveVertexArray()); break;
     case GL_RED_BITS:                           GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), params, NULL, NULL, NULL, NULL, NULL); break;
     case GL_BLUE_BITS:                          GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, params, NULL, NULL, NULL, NULL); break;
     case GL_GREEN_BITS:                         GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, NULL, params, NULL, NULL, NULL); break;
@@ -194,8 +196,8 @@ Context::GetIntegerv(GLenum pname, GLint* params)
                                                 params[1] = 1; break;
     case GL_ALIASED_POINT_SIZE_RANGE:           params[0] = 1;
                                                 params[1] = 1; break;
-    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = 0; break;
-    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = 0; break;
+    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = GL_ETC1_RGB8_OES; break;
+    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = GLOVE_NUM_COMPRESSED_TEXTURE_FORMATS; break;
     case GL_SAMPLES:                            *params = static_cast<GLint>(mStateManager.GetFragmentOperationsState()->GetSampleCoverageBits()); break;
     case GL_SAMPLE_BUFFERS:                     *params = mStateManager.GetFragmentOperationsState()->GetMultiSamplingEnabled(); break;
     case GL_SAMPLE_COVERAGE:                    *params = mStateManager.GetFragmentOperationsState()->GetSampleCoverageEnabled(); break;
@@ -262,6 +264,7 @@ Context::GetFloatv(GLenum pname, GLfloat* params)
     case GL_DEPTH_WRITEMASK:                    *params = static_cast<GLfloat>(mStateManager.GetFramebufferOperationsState()->GetDepthMask()); break;
     case GL_DITHER:                             *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetDitheringEnabled()); break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? static_cast<GLfloat>(mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER))) : 0; break;
+    case GL_VERTEX_ARRAY_BINDING_OES:           *params = static_cast<GLfloat>(mResourceManager->GetVertexArrayID(mStateManager.GetActiveObjectsState()->GetActiveVertexArray())); break;
     case GL_FRAMEBUFFER_BINDING:                *params = static_cast<GLfloat>(mStateManager.GetActiveObjectsState()->GetActiveFramebufferObjectID()); break;
     case GL_FRONT_FACE:                         *params = static_cast<GLfloat>(mStateManager.GetRasterizationState()->GetFrontFace()); break;
     case GL_IMPLEMENTATION_COLOR_READ_FORMAT:   *params = GL_RGBA; break;
@@ -303,11 +306,11 @@ Context::GetFloatv(GLenum pname, GLfloat* params)
                                                 params[1] = 1.0f; break;
     case GL_ALIASED_POINT_SIZE_RANGE:           params[0] = 1.0f;
                                                 params[1] = 1.0f; break;
-    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = 0.0f; break;
+    case GL_COMPRESSED_TEXTURE_FORMATS:         *params = static_cast<GLfloat>(GL_ETC1_RGB8_OES); break;
     case GL_DEPTH_RANGE:                        params[0] = mStateManager.GetViewportTransformationState()->GetMinDepthRange();
                                                 params[1] = mStateManager.GetViewportTransformationState()->GetMaxDepthRange(); break;
     case GL_GENERATE_MIPMAP_HINT:               *params = static_cast<GLfloat>(mStateManager.GetHintAspectsState()->GetMode(GL_GENERATE_MIPMAP_HINT)); break;
-    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = 0.0f; break;
+    case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = static_cast<GLfloat>(GLOVE_NUM_COMPRESSED_TEXTURE_FORMATS); break;
     case GL_SAMPLES:                            *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetSampleCoverageBits()); break;
     case GL_SAMPLE_BUFFERS:                     *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetMultiSamplingEnabled()); break;
     case GL_SAMPLE_COVERAGE_INVERT:             *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetSampleCoverageInvert()); break;
@@ -23,6 +23,7 @@
 
 #include "context.h"
 #include "resources/texture.h"
+#include "utils/etc1Decoder.h"
 
 void
 Context::ActiveTexture(GLenum texture)
@@ -130,7 +131,6 @@ Context::DeleteTextures(GLsizei n, const GLuint* textures)
                 tex->Unbind();
             }
 
-            mResourceManager->FramebufferCacheAttachement(tex, texture);
             GLenum target = tex->GetTarget();
             for(int i = 0; i < GLOVE_MAX_COMBINED_TEXTURE_IMAGE_UNITS && target != GL_INVALID_VALUE; ++i) {
                 if(mStateManager.GetActiveObjectsState()->EqualsActiveTexture(target, i, tex)) {
@@ -163,7 +163,7 @@ Context::GenerateMipmap(GLenum target)
         return;
     }
 
-    if(activeTexture->IsCompressed()) {
+    if(activeTexture->IsCompressed() || activeTexture->IsDepthTexture()) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
@@ -284,7 +284,8 @@ Context::GetTexParameterfv(GLenum target, GLenum pname, GLfloat* params)
     }
 
     if(pname != GL_TEXTURE_WRAP_S     && pname != GL_TEXTURE_WRAP_T &&
-       pname != GL_TEXTURE_MIN_FILTER && pname != GL_TEXTURE_MAG_FILTER) {
+       pname != GL_TEXTURE_MIN_FILTER && pname != GL_TEXTURE_MAG_FILTER &&
+       pname != GL_TEXTURE_IMMUTABLE_FORMAT_EXT) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -296,6 +297,7 @@ Context::GetTexParameterfv(GLenum target, GLenum pname, GLfloat* params)
     case GL_TEXTURE_WRAP_T:                     *params = static_cast<GLfloat>(activeTexture->GetWrapT());      break;
     case GL_TEXTURE_MIN_FILTER:                 *params = static_cast<GLfloat>(activeTexture->GetMinFilter());  break;
     case GL_TEXTURE_MAG_FILTER:                 *params = static_cast<GLfloat>(activeTexture->GetMagFilter());  break;
+    case GL_TEXTURE_IMMUTABLE_FORMAT_EXT:       *params = activeTexture->IsImmutable() ? 1.0f : 0.0f;           break;
     default:                                    break;
     }
 }
@@ -311,7 +313,8 @@ Context::GetTexParameteriv(GLenum target, GLenum pname, GLint* params)
     }
 
     if(pname != GL_TEXTURE_WRAP_S     && pname != GL_TEXTURE_WRAP_T &&
-       pname != GL_TEXTURE_MIN_FILTER && pname != GL_TEXTURE_MAG_FILTER) {
+       pname != GL_TEXTURE_MIN_FILTER && pname != GL_TEXTURE_MAG_FILTER &&
+       pname != GL_TEXTURE_IMMUTABLE_FORMAT_EXT) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -323,6 +326,7 @@ Context::GetTexParameteriv(GLenum target, GLenum pname, GLint* params)
     case GL_TEXTURE_WRAP_T:                     *params = activeTexture->GetWrapT();      break;
     case GL_TEXTURE_MIN_FILTER:                 *params = activeTexture->GetMinFilter();  break;
     case GL_TEXTURE_MAG_FILTER:                 *params = activeTexture->GetMagFilter();  break;
+    case GL_TEXTURE_IMMUTABLE_FORMAT_EXT:       *params = activeTexture->IsImmutable() ? GL_TRUE : GL_FALSE; break;
     default:                                    break;
     }
 }
@@ -346,13 +350,14 @@ Context::TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei w
     }
 
     if(format != GL_ALPHA     && format != GL_RGB && format != GL_RGBA &&
-       format != GL_LUMINANCE && format != GL_LUMINANCE_ALPHA) {
+       format != GL_LUMINANCE && format != GL_LUMINANCE_ALPHA && format != GL_DEPTH_COMPONENT) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
 
     if(type != GL_UNSIGNED_BYTE          && type != GL_UNSIGNED_SHORT_5_6_5 &&
-       type != GL_UNSIGNED_SHORT_4_4_4_4 && type != GL_UNSIGNED_SHORT_5_5_5_1) {
+       type != GL_UNSIGNED_SHORT_4_4_4_4 && type != GL_UNSIGNED_SHORT_5_5_5_1 && type != GL_HALF_FLOAT_OES &&
+       type != GL_UNSIGNED_SHORT         && type != GL_UNSIGNED_INT) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -363,7 +368,7 @@ Context::TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei w
     }
 
     if(internalformat != GL_ALPHA     && internalformat != GL_RGB && internalformat != GL_RGBA &&
-       internalformat != GL_LUMINANCE && internalformat != GL_LUMINANCE_ALPHA) {
+       internalformat != GL_LUMINANCE && internalformat != GL_LUMINANCE_ALPHA && internalformat != GL_DEPTH_COMPONENT) {
         RecordError(GL_INVALID_VALUE);
         return;
     }
@@ -386,14 +391,27 @@ Context::TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei w
         return;
     }
 
-    if((type == GL_UNSIGNED_BYTE && format != GL_RGBA && format != GL_RGB &&
+    if(((type == GL_UNSIGNED_BYTE || type == GL_HALF_FLOAT_OES) && format != GL_RGBA && format != GL_RGB &&
         format != GL_LUMINANCE_ALPHA && format != GL_LUMINANCE && format != GL_ALPHA) ||
         (type == GL_UNSIGNED_SHORT_5_6_5                                          && format != GL_RGB) ||
-        ((type == GL_UNSIGNED_SHORT_4_4_4_4 || type == GL_UNSIGNED_SHORT_5_5_5_1) && format != GL_RGBA)) {
+        ((type == GL_UNSIGNED_SHORT_4_4_4_4 || type == GL_UNSIGNED_SHORT_5_5_5_1) && format != GL_RGBA) ||
+        ((type == GL_UNSIGNED_SHORT         || type == GL_UNSIGNED_INT)           && format != GL_DEPTH_COMPONENT)) {
         RecordError(GL_INVALID_OPERATION);
         return;
      }
 
+    // depth textures are render targets only: single level 2D textures without initial data
+    if(format == GL_DEPTH_COMPONENT && (target != GL_TEXTURE_2D || level || pixels)) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
+    if(activeTexture->IsImmutable()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
     if(!width || !height) {
         return;
     }
@@ -403,15 +421,20 @@ Context::TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei w
     }
 
     // copy the buffer contents to the texture
-    Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
     GLint layer = (target == GL_TEXTURE_2D) ? 0 : target - GL_TEXTURE_CUBE_MAP_POSITIVE_X;
     activeTexture->SetState(width, height, level, layer, format, type, mStateManager.GetPixelStorageState()->GetPixelStoreUnpack(), pixels);
 
     if(activeTexture->IsCompleted()) {
-        // pass contents to the driver
-        VkFormat vkformat = activeTexture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(format, type));
-        activeTexture->SetVkFormat(vkformat);
-        activeTexture->Allocate();
+        SetTextureVkFormat(activeTexture, format, type);
+
+        if(format == GL_DEPTH_COMPONENT) {
+            // framebuffers borrow the depth attachment, so it has to exist right away
+            activeTexture->Allocate();
+        } else {
+            // the image is created once, when the texture is first used,
+            // so that a mip chain uploaded level by level is not rebuilt for every level
+            activeTexture->DeferAllocation();
+        }
     }
 }
 
@@ -437,7 +460,7 @@ Context::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
     }
 
     if(type != GL_UNSIGNED_BYTE && type != GL_UNSIGNED_SHORT_5_6_5 &&
-       type != GL_UNSIGNED_SHORT_4_4_4_4 && type != GL_UNSIGNED_SHORT_5_5_5_1) {
+       type != GL_UNSIGNED_SHORT_4_4_4_4 && type != GL_UNSIGNED_SHORT_5_5_5_1 && type != GL_HALF_FLOAT_OES) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -447,7 +470,7 @@ Context::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
         return;
     }
 
-    if((type == GL_UNSIGNED_BYTE && format != GL_RGBA && format != GL_RGB &&
+    if(((type == GL_UNSIGNED_BYTE || type == GL_HALF_FLOAT_OES) && format != GL_RGBA && format != GL_RGB &&
         format != GL_LUMINANCE_ALPHA && format != GL_LUMINANCE && format != GL_ALPHA) ||
         (type == GL_UNSIGNED_SHORT_5_6_5                                          && format != GL_RGB) ||
         ((type == GL_UNSIGNED_SHORT_4_4_4_4 || type == GL_UNSIGNED_SHORT_5_5_5_1) && format != GL_RGBA)) {
@@ -457,11 +480,18 @@ Context::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
 
     Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
     if(activeTexture->GetWidth()  < (xoffset + width ) ||
-       activeTexture->GetHeight() < (yoffset + height)) {
+       activeTexture->GetHeight() < (yoffset + height) ||
+       (activeTexture->IsImmutable() && level >= activeTexture->GetMipLevelsCount())) {
         RecordError(GL_INVALID_VALUE);
         return;
     }
 
+    // ETC1 textures cannot be partially respecified
+    if(activeTexture->IsDepthTexture() || activeTexture->GetFormat() == GL_ETC1_RGB8_OES) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
     // TODO:: We could pass a default subtexture instead
     if(pixels == nullptr) {
         return;
@@ -473,8 +503,10 @@ Context::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
 
     if(mWriteFBO != mSystemFBO && GetResourceManager()->IsTextureAttachedToFBO(activeTexture)) {
         activeTexture->SetFboColorAttached(true);
-        activeTexture->SetDataNoInvertion(true);
-        CopyTexImage2D(target, level, format, 0, 0, activeTexture->GetWidth(), activeTexture->GetHeight(), 0);
+        if(!activeTexture->IsImmutable()) {
+            activeTexture->SetDataNoInvertion(true);
+            CopyTexImage2D(target, level, format, 0, 0, activeTexture->GetWidth(), activeTexture->GetHeight(), 0);
+        }
     }
 
     GLint layer = (target == GL_TEXTURE_2D) ? 0 : target - GL_TEXTURE_CUBE_MAP_POSITIVE_X;
@@ -490,14 +522,18 @@ Context::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
                       GlTypeToElementSize(activeTexture->GetType()),
                       Texture::GetDefaultInternalAlignment());
 
+    // immutable storage is never reallocated, so no host copy is kept for it
+    if(activeTexture->IsImmutable()) {
+        activeTexture->UpdateSubImage(&srcRect, xoffset, yoffset, level, layer, srcInternalFormat, pixels);
+        return;
+    }
+
     // copy the buffer contents to the texture
     activeTexture->SetSubState(&srcRect, &dstRect, level, layer, srcInternalFormat, pixels);
 
-    if(activeTexture->IsCompleted()) {
-        // pass contents to the driver
-        VkFormat vkformat = activeTexture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(format, type));
-        activeTexture->SetVkFormat(vkformat);
-        activeTexture->Allocate();
+    // a pending allocation uploads the whole texture anyway, otherwise only the subimage is copied
+    if(activeTexture->IsCompleted() && !activeTexture->IsAllocationPending() && level < activeTexture->GetMipLevelsCount()) {
+        activeTexture->UpdateSubImage(&srcRect, xoffset, yoffset, level, layer, srcInternalFormat, pixels);
     }
 }
 
@@ -540,6 +576,11 @@ Context::CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint
         return;
     }
 
+    // the default framebuffer is read from the image of the current frame, which may not have been acquired yet
+    if(!AcquireSurfaceImage()) {
+        return;
+    }
+
     if(mWriteFBO->IsInDrawState()) {
         Finish();
     }
@@ -550,6 +591,10 @@ Context::CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint
     }
 
     Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
+    if(activeTexture->IsImmutable()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
 
     const GLenum fbFormat = fbTexture->GetFormat();
     if((fbFormat == GL_ALPHA  && internalformat != GL_ALPHA) ||
@@ -586,10 +631,8 @@ Context::CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint
     delete[] stagePixels;
 
     if(activeTexture->IsCompleted()) {
-        // pass contents to the driver
-        VkFormat vkformat = activeTexture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(activeTexture->GetFormat(), activeTexture->GetType()));
-        activeTexture->SetVkFormat(vkformat);
-        activeTexture->Allocate();
+        SetTextureVkFormat(activeTexture, dstInternalFormat, dstType);
+        activeTexture->DeferAllocation();
     }
 }
 
@@ -623,6 +666,11 @@ Context::CopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoff
         return;
     }
 
+    // the default framebuffer is read from the image of the current frame, which may not have been acquired yet
+    if(!AcquireSurfaceImage()) {
+        return;
+    }
+
     if(mWriteFBO->IsInDrawState()) {
         Finish();
     }
@@ -634,7 +682,8 @@ Context::CopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoff
 
     const GLenum fbFormat       = fbTexture->GetFormat();
     const GLenum internalformat = activeTexture->GetInternalFormat();
-    if((fbFormat == GL_ALPHA &&  internalformat != GL_ALPHA) ||
+    if(activeTexture->IsDepthTexture() || internalformat == GL_ETC1_RGB8_OES ||
+       (fbFormat == GL_ALPHA &&  internalformat != GL_ALPHA) ||
        (fbFormat == GL_RGB   && (internalformat != GL_LUMINANCE && internalformat != GL_RGB))) {
        RecordError(GL_INVALID_OPERATION);
        return;
@@ -665,14 +714,16 @@ Context::CopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoff
     srcRect.x = 0; srcRect.y = 0;
     // now copy the temp buffer contents to the texture
     // source and destination rectangles have now similar properties except from their x,y offsets
-    activeTexture->SetSubState(&srcRect, &dstRect, level, layer, dstInternalFormat, stagePixels);
-    delete[] stagePixels;
+    if(activeTexture->IsImmutable()) {
+        activeTexture->UpdateSubImage(&srcRect, xoffset, yoffset, level, layer, dstInternalFormat, stagePixels);
+    } else {
+        activeTexture->SetSubState(&srcRect, &dstRect, level, layer, dstInternalFormat, stagePixels);
 
-    if(activeTexture->IsCompleted()) {
-        VkFormat vkformat = activeTexture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(activeTexture->GetFormat(), activeTexture->GetType()));
-        activeTexture->SetVkFormat(vkformat);
-        activeTexture->Allocate();
+        if(activeTexture->IsCompleted() && !activeTexture->IsAllocationPending() && level < activeTexture->GetMipLevelsCount()) {
+            activeTexture->UpdateSubImage(&srcRect, xoffset, yoffset, level, layer, dstInternalFormat, stagePixels);
+        }
     }
+    delete[] stagePixels;
 }
 
 void
@@ -685,8 +736,7 @@ Context::CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat,
         return;
     }
 
-    if(internalformat != GL_ALPHA     && internalformat != GL_RGB && internalformat != GL_RGBA &&
-       internalformat != GL_LUMINANCE && internalformat != GL_LUMINANCE_ALPHA) {
+    if(internalformat != GL_ETC1_RGB8_OES) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -704,15 +754,38 @@ Context::CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat,
         return;
      }
 
+    if((target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) && (width != height)) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    if(imageSize < 0 || static_cast<size_t>(imageSize) != Etc1ImageSize(width, height)) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
+    if(activeTexture->IsImmutable()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
     if(width == 0 || height == 0) {
         return;
     }
 
-    // TODO:
-    //GL_INVALID_VALUE is generated if imageSize is not consistent with the format, dimensions, and contents of the specified compressed image data.
-    //GL_INVALID_OPERATION is generated if parameter combinations are not supported by the specific compressed internal format as specified in the specific texture compression extension.
+    if(mWriteFBO->IsInDrawState()) {
+        Finish();
+    }
+
+    // the blocks are uploaded or decoded when the texture is first used
+    GLint layer = (target == GL_TEXTURE_2D) ? 0 : target - GL_TEXTURE_CUBE_MAP_POSITIVE_X;
+    activeTexture->SetCompressedState(width, height, level, layer, internalformat, imageSize, data);
 
-    NOT_IMPLEMENTED();
+    if(activeTexture->IsCompleted()) {
+        SetTextureVkFormat(activeTexture, internalformat, GL_UNSIGNED_BYTE);
+        activeTexture->DeferAllocation();
+    }
 }
 
 void
@@ -725,8 +798,7 @@ Context::CompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLin
         return;
     }
 
-    if(format != GL_ALPHA     && format != GL_RGB && format != GL_RGBA &&
-       format != GL_LUMINANCE && format != GL_LUMINANCE_ALPHA) {
+    if(format != GL_ETC1_RGB8_OES) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -750,9 +822,115 @@ Context::CompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLin
         return;
     }
 
-    // TODO:
-    //GL_INVALID_VALUE is generated if imageSize is not consistent with the format, dimensions, and contents of the specified compressed image data.
-    //GL_INVALID_OPERATION is generated if parameter combinations are not supported by the specific compressed internal format as specified in the specific texture compression extension.
+    // OES_compressed_ETC1_RGB8_texture does not allow sub-image updates
+    RecordError(GL_INVALID_OPERATION);
+}
+
+void
+Context::SetTextureVkFormat(Texture *texture, GLenum format, GLenum type)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(format == GL_DEPTH_COMPONENT) {
+        // sampled only, the depth attachment is allocated by the texture
+        texture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT));
+        texture->SetVkImageTiling(VK_IMAGE_TILING_OPTIMAL);
+        texture->SetVkFormat(FindSupportedDepthStencilFormat(mVkContext->vkGpus[0], type == GL_UNSIGNED_SHORT ? 16 : 24, 0));
+        return;
+    }
+
+    if(format == GL_ETC1_RGB8_OES) {
+        // ETC1 is a subset of ETC2, otherwise the blocks are decoded to RGBA8
+        texture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT));
+        texture->SetVkImageTiling(VK_IMAGE_TILING_OPTIMAL);
+
+        bool native = mVkContext->mIsTextureCompressionETC2Supported &&
+                      FindSupportedFormat(mVkContext->vkGpus[0], {VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK},
+                                          VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != VK_FORMAT_UNDEFINED;
+        texture->SetVkFormat(native ? VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK : VK_FORMAT_R8G8B8A8_UNORM);
+        return;
+    }
+
+    // depth and compressed textures are not renderable
+    if(!(texture->GetImage()->GetImageUsage() & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)) {
+        texture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
+        texture->SetVkImageTiling();
+    }
+
+    // pass contents to the driver
+    VkFormat vkformat = texture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(format, type));
+    texture->SetVkFormat(vkformat);
+}
+
+void
+Context::TexStorage2DEXT(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_TEXTURE_2D && target != GL_TEXTURE_CUBE_MAP) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    GLenum format;
+    GLenum type;
+    switch(internalformat) {
+    case GL_ALPHA8_EXT:                 format = GL_ALPHA;           type = GL_UNSIGNED_BYTE;          break;
+    case GL_LUMINANCE8_EXT:             format = GL_LUMINANCE;       type = GL_UNSIGNED_BYTE;          break;
+    case GL_LUMINANCE8_ALPHA8_EXT:      format = GL_LUMINANCE_ALPHA; type = GL_UNSIGNED_BYTE;          break;
+    case GL_RGB8_OES:                   format = GL_RGB;             type = GL_UNSIGNED_BYTE;          break;
+    case GL_RGBA8_OES:                  format = GL_RGBA;            type = GL_UNSIGNED_BYTE;          break;
+    case GL_RGB565:                     format = GL_RGB;             type = GL_UNSIGNED_SHORT_5_6_5;   break;
+    case GL_RGBA4:                      format = GL_RGBA;            type = GL_UNSIGNED_SHORT_4_4_4_4; break;
+    case GL_RGB5_A1:                    format = GL_RGBA;            type = GL_UNSIGNED_SHORT_5_5_5_1; break;
+    case GL_ALPHA16F_EXT:               format = GL_ALPHA;           type = GL_HALF_FLOAT_OES;         break;
+    case GL_LUMINANCE16F_EXT:           format = GL_LUMINANCE;       type = GL_HALF_FLOAT_OES;         break;
+    case GL_LUMINANCE_ALPHA16F_EXT:     format = GL_LUMINANCE_ALPHA; type = GL_HALF_FLOAT_OES;         break;
+    case GL_RGB16F_EXT:                 format = GL_RGB;             type = GL_HALF_FLOAT_OES;         break;
+    case GL_RGBA16F_EXT:                format = GL_RGBA;            type = GL_HALF_FLOAT_OES;         break;
+    case GL_DEPTH_COMPONENT16:          format = GL_DEPTH_COMPONENT; type = GL_UNSIGNED_SHORT;         break;
+    case GL_DEPTH_COMPONENT32_OES:      format = GL_DEPTH_COMPONENT; type = GL_UNSIGNED_INT;           break;
+    default:                            RecordError(GL_INVALID_ENUM);                                  return;
+    }
+
+    if(levels < 1 || width < 1 || height < 1 ||
+       ((width > GLOVE_MAX_TEXTURE_SIZE || height > GLOVE_MAX_TEXTURE_SIZE) && target == GL_TEXTURE_2D) ||
+       ((width > GLOVE_MAX_CUBE_MAP_TEXTURE_SIZE || height > GLOVE_MAX_CUBE_MAP_TEXTURE_SIZE) && target != GL_TEXTURE_2D) ||
+       (target == GL_TEXTURE_CUBE_MAP && width != height)) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    if(levels > static_cast<GLsizei>(log2(std::max(width, height))) + 1) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(target);
+    if(!mResourceManager->GetTextureID(activeTexture) || activeTexture->IsImmutable()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    // depth textures are render targets only
+    if(format == GL_DEPTH_COMPONENT && (target != GL_TEXTURE_2D || levels != 1)) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    if(mWriteFBO->IsInDrawState()) {
+        Finish();
+    }
+
+    // specify every level at once, so that the image is created a single time with its final level count
+    for(GLint layer = 0; layer < activeTexture->GetLayersCount(); ++layer) {
+        for(GLint level = 0; level < levels; ++level) {
+            activeTexture->SetState(std::max(width >> level, 1), std::max(height >> level, 1), level, layer, format, type,
+                                    Texture::GetDefaultInternalAlignment(), nullptr);
+        }
+    }
+    activeTexture->SetImmutable(levels);
 
-    NOT_IMPLEMENTED();
+    SetTextureVkFormat(activeTexture, format, type);
+    activeTexture->Allocate();
 }
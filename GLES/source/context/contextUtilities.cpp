@@ -44,7 +44,7 @@ Context::GetString(GLenum name)
                                   "OpenGL ES 2.0 Over Vulkan\0",
                                   "OpenGL ES 2.0\0",
                                   "OpenGL ES GLSL ES 1.00\0",
-                                  "GL_OES_get_program_binary GL_OES_rgb8_rgba8 GL_OES_depth24 GL_OES_depth32 GL_OES_stencil4 GL_OES_texture_stencil8 GL_OES_required_internalformat GL_OES_packed_depth_stencil GL_APPLE_texture_format_BGRA8888\0"};
+                                  "GL_OES_get_program_binary GL_OES_rgb8_rgba8 GL_OES_depth24 GL_OES_depth32 GL_OES_stencil4 GL_OES_texture_stencil8 GL_OES_required_internalformat GL_OES_packed_depth_stencil GL_APPLE_texture_format_BGRA8888 GL_OES_vertex_array_object GL_EXT_draw_instanced GL_EXT_instanced_arrays GL_ANGLE_instanced_arrays GL_OES_element_index_uint GL_OES_mapbuffer GL_EXT_map_buffer_range GL_EXT_multi_draw_arrays GL_OES_texture_half_float GL_OES_texture_half_float_linear GL_OES_vertex_half_float GL_EXT_color_buffer_half_float GL_OES_depth_texture GL_EXT_texture_storage GL_OES_compressed_ETC1_RGB8_texture GL_KHR_no_error GL_OES_EGL_sync\0"};
     switch(name) {
     case GL_VENDOR:                     return (const GLubyte *)strings[0];
     case GL_RENDERER:                   return (const GLubyte *)strings[1];
@@ -33,7 +33,7 @@ Context::GetVertexAttribfv(GLuint index, GLenum pname, GLfloat* params)
         return;
     }
 
-    const GenericVertexAttribute* gVertexAttrib = mResourceManager->GetGenericVertexAttribute(index);
+    const GenericVertexAttribute* gVertexAttrib = GetGenericVertexAttribute(index);
 
     switch(pname) {
     case GL_VERTEX_ATTRIB_ARRAY_ENABLED:        *params = static_cast<GLfloat>(gVertexAttrib->IsEnabled());     break;
@@ -41,6 +41,7 @@ Context::GetVertexAttribfv(GLuint index, GLenum pname, GLfloat* params)
     case GL_VERTEX_ATTRIB_ARRAY_STRIDE:         *params = static_cast<GLfloat>(gVertexAttrib->GetStride());      break;
     case GL_VERTEX_ATTRIB_ARRAY_TYPE:           *params = static_cast<GLfloat>(gVertexAttrib->GetType());        break;
     case GL_VERTEX_ATTRIB_ARRAY_NORMALIZED:     *params = static_cast<GLfloat>(gVertexAttrib->GetNormalized());  break;
+    case GL_VERTEX_ATTRIB_ARRAY_DIVISOR_EXT:    *params = static_cast<GLfloat>(gVertexAttrib->GetDivisor());     break;
     case GL_CURRENT_VERTEX_ATTRIB:              gVertexAttrib->GetGenericValue(params);                          break;
     case GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING: { const BufferObject *vbo = gVertexAttrib->GetExternalVbo();
                                                   *params = vbo ? static_cast<GLfloat>(mResourceManager->GetBufferID(vbo)) : 0.0f;
@@ -60,7 +61,7 @@ Context::GetVertexAttribiv(GLuint index, GLenum pname, GLint* params)
         return;
     }
 
-    const GenericVertexAttribute* gVertexAttrib = mResourceManager->GetGenericVertexAttribute(index);
+    const GenericVertexAttribute* gVertexAttrib = GetGenericVertexAttribute(index);
 
     switch(pname) {
     case GL_VERTEX_ATTRIB_ARRAY_ENABLED:        *params = static_cast<GLint>(gVertexAttrib->IsEnabled());          break;
@@ -68,6 +69,7 @@ Context::GetVertexAttribiv(GLuint index, GLenum pname, GLint* params)
     case GL_VERTEX_ATTRIB_ARRAY_STRIDE:         *params = static_cast<GLint>(gVertexAttrib->GetStride());           break;
     case GL_VERTEX_ATTRIB_ARRAY_TYPE:           *params = static_cast<GLint>(gVertexAttrib->GetType());             break;
     case GL_VERTEX_ATTRIB_ARRAY_NORMALIZED:     *params = static_cast<GLint>(gVertexAttrib->GetNormalized());       break;
+    case GL_VERTEX_ATTRIB_ARRAY_DIVISOR_EXT:    *params = static_cast<GLint>(gVertexAttrib->GetDivisor());          break;
     case GL_CURRENT_VERTEX_ATTRIB:              gVertexAttrib->GetGenericValue(params); break;
     case GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING: { const BufferObject *vbo = gVertexAttrib->GetExternalVbo();
                                                   *params = vbo ? static_cast<GLint>(mResourceManager->GetBufferID(vbo)) : 0;
@@ -92,7 +94,7 @@ Context::GetVertexAttribPointerv(GLuint index, GLenum pname, void **pointer)
         return;
     }
 
-    *pointer = reinterpret_cast<void *>(mResourceManager->GetGenericVertexAttribute(index)->GetPointer());
+    *pointer = reinterpret_cast<void *>(GetGenericVertexAttribute(index)->GetPointer());
 }
 
 void
@@ -106,7 +108,7 @@ Context::VertexAttrib1f(GLuint index, GLfloat x)
     }
 
     GLfloat vals[4] = {x, 0.0f, 0.0f, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
+    GetGenericVertexAttribute(index)->SetGenericValue(vals);
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
 
@@ -121,7 +123,7 @@ Context::VertexAttrib1fv(GLuint index, const GLfloat* values)
     }
 
     GLfloat vals[4] = {values[0], 0.0f, 0.0f, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
+    GetGenericVertexAttribute(index)->SetGenericValue(vals);
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
 
@@ -136,7 +138,7 @@ Context::VertexAttrib2f(GLuint index, GLfloat x, GLfloat y)
     }
 
     GLfloat vals[4] = {x, y, 0.0f, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
+    GetGenericVertexAttribute(index)->SetGenericValue(vals);
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
 
@@ -151,7 +153,7 @@ Context::VertexAttrib2fv(GLuint index, const GLfloat* values)
     }
 
     GLfloat vals[4] = {values[0], values[1], 0.0f, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
+    GetGenericVertexAttribute(index)->SetGenericValue(vals);
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
 
@@ -166,7 +168,7 @@ Context::VertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z)
     }
 
     GLfloat vals[4] = {x, y, z, 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
+    GetGenericVertexAttribute(index)->SetGenericValue(vals);
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
 
@@ -181,7 +183,7 @@ Context::VertexAttrib3fv(GLuint index, const GLfloat* values)
     }
 
     GLfloat vals[4] = {values[0], values[1], values[2], 1.0f};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
+    GetGenericVertexAttribute(index)->SetGenericValue(vals);
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
 
@@ -196,7 +198,7 @@ Context::VertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w
     }
 
     GLfloat vals[4] = {x, y, z, w};
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(vals);
+    GetGenericVertexAttribute(index)->SetGenericValue(vals);
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
 
@@ -210,7 +212,7 @@ Context::VertexAttrib4fv(GLuint index, const GLfloat* values)
         return;
     }
 
-    mResourceManager->GetGenericVertexAttribute(index)->SetGenericValue(values);
+    GetGenericVertexAttribute(index)->SetGenericValue(values);
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
 
@@ -224,10 +226,11 @@ Context::EnableVertexAttribArray(GLuint index)
         return;
     }
 
-    GenericVertexAttribute *gVertexAttrib = mResourceManager->GetGenericVertexAttribute(index);
+    GenericVertexAttribute *gVertexAttrib = GetGenericVertexAttribute(index);
 
     if(!gVertexAttrib->IsEnabled()) {
         gVertexAttrib->SetEnabled(true);
+        mStateManager.GetActiveObjectsState()->GetActiveVertexArray()->Invalidate();
         mPipeline->SetUpdateVertexAttribVBOs(true);
     }
 }
@@ -242,10 +245,11 @@ Context::DisableVertexAttribArray(GLuint index)
         return;
     }
 
-    GenericVertexAttribute *gVertexAttrib = mResourceManager->GetGenericVertexAttribute(index);
+    GenericVertexAttribute *gVertexAttrib = GetGenericVertexAttribute(index);
 
     if(gVertexAttrib->IsEnabled()) {
         gVertexAttrib->SetEnabled(false);
+        mStateManager.GetActiveObjectsState()->GetActiveVertexArray()->Invalidate();
         mPipeline->SetUpdateVertexAttribVBOs(true);
     }
 }
@@ -255,7 +259,7 @@ Context::VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean no
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(type != GL_BYTE && type != GL_UNSIGNED_BYTE && type != GL_SHORT && type != GL_UNSIGNED_SHORT && type != GL_FIXED && type != GL_FLOAT) {
+    if(type != GL_BYTE && type != GL_UNSIGNED_BYTE && type != GL_SHORT && type != GL_UNSIGNED_SHORT && type != GL_FIXED && type != GL_FLOAT && type != GL_HALF_FLOAT_OES) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -267,6 +271,127 @@ Context::VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean no
 
     BufferObject* attachedVBO = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER);
     bool requiresInternalVBO = attachedVBO == nullptr;
-    mResourceManager->GetGenericVertexAttribute(index)->Set(size, type, normalized, stride, ptr, attachedVBO, requiresInternalVBO);
+    GetGenericVertexAttribute(index)->Set(size, type, normalized, stride, ptr, attachedVBO, requiresInternalVBO);
+    mStateManager.GetActiveObjectsState()->GetActiveVertexArray()->Invalidate();
     mPipeline->SetUpdateVertexAttribVBOs(true);
 }
+
+void
+Context::VertexAttribDivisorEXT(GLuint index, GLuint divisor)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(index >= GLOVE_MAX_VERTEX_ATTRIBS) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    GenericVertexAttribute *gVertexAttrib = GetGenericVertexAttribute(index);
+
+    if(gVertexAttrib->GetDivisor() != divisor) {
+        gVertexAttrib->SetDivisor(divisor);
+        mStateManager.GetActiveObjectsState()->GetActiveVertexArray()->Invalidate();
+        mPipeline->SetUpdateVertexAttribVBOs(true);
+    }
+}
+
+void
+Context::SetActiveVertexArray(VertexArrayObject *vao)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    StateActiveObjects *activeObjects = mStateManager.GetActiveObjectsState();
+    VertexArrayObject *activeVao = activeObjects->GetActiveVertexArray();
+    if(activeVao == vao) {
+        return;
+    }
+
+    // the element array buffer binding is part of the vertex array object state,
+    // whereas the current generic attribute values are not
+    activeVao->SetElementArrayBuffer(activeObjects->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER));
+    vao->SetGenericValues(activeVao);
+
+    activeObjects->SetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER, vao->GetElementArrayBuffer());
+    activeObjects->SetActiveVertexArray(vao);
+    mPipeline->SetUpdateIndexBuffer(true);
+}
+
+void
+Context::BindVertexArrayOES(GLuint array)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(array && !mResourceManager->VertexArrayExists(array)) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    SetActiveVertexArray(array ? mResourceManager->GetVertexArray(array) : mResourceManager->GetDefaultVertexArray());
+}
+
+void
+Context::DeleteVertexArraysOES(GLsizei n, const GLuint *arrays)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(n < 0) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    if(arrays == nullptr) {
+        return;
+    }
+
+    if(mWriteFBO->IsInDrawState()) {
+        Finish();
+    }
+
+    while(n-- != 0) {
+        uint32_t array = *arrays++;
+
+        if(array && mResourceManager->VertexArrayExists(array)) {
+            VertexArrayObject *vao = mResourceManager->GetVertexArray(array);
+
+            if(mStateManager.GetActiveObjectsState()->GetActiveVertexArray() == vao) {
+                SetActiveVertexArray(mResourceManager->GetDefaultVertexArray());
+            }
+
+            BufferObject *ibo = vao->GetElementArrayBuffer();
+            if(ibo) {
+                ibo->Unbind();
+            }
+
+            mResourceManager->DeallocateVertexArray(array);
+        }
+    }
+    mResourceManager->CleanPurgeList();
+}
+
+void
+Context::GenVertexArraysOES(GLsizei n, GLuint *arrays)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(n < 0) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    if(arrays == nullptr) {
+        return;
+    }
+
+    while(n != 0) {
+        *arrays++ = mResourceManager->AllocateVertexArray();
+        --n;
+    }
+}
+
+GLboolean
+Context::IsVertexArrayOES(GLuint array)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    return (array != 0 && mResourceManager->VertexArrayExists(array)) ? GL_TRUE : GL_FALSE;
+}
@@ -116,6 +116,10 @@ AccessChainList ReportSampler(const glslang::TIntermediate *TI)
 
 } // end of anon namespace
 
+/// ESSL 1.00 has no instance id built-in. gl_InstanceIDEXT (GL_EXT_draw_instanced) is only
+/// given a placeholder value for validation, the converted shader maps it to gl_InstanceIndex
+const char * const GlslangCompiler::esslVertexPreamble = "#define gl_InstanceIDEXT 0\n";
+
 GlslangCompiler::GlslangCompiler()
 {
     FUN_ENTRY(GL_LOG_TRACE);
@@ -191,6 +195,9 @@ GlslangCompiler::CompileShader(const char* const* source, const TBuiltInResource
     SafeDelete(mShaderMap[version]);
     mShaderMap[version] = new glslang::TShader(language);
     mShaderMap[version]->setStrings(source, 1);
+    if(version == ESSL_VERSION_100 && language == EShLangVertex) {
+        mShaderMap[version]->setPreamble(esslVertexPreamble);
+    }
 
     bool result = mShaderMap[version]->parse(resources, version, profile, false, false, messages);
     if(!result) {
@@ -198,6 +205,9 @@ GlslangCompiler::CompileShader(const char* const* source, const TBuiltInResource
             SafeDelete(mShaderMap[version]);
             mShaderMap[version] = new glslang::TShader(language);
             mShaderMap[version]->setStrings(source, 1);
+            if(version == ESSL_VERSION_100 && language == EShLangVertex) {
+                mShaderMap[version]->setPreamble(esslVertexPreamble);
+            }
             messages = static_cast<EShMessages>(EShMsgOnlyPreprocessor | EShMsgRelaxedErrors);
             if(version == ESSL_VERSION_400) {
                 messages = static_cast<EShMessages>(messages | EShMsgVulkanRules | EShMsgSpvRules);
@@ -41,6 +41,8 @@ inline EShMessages operator|(EShMessages lsh, EShMessages rsh) {
 class GlslangCompiler {
 
 private:
+    static const char * const                  esslVertexPreamble;
+
     std::map<ESSL_VERSION, glslang::TShader *> mShaderMap;
 
     void                 Release(void);
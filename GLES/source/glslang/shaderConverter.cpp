@@ -64,6 +64,10 @@ const char * const ShaderConverter::shaderDepthRange = "/// GL_KHR_vulkan_glsl r
                                                        "#define gl_DepthRange " STRINGIFY_MACRO(GLOVE_VULKAN_DEPTH_RANGE) "\n"
                                                        "\n";
 
+const char * const ShaderConverter::shaderInstanceId = "/// GL_KHR_vulkan_glsl replaced gl_InstanceID with gl_InstanceIndex\n"
+                                                       "#define gl_InstanceIDEXT gl_InstanceIndex\n"
+                                                       "\n";
+
 const char * const ShaderConverter::shaderLimitsBuiltIns = "#define gl_MaxVertexAttribs "              STRINGIFY_MACRO(GLOVE_MAX_VERTEX_ATTRIBS) "\n"
                                                            "#define gl_MaxVertexUniformVectors "       STRINGIFY_MACRO(GLOVE_MAX_VERTEX_UNIFORM_VECTORS) "\n"
                                                            "#define gl_MaxVaryingVectors "             STRINGIFY_MACRO(GLOVE_MAX_VARYING_VECTORS) "\n"
@@ -149,6 +153,7 @@ ShaderConverter::ProcessHeader(std::string& source, const uniformBlockMap_t &uni
                                 string(shaderTexture2d) +
                                 string(shaderTextureCube) +
                                 (depthRangeActive ? string(shaderDepthRange) : string("")) +
+                                (mShaderType == SHADER_TYPE_VERTEX ? string(shaderInstanceId) : string("")) +
                                 string(shaderLimitsBuiltIns);
 
     /// If #version is present
@@ -54,6 +54,7 @@ private:
     static const char * const   shaderTexture2d;
     static const char * const   shaderTextureCube;
     static const char * const   shaderDepthRange;
+    static const char * const   shaderInstanceId;
     static const char * const   shaderLimitsBuiltIns;
 
     shader_conversion_type_t    mConversionType;
@@ -29,7 +29,7 @@
 #include "attachment.h"
 
 Attachment::Attachment(Texture *tex)
-: mType(GL_NONE), mName(0), mLevel(0), mLayer(GL_TEXTURE_CUBE_MAP_POSITIVE_X), mTexture(tex)
+: mType(GL_NONE), mName(0), mLevel(0), mLayer(GL_TEXTURE_CUBE_MAP_POSITIVE_X), mTexture(tex), mRenderbuffer(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -24,7 +24,7 @@
 #ifndef __ATTACHMENT_H__
 #define __ATTACHMENT_H__
 
-#include "texture.h"
+#include "renderbuffer.h"
 
 class Attachment {
 
@@ -34,6 +34,7 @@ private:
     GLint                   mLevel;
     GLenum                  mLayer;
     Texture *               mTexture;
+    Renderbuffer *          mRenderbuffer;
 
 public:
     Attachment(Texture *tex = nullptr);
@@ -45,6 +46,10 @@ public:
     inline GLint            GetLevel(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mLevel;    }
     inline GLenum           GetLayer(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mLayer;    }
     inline Texture *        GetTexture(void)                            const   { FUN_ENTRY(GL_LOG_TRACE); return mTexture;  }
+    inline Renderbuffer *   GetRenderbuffer(void)                       const   { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffer; }
+    /// The texture that holds the image of the attached texture or renderbuffer
+    inline Texture *        GetAttachedTexture(void)                    const   { FUN_ENTRY(GL_LOG_TRACE); return mType == GL_TEXTURE      ? mTexture                    :
+                                                                                                                  mType == GL_RENDERBUFFER ? mRenderbuffer->GetTexture() : nullptr; }
 
 // Set Functions
     inline void             SetType(GLenum type)                                { FUN_ENTRY(GL_LOG_TRACE); mType    = type;  }
@@ -52,6 +57,7 @@ public:
     inline void             SetLevel(GLint level)                               { FUN_ENTRY(GL_LOG_TRACE); mLevel   = level; }
     inline void             SetLayer(GLenum layer)                              { FUN_ENTRY(GL_LOG_TRACE); mLayer   = layer; }
     inline void             SetTexture(Texture *tex)                            { FUN_ENTRY(GL_LOG_TRACE); mTexture = tex;   }
+    inline void             SetRenderbuffer(Renderbuffer *rb)                   { FUN_ENTRY(GL_LOG_TRACE); mRenderbuffer = rb; }
 };
 
 #endif // __ATTACHMENT_H__
@@ -28,9 +28,14 @@
  */
 
 #include "bufferObject.h"
+#include "vulkan/queueTracker.h"
+#include <algorithm>
 
 BufferObject::BufferObject(const vulkanAPI::vkContext_t *vkContext, const VkBufferUsageFlags vkBufferUsageFlags, const VkSharingMode vkSharingMode, const VkFlags vkFlags)
-: mVkContext(vkContext), mUsage(GL_STATIC_DRAW), mTarget(GL_INVALID_VALUE), mAllocated(false)
+: mVkContext(vkContext), mUsage(GL_STATIC_DRAW), mTarget(GL_INVALID_VALUE), mAllocated(false),
+  mVkSharingMode(vkSharingMode), mVkMemoryFlags(vkFlags),
+  mMapped(false), mMapAccess(0), mMapOffset(0), mMapLength(0),
+  mUseEpoch(0), mDataVersion(0)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
@@ -42,6 +47,7 @@ BufferObject::~BufferObject()
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    ReleaseRetiredStorages();
     delete mBuffer;
     delete mMemory;
 }
@@ -51,9 +57,45 @@ BufferObject::Release()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    // retired storages are kept, pending commands may still read them
     mBuffer->Release();
     mMemory->Release();
-    mAllocated = false;
+    mAllocated  = false;
+    mMapped     = false;
+    mMapAccess  = 0;
+    mMapOffset  = 0;
+    mMapLength  = 0;
+    mUseEpoch   = 0;
+}
+
+void
+BufferObject::ReleaseRetiredStorages(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(auto& storage : mRetiredStorages) {
+        delete storage.buffer;
+        delete storage.memory;
+    }
+    mRetiredStorages.clear();
+}
+
+void
+BufferObject::ReleaseCompletedStorages(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // storages whose last use has completed are no longer read by pending commands of any context
+    for(auto it = mRetiredStorages.begin(); it != mRetiredStorages.end();) {
+        if(!mVkContext->vkQueueTracker->IsCompleted(it->useEpoch)) {
+            ++it;
+            continue;
+        }
+
+        delete it->buffer;
+        delete it->memory;
+        it = mRetiredStorages.erase(it);
+    }
 }
 
 bool
@@ -62,6 +104,7 @@ BufferObject::Allocate(size_t size, const void *data)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     mBuffer->SetSize(size);
+    ++mDataVersion;
 
     mAllocated = mBuffer->Create()                                            &&
                  mMemory->GetBufferMemoryRequirements(mBuffer->GetVkBuffer()) &&
@@ -85,6 +128,144 @@ BufferObject::UpdateData(size_t size, size_t offset, const void *data)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     mMemory->UpdateData(size, offset, data);
+    ++mDataVersion;
+}
+
+bool
+BufferObject::Orphan(size_t size, bool preserveContents)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // The current storage may still be read by pending commands, so it is retired and
+    // a new version takes its place. Retired storages whose last use has completed on
+    // the queue are no longer in use: one of the requested size is recycled, the rest
+    // are freed.
+    vulkanAPI::Buffer *buffer = nullptr;
+    vulkanAPI::Memory *memory = nullptr;
+
+    for(auto it = mRetiredStorages.begin(); it != mRetiredStorages.end();) {
+        if(!mVkContext->vkQueueTracker->IsCompleted(it->useEpoch)) {
+            ++it;
+            continue;
+        }
+
+        if(buffer == nullptr && it->buffer->GetSize() == size) {
+            buffer = it->buffer;
+            memory = it->memory;
+        } else {
+            delete it->buffer;
+            delete it->memory;
+        }
+        it = mRetiredStorages.erase(it);
+    }
+
+    if(buffer == nullptr) {
+        buffer = new vulkanAPI::Buffer(mVkContext, mBuffer->GetFlags(), mVkSharingMode);
+        memory = new vulkanAPI::Memory(mVkContext, mVkMemoryFlags);
+        buffer->SetSize(size);
+
+        if(!(buffer->Create()                                            &&
+             memory->GetBufferMemoryRequirements(buffer->GetVkBuffer()) &&
+             memory->Create()                                            &&
+             memory->BindBufferMemory(buffer->GetVkBuffer()))) {
+            delete buffer;
+            delete memory;
+            return false;
+        }
+    }
+
+    // copy-on-write: the new version starts with the contents that pending commands see
+    if(preserveContents) {
+        uint8_t *data = memory->Map();
+        if(data == nullptr || !mMemory->GetData(std::min(size, GetSize()), 0, data)) {
+            mRetiredStorages.push_back({ buffer, memory, 0 });
+            return false;
+        }
+        memory->FlushMappedData();
+    }
+
+    mRetiredStorages.push_back({ mBuffer, mMemory, mUseEpoch });
+    mBuffer     = buffer;
+    mMemory     = memory;
+    mAllocated  = true;
+    mUseEpoch   = 0;
+    ++mDataVersion;
+
+    return true;
+}
+
+void
+BufferObject::SetUsed(uint64_t useEpoch)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // contexts drawing concurrently may stamp out of order, so only a later epoch replaces the current one
+    uint64_t epoch = mUseEpoch;
+    while(epoch < useEpoch && !mUseEpoch.compare_exchange_weak(epoch, useEpoch)) {
+    }
+}
+
+bool
+BufferObject::IsInUse(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    uint64_t epoch = mUseEpoch;
+    return epoch != 0 && !mVkContext->vkQueueTracker->IsCompleted(epoch);
+}
+
+void*
+BufferObject::Map(size_t offset, size_t length, GLbitfield access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    uint8_t *data = mMemory->Map();
+    if(data == nullptr) {
+        return nullptr;
+    }
+
+    mMapped    = true;
+    mMapAccess = access;
+    mMapOffset = offset;
+    mMapLength = length;
+
+    return data + offset;
+}
+
+bool
+BufferObject::Unmap(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the memory itself stays mapped, only the client's view of it ends here
+    bool flushed = (mMapAccess & GL_MAP_FLUSH_EXPLICIT_BIT_EXT) || FlushMappedRange();
+    ++mDataVersion;
+
+    mMapped    = false;
+    mMapAccess = 0;
+    mMapOffset = 0;
+    mMapLength = 0;
+
+    return flushed;
+}
+
+bool
+BufferObject::FlushMappedRange(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the client may have written to the mapped range
+    ++mDataVersion;
+
+    return mMemory->FlushMappedData();
+}
+
+void*
+BufferObject::GetMapPointer(void) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    return mMapped ? mMemory->Map() + mMapOffset : nullptr;
 }
 
 void
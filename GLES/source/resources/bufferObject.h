@@ -29,6 +29,8 @@
 #include "vulkan/buffer.h"
 #include "vulkan/memory.h"
 #include "refObject.h"
+#include <atomic>
+#include <vector>
 
 class BufferObject : public refObject {
 private:
@@ -39,6 +41,32 @@ private:
     GLenum                  mTarget;
     bool                    mAllocated;
 
+    const
+    VkSharingMode           mVkSharingMode;
+    const
+    VkFlags                 mVkMemoryFlags;
+
+    bool                    mMapped;
+    GLbitfield              mMapAccess;
+    size_t                  mMapOffset;
+    size_t                  mMapLength;
+
+    /// The queue epoch of the last draw that reads the buffer, 0 if none; draws of any context of the share group set it
+    std::atomic<uint64_t>   mUseEpoch;
+
+    /// Changes whenever the contents of the buffer may have changed
+    uint64_t                mDataVersion;
+
+    /// Previous versions of the storage, kept until the commands that read them have completed
+    typedef struct {
+        vulkanAPI::Buffer*  buffer;
+        vulkanAPI::Memory*  memory;
+        uint64_t            useEpoch;
+    } retiredStorage_t;
+    std::vector<retiredStorage_t> mRetiredStorages;
+
+    void                    ReleaseRetiredStorages(void);
+
     vulkanAPI::Memory*      mMemory;
 
 protected:
@@ -56,9 +84,16 @@ public:
 
 // Release Functions
     void                    Release(void);
+    void                    ReleaseCompletedStorages(void);
 
 // Update Functions
     void                    UpdateData(size_t size, size_t offset, const void *data);
+    bool                    Orphan(size_t size, bool preserveContents);
+
+// Map Functions
+    void*                   Map(size_t offset, size_t length, GLbitfield access);
+    bool                    Unmap(void);
+    bool                    FlushMappedRange(void);
 
 // Get Functions
     bool                    GetData(size_t size,
@@ -67,9 +102,14 @@ public:
     inline GLenum           GetTarget(void)                             const   { FUN_ENTRY(GL_LOG_TRACE); return mTarget; }
     inline size_t           GetSize(void)                               const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetSize(); }
     inline VkBuffer         GetVkBuffer(void)                                   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetVkBuffer(); }
+    inline GLbitfield       GetMapAccess(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mMapAccess;  }
+    inline size_t           GetMapLength(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mMapLength;  }
+    inline uint64_t         GetDataVersion(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mDataVersion; }
+           void*            GetMapPointer(void)                         const;
 
 // Set Functions
     void                    SetTarget(GLenum target);
+    void                    SetUsed(uint64_t useEpoch);
     inline void             SetUsage(GLenum usage)                                { FUN_ENTRY(GL_LOG_TRACE); mUsage     = usage; }
     inline void             SetVkContext(const vulkanAPI::vkContext_t *vkContext) { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext;
                                                                                                              mBuffer->SetContext(vkContext);
@@ -77,6 +117,8 @@ public:
 // Has/Is Functions
     inline bool             HasData(void)                               const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetVkBuffer() != VK_NULL_HANDLE; }
     inline bool             IsIndexBuffer(void)                         const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetFlags() & VK_BUFFER_USAGE_INDEX_BUFFER_BIT; }
+    inline bool             IsMapped(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mMapped; }
+           bool             IsInUse(void)                               const;
 };
 
 class IndexBufferObject : public BufferObject
@@ -122,4 +164,12 @@ public:
 
 };
 
+class IndirectBufferObject : public BufferObject
+{
+
+public:
+    explicit                IndirectBufferObject(const vulkanAPI::vkContext_t *vkContext)     : BufferObject(vkContext, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT) { FUN_ENTRY(GL_LOG_TRACE); }
+
+};
+
 #endif // __BUFFEROBJECT_H__
@@ -34,11 +34,9 @@
 Framebuffer::Framebuffer(const vulkanAPI::vkContext_t *vkContext)
 : mVkContext(vkContext),
 mTarget(GL_INVALID_VALUE), mState(IDLE),
-mUpdated(true), mSizeUpdated(false), mDepthStencilTexture(nullptr),
+mUpdated(true), mSizeUpdated(false), mDepthStencilTexture(nullptr), mDepthTextureAttached(false),
 mBindToTexture(false), mSurfaceType(GLOVE_SURFACE_INVALID),
-mIsSystem(false), mEGLSurfaceInterface(nullptr),
-mCacheColorTexture(nullptr), mCacheDepthTexture(nullptr), mCacheStencilTexture(nullptr),
-mCacheColorRenderbuffer(nullptr), mCacheDepthRenderbuffer(nullptr), mCacheStencilRenderbuffer(nullptr)
+mIsSystem(false), mEGLSurfaceInterface(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
@@ -55,13 +53,8 @@ Framebuffer::~Framebuffer()
     delete mAttachmentDepth;
     delete mAttachmentStencil;
 
-    if(!mIsSystem && mDepthStencilTexture != nullptr) {
-        if(mDepthStencilTexture->GetDepthStencilTextureRefCount() == 1) {
-            delete mDepthStencilTexture;
-        } else {
-            mDepthStencilTexture->DecreaseDepthStencilTextureRefCount();
-        }
-        mDepthStencilTexture = nullptr;
+    if(!mIsSystem) {
+        ReleaseDepthStencilTexture();
     }
 
     for(auto color : mAttachmentColors) {
@@ -87,12 +80,42 @@ Framebuffer::Release(void)
     mFramebuffers.clear();
 }
 
+void
+Framebuffer::ReleaseDepthStencilTexture(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // attachments of depth textures are owned by the texture
+    if(mDepthStencilTexture != nullptr && !mDepthTextureAttached) {
+        if(mDepthStencilTexture->GetDepthStencilTextureRefCount() == 1) {
+            delete mDepthStencilTexture;
+        } else {
+            mDepthStencilTexture->DecreaseDepthStencilTextureRefCount();
+        }
+    }
+    mDepthStencilTexture  = nullptr;
+    mDepthTextureAttached = false;
+}
+
 size_t
 Framebuffer::GetCurrentBufferIndex() const
 {
     return mIsSystem ? mEGLSurfaceInterface->nextImageIndex : 0;
 }
 
+bool
+Framebuffer::IsDepthTextureUpdated(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    Texture *depthTexture = mIsSystem ? nullptr : GetDepthAttachmentTexture();
+    if(depthTexture && depthTexture->IsDepthTexture()) {
+        return depthTexture->GetRenderTargetTexture() != mDepthStencilTexture;
+    }
+
+    return mDepthTextureAttached;
+}
+
 Texture *
 Framebuffer::GetColorAttachmentTexture(void) const
 {
@@ -103,27 +126,7 @@ Framebuffer::GetColorAttachmentTexture(void) const
         return mAttachmentColors[bufferIndex]->GetTexture();
     }
 
-    Texture * tex   = nullptr;
-    uint32_t  index = GetColorAttachmentName();
-
-    if(index) {
-        GLenum    type  = GetColorAttachmentType();
-        if(type == GL_TEXTURE) {
-            if(mCacheColorTexture) {
-                tex = mCacheColorTexture;
-            } else {
-                tex = mTextureArray->GetObject(index);
-            }
-        } else if(type == GL_RENDERBUFFER) {
-            if(mCacheColorRenderbuffer) {
-                tex = mCacheColorRenderbuffer->GetTexture();
-            } else {
-                tex = mRenderbufferArray->GetObject(index)->GetTexture();
-            }
-        }
-    }
-
-    return tex;
+    return mAttachmentColors.size() ? mAttachmentColors[0]->GetAttachedTexture() : nullptr;
 }
 
 Texture *
@@ -135,27 +138,7 @@ Framebuffer::GetDepthAttachmentTexture(void) const
         return mDepthStencilTexture;
     }
 
-    Texture * tex   = nullptr;
-    uint32_t  index = GetDepthAttachmentName();
-
-    if(index) {
-        GLenum    type  = GetDepthAttachmentType();
-        if(type == GL_TEXTURE) {
-            if(mCacheDepthTexture) {
-                tex = mCacheDepthTexture;
-            } else {
-                tex = mTextureArray->GetObject(index);
-            }
-        } else if(type == GL_RENDERBUFFER) {
-            if(mCacheDepthRenderbuffer) {
-                tex = mCacheDepthRenderbuffer->GetTexture();
-            } else {
-                tex = mRenderbufferArray->GetObject(index)->GetTexture();
-            }
-        }
-    }
-
-    return tex;
+    return mAttachmentDepth->GetAttachedTexture();
 }
 
 Texture *
@@ -167,27 +150,7 @@ Framebuffer::GetStencilAttachmentTexture(void) const
         return mDepthStencilTexture;
     }
 
-    Texture * tex   = nullptr;
-    uint32_t  index = GetStencilAttachmentName();
-
-    if(index) {
-        GLenum    type  = GetStencilAttachmentType();
-        if(type == GL_TEXTURE) {
-            if(mCacheStencilTexture) {
-                tex = mCacheStencilTexture;
-            } else {
-                tex = mTextureArray->GetObject(index);
-            }
-        } else if(type == GL_RENDERBUFFER) {
-            if(mCacheStencilRenderbuffer) {
-                tex = mCacheStencilRenderbuffer->GetTexture();
-            } else {
-                tex = mRenderbufferArray->GetObject(index)->GetTexture();
-            }
-        }
-    }
-
-    return tex;
+    return mAttachmentStencil->GetAttachedTexture();
 }
 
 void
@@ -204,6 +167,40 @@ Framebuffer::AddColorAttachment(Texture *texture)
     mUpdated = true;
 }
 
+bool
+Framebuffer::UpdateSystemAttachments(const vector<Texture *> &colorTextures, Texture *depthStencilTexture)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    assert(mIsSystem && colorTextures.size());
+
+    VkFormat colorFormat        = mAttachmentColors.size() ? mAttachmentColors[0]->GetTexture()->GetVkFormat() : VK_FORMAT_UNDEFINED;
+    VkFormat depthStencilFormat = mDepthStencilTexture     ? mDepthStencilTexture->GetVkFormat()               : VK_FORMAT_UNDEFINED;
+
+    for(auto color : mAttachmentColors) {
+        delete color;
+    }
+    mAttachmentColors.clear();
+
+    for(auto tex : colorTextures) {
+        AddColorAttachment(tex);
+    }
+    mDepthStencilTexture = depthStencilTexture;
+
+    // the render pass depends only on the formats of the attachments, so it is kept when the surface is resized
+    if(colorFormat        != colorTextures[0]->GetVkFormat() ||
+       depthStencilFormat != (depthStencilTexture ? depthStencilTexture->GetVkFormat() : VK_FORMAT_UNDEFINED)) {
+        if(!CreateVkRenderPass(mRenderPass->GetColorClearEnabled(), mRenderPass->GetDepthClearEnabled(), mRenderPass->GetStencilClearEnabled(),
+                               mRenderPass->GetColorWriteEnabled(), mRenderPass->GetDepthWriteEnabled(), mRenderPass->GetStencilWriteEnabled(),
+                               mRenderPass->GetColorLoadEnabled())) {
+            return false;
+        }
+    }
+    mUpdated = false;
+
+    return Create();
+}
+
 void
 Framebuffer::SetColorAttachment(int width, int height)
 {
@@ -251,6 +248,12 @@ Framebuffer::CheckStatus(void)
         return GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
     }
 
+    // depth textures own a depth-only attachment that cannot be shared with a stencil buffer
+    if(GetDepthAttachmentType() == GL_TEXTURE && GetStencilAttachmentType() != GL_NONE &&
+       GetDepthAttachmentTexture()->IsDepthTexture()) {
+        return GL_FRAMEBUFFER_UNSUPPORTED;
+    }
+
     if(GetColorAttachmentType() != GL_NONE && GetDepthAttachmentType() != GL_NONE) {
         if(GetColorAttachmentTexture()->GetWidth()  != GetDepthAttachmentTexture()->GetWidth() ||
            GetColorAttachmentTexture()->GetHeight() != GetDepthAttachmentTexture()->GetHeight()) {
@@ -277,13 +280,15 @@ Framebuffer::CheckStatus(void)
 
 bool
 Framebuffer::CreateVkRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled,
-                                bool writeColorEnabled, bool writeDepthEnabled, bool writeStencilEnabled)
+                                bool writeColorEnabled, bool writeDepthEnabled, bool writeStencilEnabled,
+                                bool loadColorEnabled)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     mRenderPass->SetColorClearEnabled(clearColorEnabled);
     mRenderPass->SetDepthClearEnabled(clearDepthEnabled);
     mRenderPass->SetStencilClearEnabled(clearStencilEnabled);
+    mRenderPass->SetColorLoadEnabled(loadColorEnabled);
 
     mRenderPass->SetColorWriteEnabled(writeColorEnabled);
     mRenderPass->SetDepthWriteEnabled(writeDepthEnabled);
@@ -300,6 +305,17 @@ Framebuffer::CreateDepthStencilTexture(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    if(!mIsSystem && GetDepthAttachmentTexture() && GetDepthAttachmentTexture()->IsDepthTexture()) {
+        ReleaseDepthStencilTexture();
+        mDepthStencilTexture  = GetDepthAttachmentTexture()->GetRenderTargetTexture();
+        mDepthTextureAttached = true;
+        return;
+    }
+
+    if(mDepthTextureAttached) {
+        ReleaseDepthStencilTexture();
+    }
+
     if(GetDepthAttachmentTexture() || GetStencilAttachmentTexture()) {
        
         if(!mIsSystem && GetDepthAttachmentTexture() && GetDepthAttachmentTexture()->GetDepthStencilTexture()) {
@@ -396,6 +412,7 @@ Framebuffer::CheckForUpdatedResources()
 {
     if(GetColorAttachmentTexture()) {
 
+        GetColorAttachmentTexture()->FlushAllocation();
         mUpdated |= GetColorAttachmentTexture()->GetDataUpdated();
         if( GetColorAttachmentTexture()->GetWidth()  != GetWidth()  ||
             GetColorAttachmentTexture()->GetHeight() != GetHeight() ) {
@@ -407,93 +424,28 @@ Framebuffer::CheckForUpdatedResources()
         }
         GetColorAttachmentTexture()->SetDataUpdated(false);
     }
-}
 
-void
-Framebuffer::CacheAttachement(Texture *bTexture, GLuint index)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    if(index == GetColorAttachmentName() && GL_TEXTURE == GetColorAttachmentType() && !mCacheColorTexture) {
-        mCacheColorTexture = bTexture;
-    }
-    if(index == GetDepthAttachmentName() && GL_TEXTURE == GetDepthAttachmentType() && !mCacheDepthTexture) {
-        mCacheDepthTexture = bTexture;
-    }
-    if(index == GetStencilAttachmentName() && GL_TEXTURE == GetStencilAttachmentType() && !mCacheStencilTexture) {
-        mCacheStencilTexture = bTexture;
+    Texture *depthTexture = mIsSystem ? nullptr : GetDepthAttachmentTexture();
+    if(depthTexture && depthTexture->IsDepthTexture()) {
+        mUpdated |= depthTexture->GetDataUpdated();
+        depthTexture->SetDataUpdated(false);
     }
+    mUpdated |= IsDepthTextureUpdated();
 }
 
-void
-Framebuffer::CacheAttachement(Renderbuffer *bRenderbuffer, GLuint index)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    if(index == GetColorAttachmentName() && GL_RENDERBUFFER == GetColorAttachmentType() && !mCacheColorRenderbuffer) {
-        mCacheColorRenderbuffer = bRenderbuffer;
-    }
 
-    if(index == GetDepthAttachmentName() && GL_RENDERBUFFER == GetDepthAttachmentType() && !mCacheDepthRenderbuffer) {
-        mCacheDepthRenderbuffer = bRenderbuffer;
-    }
 
-    if(index == GetStencilAttachmentName() && GL_RENDERBUFFER == GetStencilAttachmentType() && !mCacheStencilRenderbuffer) {
-        mCacheStencilRenderbuffer = bRenderbuffer;
-    }
-}
 
-void
-Framebuffer::CleanCachedAttachment(GLenum attachment)
+Attachment *
+Framebuffer::GetAttachment(GLenum attachment) const
 {
-    FUN_ENTRY(GL_LOG_DEBUG);
+    FUN_ENTRY(GL_LOG_TRACE);
 
     switch(attachment) {
-    case GL_COLOR_ATTACHMENT0: {
-        uint32_t index = GetColorAttachmentName();
-        if(index) {
-            GLenum type  = GetColorAttachmentType();
-            if(type == GL_TEXTURE) {
-                if(mCacheColorTexture) {
-                    mCacheColorTexture = nullptr;
-                }
-            } else if(type == GL_RENDERBUFFER) {
-                if(mCacheColorRenderbuffer) {
-                    mCacheColorRenderbuffer = nullptr;
-                }
-            }
-        }
-        break; }
-    case GL_DEPTH_ATTACHMENT: {
-        uint32_t index = GetDepthAttachmentName();
-        if(index) {
-            GLenum type  = GetDepthAttachmentType();
-            if(type == GL_TEXTURE) {
-                if(mCacheDepthTexture) {
-                    mCacheDepthTexture = nullptr;
-                }
-            } else if(type == GL_RENDERBUFFER) {
-                if(mCacheDepthRenderbuffer) {
-                    mCacheDepthRenderbuffer = nullptr;
-                }
-            }
-        }
-        break; }
-    case GL_STENCIL_ATTACHMENT: {
-        uint32_t index = GetStencilAttachmentName();
-        if(index) {
-            GLenum type  = GetStencilAttachmentType();
-            if(type == GL_TEXTURE) {
-                if(mCacheStencilTexture) {
-                    mCacheStencilTexture = nullptr;
-                }
-            } else if(type == GL_RENDERBUFFER) {
-                if(mCacheStencilRenderbuffer) {
-                    mCacheStencilRenderbuffer = nullptr;
-                }
-            }
-        }
-        break; }
+    case GL_COLOR_ATTACHMENT0:  return mAttachmentColors.size() ? mAttachmentColors[0] : nullptr;
+    case GL_DEPTH_ATTACHMENT:   return mAttachmentDepth;
+    case GL_STENCIL_ATTACHMENT: return mAttachmentStencil;
+    default:                    return nullptr;
     }
 }
 
@@ -502,64 +454,16 @@ Framebuffer::UnrefAttachment(GLenum attachment)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    switch(attachment) {
-    case GL_COLOR_ATTACHMENT0: {
-        uint32_t index = GetColorAttachmentName();
-        if(index) {
-            GLenum type  = GetColorAttachmentType();
-            if(type == GL_TEXTURE) {
-                if(mCacheColorTexture) {
-                    mCacheColorTexture->Unbind();
-                } else {
-                    mTextureArray->GetObject(index)->Unbind();
-                }
-            } else if(type == GL_RENDERBUFFER) {
-                if(mCacheColorRenderbuffer) {
-                    mCacheColorRenderbuffer->Unbind();
-                } else {
-                    mRenderbufferArray->GetObject(index)->Unbind();
-                }
-            }
-        }
-        break; }
-    case GL_DEPTH_ATTACHMENT: {
-        uint32_t index = GetDepthAttachmentName();
-        if(index) {
-            GLenum type  = GetDepthAttachmentType();
-            if(type == GL_TEXTURE) {
-                if(mCacheDepthTexture) {
-                    mCacheDepthTexture->Unbind();
-                } else {
-                    mTextureArray->GetObject(index)->Unbind();
-                }
-            } else if(type == GL_RENDERBUFFER) {
-                if(mCacheDepthRenderbuffer) {
-                    mCacheDepthRenderbuffer->Unbind();
-                } else {
-                    mRenderbufferArray->GetObject(index)->Unbind();
-                }
-            }
-        }
-        break; }
-    case GL_STENCIL_ATTACHMENT: {
-        uint32_t index = GetStencilAttachmentName();
-        if(index) {
-            GLenum type  = GetStencilAttachmentType();
-            if(type == GL_TEXTURE) {
-                if(mCacheStencilTexture) {
-                    mCacheStencilTexture->Unbind();
-                } else {
-                    mTextureArray->GetObject(index)->Unbind();
-                }
-            } else if(type == GL_RENDERBUFFER) {
-                if(mCacheStencilRenderbuffer) {
-                    mCacheStencilRenderbuffer->Unbind();
-                } else {
-                    mRenderbufferArray->GetObject(index)->Unbind();
-                }
-            }
-        }
-        break; }
+    // the reference of the attachment keeps a deleted texture or renderbuffer alive until it is detached
+    Attachment *att = GetAttachment(attachment);
+    if(att == nullptr || !att->GetName()) {
+        return;
+    }
+
+    if(att->GetType() == GL_TEXTURE) {
+        att->GetTexture()->Unbind();
+    } else if(att->GetType() == GL_RENDERBUFFER) {
+        att->GetRenderbuffer()->Unbind();
     }
 }
 
@@ -568,40 +472,15 @@ Framebuffer::RefAttachment(GLenum attachment)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    switch(attachment) {
-    case GL_COLOR_ATTACHMENT0: {
-        uint32_t index = GetColorAttachmentName();
-        if(index) {
-            GLenum type  = GetColorAttachmentType();
-            if(type == GL_TEXTURE) {
-                mTextureArray->GetObject(index)->Bind();
-            } else if(type == GL_RENDERBUFFER) {
-                mRenderbufferArray->GetObject(index)->Bind();
-            }
-        }
-        break; }
-    case GL_DEPTH_ATTACHMENT: {
-        uint32_t index = GetDepthAttachmentName();
-        if(index) {
-            GLenum type  = GetDepthAttachmentType();
-            if(type == GL_TEXTURE) {
-                mTextureArray->GetObject(index)->Bind();
-            } else if(type == GL_RENDERBUFFER) {
-                mRenderbufferArray->GetObject(index)->Bind();
-            }
-        }
-        break; }
-    case GL_STENCIL_ATTACHMENT: {
-        uint32_t index = GetStencilAttachmentName();
-        if(index) {
-            GLenum type  = GetStencilAttachmentType();
-            if(type == GL_TEXTURE) {
-                mTextureArray->GetObject(index)->Bind();
-            } else if(type == GL_RENDERBUFFER) {
-                mRenderbufferArray->GetObject(index)->Bind();
-            }
-        }
-        break; }
+    Attachment *att = GetAttachment(attachment);
+    if(att == nullptr || !att->GetName()) {
+        return;
+    }
+
+    if(att->GetType() == GL_TEXTURE) {
+        att->GetTexture()->Bind();
+    } else if(att->GetType() == GL_RENDERBUFFER) {
+        att->GetRenderbuffer()->Bind();
     }
 }
 
@@ -617,6 +496,7 @@ Framebuffer::GetActiveVkFramebuffer() const
 void
 Framebuffer::CreateRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled,
                                bool writeColorEnabled, bool writeDepthEnabled, bool writeStencilEnabled,
+                               bool loadColorEnabled,
                                const float *colorValue, float depthValue, uint32_t stencilValue,
                                const Rect  *clearRect)
 {
@@ -628,14 +508,16 @@ Framebuffer::CreateRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bo
        static_cast<bool>(mRenderPass->GetStencilClearEnabled()) != clearStencilEnabled  ||
        static_cast<bool>(mRenderPass->GetColorWriteEnabled())   != writeColorEnabled    ||
        static_cast<bool>(mRenderPass->GetDepthWriteEnabled())   != writeDepthEnabled    ||
-       static_cast<bool>(mRenderPass->GetStencilWriteEnabled()) != writeStencilEnabled) {
+       static_cast<bool>(mRenderPass->GetStencilWriteEnabled()) != writeStencilEnabled  ||
+       static_cast<bool>(mRenderPass->GetColorLoadEnabled())    != loadColorEnabled) {
 
-        if(!mIsSystem && mSizeUpdated) {
+        if(!mIsSystem && (mSizeUpdated || IsDepthTextureUpdated())) {
             CreateDepthStencilTexture();
             mSizeUpdated = false;
         }
         CreateVkRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled,
-                           writeColorEnabled, writeDepthEnabled, writeStencilEnabled);
+                           writeColorEnabled, writeDepthEnabled, writeStencilEnabled,
+                           loadColorEnabled);
         Create();
 
         mUpdated = false;
@@ -673,6 +555,19 @@ Framebuffer::EndVkRenderPass(void)
     return mRenderPass->End(&activeCmdBuffer);
 }
 
+bool
+Framebuffer::AcquireSurfaceImage(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // window surfaces acquire their image lazily, on the first draw or clear of each frame
+    if(!mIsSystem || mEGLSurfaceInterface->nextImageAcquired || mEGLSurfaceInterface->acquire_image_cb == nullptr) {
+        return true;
+    }
+
+    return mEGLSurfaceInterface->acquire_image_cb(mEGLSurfaceInterface);
+}
+
 void
 Framebuffer::PrepareVkImage(VkImageLayout newImageLayout)
 {
@@ -685,6 +580,16 @@ Framebuffer::PrepareVkImage(VkImageLayout newImageLayout)
     }
 }
 
+void
+Framebuffer::UpdateDepthTexture(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mDepthTextureAttached && !IsDepthTextureUpdated() && mRenderPass->GetDepthWriteEnabled()) {
+        GetDepthAttachmentTexture()->UpdateFromRenderTargetTexture();
+    }
+}
+
 bool
 Framebuffer::Create(void)
 {
@@ -36,7 +36,7 @@ typedef enum {
     GLOVE_SURFACE_PBUFFER
 } glove_surface_type;
 
-class Framebuffer {
+class Framebuffer : public refObject {
 private:
     enum State {
         IDLE,
@@ -48,8 +48,6 @@ private:
 
     const
     vulkanAPI::vkContext_t *         mVkContext;
-    ObjectArray<Texture>            *mTextureArray;
-    ObjectArray<Renderbuffer>       *mRenderbufferArray;
 
     Rect                            mDims;
     GLenum                          mTarget;
@@ -64,22 +62,18 @@ private:
     Attachment*                     mAttachmentDepth;
     Attachment*                     mAttachmentStencil;
     Texture*                        mDepthStencilTexture;
+    bool                            mDepthTextureAttached;
     bool                            mBindToTexture;
     GLenum                          mSurfaceType;
 
     bool                            mIsSystem;
     const EGLSurfaceInterface      *mEGLSurfaceInterface;
 
-    //Cache for possible deleted textures and renderbuffers
-    Texture*                        mCacheColorTexture;
-    Texture*                        mCacheDepthTexture;
-    Texture*                        mCacheStencilTexture;
-    Renderbuffer*                   mCacheColorRenderbuffer;
-    Renderbuffer*                   mCacheDepthRenderbuffer;
-    Renderbuffer*                   mCacheStencilRenderbuffer;
-
     void                            Release(void);
+    void                            ReleaseDepthStencilTexture(void);
     size_t                          GetCurrentBufferIndex(void) const;
+    bool                            IsDepthTextureUpdated(void) const;
+    Attachment *                    GetAttachment(GLenum attachment) const;
 
 public:
     Framebuffer(const vulkanAPI::vkContext_t *vkContext = nullptr);
@@ -92,16 +86,21 @@ public:
 
 // RenderPass Functions
     bool                    CreateVkRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled,
-                                               bool writeColorEnabled, bool writeDepthEnabled, bool writeStencilEnabled);
+                                               bool writeColorEnabled, bool writeDepthEnabled, bool writeStencilEnabled,
+                                               bool loadColorEnabled);
     void                    CreateRenderPass (bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled,
                                                bool writeColorEnabled, bool writeDepthEnabled, bool writeStencilEnabled,
+                                               bool loadColorEnabled,
                                                const float *colorValue, float depthValue, uint32_t stencilValue, const Rect *clearRect);
     void                    BeginVkRenderPass(void);
     bool                    EndVkRenderPass(void);
     void                    PrepareVkImage(VkImageLayout newImageLayout);
+    void                    UpdateDepthTexture(void);
+    bool                    AcquireSurfaceImage(void);
 
 // Add Functions
     void                    AddColorAttachment(Texture *texture);
+    bool                    UpdateSystemAttachments(const vector<Texture *> &colorTextures, Texture *depthStencilTexture);
 
 // Check Functions
     GLenum                  CheckStatus(void);
@@ -110,9 +109,6 @@ public:
     void                    CheckForUpdatedResources(void);
 
 //Attachment Reference Functions
-    void                    CacheAttachement(Texture *bTexture, GLuint index);
-    void                    CacheAttachement(Renderbuffer *bRenderbuffer, GLuint index);
-    void                    CleanCachedAttachment(GLenum attachment);
     void                    UnrefAttachment(GLenum attachment);
     void                    RefAttachment(GLenum attachment);
 
@@ -134,6 +130,7 @@ public:
                                                                                                            case GL_STENCIL_ATTACHMENT:  return GetStencilAttachmentName();
                                                                                                            default:                     return 0;}}
 
+    inline uint32_t         GetColorAttachmentCount(void)               const   { FUN_ENTRY(GL_LOG_TRACE); return static_cast<uint32_t>(mAttachmentColors.size()); }
     inline GLenum           GetColorAttachmentType(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mAttachmentColors.size() ? mAttachmentColors[0]->GetType()  : GL_NONE; }
     inline uint32_t         GetColorAttachmentName(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mAttachmentColors.size() ? mAttachmentColors[0]->GetName()  : 0; }
     inline GLint            GetColorAttachmentLevel(void)               const   { FUN_ENTRY(GL_LOG_TRACE); return mAttachmentColors.size() ? mAttachmentColors[0]->GetLevel() : 0; }
@@ -160,9 +157,6 @@ public:
     inline void             SetEGLSurfaceInterface(const EGLSurfaceInterface_t* eglSurfaceInterface) { FUN_ENTRY(GL_LOG_TRACE); mEGLSurfaceInterface = eglSurfaceInterface; }
     inline void             SetVkContext(const
                                          vulkanAPI::vkContext_t *vkContext)     { FUN_ENTRY(GL_LOG_TRACE); mVkContext   = vkContext; mRenderPass->SetVkContext(vkContext); }
-    inline void             SetResources(
-                            ObjectArray<Texture>            *texArray,
-                            ObjectArray<Renderbuffer>       *rbArray)           { FUN_ENTRY(GL_LOG_TRACE); mTextureArray = texArray; mRenderbufferArray = rbArray; }
 
     inline void             SetUpdated(void)                                    { FUN_ENTRY(GL_LOG_TRACE); mUpdated     = true;   }
     inline void             SetIsSystem(void)                                   { FUN_ENTRY(GL_LOG_TRACE); mIsSystem    = true;   }
@@ -180,16 +174,22 @@ public:
     inline void             SetColorAttachmentName(uint32_t name)               { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetName(name);   }
     inline void             SetColorAttachmentLevel(GLint level)                { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetLevel(level); }
     inline void             SetColorAttachmentLayer(GLenum layer)               { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetLayer(layer); }
+    inline void             SetColorAttachmentTexture(Texture *tex)             { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetTexture(tex); }
+    inline void             SetColorAttachmentRenderbuffer(Renderbuffer *rb)    { FUN_ENTRY(GL_LOG_TRACE); mAttachmentColors[0]->SetRenderbuffer(rb); }
 
     inline void             SetDepthAttachmentName(uint32_t name)               { FUN_ENTRY(GL_LOG_TRACE); mAttachmentDepth->SetName(name);   mUpdated = true;}
     inline void             SetDepthAttachmentType(GLenum type)                 { FUN_ENTRY(GL_LOG_TRACE); mAttachmentDepth->SetType(type);   }
     inline void             SetDepthAttachmentLevel(GLint level)                { FUN_ENTRY(GL_LOG_TRACE); mAttachmentDepth->SetLevel(level); }
     inline void             SetDepthAttachmentLayer(GLenum layer)               { FUN_ENTRY(GL_LOG_TRACE); mAttachmentDepth->SetLayer(layer); }
+    inline void             SetDepthAttachmentTexture(Texture *tex)             { FUN_ENTRY(GL_LOG_TRACE); mAttachmentDepth->SetTexture(tex); }
+    inline void             SetDepthAttachmentRenderbuffer(Renderbuffer *rb)    { FUN_ENTRY(GL_LOG_TRACE); mAttachmentDepth->SetRenderbuffer(rb); }
 
     inline void             SetStencilAttachmentName(uint32_t name)             { FUN_ENTRY(GL_LOG_TRACE); mAttachmentStencil->SetName(name); mUpdated = true;}
     inline void             SetStencilAttachmentType(GLenum type)               { FUN_ENTRY(GL_LOG_TRACE); mAttachmentStencil->SetType(type);   }
     inline void             SetStencilAttachmentLevel(GLint level)              { FUN_ENTRY(GL_LOG_TRACE); mAttachmentStencil->SetLevel(level); }
     inline void             SetStencilAttachmentLayer(GLenum layer)             { FUN_ENTRY(GL_LOG_TRACE); mAttachmentStencil->SetLayer(layer); }
+    inline void             SetStencilAttachmentTexture(Texture *tex)           { FUN_ENTRY(GL_LOG_TRACE); mAttachmentStencil->SetTexture(tex); }
+    inline void             SetStencilAttachmentRenderbuffer(Renderbuffer *rb)  { FUN_ENTRY(GL_LOG_TRACE); mAttachmentStencil->SetRenderbuffer(rb); }
 
     inline void             SetDepthStencilAttachmentTexture(Texture *texture)  { FUN_ENTRY(GL_LOG_TRACE); mDepthStencilTexture = texture; }
     inline void             SetBindToTexture(GLint bindToTexture)               { FUN_ENTRY(GL_LOG_TRACE); mBindToTexture = bindToTexture;      }
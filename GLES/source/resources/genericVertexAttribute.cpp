@@ -29,13 +29,15 @@
 #include "utils/glUtils.h"
 
 GenericVertexAttribute::GenericVertexAttribute()
-: mElements(4), mType(GL_FLOAT), mNormalized(false), mStride(0), mEnabled(false),
+: mElements(4), mType(GL_FLOAT), mNormalized(false), mStride(0), mEnabled(false), mDivisor(0),
   mOffset(0), mPtr(0),
   mInternalVbo(nullptr), mExternalVbo(nullptr),
   mInternalVBOStatus(true), mCacheManager(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    memset(static_cast<void *>(&mExpanded), 0, sizeof(mExpanded));
+
     mGenericValue[0] = 0.0f;
     mGenericValue[1] = 0.0f;
     mGenericValue[2] = 0.0f;
@@ -80,8 +82,10 @@ GenericVertexAttribute::GenerateUserSpaceVBO(uint32_t numVertices, bool& updated
     void *srcData = reinterpret_cast<void*>(GetPointer());
     size_t byteSize = numVertices * GetStride();
 
-    // explicitly convert GL_FIXED to GL_FLOAT
-    if(GetType() != GL_FIXED) {
+    // explicitly pad 3-component half floats and convert GL_FIXED to GL_FLOAT
+    if(IsPaddedHalfFloat3()) {
+        PadHalfFloat3Buffer(vbo, byteSize, srcData, 0, numVertices);
+    } else if(GetType() != GL_FIXED) {
         vbo->Allocate(byteSize, srcData);
     }
     else {
@@ -113,10 +117,101 @@ GenericVertexAttribute::AttachDeviceSpaceVBO(uint32_t numVertices, bool& updated
         delete[] srcData;
         mCacheManager->CacheVBO(vbo);
         updatedVBO = true;
+    } else if(IsPaddedHalfFloat3()) {
+        size_t byteSize = vbo->GetSize();
+        uint8_t *srcData = new uint8_t[byteSize];
+        vbo->GetData(byteSize, 0, srcData);
+        vbo = new VertexBufferObject(mVkContext);
+        PadHalfFloat3Buffer(vbo, byteSize, srcData, GetOffset(), numVertices);
+        delete[] srcData;
+        mCacheManager->CacheVBO(vbo);
+        updatedVBO = true;
     }
     return vbo;
 }
 
+BufferObject*
+GenericVertexAttribute::ExpandInstancedVBO(BufferObject *vbo, uint32_t numInstances, bool& updatedVBO)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // Vulkan steps instanced bindings once per instance. Without VK_EXT_vertex_attribute_divisor
+    // each element is replicated, so that instance i reads the element i / divisor
+    // NOTE: this is an inefficient operation, used only for divisors greater than 1
+    const size_t divisor = static_cast<size_t>(GetDivisor());
+    const size_t offset  = GetVkOffset();
+    const size_t stride  = static_cast<size_t>(GetVkStride());
+
+    // the expansion of an attached buffer object is reused as long as neither its
+    // contents nor the attribute layout and the instance count change
+    const bool cacheable = vbo == mExternalVbo;
+    if(cacheable && mExpanded.vbo != nullptr                 &&
+       mExpanded.srcVbo       == vbo                         &&
+       mExpanded.srcVersion   == vbo->GetDataVersion()       &&
+       mExpanded.offset       == offset                      &&
+       mExpanded.stride       == GetVkStride()               &&
+       mExpanded.divisor      == GetDivisor()                &&
+       mExpanded.numInstances == numInstances) {
+        return mExpanded.vbo;
+    }
+
+    const size_t srcSize = vbo->GetSize();
+    const size_t dstSize = offset + numInstances * stride;
+
+    uint8_t *srcData = new uint8_t[srcSize];
+    uint8_t *dstData = new uint8_t[dstSize];
+    vbo->GetData(srcSize, 0, srcData);
+    memset(dstData, 0, dstSize);
+
+    for(size_t inst = 0; inst < numInstances; ++inst) {
+        const size_t srcIndex = offset + (inst / divisor) * stride;
+        const size_t dstIndex = offset + inst * stride;
+        if(srcIndex < srcSize) {
+            const size_t size = srcSize - srcIndex < stride ? srcSize - srcIndex : stride;
+            memcpy(&dstData[dstIndex], &srcData[srcIndex], size);
+        }
+    }
+
+    BufferObject *expandedVbo = new VertexBufferObject(mVkContext);
+    expandedVbo->Allocate(dstSize, dstData);
+    delete[] srcData;
+    delete[] dstData;
+
+    if(cacheable) {
+        ReleaseExpandedVBO();
+        mExpanded.vbo          = expandedVbo;
+        mExpanded.srcVbo       = vbo;
+        mExpanded.srcVersion   = vbo->GetDataVersion();
+        mExpanded.offset       = offset;
+        mExpanded.stride       = GetVkStride();
+        mExpanded.divisor      = GetDivisor();
+        mExpanded.numInstances = numInstances;
+    } else {
+        mCacheManager->CacheVBO(expandedVbo);
+    }
+
+    updatedVBO = true;
+    return expandedVbo;
+}
+
+void
+GenericVertexAttribute::ReleaseExpandedVBO(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mExpanded.vbo == nullptr) {
+        return;
+    }
+
+    // pending draws may still read the expanded VBO
+    if(mCacheManager != nullptr) {
+        mCacheManager->CacheVBO(mExpanded.vbo);
+    } else {
+        delete mExpanded.vbo;
+    }
+    memset(static_cast<void *>(&mExpanded), 0, sizeof(mExpanded));
+}
+
 BufferObject*
 GenericVertexAttribute::UpdateGenericValueVBO(bool& updatedVBO)
 {
@@ -136,6 +231,35 @@ GenericVertexAttribute::UpdateGenericValueVBO(bool& updatedVBO)
     return vbo;
 }
 
+void
+GenericVertexAttribute::PadHalfFloat3Buffer(BufferObject* vbo, size_t byteSize, const void *srcData,
+                                            size_t offset, size_t numVertices)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // each vertex is tightly packed into 4 half floats, with w = 1.0
+    const GLushort halfFloatOne = 0x3C00;
+    const size_t   srcStride    = static_cast<size_t>(GetStride());
+    const size_t   dstStride    = 4 * sizeof(GLushort);
+    const size_t   dstSize      = numVertices * dstStride;
+
+    const uint8_t *srcBuffer = static_cast<const uint8_t *>(srcData);
+    uint8_t       *dstBuffer = new uint8_t[dstSize];
+    memset(dstBuffer, 0, dstSize);
+
+    for(size_t ver = 0; ver < numVertices; ++ver) {
+        const size_t srcIndex = offset + ver * srcStride;
+        uint8_t     *dst      = &dstBuffer[ver * dstStride];
+        if(srcIndex + 3 * sizeof(GLushort) <= byteSize) {
+            memcpy(dst, &srcBuffer[srcIndex], 3 * sizeof(GLushort));
+        }
+        memcpy(dst + 3 * sizeof(GLushort), &halfFloatOne, sizeof(GLushort));
+    }
+
+    vbo->Allocate(dstSize, dstBuffer);
+    delete[] dstBuffer;
+}
+
 void
 GenericVertexAttribute::ConvertFixedBufferToFloat(BufferObject* vbo, size_t byteSize,
                                                   void *srcData, size_t numVertices)
@@ -181,6 +305,13 @@ GenericVertexAttribute::Release(void)
        delete mInternalVbo;
        mInternalVbo        = nullptr;
     }
+
+    if(mExternalVbo != nullptr) {
+        mExternalVbo->Unbind();
+        mExternalVbo = nullptr;
+    }
+
+    ReleaseExpandedVBO();
 }
 
 void
@@ -192,8 +323,21 @@ GenericVertexAttribute::SetCurrentVbo(BufferObject *vbo)
         mCacheManager->CacheVBO(mInternalVbo);
     }
 
+    // the attached buffer object is referenced, so that it outlives glDeleteBuffers
+    // while the attribute, possibly of an unbound vertex array object, still uses it
+    BufferObject *externalVbo = mInternalVBOStatus ? nullptr : vbo;
+    if(externalVbo != mExternalVbo) {
+        if(externalVbo != nullptr) {
+            externalVbo->Bind();
+        }
+        if(mExternalVbo != nullptr) {
+            mExternalVbo->Unbind();
+        }
+        ReleaseExpandedVBO();
+    }
+
     mInternalVbo = mInternalVBOStatus ? vbo : nullptr;
-    mExternalVbo = mInternalVBOStatus ? nullptr : vbo;
+    mExternalVbo = externalVbo;
 }
 
 void
@@ -37,6 +37,7 @@ private:
     GLsizei                             mStride;
     GLfloat                             mGenericValue[4];
     bool                                mEnabled;
+    GLuint                              mDivisor;
 
     uintptr_t                           mOffset;
     uintptr_t                           mPtr;
@@ -45,21 +46,38 @@ private:
     bool                                mInternalVBOStatus;
     CacheManager                       *mCacheManager;
 
+    /// The last instanced VBO expanded from the attached buffer object, with what it was expanded from
+    typedef struct {
+        BufferObject                   *vbo;
+        const BufferObject             *srcVbo;
+        uint64_t                        srcVersion;
+        uintptr_t                       offset;
+        GLsizei                         stride;
+        GLuint                          divisor;
+        uint32_t                        numInstances;
+    } expandedVbo_t;
+    expandedVbo_t                       mExpanded;
+
+    void                                ReleaseExpandedVBO(void);
+
 public:
     GenericVertexAttribute();
     ~GenericVertexAttribute();
 
     void                                ConvertFixedBufferToFloat(BufferObject* vbo, size_t byteSize, void *srcData, size_t numVertices);
+    void                                PadHalfFloat3Buffer(BufferObject* vbo, size_t byteSize, const void *srcData, size_t offset, size_t numVertices);
     BufferObject                       *UpdateVertexAttribute(uint32_t numVertices, bool &updatedVBO);
     BufferObject                       *UpdateGenericValueVBO(bool &updatedVBO);
     BufferObject                       *GenerateUserSpaceVBO(uint32_t numVertices, bool &updatedVBO);
     BufferObject                       *AttachDeviceSpaceVBO(uint32_t numVertices, bool &updatedVBO);
+    BufferObject                       *ExpandInstancedVBO(BufferObject *vbo, uint32_t numInstances, bool &updatedVBO);
 
     // Release Functions
     void                                Release(void);
 
     // Get Functions
     inline bool                         IsEnabled(void)                  const { FUN_ENTRY(GL_LOG_TRACE); return mEnabled;    }
+    inline GLuint                       GetDivisor(void)                  const { FUN_ENTRY(GL_LOG_TRACE); return mDivisor;    }
     inline GLint                        GetNumElements(void)              const { FUN_ENTRY(GL_LOG_TRACE); return mElements;   }
     inline GLenum                       GetType(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return mType;       }
     inline GLboolean                    GetNormalized(void)               const { FUN_ENTRY(GL_LOG_TRACE); return mNormalized; }
@@ -69,7 +87,13 @@ public:
     inline uintptr_t                    GetPointer(void)                  const { FUN_ENTRY(GL_LOG_TRACE); return mPtr;        }
     inline const BufferObject *         GetExternalVbo(void)              const { FUN_ENTRY(GL_LOG_TRACE); return mExternalVbo;}
 
-    inline VkFormat                     GetVkFormat(void)                 const { FUN_ENTRY(GL_LOG_TRACE); return GlAttribPointerToVkFormat(mElements, mType, mNormalized); }
+    /// 3-component half floats are padded to 4 components, if the device cannot fetch them from vertex buffers
+    inline bool                         IsPaddedHalfFloat3(void)          const { FUN_ENTRY(GL_LOG_TRACE); return mType == GL_HALF_FLOAT_OES && mElements == 3 &&
+                                                                                                           mVkContext && !mVkContext->mIsVertexFormatRGB16FSupported; }
+    inline VkFormat                     GetVkFormat(void)                 const { FUN_ENTRY(GL_LOG_TRACE); return IsPaddedHalfFloat3() ? VK_FORMAT_R16G16B16A16_SFLOAT :
+                                                                                                           GlAttribPointerToVkFormat(mElements, mType, mNormalized); }
+    inline GLsizei                      GetVkStride(void)                 const { FUN_ENTRY(GL_LOG_TRACE); return IsPaddedHalfFloat3() ? static_cast<GLsizei>(4 * sizeof(GLushort)) : mStride; }
+    inline uint32_t                     GetVkOffset(void)                 const { FUN_ENTRY(GL_LOG_TRACE); return IsPaddedHalfFloat3() ? 0 : GetOffset(); }
     inline bool                         IsInternalVBO(void)        const { FUN_ENTRY(GL_LOG_TRACE); return mInternalVBOStatus;}
     inline void                         GetGenericValue(GLint *ptr)       const { FUN_ENTRY(GL_LOG_TRACE); ptr[0] = static_cast<GLint>(mGenericValue[0]);
                                                                                                            ptr[1] = static_cast<GLint>(mGenericValue[1]);
@@ -85,6 +109,7 @@ public:
            void                         Set(GLint nElements, GLenum type, GLboolean normalized, GLsizei stride, const void *ptr, BufferObject *vbo, bool internalVBO);
            void                         SetCurrentVbo(BufferObject *vbo);
     inline void                         SetEnabled(bool enabled)                    { FUN_ENTRY(GL_LOG_TRACE); mEnabled         = enabled;     }
+    inline void                         SetDivisor(GLuint divisor)                  { FUN_ENTRY(GL_LOG_TRACE); mDivisor         = divisor;     }
     inline void                         SetNumElements(GLint nElements)             { FUN_ENTRY(GL_LOG_TRACE); mElements        = nElements;   }
     inline void                         SetType(GLenum type)                        { FUN_ENTRY(GL_LOG_TRACE); mType            = type;        }
     inline void                         SetNormalized(GLboolean normalized)         { FUN_ENTRY(GL_LOG_TRACE); mNormalized      = normalized;  }
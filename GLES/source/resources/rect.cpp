@@ -119,14 +119,15 @@ InvertImageYAxis(uint8_t *image, const ImageRect* rect)
 
 // converts and copies pixels between two buffers with different formats
 // e.g., copies RGB565 pixels to BGRA8888
+template<typename ColorType>
 void
 CopyPixelsConvert(
             const ImageRect* srcRect,
             const void* srcData,
             const ImageRect* dstRect,
             void* dstData,
-            Color (*SrcColorFunPtr)(const uint8_t*),
-            void (*DstColorFunPtr)(Color&, uint8_t*))
+            ColorType (*SrcColorFunPtr)(const uint8_t*),
+            void (*DstColorFunPtr)(ColorType&, uint8_t*))
 {
 
     // size of an entire row in bytes
@@ -146,7 +147,7 @@ CopyPixelsConvert(
         for(int col = 0; col < srcRect->width; ++col) {
             const uint32_t srcIndex = col * srcRect->GetPixelByteOffset();
             const uint32_t dstIndex = col * dstRect->GetPixelByteOffset();
-            Color color = SrcColorFunPtr(&srcPtr[srcIndex]);
+            ColorType color = SrcColorFunPtr(&srcPtr[srcIndex]);
             DstColorFunPtr(color, &dstPtr[dstIndex]);
         }
         // offset by the number of bytes per row
@@ -351,6 +352,67 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
         }
         break;
 
+    case GL_RGBA16F_EXT:
+        switch(dstFormat) {
+        case GL_RGBA16F_EXT:
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            break;
+        case GL_RGBA:
+        case GL_RGBA8_OES:
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromRGBA16F, &Color::ConvertToRGBA);
+            break;
+        default: NOT_FOUND_ENUM(dstFormat); break;
+        }
+        break;
+
+    case GL_RGB16F_EXT:
+        switch(dstFormat) {
+        case GL_RGB16F_EXT:
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            break;
+        case GL_RGBA16F_EXT:
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &ColorHalf::FromRGB16F, &ColorHalf::ConvertToRGBA16F);
+            break;
+        default: NOT_FOUND_ENUM(dstFormat); break;
+        }
+        break;
+
+    case GL_LUMINANCE_ALPHA16F_EXT:
+        switch(dstFormat) {
+        case GL_LUMINANCE_ALPHA16F_EXT:
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            break;
+        case GL_RGBA16F_EXT:
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &ColorHalf::FromLuminanceAlpha16F, &ColorHalf::ConvertToRGBA16F);
+            break;
+        default: NOT_FOUND_ENUM(dstFormat); break;
+        }
+        break;
+
+    case GL_LUMINANCE16F_EXT:
+        switch(dstFormat) {
+        case GL_LUMINANCE16F_EXT:
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            break;
+        case GL_RGBA16F_EXT:
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &ColorHalf::FromLuminance16F, &ColorHalf::ConvertToRGBA16F);
+            break;
+        default: NOT_FOUND_ENUM(dstFormat); break;
+        }
+        break;
+
+    case GL_ALPHA16F_EXT:
+        switch(dstFormat) {
+        case GL_ALPHA16F_EXT:
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            break;
+        case GL_RGBA16F_EXT:
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &ColorHalf::FromAlpha16F, &ColorHalf::ConvertToRGBA16F);
+            break;
+        default: NOT_FOUND_ENUM(dstFormat); break;
+        }
+        break;
+
     case GL_UNSIGNED_INT_24_8_OES:
     case GL_DEPTH24_STENCIL8_OES:
         switch(dstFormat) {
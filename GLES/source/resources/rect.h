@@ -78,13 +78,14 @@ void                    CopyPixelsNoConversion(
                         const void* srcData,
                         const ImageRect* dstRect,
                         void* dstData);
+template<typename ColorType>
 void                    CopyPixelsConvert(
                         const ImageRect* srcRect,
                         const void* srcData,
                         const ImageRect* dstRect,
                         void* dstData,
-                        Color (*SrcColorFunPtr)(const uint8_t*),
-                                          void (*DstColorFunPtr)(struct Color&, uint8_t*));
+                        ColorType (*SrcColorFunPtr)(const uint8_t*),
+                                          void (*DstColorFunPtr)(ColorType&, uint8_t*));
 void                    ConvertPixels(GLenum srcFormat , GLenum dstFormat,
                         ImageRect* srcRect,
                         const void* srcData,
@@ -24,7 +24,7 @@
 #include "refObject.h"
 
 refObject::refObject()
-: refCount(0), markForDeletion(false)
+: refCount(0), markForDeletion(false), objectId(0)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -39,7 +39,7 @@ refObject::Bind()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    //TODO: mutex lock
+    // objects may be bound by contexts that render on different threads
     refCount++;
     return 0;
 }
@@ -49,8 +49,8 @@ refObject::Unbind()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    //TODO: mutex lock
-    refCount--;
-    assert(refCount >= 0);
+    int newRefCount = --refCount;
+    assert(newRefCount >= 0);
+    (void)newRefCount;
     return 0;
 }
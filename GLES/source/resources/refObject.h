@@ -25,11 +25,13 @@
 #define __REFOBJECT_H_
 
 #include "utils/glLogger.h"
+#include <atomic>
 
 class refObject {
 private:
-    int   refCount;
-    int   markForDeletion;
+    std::atomic<int> refCount;
+    int      markForDeletion;
+    uint32_t objectId;
 
 public:
 // Constructor
@@ -44,6 +46,8 @@ public:
     bool FreeForDeletion()                  const { FUN_ENTRY(GL_LOG_TRACE); return refCount == 0; }
     bool GetMarkForDeletion()                     { FUN_ENTRY(GL_LOG_TRACE); return markForDeletion; }
     void SetMarkForDeletion(bool flag)            { FUN_ENTRY(GL_LOG_TRACE); markForDeletion = flag;}
+    uint32_t GetObjectId()                  const { FUN_ENTRY(GL_LOG_TRACE); return objectId; }
+    void SetObjectId(uint32_t id)                 { FUN_ENTRY(GL_LOG_TRACE); objectId = id; }
 };
 
 #endif // __REFOBJECT_H_
@@ -22,24 +22,32 @@
  *  @section
  *
  *  OpenGL ES allows developers to allocate, edit and delete a variety of
- *  resources. These include Generic Vertex Attributes, Buffers, Renderbuffers,
- *  Framebuffers, Textures, Shaders, and Shader Programs.
+ *  resources. These include Vertex Array Objects, Buffers, Renderbuffers,
+ *  Framebuffers, Textures, Shaders, and Shader Programs. All but the Vertex
+ *  Array Objects and the Framebuffers are shared among the contexts of a
+ *  share group.
  */
 
 #include "resourceManager.h"
+#include "glslang/glslangShaderCompiler.h"
+#include "vulkan/queueTracker.h"
 
-ResourceManager::ResourceManager(const vulkanAPI::vkContext_t *vkContext):
+ResourceManager::ResourceManager(const vulkanAPI::vkContext_t *vkContext, ResourceManager *shareResourceManager):
     mVkContext(vkContext),
-    mShadingObjectCount(1),
-    mGenericVertexAttributes(GLOVE_MAX_VERTEX_ATTRIBS)
+    mCacheManager(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    if(shareResourceManager) {
+        mShareGroup = shareResourceManager->mShareGroup;
+        mShareGroup->Acquire();
+    } else {
+        mShareGroup = new ShareGroup(vkContext);
+    }
+
     CreateDefaultTextures();
 
-    for(auto& gva : mGenericVertexAttributes) {
-        gva.SetVkContext(vkContext);
-    }
+    mDefaultVertexArray = new VertexArrayObject(vkContext);
 }
 
 ResourceManager::~ResourceManager()
@@ -49,18 +57,38 @@ ResourceManager::~ResourceManager()
     delete mDefaultTexture2D;
     delete mDefaultTextureCubeMap;
 
-    for(auto& gva : mGenericVertexAttributes) {
-        gva.Release();
+    delete mDefaultVertexArray;
+
+    // vertex arrays reference buffers of the share group, which may be deleted along with it
+    for(const auto &vao : mVertexArrays) {
+        vao.second->Release();
+    }
+
+    if(mShareGroup->Release()) {
+        delete mShareGroup;
     }
-    mGenericVertexAttributes.clear();
 }
 
 void
 ResourceManager::SetCacheManager(CacheManager *cacheManager)
 {
-    for(auto& gva : mGenericVertexAttributes) {
-        gva.SetCacheManager(cacheManager);
-    }
+    mCacheManager = cacheManager;
+    mDefaultVertexArray->SetCacheManager(cacheManager);
+}
+
+GLuint
+ResourceManager::AllocateVertexArray(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the object is created along with its name, so that only generated names can be bound
+    uint32_t index = mVertexArrays.Allocate();
+
+    VertexArrayObject *vao = mVertexArrays.GetObject(index);
+    vao->SetVkContext(mVkContext);
+    vao->SetCacheManager(mCacheManager);
+
+    return index;
 }
 
 void
@@ -90,15 +118,17 @@ uint32_t
 ResourceManager::PushShadingObject(const ShadingNamespace_t& obj)
 {
     FUN_ENTRY(GL_LOG_TRACE);
-    mShadingObjectPool[mShadingObjectCount] = obj;
-    return mShadingObjectCount++;
+    ShareGroupLock lock(mShareGroup->mMutex);
+    mShareGroup->mShadingObjectPool[mShareGroup->mShadingObjectCount] = obj;
+    return mShareGroup->mShadingObjectCount++;
 }
 
 void
 ResourceManager::EraseShadingObject(uint32_t id)
 {
     FUN_ENTRY(GL_LOG_TRACE);
-    mShadingObjectPool.erase(id);
+    ShareGroupLock lock(mShareGroup->mMutex);
+    mShareGroup->mShadingObjectPool.erase(id);
 }
 
 GLboolean
@@ -106,11 +136,13 @@ ResourceManager::IsShadingObject(GLuint index, shadingNamespaceType_t type) cons
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(!index || index >= mShadingObjectCount || !ShadingObjectExists(index)) {
+    ShareGroupLock lock(mShareGroup->mMutex);
+
+    if(!index || index >= mShareGroup->mShadingObjectCount || !ShadingObjectExists(index)) {
         return GL_FALSE;
     }
 
-    ShadingNamespace_t shadId = mShadingObjectPool.find(index)->second;
+    ShadingNamespace_t shadId = mShareGroup->mShadingObjectPool.find(index)->second;
     return (shadId.arrayIndex && shadId.type == type) ? GL_TRUE : GL_FALSE;
 }
 
@@ -119,7 +151,9 @@ ResourceManager::FindShaderID(const Shader *shader)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(shadingPoolIDs_t::iterator it = mShadingObjectPool.begin(); it != mShadingObjectPool.end(); ++it) {
+    ShareGroupLock lock(mShareGroup->mMutex);
+
+    for(ShareGroup::shadingPoolIDs_t::iterator it = mShareGroup->mShadingObjectPool.begin(); it != mShareGroup->mShadingObjectPool.end(); ++it) {
         if(it->second.type == SHADER_ID && GetShaderID(shader) == it->second.arrayIndex) {
             return it->first;
         }
@@ -132,7 +166,9 @@ ResourceManager::FindShaderProgramID(const ShaderProgram *program)
 {
    FUN_ENTRY(GL_LOG_DEBUG);
 
-   for(shadingPoolIDs_t::iterator it = mShadingObjectPool.begin(); it != mShadingObjectPool.end(); ++it) {
+   ShareGroupLock lock(mShareGroup->mMutex);
+
+   for(ShareGroup::shadingPoolIDs_t::iterator it = mShareGroup->mShadingObjectPool.begin(); it != mShareGroup->mShadingObjectPool.end(); ++it) {
         if(it->second.type == SHADER_PROGRAM_ID && GetShaderProgramID(program) == it->second.arrayIndex) {
             return it->first;
         }
@@ -146,8 +182,7 @@ ResourceManager::UpdateFramebufferObjects(GLuint index, GLenum target)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(typename map<uint32_t, Framebuffer *>::const_iterator it =
-        mFramebuffers.GetObjects()->begin(); it != mFramebuffers.GetObjects()->end(); it++) {
+    for(FramebufferArray::const_iterator it = mFramebuffers.begin(); it != mFramebuffers.end(); ++it) {
 
         Framebuffer *fb = it->second;
         if((fb->GetColorAttachmentType()   == target && index == fb->GetColorAttachmentName()) ||
@@ -163,8 +198,7 @@ ResourceManager::IsTextureAttachedToFBO(const Texture *texture)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(typename map<uint32_t, Framebuffer *>::const_iterator it =
-        mFramebuffers.GetObjects()->begin(); it != mFramebuffers.GetObjects()->end(); it++) {
+    for(FramebufferArray::const_iterator it = mFramebuffers.begin(); it != mFramebuffers.end(); ++it) {
 
         if(it->second->GetColorAttachmentType() == GL_TEXTURE && texture == it->second->GetColorAttachmentTexture()) {
             return true;
@@ -174,85 +208,119 @@ ResourceManager::IsTextureAttachedToFBO(const Texture *texture)
     return false;
 }
 
+void
+ResourceManager::CreateShaderCompiler(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    ShareGroupLock lock(mShareGroup->mMutex);
+
+    if(mShareGroup->mShaderCompiler == nullptr) {
+        mShareGroup->mShaderCompiler = new GlslangShaderCompiler();
+
+        for(ShareGroup::ShaderArray::const_iterator it = mShareGroup->mShaders.begin(); it != mShareGroup->mShaders.end(); ++it) {
+            it->second->SetShaderCompiler(mShareGroup->mShaderCompiler);
+        }
+
+        for(ShareGroup::ShaderProgramArray::const_iterator it = mShareGroup->mShaderPrograms.begin(); it != mShareGroup->mShaderPrograms.end(); ++it) {
+            it->second->SetShaderCompiler(mShareGroup->mShaderCompiler);
+        }
+    }
+}
+
+void
+ResourceManager::ReleaseShaderCompiler(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    ShareGroupLock lock(mShareGroup->mMutex);
+
+    if(mShareGroup->mShaderCompiler != nullptr) {
+        delete mShareGroup->mShaderCompiler;
+        mShareGroup->mShaderCompiler = nullptr;
+    }
+}
+
+bool
+ResourceManager::IsPurgeable(bool unreferenced, uint64_t &releaseEpoch)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(!unreferenced) {
+        return false;
+    }
+
+    if(!mShareGroup->IsShared()) {
+        return true;
+    }
+
+    // other contexts of the share group may still use the object in submitted work, up to the epoch it became unreferenced at
+    if(!releaseEpoch) {
+        releaseEpoch = mVkContext->vkQueueTracker->GetEpoch();
+    }
+
+    return mVkContext->vkQueueTracker->IsCompleted(releaseEpoch);
+}
+
 void
 ResourceManager::CleanPurgeList()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    ShareGroupLock lock(mShareGroup->mMutex);
+
+    mShareGroup->mRetireList.CleanUp();
+
     //Buffers
-    for (auto it = mPurgeListBufferObject.begin(); it != mPurgeListBufferObject.end(); ) {
-        if ((*it)->GetRefCount() == 0) {
-            delete *it;
-            it = mPurgeListBufferObject.erase(it);
+    for (auto it = mShareGroup->mPurgeListBufferObject.begin(); it != mShareGroup->mPurgeListBufferObject.end(); ) {
+        if (IsPurgeable(it->object->GetRefCount() == 0, it->releaseEpoch)) {
+            delete it->object;
+            it = mShareGroup->mPurgeListBufferObject.erase(it);
         } else {
             ++it;
         }
     }
     //Textures
-    for (auto it = mPurgeListTexture.begin(); it != mPurgeListTexture.end(); ) {
-        if ((*it)->GetRefCount() == 0) {
-            delete *it;
-            it = mPurgeListTexture.erase(it);
+    for (auto it = mShareGroup->mPurgeListTexture.begin(); it != mShareGroup->mPurgeListTexture.end(); ) {
+        if (IsPurgeable(it->object->GetRefCount() == 0, it->releaseEpoch)) {
+            delete it->object;
+            it = mShareGroup->mPurgeListTexture.erase(it);
         } else {
             ++it;
         }
     }
     //Shader Programs
-    for (auto it = mPurgeListShaderPrograms.begin(); it != mPurgeListShaderPrograms.end();) {
-        ShaderProgram* shaderProgramPtr = *it;
-        if (shaderProgramPtr->FreeForDeletion()) {
+    for (auto it = mShareGroup->mPurgeListShaderPrograms.begin(); it != mShareGroup->mPurgeListShaderPrograms.end();) {
+        ShaderProgram* shaderProgramPtr = it->object;
+        if (IsPurgeable(shaderProgramPtr->FreeForDeletion(), it->releaseEpoch)) {
             shaderProgramPtr->DetachShaders();
             uint32_t id = FindShaderProgramID(shaderProgramPtr);
             EraseShadingObject(id);
             DeallocateShaderProgram(shaderProgramPtr);
-            it = mPurgeListShaderPrograms.erase(it);
+            it = mShareGroup->mPurgeListShaderPrograms.erase(it);
         } else {
             ++it;
         }
     }
     //Shaders
-    for (auto it = mPurgeListShaders.begin(); it != mPurgeListShaders.end();) {
-        Shader* shaderPtr = *it;
-        if (shaderPtr->FreeForDeletion()) {
+    for (auto it = mShareGroup->mPurgeListShaders.begin(); it != mShareGroup->mPurgeListShaders.end();) {
+        Shader* shaderPtr = it->object;
+        if (IsPurgeable(shaderPtr->FreeForDeletion(), it->releaseEpoch)) {
             uint32_t id = FindShaderID(shaderPtr);
             EraseShadingObject(id);
             DeallocateShader(shaderPtr);
-            it = mPurgeListShaders.erase(it);
+            it = mShareGroup->mPurgeListShaders.erase(it);
         } else {
             ++it;
         }
     }
     //Renderbuffer
-    for (auto it = mPurgeListRenderbuffers.begin(); it != mPurgeListRenderbuffers.end(); ) {
-        if ((*it)->GetRefCount() == 0) {
-            delete *it;
-            it = mPurgeListRenderbuffers.erase(it);
+    for (auto it = mShareGroup->mPurgeListRenderbuffers.begin(); it != mShareGroup->mPurgeListRenderbuffers.end(); ) {
+        if (IsPurgeable(it->object->GetRefCount() == 0, it->releaseEpoch)) {
+            delete it->object;
+            it = mShareGroup->mPurgeListRenderbuffers.erase(it);
         } else {
             ++it;
         }
     }
 }
-
-void
-ResourceManager::FramebufferCacheAttachement(Texture *texture, GLuint index)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    for(typename map<uint32_t, Framebuffer *>::const_iterator it =
-        mFramebuffers.GetObjects()->begin(); it != mFramebuffers.GetObjects()->end(); it++) {
-
-        it->second->CacheAttachement(texture, index);
-    }
-}
-
-void
-ResourceManager::FramebufferCacheAttachement(Renderbuffer *renderbuffer, GLuint index)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    for(typename map<uint32_t, Framebuffer *>::const_iterator it =
-        mFramebuffers.GetObjects()->begin(); it != mFramebuffers.GetObjects()->end(); it++) {
-
-        it->second->CacheAttachement(renderbuffer, index);
-    }
-}
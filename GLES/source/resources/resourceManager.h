@@ -24,100 +24,80 @@
 #ifndef __RESOURCEMANAGER_H__
 #define __RESOURCEMANAGER_H__
 
-#include "resources/bufferObject.h"
+#include "resources/shareGroup.h"
 #include "resources/framebuffer.h"
-#include "resources/shaderProgram.h"
-#include "resources/renderbuffer.h"
-#include "resources/shader.h"
-#include "resources/texture.h"
+#include "resources/vertexArrayObject.h"
 #include "utils/cacheManager.h"
 
-typedef enum {
-    NO_ID,
-    SHADER_ID,
-    SHADER_PROGRAM_ID
-} shadingNamespaceType_t;
-
-typedef struct {
-    shadingNamespaceType_t                 type;
-    uint32_t                               arrayIndex;
-} ShadingNamespace_t;
-
+/**
+ * @brief The objects of a context. Framebuffers, vertex arrays and the
+ * default textures belong to the context itself, while the rest of them are
+ * accessed through the share group of the context.
+ */
 class ResourceManager {
 private:
 
+    typedef std::lock_guard<std::recursive_mutex> ShareGroupLock;
+
     const vulkanAPI::vkContext_t              *mVkContext;
-    typedef ObjectArray<Texture>               TextureArray;
-    typedef ObjectArray<BufferObject>          BufferArray;
-    typedef ObjectArray<Shader>                ShaderArray;
-    typedef ObjectArray<ShaderProgram>         ShaderProgramArray;
-    typedef ObjectArray<Renderbuffer>          RenderbufferArray;
     typedef ObjectArray<Framebuffer>           FramebufferArray;
-    typedef map<uint32_t, ShadingNamespace_t>  shadingPoolIDs_t;
+    typedef ObjectArray<VertexArrayObject>     VertexArrayObjectArray;
 
-    BufferArray                                mBuffers;
-    RenderbufferArray                          mRenderbuffers;
+    ShareGroup                                *mShareGroup;
     FramebufferArray                           mFramebuffers;
-    TextureArray                               mTextures;
-
-    uint32_t                                   mShadingObjectCount;
-    shadingPoolIDs_t                           mShadingObjectPool;
-    ShaderArray                                mShaders;
-    ShaderProgramArray                         mShaderPrograms;
+    VertexArrayObjectArray                     mVertexArrays;
 
     Texture                                   *mDefaultTexture2D;
     Texture                                   *mDefaultTextureCubeMap;
-    std::vector<GenericVertexAttribute>        mGenericVertexAttributes;
-    std::vector<BufferObject*>                 mPurgeListBufferObject;
-    std::vector<Texture*>                      mPurgeListTexture;
-    std::vector<Shader*>                       mPurgeListShaders;
-    std::vector<ShaderProgram*>                mPurgeListShaderPrograms;
-    std::vector<Renderbuffer*>                 mPurgeListRenderbuffers;
+    VertexArrayObject                         *mDefaultVertexArray;
+    CacheManager                              *mCacheManager;
+
+    template <class OBJECT>
+    void                       AddToPurgeList(std::vector<purgeEntry_t<OBJECT>> &purgeList, OBJECT *object) { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); purgeList.push_back({object, 0}); }
+    bool                       IsPurgeable(bool unreferenced, uint64_t &releaseEpoch);
 
 public:
-    ResourceManager(const vulkanAPI::vkContext_t *vkContext);
+    ResourceManager(const vulkanAPI::vkContext_t *vkContext, ResourceManager *shareResourceManager = nullptr);
     ~ResourceManager();
 
 // Allocate/Deallocate Functions
-    inline GLuint              AllocateTexture(void)                            { FUN_ENTRY(GL_LOG_TRACE); return mTextures.Allocate(); }
-    inline GLuint              AllocateBuffer(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.Allocate(); }
-    inline GLuint              AllocateRenderbuffer(void)                       { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers.Allocate(); }
+    inline GLuint              AllocateTexture(void)                            { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mTextures.Allocate(); }
+    inline GLuint              AllocateBuffer(void)                             { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mBuffers.Allocate(); }
+    inline GLuint              AllocateRenderbuffer(void)                       { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mRenderbuffers.Allocate(); }
     inline GLuint              AllocateFramebuffer(void)                        { FUN_ENTRY(GL_LOG_TRACE); return mFramebuffers.Allocate(); }
-    inline GLuint              AllocateShader(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mShaders.Allocate(); }
-    inline GLuint              AllocateShaderProgram(void)                      { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms.Allocate(); }
-    inline void                DeallocateTexture(uint32_t index)                { FUN_ENTRY(GL_LOG_TRACE); mTextures.Deallocate(index); }
-    inline void                DeallocateBuffer(uint32_t index)                 { FUN_ENTRY(GL_LOG_TRACE); mBuffers.Deallocate(index); }
-    inline void                DeallocateRenderbuffer(uint32_t index)           { FUN_ENTRY(GL_LOG_TRACE); mRenderbuffers.Deallocate(index); }
+    inline GLuint              AllocateShader(void)                             { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShaders.Allocate(); }
+    inline GLuint              AllocateShaderProgram(void)                      { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShaderPrograms.Allocate(); }
+           GLuint              AllocateVertexArray(void);
     inline void                DeallocateFramebuffer(uint32_t index)            { FUN_ENTRY(GL_LOG_TRACE); mFramebuffers.Deallocate(index); }
-    inline void                DeallocateShader(Shader *shader)                 { FUN_ENTRY(GL_LOG_TRACE); mShaders.Deallocate(mShaders.GetObjectId(shader)); }
-    inline void                DeallocateShaderProgram(ShaderProgram *program)  { FUN_ENTRY(GL_LOG_TRACE); mShaderPrograms.Deallocate(mShaderPrograms.GetObjectId(program)); }
-    inline void                RemoveFromListTexture(uint32_t index)            { FUN_ENTRY(GL_LOG_TRACE); mTextures.RemoveFromList(index); }
-    inline void                RemoveFromListBuffer(uint32_t index)             { FUN_ENTRY(GL_LOG_TRACE); mBuffers.RemoveFromList(index); }
-    inline void                RemoveFromListRenderbuffer(uint32_t index)       { FUN_ENTRY(GL_LOG_TRACE); mRenderbuffers.RemoveFromList(index); }
+    inline void                DeallocateShader(Shader *shader)                 { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); mShareGroup->mShaders.Deallocate(mShareGroup->mShaders.GetObjectId(shader)); }
+    inline void                DeallocateShaderProgram(ShaderProgram *program)  { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); mShareGroup->mShaderPrograms.Deallocate(mShareGroup->mShaderPrograms.GetObjectId(program)); }
+    inline void                DeallocateVertexArray(uint32_t index)            { FUN_ENTRY(GL_LOG_TRACE); mVertexArrays.Deallocate(index); }
+    inline void                RemoveFromListTexture(uint32_t index)            { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); mShareGroup->mTextures.RemoveFromList(index); }
+    inline void                RemoveFromListBuffer(uint32_t index)             { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); mShareGroup->mBuffers.RemoveFromList(index); }
+    inline void                RemoveFromListRenderbuffer(uint32_t index)       { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); mShareGroup->mRenderbuffers.RemoveFromList(index); }
 
 // Get Functions
-    inline std::vector<GenericVertexAttribute>& GetGenericVertexAttributes(void) { FUN_ENTRY(GL_LOG_TRACE); return mGenericVertexAttributes; }
-    inline GenericVertexAttribute* GetGenericVertexAttribute(size_t index)      { FUN_ENTRY(GL_LOG_TRACE); return &mGenericVertexAttributes[index]; }
-
-    inline TextureArray       *GetTextureArray(void)                            { FUN_ENTRY(GL_LOG_TRACE); return &mTextures; }
-    inline ShaderArray        *GetShaderArray(void)                             { FUN_ENTRY(GL_LOG_TRACE); return &mShaders;  }
-    inline ShaderProgramArray *GetShaderProgramArray(void)                      { FUN_ENTRY(GL_LOG_TRACE); return &mShaderPrograms; }
-    inline RenderbufferArray  *GetRenderbufferArray(void)                       { FUN_ENTRY(GL_LOG_TRACE); return &mRenderbuffers; }
+    inline VertexArrayObject * GetDefaultVertexArray(void)                      { FUN_ENTRY(GL_LOG_TRACE); return mDefaultVertexArray; }
+    inline VertexArrayObject * GetVertexArray(GLuint index)                     { FUN_ENTRY(GL_LOG_TRACE); return mVertexArrays.GetObject(index); }
+    inline uint32_t            GetVertexArrayID(const VertexArrayObject *vao)   { FUN_ENTRY(GL_LOG_TRACE); return vao == mDefaultVertexArray ? 0 : mVertexArrays.GetObjectId(vao); }
 
-    inline Texture *           GetTexture(GLuint index)                         { FUN_ENTRY(GL_LOG_TRACE); return mTextures.GetObject(index); }
+    inline Texture *           GetTexture(GLuint index)                         { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mTextures.GetObject(index); }
     inline Texture *           GetDefaultTexture(GLenum target)                 { FUN_ENTRY(GL_LOG_TRACE); return target == GL_TEXTURE_2D ? mDefaultTexture2D : mDefaultTextureCubeMap; }
     inline Framebuffer *       GetFramebuffer(GLuint index)                     { FUN_ENTRY(GL_LOG_TRACE); return mFramebuffers.GetObject(index); }
-    inline Renderbuffer *      GetRenderbuffer(GLuint index)                    { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers.GetObject(index); }
-    inline BufferObject *      GetBuffer(GLuint index)                          { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.GetObject(index); }
-    inline uint32_t            GetTextureID(const Texture *texture)             { FUN_ENTRY(GL_LOG_TRACE); return (texture == mDefaultTexture2D) || (texture == mDefaultTextureCubeMap) ? 0 : mTextures.GetObjectId(texture); }
-    inline uint32_t            GetBufferID(const BufferObject *bo)              { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.GetObjectId(bo); }
-    inline Shader *            GetShader(GLuint index)                          { FUN_ENTRY(GL_LOG_TRACE); return mShaders.GetObject(index); }
-    inline ShaderProgram *     GetShaderProgram(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms.GetObject(index); }
-    inline uint32_t            GetShaderID(const Shader *shader)                { FUN_ENTRY(GL_LOG_TRACE); return mShaders.GetObjectId(shader); }
-    inline uint32_t            GetShaderProgramID(const ShaderProgram *program) { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms.GetObjectId(program); }
-    inline uint32_t            GetShadingObjectCount(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectCount; }
-    inline ShadingNamespace_t  GetShadingObject(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectPool[index]; }
-    
+    inline Renderbuffer *      GetRenderbuffer(GLuint index)                    { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mRenderbuffers.GetObject(index); }
+    inline BufferObject *      GetBuffer(GLuint index)                          { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mBuffers.GetObject(index); }
+    inline uint32_t            GetTextureID(const Texture *texture)             { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return (texture == mDefaultTexture2D) || (texture == mDefaultTextureCubeMap) ? 0 : mShareGroup->mTextures.GetObjectId(texture); }
+    inline uint32_t            GetBufferID(const BufferObject *bo)              { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mBuffers.GetObjectId(bo); }
+    inline Shader *            GetShader(GLuint index)                          { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShaders.GetObject(index); }
+    inline ShaderProgram *     GetShaderProgram(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShaderPrograms.GetObject(index); }
+    inline uint32_t            GetShaderID(const Shader *shader)                { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShaders.GetObjectId(shader); }
+    inline uint32_t            GetShaderProgramID(const ShaderProgram *program) { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShaderPrograms.GetObjectId(program); }
+    inline uint32_t            GetShadingObjectCount(void)                const { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShadingObjectCount; }
+    inline ShadingNamespace_t  GetShadingObject(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShadingObjectPool[index]; }
+    inline ShaderCompiler *    GetShaderCompiler(void)                    const { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->mShaderCompiler; }
+    inline std::recursive_mutex &GetShareGroupMutex(void)                 const { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->mMutex; }
+    inline RetireList *        GetRetireList(void)                        const { FUN_ENTRY(GL_LOG_TRACE); return &mShareGroup->mRetireList; }
+
 // Set Functions
     void                       SetCacheManager(CacheManager *cacheManager);
 
@@ -125,11 +105,13 @@ public:
            uint32_t            PushShadingObject(const ShadingNamespace_t& obj);
            void                EraseShadingObject(GLuint index);
 
-    inline bool                TextureExists(GLuint index)                const { FUN_ENTRY(GL_LOG_TRACE); return mTextures.ObjectExists(index); }
-    inline bool                BufferExists(GLuint index)                 const { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.ObjectExists(index); }
-    inline bool                RenderbufferExists(GLuint index)           const { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers.ObjectExists(index); }
+    inline bool                TextureExists(GLuint index)                const { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mTextures.ObjectExists(index); }
+    inline bool                BufferExists(GLuint index)                 const { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mBuffers.ObjectExists(index); }
+    inline bool                RenderbufferExists(GLuint index)           const { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mRenderbuffers.ObjectExists(index); }
     inline bool                FramebufferExists(GLuint index)            const { FUN_ENTRY(GL_LOG_TRACE); return mFramebuffers.ObjectExists(index); }
-    inline bool                ShadingObjectExists(GLuint index)          const { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectPool.find(index) != mShadingObjectPool.end(); }
+    inline bool                VertexArrayExists(GLuint index)            const { FUN_ENTRY(GL_LOG_TRACE); return mVertexArrays.ObjectExists(index); }
+    inline bool                ShadingObjectExists(GLuint index)          const { FUN_ENTRY(GL_LOG_TRACE); ShareGroupLock lock(mShareGroup->mMutex); return mShareGroup->mShadingObjectPool.find(index) != mShareGroup->mShadingObjectPool.end(); }
+    inline bool                IsShared(void)                             const { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->IsShared(); }
 
            GLboolean           IsShadingObject(GLuint index, shadingNamespaceType_t type) const;
     bool                       IsTextureAttachedToFBO(const Texture *texture);
@@ -139,15 +121,17 @@ public:
     void                       UpdateFramebufferObjects(GLuint index, GLenum target);
     void                       CreateDefaultTextures(void);
 
+// Shader Compiler Functions
+    void                       CreateShaderCompiler(void);
+    void                       ReleaseShaderCompiler(void);
+
 //PurgeList Functions
-    void                       AddToPurgeList(BufferObject *object)             { FUN_ENTRY(GL_LOG_TRACE); mPurgeListBufferObject.push_back(object); }
-    void                       AddToPurgeList(Texture *object)                  { FUN_ENTRY(GL_LOG_TRACE); mPurgeListTexture.push_back(object); }
-    void                       AddToPurgeList(Shader *object)                   { FUN_ENTRY(GL_LOG_TRACE); mPurgeListShaders.push_back(object); }
-    void                       AddToPurgeList(ShaderProgram *object)            { FUN_ENTRY(GL_LOG_TRACE); mPurgeListShaderPrograms.push_back(object); }
-    void                       AddToPurgeList(Renderbuffer *object)             { FUN_ENTRY(GL_LOG_TRACE); mPurgeListRenderbuffers.push_back(object); }
+    void                       AddToPurgeList(BufferObject *object)             { FUN_ENTRY(GL_LOG_TRACE); AddToPurgeList(mShareGroup->mPurgeListBufferObject, object); }
+    void                       AddToPurgeList(Texture *object)                  { FUN_ENTRY(GL_LOG_TRACE); AddToPurgeList(mShareGroup->mPurgeListTexture, object); }
+    void                       AddToPurgeList(Shader *object)                   { FUN_ENTRY(GL_LOG_TRACE); AddToPurgeList(mShareGroup->mPurgeListShaders, object); }
+    void                       AddToPurgeList(ShaderProgram *object)            { FUN_ENTRY(GL_LOG_TRACE); AddToPurgeList(mShareGroup->mPurgeListShaderPrograms, object); }
+    void                       AddToPurgeList(Renderbuffer *object)             { FUN_ENTRY(GL_LOG_TRACE); AddToPurgeList(mShareGroup->mPurgeListRenderbuffers, object); }
     void                       CleanPurgeList();
-    void                       FramebufferCacheAttachement(Texture *texture, GLuint index);
-    void                       FramebufferCacheAttachement(Renderbuffer *renderbuffer, GLuint index);
 };
 
 #endif //__RESOURCEMANAGER_H__
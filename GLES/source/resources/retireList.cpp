@@ -0,0 +1,91 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       retireList.cpp
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Objects replaced by a shared object, deleted once the queue has completed their last use
+ *
+ */
+
+#include "retireList.h"
+#include "vulkan/queueTracker.h"
+
+RetireList::RetireList(const vulkanAPI::vkContext_t *vkContext)
+: mVkContext(vkContext)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+RetireList::~RetireList()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // destroyed along with the last context of the share group, which has waited for its work
+    for(auto &entry : mBuffers) {
+        delete entry.object;
+    }
+    for(auto &entry : mTextures) {
+        delete entry.object;
+    }
+}
+
+void
+RetireList::Retire(BufferObject *bufferObject)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mBuffers.push_back({bufferObject, mVkContext->vkQueueTracker->GetEpoch()});
+}
+
+void
+RetireList::Retire(Texture *texture)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mTextures.push_back({texture, mVkContext->vkQueueTracker->GetEpoch()});
+}
+
+template <class OBJECT>
+void
+RetireList::CleanUp(std::vector<retiredEntry_t<OBJECT>> &entries)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    for(auto it = entries.begin(); it != entries.end();) {
+        if(mVkContext->vkQueueTracker->IsCompleted(it->epoch)) {
+            delete it->object;
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void
+RetireList::CleanUp(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    CleanUp(mBuffers);
+    CleanUp(mTextures);
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       retireList.h
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Objects replaced by a shared object, deleted once the queue has completed their last use
+ *
+ */
+
+#ifndef __RETIRELIST_H__
+#define __RETIRELIST_H__
+
+#include <mutex>
+#include <vector>
+#include "resources/bufferObject.h"
+#include "resources/texture.h"
+
+/**
+ * @brief The buffers and textures that a program of the share group replaces
+ * while drawing. Any context of the share group may have pending commands
+ * that read them, so they are stamped with the queue epoch at retirement and
+ * deleted once that epoch has completed.
+ */
+class RetireList {
+private:
+    template <class OBJECT>
+    struct retiredEntry_t {
+        OBJECT                                *object;
+        uint64_t                               epoch;
+    };
+
+    const vulkanAPI::vkContext_t              *mVkContext;
+    std::mutex                                 mMutex;
+
+    std::vector<retiredEntry_t<BufferObject>>  mBuffers;
+    std::vector<retiredEntry_t<Texture>>       mTextures;
+
+    template <class OBJECT>
+    void                                       CleanUp(std::vector<retiredEntry_t<OBJECT>> &entries);
+
+public:
+    RetireList(const vulkanAPI::vkContext_t *vkContext);
+    ~RetireList();
+
+    /// Called while the retiring context records, so its pending use is covered by the current epoch
+    void                                       Retire(BufferObject *bufferObject);
+    void                                       Retire(Texture *texture);
+    void                                       CleanUp(void);
+};
+
+#endif //__RETIRELIST_H__
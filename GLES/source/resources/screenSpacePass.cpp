@@ -37,7 +37,7 @@ struct UniformBufferObject_ScreenSpace {
 };
 
 ScreenSpacePass::ScreenSpacePass(const vulkanAPI::vkContext_t *vkContext):
-    mVkContext(vkContext), mCacheManager(nullptr),
+    mVkContext(vkContext), mCacheManager(nullptr), mRetireList(nullptr),
     mNumElements(0), mVertexBuffer(nullptr),
     mVertexVkBuffer(VK_NULL_HANDLE), mVertexVkBufferOffset(0),
     mVertexInputInfo(), mPipelineCache(new vulkanAPI::PipelineCache(mVkContext)),
@@ -144,7 +144,7 @@ ScreenSpacePass::ShaderData::Destroy()
 }
 
 void
-ScreenSpacePass::ShaderData::InitResources(CacheManager* cacheManager, const vulkanAPI::vkContext_t* mVkContext)
+ScreenSpacePass::ShaderData::InitResources(RetireList* retireList, const vulkanAPI::vkContext_t* mVkContext)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -158,7 +158,7 @@ ScreenSpacePass::ShaderData::InitResources(CacheManager* cacheManager, const vul
     fragShader->SetVkContext(mVkContext);
     shaderProgram = new ShaderProgram(mVkContext);
     shaderProgram->SetShaderCompiler(shaderCompiler);
-    shaderProgram->SetCacheManager(cacheManager);
+    shaderProgram->SetRetireList(retireList);
 }
 
 bool
@@ -220,7 +220,7 @@ void main() {\n\
 }\n\
 ";
 
-    mShaderData.InitResources(mCacheManager, mVkContext);
+    mShaderData.InitResources(mRetireList, mVkContext);
     mShaderData.Generate(vertexSource100, fragmentSource100);
 
     if(!mShaderData.shaderProgram->SetPipelineShaderStage(mPipeline->GetShaderStageCountRef(), mPipeline->GetShaderStageIDsRef(), mPipeline->GetShaderStages())) {
@@ -351,8 +351,7 @@ ScreenSpacePass::BindUniformDescriptors(const VkCommandBuffer *cmdBuffer) const
 
     mShaderData.shaderProgram->UpdateDescriptorSet();
     mShaderData.shaderProgram->UpdateBuiltInUniformData(0.0f, 1.0f);
-    vkCmdBindDescriptorSets(*cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mShaderData.shaderProgram->GetVkPipelineLayout(), 0, 1,
-                            mShaderData.shaderProgram->GetVkDescSet(), 0, nullptr);
+    mShaderData.shaderProgram->BindDescriptorSet(*cmdBuffer);
 }
 
 void
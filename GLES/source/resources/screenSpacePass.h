@@ -27,6 +27,7 @@
 #include "utils/glUtils.h"
 #include "utils/glLogger.h"
 #include "bufferObject.h"
+#include "retireList.h"
 #include "vulkan/context.h"
 #include "vulkan/renderPass.h"
 #include "vulkan/pipeline.h"
@@ -55,7 +56,7 @@ struct ShaderData {
     vertShader(nullptr), fragShader(nullptr){
 
     }
-    void InitResources(CacheManager* cacheManager, const vulkanAPI::vkContext_t *mVkContext);
+    void InitResources(RetireList* retireList, const vulkanAPI::vkContext_t *mVkContext);
     bool Generate(const std::string& vertexSource, const std::string& fragmentSource);
     void Destroy(void);
 };
@@ -64,6 +65,7 @@ struct ShaderData {
 
     const vulkanAPI::vkContext_t               *mVkContext;
     CacheManager*                               mCacheManager;
+    RetireList*                                 mRetireList;
 
     // shader
     ShaderData                                  mShaderData;
@@ -126,6 +128,7 @@ public:
 
 // Set Functions
     void                                        SetCacheManager(CacheManager* cacheManager);
+    inline void                                 SetRetireList(RetireList* retireList)     {  FUN_ENTRY(GL_LOG_TRACE); mRetireList = retireList; }
 
 };
 
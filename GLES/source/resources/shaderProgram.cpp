@@ -28,6 +28,15 @@
 
 #include "shaderProgram.h"
 #include "context/context.h"
+#include <algorithm>
+#include <atomic>
+
+// Minimum value of VkPhysicalDevicePushDescriptorPropertiesKHR::maxPushDescriptors
+#define GLOVE_MAX_PUSH_DESCRIPTORS                      32
+
+// Identifies the vertex input interface of a program, so that a vertex array
+// object validated against it is never reused after a relink
+static std::atomic<uint32_t> vertexInputStampCounter(0);
 
 ShaderProgram::ShaderProgram(const vulkanAPI::vkContext_t *vkContext)
 : refObject()
@@ -53,18 +62,25 @@ ShaderProgram::ShaderProgram(const vulkanAPI::vkContext_t *vkContext)
     mVkDescPool = VK_NULL_HANDLE;
     mVkDescSet = VK_NULL_HANDLE;
     mVkPipelineLayout = VK_NULL_HANDLE;
+    mVkDescUpdateTemplate = VK_NULL_HANDLE;
 
     mPipelineCache = new vulkanAPI::PipelineCache(mVkContext);
+    mRetireList    = nullptr;
 
     mStageCount = 0;
 
     mUpdateDescriptorSets = false;
-    mUpdateDescriptorData = false;
+    mUsePushDescriptors = false;
     mLinked = false;
     mIsPrecompiled = false;
     mValidated = false;
     mActiveVertexVkBuffersCount = 0;
+    mVertexInputLayout = nullptr;
+    mVertexInputStamp = ++vertexInputStampCounter;
     mActiveIndexVkBuffer = VK_NULL_HANDLE;
+
+    memset(static_cast<void *>(mActiveVertexVkBufferOffsets), 0, sizeof(mActiveVertexVkBufferOffsets));
+    memset(static_cast<void *>(mActiveVertexBufferObjects), 0, sizeof(mActiveVertexBufferObjects));
     mExplicitIbo = nullptr;
 
     SetPipelineVertexInputStateInfo();
@@ -76,6 +92,9 @@ ShaderProgram::~ShaderProgram()
 
     ReleaseVkObjects();
 
+    vulkanAPI::VertexInputCache::ReleaseLayout(mVertexInputLayout);
+    mVertexInputLayout = nullptr;
+
     if(mPipelineCache) {
         delete mPipelineCache;
         mPipelineCache = nullptr;
@@ -150,9 +169,9 @@ ShaderProgram::SetPipelineVertexInputStateInfo(void)
     mVkPipelineVertexInput.pNext                            = nullptr;
     mVkPipelineVertexInput.flags                            = 0;
     mVkPipelineVertexInput.vertexBindingDescriptionCount    = 0;
-    mVkPipelineVertexInput.pVertexBindingDescriptions       = mVkVertexInputBinding;
+    mVkPipelineVertexInput.pVertexBindingDescriptions       = nullptr;
     mVkPipelineVertexInput.vertexAttributeDescriptionCount  = 0;
-    mVkPipelineVertexInput.pVertexAttributeDescriptions     = mVkVertexInputAttribute;
+    mVkPipelineVertexInput.pVertexAttributeDescriptions     = nullptr;
 }
 
 int
@@ -436,7 +455,7 @@ ShaderProgram::AllocateExplicitIndexBuffer(const void* data, size_t size, Buffer
     FUN_ENTRY(GL_LOG_TRACE);
 
     if(mExplicitIbo != nullptr) {
-        mCacheManager->CacheVBO(mExplicitIbo);
+        mRetireList->Retire(mExplicitIbo);
         mExplicitIbo = nullptr;
     }
 
@@ -472,21 +491,30 @@ ShaderProgram::LineLoopConversion(void* data, uint32_t indexCount, size_t elemen
     memcpy(static_cast<uint8_t*>(data) + (indexCount - 1) * elementByteSize, data, elementByteSize);
 }
 
+template<typename T>
+static uint32_t
+ScanMaxIndex(const T* srcData, uint32_t indexCount)
+{
+    T maxIndex = srcData[0];
+    for(uint32_t i = indexCount - 1; i > 0; --i) {
+        if(maxIndex < srcData[i]) {
+            maxIndex = srcData[i];
+        }
+    }
+
+    return static_cast<uint32_t>(maxIndex);
+}
+
 uint32_t
-ShaderProgram::GetMaxIndex(BufferObject* ibo, uint32_t indexCount, size_t actualSize, VkDeviceSize offset)
+ShaderProgram::GetMaxIndex(BufferObject* ibo, uint32_t indexCount, size_t actualSize, VkDeviceSize offset, GLenum type)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    uint16_t* srcData = new uint16_t[actualSize];
+    uint8_t* srcData = new uint8_t[actualSize];
     ibo->GetData(actualSize, offset, srcData);
 
-    uint16_t maxIndex = srcData[0];
-    for(uint32_t i = indexCount - 1; i > 0; --i) {
-        uint16_t index = srcData[i];
-        if(maxIndex < index) {
-            maxIndex = index;
-        }
-    }
+    uint32_t maxIndex = type == GL_UNSIGNED_INT ? ScanMaxIndex(reinterpret_cast<const uint32_t*>(srcData), indexCount) :
+                                                  ScanMaxIndex(reinterpret_cast<const uint16_t*>(srcData), indexCount);
     delete[] srcData;
 
     return maxIndex;
@@ -534,37 +562,132 @@ ShaderProgram::PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex
         LineLoopConversion(srcData, indexCount, sizeOne);
 
         validatedBuffer = AllocateExplicitIndexBuffer(srcData, actualSize, &ibo);
+        offset = 0;
         delete[] srcData;
     }
 
     if(validatedBuffer) {
         *firstIndex = offset;
-        *maxIndex = GetMaxIndex(ibo, indexCount, actualSize, offset);
+        *maxIndex = GetMaxIndex(ibo, indexCount, actualSize, offset, type);
+        mActiveIndexVkBuffer = ibo->GetVkBuffer();
+    }
+}
+
+bool
+ShaderProgram::PrepareMultiIndexBufferObject(uint32_t* firstIndices, uint32_t* maxIndex, const GLsizei* indexCounts, GLenum type, const void* const* indices, GLsizei drawCount, BufferObject* ibo)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    mActiveIndexVkBuffer = VK_NULL_HANDLE;
+    const size_t srcElementSize = type == GL_UNSIGNED_INT ? sizeof(GLuint) : type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLubyte);
+    const size_t dstElementSize = type == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort);
+    const GLenum dstType        = type == GL_UNSIGNED_INT ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    *maxIndex = 0;
+
+    // A bound index buffer that Vulkan can consume as-is is shared by all ranges,
+    // each of them addressed through its first index instead of a bind offset.
+    if(ibo && type != GL_UNSIGNED_BYTE) {
+        for(GLsizei i = 0; i < drawCount; ++i) {
+            VkDeviceSize offset = reinterpret_cast<VkDeviceSize>(indices[i]);
+            firstIndices[i] = static_cast<uint32_t>(offset / dstElementSize);
+            if(indexCounts[i]) {
+                *maxIndex = std::max(*maxIndex, GetMaxIndex(ibo, indexCounts[i], indexCounts[i] * dstElementSize, offset, type));
+            }
+        }
+        mActiveIndexVkBuffer = ibo->GetVkBuffer();
+        return true;
+    }
+
+    // Otherwise the ranges are gathered into a single explicit index buffer,
+    // widening unsigned bytes to uint16 on the way.
+    size_t totalCount = 0;
+    size_t maxCount   = 0;
+    for(GLsizei i = 0; i < drawCount; ++i) {
+        totalCount += indexCounts[i];
+        maxCount    = std::max(maxCount, static_cast<size_t>(indexCounts[i]));
+    }
+
+    uint8_t* dstData = new uint8_t[totalCount * dstElementSize];
+    uint8_t* srcData = ibo ? new uint8_t[maxCount * srcElementSize] : nullptr;
+    bool validatedBuffer = true;
+
+    uint32_t firstIndex = 0;
+    for(GLsizei i = 0; i < drawCount && validatedBuffer; ++i) {
+        firstIndices[i] = firstIndex;
+        if(!indexCounts[i]) {
+            continue;
+        }
+
+        const void* rangeData = indices[i];
+        if(ibo) {
+            validatedBuffer = ibo->GetData(indexCounts[i] * srcElementSize, reinterpret_cast<VkDeviceSize>(indices[i]), srcData);
+            rangeData = srcData;
+        }
+
+        uint8_t* dst = dstData + firstIndex * dstElementSize;
+        if(type == GL_UNSIGNED_BYTE) {
+            validatedBuffer = validatedBuffer && ConvertBuffer<uint8_t, uint16_t>(rangeData, dst, indexCounts[i]);
+        } else {
+            memcpy(dst, rangeData, indexCounts[i] * dstElementSize);
+        }
+        firstIndex += indexCounts[i];
+    }
+
+    validatedBuffer = validatedBuffer && AllocateExplicitIndexBuffer(dstData, totalCount * dstElementSize, &ibo);
+    if(validatedBuffer) {
+        *maxIndex = GetMaxIndex(ibo, totalCount, totalCount * dstElementSize, 0, dstType);
         mActiveIndexVkBuffer = ibo->GetVkBuffer();
     }
+
+    delete[] srcData;
+    delete[] dstData;
+
+    return validatedBuffer;
 }
 
 bool
-ShaderProgram::PrepareVertexAttribBufferObjects(size_t vertCount, uint32_t firstVertex,
-                                                std::vector<GenericVertexAttribute>& genericVertAttribs,
-                                                bool updatedVertexAttrib)
+ShaderProgram::PrepareVertexAttribBufferObjects(size_t vertCount, uint32_t firstVertex, uint32_t instanceCount,
+                                                VertexArrayObject *vao, bool updatedVertexAttrib)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    assert(GetCurrentContext());
+    bool resolved = vao->IsResolved(this, mVertexInputStamp);
+
+    // the vertex array object has already been validated against this program,
+    // so only the VkBuffer handles of its bindings need to be refreshed
+    if(resolved && !updatedVertexAttrib && !GetCurrentContext()->IsModeLineLoop()) {
+        mActiveVertexVkBuffersCount = vao->GetVkBuffers(mActiveVertexVkBuffers, mActiveVertexBufferObjects);
+        return SetVertexInputLayout(vao->GetVertexInputLayout());
+    }
+
     // store the location-binding associations for faster lookup
-    std::map<uint32_t, uint32_t> vboLocationBindings;
+    uint32_t vboLocationBindings[GLOVE_MAX_VERTEX_ATTRIBS];
+    uint32_t bindingDivisors[GLOVE_MAX_VERTEX_ATTRIBS];
+    bool resolvable = false;
 
-    if(UpdateVertexAttribProperties(vertCount, firstVertex, genericVertAttribs, vboLocationBindings, updatedVertexAttrib)) {
-        GenerateVertexInputProperties(genericVertAttribs, vboLocationBindings);
-        return true;
+    if(!UpdateVertexAttribProperties(vertCount, firstVertex, instanceCount, vao->GetGenericVertexAttributes(), vboLocationBindings,
+                                     bindingDivisors, mActiveVertexBufferObjects, &resolvable, updatedVertexAttrib || !resolved)) {
+        return false;
+    }
+
+    bool updatedLayout = GenerateVertexInputProperties(vao->GetGenericVertexAttributes(), vboLocationBindings, bindingDivisors);
+
+    if(resolvable) {
+        vao->Resolve(this, mVertexInputStamp, mVertexInputLayout, mActiveVertexVkBuffersCount, mActiveVertexBufferObjects);
+    } else {
+        vao->Invalidate();
     }
-    return false;
+
+    return updatedLayout;
 }
 
 bool
-ShaderProgram::UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVertex,
+ShaderProgram::UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVertex, uint32_t instanceCount,
                                               std::vector<GenericVertexAttribute>& genericVertAttribs,
-                                              std::map<uint32_t, uint32_t>& vboLocationBindings, bool updatedVertexAttrib)
+                                              uint32_t *vboLocationBindings, uint32_t *bindingDivisors,
+                                              BufferObject **bindingBufferObjects,
+                                              bool *resolvable, bool updatedVertexAttrib)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -573,39 +696,59 @@ ShaderProgram::UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVert
         --vertCount;
     }
 
-    // store attribute locations containing the same VkBuffer and stride
-    // as they are directly associated with vertex input bindings
-    typedef std::pair<VkBuffer, int32_t> BUFFER_STRIDE_PAIR;
-    std::map<BUFFER_STRIDE_PAIR, std::vector<uint32_t>> unique_buffer_stride_map;
+    // attribute locations containing the same VkBuffer, stride and divisor share a vertex input binding.
+    // Bindings are numbered in order of first use, so that the numbering, and thus the vertex
+    // input layout, does not depend on the VkBuffer handles.
+    VkBuffer bindingBuffers[GLOVE_MAX_VERTEX_ATTRIBS];
+    int32_t  bindingStrides[GLOVE_MAX_VERTEX_ATTRIBS];
+    uint32_t bindingCount = 0;
+
+    // the bindings can be reused by later draws only if every attribute is
+    // sourced as-is from a buffer object
+    *resolvable = !GetCurrentContext()->IsModeLineLoop();
 
-    std::vector<uint32_t> locationUsed;
+    uint32_t locationUsed = 0;
     for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveAttributes(); ++i) {
         const uint32_t attributelocation  = mShaderResourceInterface.GetAttributeLocation(i);
         const uint32_t occupiedLocations = OccupiedLocationsPerGlType(mShaderResourceInterface.GetAttributeType(i));
 
         for(uint32_t j = 0; j < occupiedLocations; ++j) {
             const uint32_t location = attributelocation + j;
+            assert(location < GLOVE_MAX_VERTEX_ATTRIBS);
 
             // if location is currently used then ommit it
-            if (std::find(locationUsed.begin(), locationUsed.end(), location) != locationUsed.end()) {
+            if(locationUsed & (1u << location)) {
                 continue;
             }
 
             GenericVertexAttribute& gva = genericVertAttribs[location];
+
+            // instanced arrays are sourced once per 'divisor' instances
+            uint32_t divisor     = gva.IsEnabled() ? gva.GetDivisor() : 0;
+            uint32_t numElements = divisor ? (instanceCount + divisor - 1) / divisor : static_cast<uint32_t>(firstVertex + vertCount);
+
             bool updatedVBO   = false;
-            BufferObject *vbo = gva.UpdateVertexAttribute(static_cast<uint32_t>(firstVertex + vertCount), updatedVBO);
+            BufferObject *vbo = gva.UpdateVertexAttribute(numElements, updatedVBO);
+            if(divisor > mVkContext->vkMaxVertexAttribDivisor) {
+                vbo     = gva.ExpandInstancedVBO(vbo, instanceCount, updatedVBO);
+                divisor = 1;
+                *resolvable = false;
+            }
             if(updatedVBO) {
                 updatedVertexAttrib = true;
             }
+            if(!gva.IsEnabled() || gva.IsInternalVBO() || gva.GetType() == GL_FIXED || gva.IsPaddedHalfFloat3()) {
+                *resolvable = false;
+            }
             VkBuffer bo       = vbo->GetVkBuffer();
 
             // If the primitives are rendered with GL_LINE_LOOP, which is not
             // supported in Vulkan, we have to modify the vbo and add the first vertex at the end.
-            if(GetCurrentContext()->IsModeLineLoop() && !mActiveIndexVkBuffer) {
+            if(GetCurrentContext()->IsModeLineLoop() && !mActiveIndexVkBuffer && !divisor) {
                 BufferObject* vboLineLoopUpdated = new VertexBufferObject(mVkContext);
 
                 size_t sizeOld = vbo->GetSize();
-                size_t sizeOne = gva.GetStride();
+                size_t sizeOne = gva.GetVkStride();
                 size_t sizeNew = sizeOld + sizeOne;
 
                 uint8_t *dataNew = new uint8_t[sizeNew];
@@ -616,45 +759,46 @@ ShaderProgram::UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVert
 
                 delete[] dataNew;
                 bo          = vboLineLoopUpdated->GetVkBuffer();
-                mCacheManager->CacheVBO(vboLineLoopUpdated);
+                mRetireList->Retire(vboLineLoopUpdated);
                 updatedVertexAttrib = true;
             }
 
             // store each location
-            int32_t stride      = gva.GetStride();
-            BUFFER_STRIDE_PAIR p = {bo, stride};
-            unique_buffer_stride_map[p].push_back(location);
-            locationUsed.push_back(location);
-        }
-    }
+            int32_t  stride  = gva.GetVkStride();
+            uint32_t binding = 0;
+            while(binding < bindingCount && (bindingBuffers[binding] != bo || bindingStrides[binding] != stride || bindingDivisors[binding] != divisor)) {
+                ++binding;
+            }
+            if(binding == bindingCount) {
+                bindingBuffers[bindingCount]       = bo;
+                bindingStrides[bindingCount]       = stride;
+                bindingDivisors[bindingCount]      = divisor;
+                bindingBufferObjects[bindingCount] = vbo;
+                ++bindingCount;
+            }
 
-    if(!updatedVertexAttrib) {
-        return false;
+            vboLocationBindings[location] = binding;
+            locationUsed |= 1u << location;
+        }
     }
 
+    // the handles are refreshed even if nothing else changed, as an orphaned
+    // buffer object is backed by a different VkBuffer
     memset(mActiveVertexVkBuffers, VK_NULL_HANDLE, sizeof(VkBuffer) * mActiveVertexVkBuffersCount);
-    mActiveVertexVkBuffersCount = 0;
+    memcpy(mActiveVertexVkBuffers, bindingBuffers, sizeof(VkBuffer) * bindingCount);
+    mActiveVertexVkBuffersCount = bindingCount;
 
-    // generate unique bindings for each VKbuffer/stride pair
-    uint32_t current_binding = 0;
-    for(const auto& iter : unique_buffer_stride_map) {
-        VkBuffer bo = iter.first.first;
-        for(const auto& loc_str_iter : iter.second) {
-            vboLocationBindings[loc_str_iter] = current_binding;
-        }
-        mActiveVertexVkBuffers[current_binding] = bo;
-        ++current_binding;
-    }
-    mActiveVertexVkBuffersCount = current_binding;
-    return true;
+    return updatedVertexAttrib;
 }
 
-void
-ShaderProgram::GenerateVertexInputProperties(std::vector<GenericVertexAttribute>& genericVertAttribs, const std::map<uint32_t, uint32_t>& vboLocationBindings)
+bool
+ShaderProgram::GenerateVertexInputProperties(std::vector<GenericVertexAttribute>& genericVertAttribs, const uint32_t *vboLocationBindings, const uint32_t *bindingDivisors)
 {
+    FUN_ENTRY(GL_LOG_DEBUG);
+
     // create vertex input bindings and attributes
-    uint32_t count = 0;
-    std::vector<uint32_t> locationUsed;
+    vulkanAPI::vertexInputLayout_t layout;
+    uint32_t locationUsed = 0;
 
     for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveAttributes(); ++i) {
         const uint32_t attributelocation  = mShaderResourceInterface.GetAttributeLocation(i);
@@ -662,31 +806,75 @@ ShaderProgram::GenerateVertexInputProperties(std::vector<GenericVertexAttribute>
 
         for(uint32_t j = 0; j < occupiedLocations; ++j) {
             const uint32_t location = attributelocation + j;
-            const uint32_t binding  = vboLocationBindings.at(location);
 
             // if location is currently used then ommit it
-            if (std::find(locationUsed.begin(), locationUsed.end(), location) != locationUsed.end()) {
+            if(locationUsed & (1u << location)) {
                 continue;
             }
 
+            const uint32_t binding = vboLocationBindings[location];
+
             GenericVertexAttribute& gva = genericVertAttribs[location];
-            mVkVertexInputBinding[binding].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-            mVkVertexInputBinding[binding].binding   = binding;
-            mVkVertexInputBinding[binding].stride    = static_cast<uint32_t>(gva.GetStride());
+            layout.bindings[binding].inputRate = bindingDivisors[binding] ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX;
+            layout.bindings[binding].binding   = binding;
+            layout.bindings[binding].stride    = static_cast<uint32_t>(gva.GetVkStride());
+            layout.divisors[binding]           = bindingDivisors[binding];
 
-            mVkVertexInputAttribute[count].binding  = binding;
-            mVkVertexInputAttribute[count].location = location;
-            mVkVertexInputAttribute[count].format   = gva.GetVkFormat();
-            mVkVertexInputAttribute[count].offset   = gva.GetOffset();
+            VkVertexInputAttributeDescription &attribute = layout.attributes[layout.attributeCount];
+            attribute.binding  = binding;
+            attribute.location = location;
+            attribute.format   = gva.GetVkFormat();
+            attribute.offset   = gva.GetVkOffset();
 
-            ++count;
+            ++layout.attributeCount;
 
-            locationUsed.push_back(location);
+            locationUsed |= 1u << location;
         }
     }
+    layout.bindingCount = mActiveVertexVkBuffersCount;
 
-    mVkPipelineVertexInput.vertexBindingDescriptionCount   = mActiveVertexVkBuffersCount;
-    mVkPipelineVertexInput.vertexAttributeDescriptionCount = count;
+    return SetVertexInputLayout(GetCurrentContext()->GetVertexInputCache()->GetLayout(&layout));
+}
+
+bool
+ShaderProgram::SetVertexInputLayout(const vulkanAPI::vertexInputLayout_t *vertexInputLayout)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// The VkPipeline needs to be rebuilt only if the layout has actually changed
+    if(vertexInputLayout == mVertexInputLayout) {
+        return false;
+    }
+    vulkanAPI::VertexInputCache::AcquireLayout(vertexInputLayout);
+    vulkanAPI::VertexInputCache::ReleaseLayout(mVertexInputLayout);
+    mVertexInputLayout = vertexInputLayout;
+
+    mVkPipelineVertexInput.vertexBindingDescriptionCount   = mVertexInputLayout->bindingCount;
+    mVkPipelineVertexInput.pVertexBindingDescriptions      = mVertexInputLayout->bindings;
+    mVkPipelineVertexInput.vertexAttributeDescriptionCount = mVertexInputLayout->attributeCount;
+    mVkPipelineVertexInput.pVertexAttributeDescriptions    = mVertexInputLayout->attributes;
+    mVkPipelineVertexInput.pNext                           = nullptr;
+
+#ifdef VK_EXT_vertex_attribute_divisor
+    /// divisors other than 1 are only present when VK_EXT_vertex_attribute_divisor is enabled
+    uint32_t divisorCount = 0;
+    for(uint32_t i = 0; i < mVertexInputLayout->bindingCount; ++i) {
+        if(mVertexInputLayout->divisors[i] > 1) {
+            mVkVertexBindingDivisors[divisorCount].binding = i;
+            mVkVertexBindingDivisors[divisorCount].divisor = mVertexInputLayout->divisors[i];
+            ++divisorCount;
+        }
+    }
+    if(divisorCount) {
+        mVkPipelineVertexInputDivisor.sType                     = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_DIVISOR_STATE_CREATE_INFO_EXT;
+        mVkPipelineVertexInputDivisor.pNext                     = nullptr;
+        mVkPipelineVertexInputDivisor.vertexBindingDivisorCount = divisorCount;
+        mVkPipelineVertexInputDivisor.pVertexBindingDivisors    = mVkVertexBindingDivisors;
+        mVkPipelineVertexInput.pNext                            = &mVkPipelineVertexInputDivisor;
+    }
+#endif
+
+    return true;
 }
 
 void
@@ -777,7 +965,6 @@ ShaderProgram::SetUniformData(uint32_t location, size_t size, const void *ptr)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     mShaderResourceInterface.SetUniformClientData(location, size, ptr);
-    mUpdateDescriptorData = true;
 }
 
 void
@@ -790,12 +977,12 @@ ShaderProgram::SetUniformSampler(uint32_t location, int count, const int *textur
 }
 
 void
-ShaderProgram::SetCacheManager(CacheManager *cacheManager)
+ShaderProgram::SetRetireList(RetireList *retireList)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    mCacheManager = cacheManager;
-    mShaderResourceInterface.SetCacheManager(cacheManager);
+    mRetireList = retireList;
+    mShaderResourceInterface.SetRetireList(retireList);
 }
 
 void
@@ -808,6 +995,11 @@ ShaderProgram::ReleaseVkObjects(void)
         mVkPipelineLayout = VK_NULL_HANDLE;
     }
 
+    if(mVkDescUpdateTemplate != VK_NULL_HANDLE) {
+        mVkContext->vkExtCallbacks.fpDestroyDescriptorUpdateTemplateKHR(mVkContext->vkDevice, mVkDescUpdateTemplate, nullptr);
+        mVkDescUpdateTemplate = VK_NULL_HANDLE;
+    }
+
     if(mVkDescSetLayout != VK_NULL_HANDLE) {
         vkDestroyDescriptorSetLayout(mVkContext->vkDevice, mVkDescSetLayout, nullptr);
         mVkDescSetLayout = VK_NULL_HANDLE;
@@ -823,6 +1015,11 @@ ShaderProgram::ReleaseVkObjects(void)
         mVkDescPool = VK_NULL_HANDLE;
     }
 
+    mVkDescUpdateData.clear();
+    mVkDescUpdateDataOffsets.clear();
+    mVkWriteDescSets.clear();
+    mUsePushDescriptors = false;
+
     for(int32_t i = 0; i < MAX_SHADERS; ++i) {
         mShaderSPVsize[i] = 0;
         mShaderSPVdata[i] = nullptr;
@@ -889,7 +1086,7 @@ ShaderProgram::CreateDescriptorSetLayout(uint32_t nLiveUniformBlocks)
     memset(static_cast<void *>(&descLayoutInfo), 0, sizeof(descLayoutInfo));
     descLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     descLayoutInfo.pNext = nullptr;
-    descLayoutInfo.flags = 0;
+    descLayoutInfo.flags = mUsePushDescriptors ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
     descLayoutInfo.bindingCount = nLiveUniformBlocks;
     descLayoutInfo.pBindings = mVkDescSetLayoutBind;
 
@@ -978,6 +1175,88 @@ ShaderProgram::CreateDescriptorSet(void)
     return true;
 }
 
+void
+ShaderProgram::CreateDescriptorUpdateData(uint32_t nLiveUniformBlocks)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// Each opaque block holds the image descriptors of a single sampler uniform
+    std::vector<uint32_t> descriptorCounts(nLiveUniformBlocks, 1);
+    for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveUniforms(); ++i) {
+        if(mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_2D || mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_CUBE) {
+            descriptorCounts[mShaderResourceInterface.GetUniformBlockIndex(i)] = mShaderResourceInterface.GetUniformArraySize(i);
+        }
+    }
+
+    /// Lay out the image/buffer infos of all blocks in a single buffer, so that
+    /// it can be handed as is to the update template or to vkUpdateDescriptorSets
+    uint32_t dataSize = 0;
+    mVkDescUpdateDataOffsets.resize(nLiveUniformBlocks);
+    for(uint32_t i = 0; i < nLiveUniformBlocks; ++i) {
+        mVkDescUpdateDataOffsets[i] = dataSize;
+        dataSize += descriptorCounts[i] * (mShaderResourceInterface.IsUniformBlockOpaque(i) ? sizeof(VkDescriptorImageInfo) : sizeof(VkDescriptorBufferInfo));
+    }
+    mVkDescUpdateData.assign(dataSize, 0);
+
+    mVkWriteDescSets.resize(nLiveUniformBlocks);
+    memset(static_cast<void*>(mVkWriteDescSets.data()), 0, nLiveUniformBlocks * sizeof(VkWriteDescriptorSet));
+    for(uint32_t i = 0; i < nLiveUniformBlocks; ++i) {
+        uint8_t *data = &mVkDescUpdateData[mVkDescUpdateDataOffsets[i]];
+
+        mVkWriteDescSets[i].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        mVkWriteDescSets[i].pNext           = nullptr;
+        mVkWriteDescSets[i].dstSet          = VK_NULL_HANDLE;
+        mVkWriteDescSets[i].dstBinding      = mShaderResourceInterface.GetUniformBlockBinding(i);
+        mVkWriteDescSets[i].dstArrayElement = 0;
+        mVkWriteDescSets[i].descriptorCount = descriptorCounts[i];
+
+        if(mShaderResourceInterface.IsUniformBlockOpaque(i)) {
+            mVkWriteDescSets[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            mVkWriteDescSets[i].pImageInfo     = reinterpret_cast<VkDescriptorImageInfo *>(data);
+        } else {
+            mVkWriteDescSets[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            mVkWriteDescSets[i].pBufferInfo    = reinterpret_cast<VkDescriptorBufferInfo *>(data);
+        }
+    }
+}
+
+bool
+ShaderProgram::CreateDescriptorUpdateTemplate(uint32_t nLiveUniformBlocks)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::vector<VkDescriptorUpdateTemplateEntryKHR> entries(nLiveUniformBlocks);
+    for(uint32_t i = 0; i < nLiveUniformBlocks; ++i) {
+        entries[i].dstBinding      = mVkWriteDescSets[i].dstBinding;
+        entries[i].dstArrayElement = mVkWriteDescSets[i].dstArrayElement;
+        entries[i].descriptorCount = mVkWriteDescSets[i].descriptorCount;
+        entries[i].descriptorType  = mVkWriteDescSets[i].descriptorType;
+        entries[i].offset          = mVkDescUpdateDataOffsets[i];
+        entries[i].stride          = mShaderResourceInterface.IsUniformBlockOpaque(i) ? sizeof(VkDescriptorImageInfo) : sizeof(VkDescriptorBufferInfo);
+    }
+
+    VkDescriptorUpdateTemplateCreateInfoKHR templateInfo;
+    memset(static_cast<void *>(&templateInfo), 0, sizeof(templateInfo));
+    templateInfo.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+    templateInfo.pNext                      = nullptr;
+    templateInfo.flags                      = 0;
+    templateInfo.descriptorUpdateEntryCount = nLiveUniformBlocks;
+    templateInfo.pDescriptorUpdateEntries   = entries.data();
+    templateInfo.templateType               = mUsePushDescriptors ? VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR :
+                                                                    VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+    templateInfo.descriptorSetLayout        = mVkDescSetLayout;
+    templateInfo.pipelineBindPoint          = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    templateInfo.pipelineLayout             = mVkPipelineLayout;
+    templateInfo.set                        = 0;
+
+    if(mVkContext->vkExtCallbacks.fpCreateDescriptorUpdateTemplateKHR(mVkContext->vkDevice, &templateInfo, nullptr, &mVkDescUpdateTemplate) != VK_SUCCESS) {
+        mVkDescUpdateTemplate = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
 bool
 ShaderProgram::AllocateVkDescriptoSet(void)
 {
@@ -987,6 +1266,17 @@ ShaderProgram::AllocateVkDescriptoSet(void)
 
     ReleaseVkObjects();
 
+    CreateDescriptorUpdateData(nLiveUniformBlocks);
+
+    /// Push descriptors are recorded straight into the command buffer,
+    /// so neither a descriptor pool nor a descriptor set is needed
+    uint32_t nDescriptors = 0;
+    for(uint32_t i = 0; i < nLiveUniformBlocks; ++i) {
+        nDescriptors += mVkWriteDescSets[i].descriptorCount;
+    }
+    mUsePushDescriptors = nLiveUniformBlocks && nDescriptors <= GLOVE_MAX_PUSH_DESCRIPTORS &&
+                          mVkContext->mIsPushDescriptorExtSupported;
+
     if(!CreateDescriptorSetLayout(nLiveUniformBlocks)) {
         assert(0);
         return false;
@@ -996,12 +1286,24 @@ ShaderProgram::AllocateVkDescriptoSet(void)
         return true;
     }
 
-    if(!CreateDescriptorPool(nLiveUniformBlocks)) {
-        assert(0);
-        return false;
+    if(!mUsePushDescriptors) {
+        if(!CreateDescriptorPool(nLiveUniformBlocks)) {
+            assert(0);
+            return false;
+        }
+
+        if(!CreateDescriptorSet()) {
+            assert(0);
+            return false;
+        }
+
+        for(uint32_t i = 0; i < nLiveUniformBlocks; ++i) {
+            mVkWriteDescSets[i].dstSet = mVkDescSet;
+        }
     }
 
-    if(!CreateDescriptorSet()) {
+    /// Without a template, the descriptor set is updated through vkUpdateDescriptorSets
+    if(mVkContext->mIsDescriptorUpdateTemplateExtSupported && !CreateDescriptorUpdateTemplate(nLiveUniformBlocks) && mUsePushDescriptors) {
         assert(0);
         return false;
     }
@@ -1043,23 +1345,22 @@ ShaderProgram::UpdateDescriptorSet(void)
 
     Context *context = GetCurrentContext();
     assert(context);
-    assert(mVkDescSet);
     assert(mVkContext);
 
     if(mShaderResourceInterface.GetLiveUniformBlocks() == 0) {
         return;
     }
+    assert(mVkDescSet || mUsePushDescriptors);
 
-    /// Transfer any new local uniform data into the buffer objects
-    if(mUpdateDescriptorData) {
-        bool allocatedNewBufferObject = false;
-        mShaderResourceInterface.UpdateUniformBufferData(mVkContext, &allocatedNewBufferObject);
-        if(allocatedNewBufferObject) {
-            mUpdateDescriptorSets = true;
-        }
-
-        mUpdateDescriptorData = false;
+    /// Transfer any new local uniform data into the buffer objects.
+    /// This also marks the buffer objects as referenced by the upcoming draw.
+    bool   allocatedNewBufferObject = false;
+    size_t uniformBytesCopied       = 0;
+    mShaderResourceInterface.UpdateUniformBufferData(mVkContext, &allocatedNewBufferObject, &uniformBytesCopied);
+    if(allocatedNewBufferObject) {
+        mUpdateDescriptorSets = true;
     }
+    context->GetCacheManager()->AddUniformBytesCopied(uniformBytesCopied);
 
     // Check if any texture is attached to a user-based FBO
     for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveUniforms(); ++i) {
@@ -1101,130 +1402,119 @@ ShaderProgram::UpdateSamplerDescriptors(void)
     assert(context);
 
     const uint32_t nLiveUniformBlocks = mShaderResourceInterface.GetLiveUniformBlocks();
-    uint32_t nSamplers = 0;
-    for(uint32_t i = 0; i < nLiveUniformBlocks; ++i) {
-        if(mShaderResourceInterface.IsUniformBlockOpaque(i)) {
-            nSamplers += mShaderResourceInterface.GetUniformArraySize(i);
-        }
-    }
 
     /// Get texture units from samplers
-    uint32_t samp = 0;
-    std::map<uint32_t, uint32_t> map_block_texDescriptor;
-    VkDescriptorImageInfo *textureDescriptors = nullptr;
-    if(nSamplers) {
-        textureDescriptors = new VkDescriptorImageInfo[nSamplers];
-        memset(static_cast<void *>(textureDescriptors), 0, nSamplers * sizeof(*textureDescriptors));
-
-        for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveUniforms(); ++i) {
-            if(mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_2D || mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_CUBE) {
-                for(int32_t j = 0; j < mShaderResourceInterface.GetUniformArraySize(i); ++j) {
-                    const glsl_sampler_t textureUnit = *(glsl_sampler_t *)mShaderResourceInterface.GetUniformClientData(i);
-
-                    /// Sampler might need an update
-                    Texture *activeTexture = context->GetStateManager()->GetActiveObjectsState()->GetActiveTexture(
-                    mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP, textureUnit); // TODO remove mGlContext
-                    // Calling a sampler from a fragment shader must return (0, 0, 0, 1) 
-                    // when the sampler’s associated texture object is not complete.
-                    if( !activeTexture->IsCompleted() || !activeTexture->IsNPOTAccessCompleted()) {
-                        uint8_t pixels[4] = {0,0,0,255};
-                        for(GLint layer = 0; layer < activeTexture->GetLayersCount(); ++layer) {
-                            for(GLint level = 0; level < activeTexture->GetMipLevelsCount(); ++level) {
-                                activeTexture->SetState(1, 1, level, layer, GL_RGBA, GL_UNSIGNED_BYTE, Texture::GetDefaultInternalAlignment(), pixels);
-                            }
-                        }
+    for(uint32_t i = 0; i < mShaderResourceInterface.GetLiveUniforms(); ++i) {
+        if(mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_2D || mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_CUBE) {
+            VkDescriptorImageInfo *textureDescriptors = reinterpret_cast<VkDescriptorImageInfo *>(
+                &mVkDescUpdateData[mVkDescUpdateDataOffsets[mShaderResourceInterface.GetUniformBlockIndex(i)]]);
 
-                        if(activeTexture->IsCompleted()) {
-                            activeTexture->SetVkFormat(VK_FORMAT_R8G8B8A8_UNORM);
-                            activeTexture->Allocate();
-                            activeTexture->PrepareVkImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            for(int32_t j = 0; j < mShaderResourceInterface.GetUniformArraySize(i); ++j) {
+                const glsl_sampler_t textureUnit = *(glsl_sampler_t *)mShaderResourceInterface.GetUniformClientData(i);
+
+                /// Sampler might need an update
+                Texture *activeTexture = context->GetStateManager()->GetActiveObjectsState()->GetActiveTexture(
+                mShaderResourceInterface.GetUniformType(i) == GL_SAMPLER_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP, textureUnit); // TODO remove mGlContext
+                activeTexture->FlushAllocation();
+
+                // Calling a sampler from a fragment shader must return (0, 0, 0, 1) 
+                // when the sampler’s associated texture object is not complete.
+                if( !activeTexture->IsCompleted() || !activeTexture->IsNPOTAccessCompleted()) {
+                    uint8_t pixels[4] = {0,0,0,255};
+                    for(GLint layer = 0; layer < activeTexture->GetLayersCount(); ++layer) {
+                        for(GLint level = 0; level < activeTexture->GetMipLevelsCount(); ++level) {
+                            activeTexture->SetState(1, 1, level, layer, GL_RGBA, GL_UNSIGNED_BYTE, Texture::GetDefaultInternalAlignment(), pixels);
                         }
                     }
-                    else if(context->GetResourceManager()->IsTextureAttachedToFBO(activeTexture)) {
-
-                        // Get Inverted Data from FBO's Color Attachment Texture
-                        GLenum dstInternalFormat = activeTexture->GetExplicitInternalFormat();
-                        ImageRect srcRect(0, 0, activeTexture->GetWidth(), activeTexture->GetHeight(),
-                            GlInternalFormatTypeToNumElements(dstInternalFormat, activeTexture->GetExplicitType()),
-                            GlTypeToElementSize(activeTexture->GetExplicitType()),
-                            Texture::GetDefaultInternalAlignment());
-                        ImageRect dstRect(0, 0, activeTexture->GetWidth(), activeTexture->GetHeight(),
-                            GlInternalFormatTypeToNumElements(dstInternalFormat, activeTexture->GetExplicitType()),
-                            GlTypeToElementSize(activeTexture->GetExplicitType()),
-                            Texture::GetDefaultInternalAlignment());
-
-                        uint8_t* dstData = new uint8_t[dstRect.GetRectBufferSize()];
-                        srcRect.y = activeTexture->GetInvertedYOrigin(&srcRect);
-                        activeTexture->CopyPixelsToHost  (&srcRect, &dstRect, 0, 0, dstInternalFormat, static_cast<void *>(dstData));
-
-                        // Create new Texture with this data 
-                        Texture *inverted_texture = new Texture(mVkContext);
-                        inverted_texture->SetTarget(GL_TEXTURE_2D);
-                        inverted_texture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT));
-                        inverted_texture->SetVkImageTiling();
-                        inverted_texture->SetVkImageTarget(vulkanAPI::Image::VK_IMAGE_TARGET_2D);
-                        inverted_texture->InitState();
-
-                        inverted_texture->SetVkFormat(activeTexture->GetVkFormat());
-                        inverted_texture->SetState(activeTexture->GetWidth(), activeTexture->GetHeight(),
-                                    0, 0,
-                                    GlInternalFormatToGlFormat(dstInternalFormat),
-                                    GlInternalFormatToGlType(dstInternalFormat),
-                                    Texture::GetDefaultInternalAlignment(),
-                                    dstData);
-                        
-                        if(inverted_texture->IsCompleted()) {
-                            inverted_texture->Allocate();
-                            inverted_texture->PrepareVkImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-                            mCacheManager->CacheTexture(inverted_texture);
-                        }
 
-                        activeTexture = inverted_texture;
-
-                        delete[] dstData;
+                    if(activeTexture->IsCompleted()) {
+                        activeTexture->SetVkFormat(VK_FORMAT_R8G8B8A8_UNORM);
+                        activeTexture->Allocate();
+                        activeTexture->PrepareVkImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+                    }
+                }
+                else if(context->GetResourceManager()->IsTextureAttachedToFBO(activeTexture)) {
+
+                    // Get Inverted Data from FBO's Color Attachment Texture
+                    GLenum dstInternalFormat = activeTexture->GetExplicitInternalFormat();
+                    ImageRect srcRect(0, 0, activeTexture->GetWidth(), activeTexture->GetHeight(),
+                        GlInternalFormatTypeToNumElements(dstInternalFormat, activeTexture->GetExplicitType()),
+                        GlTypeToElementSize(activeTexture->GetExplicitType()),
+                        Texture::GetDefaultInternalAlignment());
+                    ImageRect dstRect(0, 0, activeTexture->GetWidth(), activeTexture->GetHeight(),
+                        GlInternalFormatTypeToNumElements(dstInternalFormat, activeTexture->GetExplicitType()),
+                        GlTypeToElementSize(activeTexture->GetExplicitType()),
+                        Texture::GetDefaultInternalAlignment());
+
+                    uint8_t* dstData = new uint8_t[dstRect.GetRectBufferSize()];
+                    srcRect.y = activeTexture->GetInvertedYOrigin(&srcRect);
+                    activeTexture->CopyPixelsToHost  (&srcRect, &dstRect, 0, 0, dstInternalFormat, static_cast<void *>(dstData));
+
+                    // Create new Texture with this data 
+                    Texture *inverted_texture = new Texture(mVkContext);
+                    inverted_texture->SetTarget(GL_TEXTURE_2D);
+                    inverted_texture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT));
+                    inverted_texture->SetVkImageTiling();
+                    inverted_texture->SetVkImageTarget(vulkanAPI::Image::VK_IMAGE_TARGET_2D);
+                    inverted_texture->InitState();
+
+                    inverted_texture->SetVkFormat(activeTexture->GetVkFormat());
+                    inverted_texture->SetState(activeTexture->GetWidth(), activeTexture->GetHeight(),
+                                0, 0,
+                                GlInternalFormatToGlFormat(dstInternalFormat),
+                                GlInternalFormatToGlType(dstInternalFormat),
+                                Texture::GetDefaultInternalAlignment(),
+                                dstData);
+                    
+                    if(inverted_texture->IsCompleted()) {
+                        inverted_texture->Allocate();
+                        inverted_texture->PrepareVkImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+                        mRetireList->Retire(inverted_texture);
                     }
 
-                    activeTexture->CreateVkSampler();
-
-                    textureDescriptors[samp].sampler     = activeTexture->GetVkSampler();
-                    textureDescriptors[samp].imageLayout = activeTexture->GetVkImageLayout();
-                    textureDescriptors[samp].imageView   = activeTexture->GetVkImageView();
+                    activeTexture = inverted_texture;
 
-                    if(j == 0) {
-                        map_block_texDescriptor[mShaderResourceInterface.GetUniformBlockIndex(i)] = samp;
-                    }
-                    ++samp;
+                    delete[] dstData;
                 }
+
+                activeTexture->CreateVkSampler();
+
+                textureDescriptors[j].sampler     = activeTexture->GetVkSampler();
+                textureDescriptors[j].imageLayout = activeTexture->GetVkImageLayout();
+                textureDescriptors[j].imageView   = activeTexture->GetVkImageView();
             }
         }
     }
-    assert(samp == nSamplers);
 
-    VkWriteDescriptorSet *writes = new VkWriteDescriptorSet[nLiveUniformBlocks];
-    memset(static_cast<void*>(writes), 0, nLiveUniformBlocks * sizeof(*writes));
     for(uint32_t i = 0; i < nLiveUniformBlocks; ++i) {
-        writes[i].sType      = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writes[i].pNext      = nullptr;
-        writes[i].dstSet     = mVkDescSet;
-        writes[i].dstBinding = mShaderResourceInterface.GetUniformBlockBinding(i);
+        if(!mShaderResourceInterface.IsUniformBlockOpaque(i)) {
+            VkDescriptorBufferInfo *bufferDescriptor = reinterpret_cast<VkDescriptorBufferInfo *>(&mVkDescUpdateData[mVkDescUpdateDataOffsets[i]]);
+            *bufferDescriptor = *mShaderResourceInterface.GetUniformBufferObject(i)->GetBufferDescInfo();
+        }
+    }
 
-        if(mShaderResourceInterface.IsUniformBlockOpaque(i)) {
-            writes[i].pImageInfo      = &textureDescriptors[map_block_texDescriptor[i]];
-            writes[i].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            writes[i].descriptorCount = mShaderResourceInterface.GetUniformArraySize(i);
+    /// Push descriptors are recorded from mVkDescUpdateData in BindDescriptorSet()
+    if(!mUsePushDescriptors) {
+        if(mVkDescUpdateTemplate != VK_NULL_HANDLE) {
+            mVkContext->vkExtCallbacks.fpUpdateDescriptorSetWithTemplateKHR(mVkContext->vkDevice, mVkDescSet, mVkDescUpdateTemplate, mVkDescUpdateData.data());
         } else {
-            writes[i].descriptorCount = 1;
-            writes[i].descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            writes[i].pBufferInfo     = mShaderResourceInterface.GetUniformBufferObject(i)->GetBufferDescInfo();
+            vkUpdateDescriptorSets(mVkContext->vkDevice, nLiveUniformBlocks, mVkWriteDescSets.data(), 0, nullptr);
         }
     }
 
-    vkUpdateDescriptorSets(mVkContext->vkDevice, nLiveUniformBlocks, writes, 0, nullptr);
+    mUpdateDescriptorSets = false;
+}
 
-    delete[] writes;
-    delete[] textureDescriptors;
+void
+ShaderProgram::BindDescriptorSet(VkCommandBuffer cmdBuffer) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
 
-    mUpdateDescriptorSets = false;
+    if(mUsePushDescriptors) {
+        mVkContext->vkExtCallbacks.fpCmdPushDescriptorSetWithTemplateKHR(cmdBuffer, mVkDescUpdateTemplate, mVkPipelineLayout, 0, mVkDescUpdateData.data());
+    } else {
+        vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mVkPipelineLayout, 0, 1, &mVkDescSet, 0, nullptr);
+    }
 }
 
 void
@@ -1234,8 +1524,13 @@ ShaderProgram::ResetVulkanVertexInput(void)
 
     mVkPipelineVertexInput.vertexAttributeDescriptionCount = 0;
     mVkPipelineVertexInput.vertexBindingDescriptionCount = 0;
+    mVkPipelineVertexInput.pNext = nullptr;
+    vulkanAPI::VertexInputCache::ReleaseLayout(mVertexInputLayout);
+    mVertexInputLayout = nullptr;
+    mVertexInputStamp = ++vertexInputStampCounter;
     mActiveVertexVkBuffersCount = 0;
     memset(static_cast<void *>(mActiveVertexVkBuffers), 0, sizeof(mActiveVertexVkBuffers));
+    memset(static_cast<void *>(mActiveVertexBufferObjects), 0, sizeof(mActiveVertexBufferObjects));
 }
 
 void
@@ -1265,5 +1560,4 @@ ShaderProgram::BuildShaderResourceInterface(void)
 
     AllocateVkDescriptoSet();
     mUpdateDescriptorSets = true;
-    mUpdateDescriptorData = true;
 }
@@ -26,9 +26,10 @@
 
 #include "shader.h"
 #include "shaderResourceInterface.h"
-#include "utils/cacheManager.h"
-#include "genericVertexAttribute.h"
+#include "retireList.h"
+#include "vertexArrayObject.h"
 #include "vulkan/pipelineCache.h"
+#include "vulkan/vertexInputCache.h"
 #include "refObject.h"
 
 class Context;
@@ -42,22 +43,33 @@ private:
     VkDescriptorPool                                    mVkDescPool;
     VkDescriptorSet                                     mVkDescSet;
     VkPipelineLayout                                    mVkPipelineLayout;
+    VkDescriptorUpdateTemplateKHR                       mVkDescUpdateTemplate;
+
+    std::vector<uint8_t>                                mVkDescUpdateData;
+    std::vector<uint32_t>                               mVkDescUpdateDataOffsets;
+    std::vector<VkWriteDescriptorSet>                   mVkWriteDescSets;
 
     vulkanAPI::PipelineCache                           *mPipelineCache;
-    CacheManager                                       *mCacheManager;
+    RetireList                                         *mRetireList;
 
     VkPipelineVertexInputStateCreateInfo                mVkPipelineVertexInput;
-    VkVertexInputBindingDescription                     mVkVertexInputBinding[GLOVE_MAX_VERTEX_ATTRIBS];
-    VkVertexInputAttributeDescription                   mVkVertexInputAttribute[GLOVE_MAX_VERTEX_ATTRIBS];
+    const vulkanAPI::vertexInputLayout_t               *mVertexInputLayout;
+    uint32_t                                            mVertexInputStamp;
+#ifdef VK_EXT_vertex_attribute_divisor
+    VkPipelineVertexInputDivisorStateCreateInfoEXT      mVkPipelineVertexInputDivisor;
+    VkVertexInputBindingDivisorDescriptionEXT           mVkVertexBindingDivisors[GLOVE_MAX_VERTEX_ATTRIBS];
+#endif
 
     uint32_t                                            mActiveVertexVkBuffersCount;
     VkBuffer                                            mActiveVertexVkBuffers[GLOVE_MAX_VERTEX_ATTRIBS];
+    VkDeviceSize                                        mActiveVertexVkBufferOffsets[GLOVE_MAX_VERTEX_ATTRIBS];
+    BufferObject                                       *mActiveVertexBufferObjects[GLOVE_MAX_VERTEX_ATTRIBS];
 
     BufferObject                                       *mExplicitIbo;
     VkBuffer                                            mActiveIndexVkBuffer;
 
     bool                                                mUpdateDescriptorSets;
-    bool                                                mUpdateDescriptorData;
+    bool                                                mUsePushDescriptors;
     bool                                                mLinked;
     bool                                                mIsPrecompiled;
     bool                                                mValidated;
@@ -83,6 +95,8 @@ private:
     bool                                                CreateDescriptorSetLayout(uint32_t nLiveUniformBlocks);
     bool                                                CreateDescriptorPool(uint32_t nLiveUniformBlocks);
     bool                                                CreateDescriptorSet(void);
+    void                                                CreateDescriptorUpdateData(uint32_t nLiveUniformBlocks);
+    bool                                                CreateDescriptorUpdateTemplate(uint32_t nLiveUniformBlocks);
     void                                                UpdateSamplerDescriptors(void);
 
     uint32_t                                            SerializeShadersSpirv(void *binary);
@@ -91,13 +105,14 @@ private:
     void                                                ResetVulkanVertexInput(void);
     void                                                UpdateAttributeInterface(void);
     void                                                BuildShaderResourceInterface(void);
-    bool                                                UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVertex, std::vector<GenericVertexAttribute>& genericVertAttribs, std::map<uint32_t, uint32_t>& vboLocationBindings, bool updatedVertexAttrib);
-    void                                                GenerateVertexInputProperties(std::vector<GenericVertexAttribute>& genericVertAttribs, const std::map<uint32_t, uint32_t>& vboLocationBindings);
+    bool                                                UpdateVertexAttribProperties(size_t vertCount, uint32_t firstVertex, uint32_t instanceCount, std::vector<GenericVertexAttribute>& genericVertAttribs, uint32_t *vboLocationBindings, uint32_t *bindingDivisors, BufferObject **bindingBufferObjects, bool *resolvable, bool updatedVertexAttrib);
+    bool                                                GenerateVertexInputProperties(std::vector<GenericVertexAttribute>& genericVertAttribs, const uint32_t *vboLocationBindings, const uint32_t *bindingDivisors);
+    bool                                                SetVertexInputLayout(const vulkanAPI::vertexInputLayout_t *vertexInputLayout);
 
     void                                                LineLoopConversion(void* data, uint32_t indexCount, size_t elementByteSize);
     bool                                                ConvertIndexBufferToUint16(const void* srcData, size_t elementCount, BufferObject** ibo);
     bool                                                AllocateExplicitIndexBuffer(const void* data, size_t size, BufferObject** ibo);
-    uint32_t                                            GetMaxIndex(BufferObject* ibo, uint32_t indexCount, size_t actualSize, VkDeviceSize offset);
+    uint32_t                                            GetMaxIndex(BufferObject* ibo, uint32_t indexCount, size_t actualSize, VkDeviceSize offset, GLenum type);
 
 public:
     ShaderProgram(const vulkanAPI::vkContext_t *vkContext = nullptr);
@@ -106,7 +121,8 @@ public:
     void                                                SetPipelineVertexInputStateInfo(void);
     bool                                                SetPipelineShaderStage(uint32_t &pipelineShaderStageCount, int *pipelineStagesIDs, VkPipelineShaderStageCreateInfo *pipelineShaderStages);
     void                                                PrepareIndexBufferObject(uint32_t* firstIndex, uint32_t* maxIndex, uint32_t indexCount, GLenum type, const void* indices, BufferObject* ibo);
-    bool                                                PrepareVertexAttribBufferObjects(size_t vertCount, uint32_t firstVertex, std::vector<GenericVertexAttribute>& genericVertAttribs, bool updatedVertexAttrib);
+    bool                                                PrepareMultiIndexBufferObject(uint32_t* firstIndices, uint32_t* maxIndex, const GLsizei* indexCounts, GLenum type, const void* const* indices, GLsizei drawCount, BufferObject* ibo);
+    bool                                                PrepareVertexAttribBufferObjects(size_t vertCount, uint32_t firstVertex, uint32_t instanceCount, VertexArrayObject *vao, bool updatedVertexAttrib);
     Shader                                             *IsShaderAttached(Shader *shader) const;
     void                                                AttachShader(Shader *shader);
     void                                                DetachShader(Shader *shader);
@@ -144,6 +160,8 @@ public:
     const VkDescriptorSet                              *GetVkDescSet(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return &mVkDescSet; }
     uint32_t                                            GetActiveVertexVkBuffersCount(void)         const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexVkBuffersCount; }
     const VkBuffer                                     *GetActiveVertexVkBuffers(void)              const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexVkBuffers; }
+    const VkDeviceSize                                 *GetActiveVertexVkBufferOffsets(void)        const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexVkBufferOffsets; }
+    BufferObject * const                               *GetActiveVertexBufferObjects(void)          const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexBufferObjects; }
     VkBuffer                                            GetActiveIndexVkBuffer(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveIndexVkBuffer; }
 
     void                                                SetVkContext(const vulkanAPI::vkContext_t *vkContext) { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; mPipelineCache->SetContext(mVkContext);}
@@ -154,8 +172,9 @@ public:
     void                                                SetUniformData(uint32_t location, size_t size, const void *ptr);
     void                                                GetUniformData(uint32_t location, size_t size, void *ptr) const;
     void                                                SetUniformSampler(uint32_t location, int count, const int *textureUnit);
-    void                                                SetCacheManager(CacheManager *cacheManager);
+    void                                                SetRetireList(RetireList *retireList);
     void                                                UpdateDescriptorSet(void);
+    void                                                BindDescriptorSet(VkCommandBuffer cmdBuffer) const;
     void                                                UpdateBuiltInUniformData(float minDepthRange, float maxDepthRange);
 
     uint32_t                                            GetNumberOfActiveAttributes(void) const;
@@ -170,6 +189,7 @@ public:
     bool                                                HasVertexShader(void)                       const   { FUN_ENTRY(GL_LOG_TRACE); return (bool)mShaders[0]; }
     bool                                                HasFragmentShader(void)                     const   { FUN_ENTRY(GL_LOG_TRACE); return (bool)mShaders[1]; }
     bool                                                HasStages(void)                             const   { FUN_ENTRY(GL_LOG_TRACE); return mStageCount; }
+    bool                                                HasUniformBlocks(void)                      const   { FUN_ENTRY(GL_LOG_TRACE); return mShaderResourceInterface.GetLiveUniformBlocks() > 0; }
     bool                                                HasStagesUpdated(int stageIDs[2])           const   { FUN_ENTRY(GL_LOG_TRACE); return (stageIDs[0] != GetStagesIDs(0) || stageIDs[1] != GetStagesIDs(1)) ? true : false; }
     bool                                                IsLinked(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mLinked; }
     bool                                                IsPrecompiled(void)                         const   { FUN_ENTRY(GL_LOG_TRACE); return mIsPrecompiled; }
@@ -30,11 +30,12 @@
 #include "utils/parser_helpers.h"
 #include "utils/glUtils.h"
 #include "utils/glLogger.h"
+#include "vulkan/queueTracker.h"
 #include <algorithm>
 
 ShaderResourceInterface::ShaderResourceInterface()
 : mLiveAttributes(0), mLiveUniforms(0), mLiveUniformBlocks(0),
-  mActiveAttributeMaxLength(0), mActiveUniformMaxLength(0), mReflectionSize(0), mCacheManager(nullptr)
+  mActiveAttributeMaxLength(0), mActiveUniformMaxLength(0), mReflectionSize(0), mRetireList(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -44,6 +45,7 @@ ShaderResourceInterface::~ShaderResourceInterface()
     FUN_ENTRY(GL_LOG_TRACE);
 
     Reset();
+    ReleaseUniformData(false);
 }
 
 void
@@ -57,9 +59,35 @@ ShaderResourceInterface::Reset(void)
 
     mAttributeInterface.clear();
     mUniformInterface.clear();
+    mUniformLocationInterface.clear();
     mUniformBlockInterface.clear();
 }
 
+void
+ShaderResourceInterface::ReleaseUniformData(bool cacheBufferObjects)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(auto &blockData : mUniformBlockDataInterface) {
+        if(blockData.pBufferObject) {
+            /// Buffers of a relinked program might still be referenced by in-flight command buffers
+            if(cacheBufferObjects && mRetireList) {
+                mRetireList->Retire(blockData.pBufferObject);
+            } else {
+                delete blockData.pBufferObject;
+            }
+            blockData.pBufferObject = nullptr;
+        }
+
+        if(blockData.pClientData) {
+            delete[] blockData.pClientData;
+            blockData.pClientData = nullptr;
+        }
+    }
+
+    mUniformBlockDataInterface.clear();
+}
+
 void
 ShaderResourceInterface::CreateInterface(void)
 {
@@ -104,14 +132,59 @@ ShaderResourceInterface::AllocateUniformClientData(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(auto& uni : mUniformInterface) {
-        size_t   size = uni.arraySize * GlslTypeToSize(uni.type);
-        uint8_t* data = new uint8_t[size];
-        memset(static_cast<void *>(data), 0, size);
+    ReleaseUniformData(true);
 
-        mUniformDataInterface.insert(make_pair(uni.name, uniformData()));
-        map<std::string, uniformData>::iterator it = mUniformDataInterface.find(uni.name);
-        it->second.pClientData = data;
+    /// Each block keeps a CPU shadow of its data. Non-opaque blocks follow the
+    /// layout of the uniform buffer, opaque ones store their texture units packed.
+    mUniformBlockDataInterface.resize(mUniformBlockInterface.size());
+    for(uint32_t i = 0; i < mUniformBlockInterface.size(); ++i) {
+        if(!mUniformBlockInterface[i].isOpaque) {
+            mUniformBlockDataInterface[i].clientDataSize = mUniformBlockInterface[i].memorySize;
+        }
+    }
+
+    uint32_t       nLocations = 0;
+    vector<size_t> uniformOffsets(mUniformInterface.size());
+    for(uint32_t i = 0; i < mUniformInterface.size(); ++i) {
+        const uniform &uni = mUniformInterface[i];
+        assert(uni.index < mUniformBlockInterface.size());
+
+        uniformBlockData &blockData = mUniformBlockDataInterface[uni.index];
+        if(mUniformBlockInterface[uni.index].isOpaque) {
+            uniformOffsets[i]         = blockData.clientDataSize;
+            blockData.clientDataSize += uni.arraySize * GlslTypeToSize(uni.type);
+        } else {
+            uniformOffsets[i]         = uni.offset;
+            blockData.clientDataSize  = std::max(blockData.clientDataSize, uni.offset + uni.arraySize * GlslTypeToAllignment(uni.type));
+        }
+
+        nLocations = std::max(nLocations, uni.location + uni.arraySize);
+    }
+
+    for(auto &blockData : mUniformBlockDataInterface) {
+        if(blockData.clientDataSize) {
+            blockData.pClientData = new uint8_t[blockData.clientDataSize];
+            memset(static_cast<void *>(blockData.pClientData), 0, blockData.clientDataSize);
+        }
+    }
+
+    /// Locations not used by any uniform are left empty
+    mUniformLocationInterface.clear();
+    mUniformLocationInterface.resize(nLocations);
+    for(uint32_t i = 0; i < mUniformInterface.size(); ++i) {
+        const uniform &uni = mUniformInterface[i];
+        const bool     isOpaque  = mUniformBlockInterface[uni.index].isOpaque;
+        const bool     isBuildIn = IsBuildInUniform(uni.name);
+
+        for(int32_t j = 0; j < uni.arraySize; ++j) {
+            uniformLocation &uniLoc = mUniformLocationInterface[uni.location + j];
+            uniLoc.pUniform    = &uni;
+            uniLoc.blockIndex  = uni.index;
+            uniLoc.elementSize = GlslTypeToSize(uni.type);
+            uniLoc.stride      = isOpaque ? uniLoc.elementSize : GlslTypeToAllignment(uni.type);
+            uniLoc.offset      = uniformOffsets[i] + j * uniLoc.stride;
+            uniLoc.isBuildIn   = isBuildIn;
+        }
     }
 }
 
@@ -120,14 +193,12 @@ ShaderResourceInterface::AllocateUniformBufferObjects(const vulkanAPI::vkContext
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    for(auto &uniBlock : mUniformBlockInterface) {
-        if(!uniBlock.isOpaque) {
+    for(uint32_t i = 0; i < mUniformBlockInterface.size(); ++i) {
+        if(!mUniformBlockInterface[i].isOpaque) {
+            uniformBlockData &blockData = mUniformBlockDataInterface[i];
 
-            mUniformBlockDataInterface.insert(make_pair(uniBlock.name, uniformBlockData()));
-            map<std::string, uniformBlockData>::iterator it = mUniformBlockDataInterface.find(uniBlock.name);
-
-            it->second.pBufferObject = new UniformBufferObject(vkContext);
-            it->second.pBufferObject->Allocate(uniBlock.memorySize, nullptr);
+            blockData.pBufferObject = new UniformBufferObject(vkContext);
+            blockData.pBufferObject->Allocate(mUniformBlockInterface[i].memorySize, blockData.pClientData);
         }
     }
 
@@ -139,22 +210,7 @@ ShaderResourceInterface::GetUniformBufferObject(uint32_t index) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    map<std::string, uniformBlockData>::const_iterator itBlock = mUniformBlockDataInterface.find(mUniformBlockInterface[index].name);
-    return itBlock->second.pBufferObject;
-}
-
-const ShaderResourceInterface::uniform *
-ShaderResourceInterface::GetUniformAtLocation(uint32_t loc) const
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    for(const auto &uniform : mUniformInterface) {
-        if(loc >= (uint32_t)uniform.location && loc < (uint32_t)(uniform.location + uniform.arraySize)) {
-            return &uniform;
-        }
-    }
-
-    return nullptr;
+    return mUniformBlockDataInterface[index].pBufferObject;
 }
 
 int
@@ -194,12 +250,24 @@ ShaderResourceInterface::GetUniformClientData(uint32_t location, size_t size, vo
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    const ShaderResourceInterface::uniform *uniform = GetUniformAtLocation(location);
+    assert(location < mUniformLocationInterface.size() && mUniformLocationInterface[location].pUniform);
 
-    size_t arrayOffset = (location - uniform->location) * GlslTypeToSize(uniform->type);
+    const uniformLocation &uniLoc = mUniformLocationInterface[location];
+    const uint8_t         *src    = mUniformBlockDataInterface[uniLoc.blockIndex].pClientData + uniLoc.offset;
+    uint8_t               *dst    = static_cast<uint8_t *>(ptr);
 
-    map<std::string, uniformData>::const_iterator it = mUniformDataInterface.find(uniform->name);
-    memcpy(ptr, static_cast<const void *>(it->second.pClientData + arrayOffset), size);
+    if(uniLoc.stride == uniLoc.elementSize) {
+        memcpy(static_cast<void *>(dst), static_cast<const void *>(src), size);
+        return;
+    }
+
+    while(size) {
+        size_t copySize = std::min(size, uniLoc.elementSize);
+        memcpy(static_cast<void *>(dst), static_cast<const void *>(src), copySize);
+        src  += uniLoc.stride;
+        dst  += copySize;
+        size -= copySize;
+    }
 }
 
 const uint8_t*
@@ -207,8 +275,8 @@ ShaderResourceInterface::GetUniformClientData(uint32_t index) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    map<std::string, uniformData>::const_iterator it = mUniformDataInterface.find(mUniformInterface[index].name);
-    return it->second.pClientData;
+    const uniformLocation &uniLoc = mUniformLocationInterface[mUniformInterface[index].location];
+    return mUniformBlockDataInterface[uniLoc.blockIndex].pClientData + uniLoc.offset;
 }
 
 int
@@ -258,20 +326,49 @@ ShaderResourceInterface::SetUniformClientData(uint32_t location, size_t size, co
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    ShaderResourceInterface::uniform *uniform = nullptr;
-    for(auto &uni: mUniformInterface) {
-        if(location >= (uint32_t)uni.location && location < (uint32_t)(uni.location + uni.arraySize)) {
-            uniform = &uni;
-            break;
+    assert(location < mUniformLocationInterface.size() && mUniformLocationInterface[location].pUniform);
+
+    const uniformLocation &uniLoc    = mUniformLocationInterface[location];
+    uniformBlockData      &blockData = mUniformBlockDataInterface[uniLoc.blockIndex];
+    uint8_t               *dst       = blockData.pClientData + uniLoc.offset;
+    const uint8_t         *src       = static_cast<const uint8_t *>(ptr);
+    size_t                 dirtyEnd  = 0;
+
+    /// Array elements of types smaller than their alignment are scattered in the shadow.
+    /// Elements that are written with the value they already hold do not dirty the block.
+    if(uniLoc.stride == uniLoc.elementSize) {
+        if(memcmp(static_cast<const void *>(dst), static_cast<const void *>(src), size)) {
+            memcpy(static_cast<void *>(dst), static_cast<const void *>(src), size);
+            dirtyEnd = uniLoc.offset + size;
+        }
+    } else {
+        while(size) {
+            size_t copySize = std::min(size, uniLoc.elementSize);
+            if(memcmp(static_cast<const void *>(dst), static_cast<const void *>(src), copySize)) {
+                memcpy(static_cast<void *>(dst), static_cast<const void *>(src), copySize);
+                dirtyEnd = static_cast<size_t>(dst - blockData.pClientData) + copySize;
+            }
+            dst  += uniLoc.stride;
+            src  += copySize;
+            size -= copySize;
         }
     }
 
-    size_t arrayOffset = (location - uniform->location) * GlslTypeToSize(uniform->type);
+    if(!dirtyEnd) {
+        return;
+    }
 
-    map<std::string, uniformData>::iterator it = mUniformDataInterface.find(uniform->name);
-    memcpy(static_cast<void *>(it->second.pClientData + arrayOffset), ptr, size);
+    if(blockData.dirtyBegin == blockData.dirtyEnd) {
+        blockData.dirtyBegin = uniLoc.offset;
+        blockData.dirtyEnd   = dirtyEnd;
+    } else {
+        blockData.dirtyBegin = std::min(blockData.dirtyBegin, uniLoc.offset);
+        blockData.dirtyEnd   = std::max(blockData.dirtyEnd, dirtyEnd);
+    }
 
-    it->second.clientDataDirty = true;
+    if(!uniLoc.isBuildIn) {
+        blockData.clientDataDirty = true;
+    }
 }
 
 void
@@ -281,16 +378,14 @@ ShaderResourceInterface::SetUniformSampler(uint32_t location, int count, const i
 
     while(count--) {
 
-        const ShaderResourceInterface::uniform *uniformSampler = GetUniformAtLocation(location);
-        map<std::string, uniformData>::iterator it = mUniformDataInterface.find(uniformSampler->name);
-
-        size_t arrayOffset = (location - uniformSampler->location) * GlslTypeToSize(uniformSampler->type);
+        const uniformLocation &uniLoc  = mUniformLocationInterface[location];
+        glsl_sampler_t        *sampler = reinterpret_cast<glsl_sampler_t *>(mUniformBlockDataInterface[uniLoc.blockIndex].pClientData + uniLoc.offset);
 
         /// Make sure textureUnit is inside [0, GLOVE_MAX_COMBINED_TEXTURE_IMAGE_UNITS)
         if(*textureUnit >= GL_TEXTURE0 && *textureUnit < GL_TEXTURE0 + GLOVE_MAX_COMBINED_TEXTURE_IMAGE_UNITS) {
-            *((glsl_sampler_t *)(it->second.pClientData + arrayOffset)) = (glsl_sampler_t)(*textureUnit - GL_TEXTURE0);
+            *sampler = (glsl_sampler_t)(*textureUnit - GL_TEXTURE0);
         } else {
-            *((glsl_sampler_t *)(it->second.pClientData + arrayOffset)) = (glsl_sampler_t)(*textureUnit);
+            *sampler = (glsl_sampler_t)(*textureUnit);
         }
 
         ++textureUnit;
@@ -348,85 +443,43 @@ ShaderResourceInterface::UpdateAttributeInterface(void)
 }
 
 bool
-ShaderResourceInterface::UpdateUniformBufferData(const vulkanAPI::vkContext_t *vkContext, bool *allocatedNewBufferObject)
+ShaderResourceInterface::UpdateUniformBufferData(const vulkanAPI::vkContext_t *vkContext, bool *allocatedNewBufferObject, size_t *bytesCopied)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    uint32_t blockIndex=0;
-    bool     blockDataDirty;
-
-    struct uniformDirty {
-        size_t       offset;
-        size_t       size;
-        const void * data;
-    };
-
-    for(auto &uniBlock : mUniformBlockInterface) {
-
-        map<std::string, uniformBlockData>::iterator itBlock = mUniformBlockDataInterface.find(uniBlock.name);
+    for(uint32_t i = 0; i < mUniformBlockInterface.size(); ++i) {
+        const uniformBlock &uniBlock  = mUniformBlockInterface[i];
+        uniformBlockData   &blockData = mUniformBlockDataInterface[i];
 
-        blockDataDirty = false;
-        std::vector<struct uniformDirty> uniformInterfaceDirty;
-        for(auto &uniform : mUniformInterface) {
-
-            // if does not belong to Block
-            if(uniform.index != blockIndex) {
-                continue;
-            }
-
-            map<std::string, uniformData>::iterator itUniform = mUniformDataInterface.find(uniform.name);
-
-            // check if is updated
-            if(!itUniform->second.clientDataDirty) {
-               continue;
-            }
-            itUniform->second.clientDataDirty = false;
-
-            blockDataDirty = true;
-            if(IsBuildInUniform(uniform.name)) {
-                blockDataDirty = false;
-            }
-
-            // compute uniform size
-            for (size_t i = 0; i < (size_t)uniform.arraySize; i++) {
-                struct uniformDirty newUniformDirty;
-                newUniformDirty.size   = GlslTypeToSize(uniform.type);
-                newUniformDirty.offset = uniform.offset + i*GlslTypeToAllignment(uniform.type);
-                newUniformDirty.data   = static_cast<const void *>(itUniform->second.pClientData + i*newUniformDirty.size);
-                uniformInterfaceDirty.push_back(newUniformDirty);
-            }
+        /// Texture units of opaque blocks are consumed by the descriptor updates
+        if(uniBlock.isOpaque) {
+            continue;
         }
 
-        if(blockDataDirty) {
+        size_t dirtyEnd = std::min(blockData.dirtyEnd, uniBlock.memorySize);
+        if(blockData.dirtyBegin < dirtyEnd) {
+            /// A buffer whose last use has not completed might still be read by pending commands
+            /// of any context drawing with the program, so it is replaced instead of being overwritten.
+            /// Build-in uniforms are always updated in place.
+            if(blockData.clientDataDirty && blockData.pBufferObject->IsInUse()) {
+                mRetireList->Retire(blockData.pBufferObject);
 
-            size_t   srcSize = 0;
-            uint8_t *srcData = nullptr;
-
-            if(itBlock->second.pBufferObject && itBlock->second.pBufferObject->GetSize() > 0) {
-                mCacheManager->CacheUBO(itBlock->second.pBufferObject);
-
-                // memcopy data
-                srcSize = itBlock->second.pBufferObject->GetSize();
-                srcData = new uint8_t[srcSize];
-                itBlock->second.pBufferObject->GetData(srcSize, 0, srcData);
+                blockData.pBufferObject = new UniformBufferObject(vkContext);
+                blockData.pBufferObject->Allocate(uniBlock.memorySize, blockData.pClientData);
+                *bytesCopied += uniBlock.memorySize;
 
                 *allocatedNewBufferObject = true;
+            } else {
+                blockData.pBufferObject->UpdateData(dirtyEnd - blockData.dirtyBegin, blockData.dirtyBegin, blockData.pClientData + blockData.dirtyBegin);
+                *bytesCopied += dirtyEnd - blockData.dirtyBegin;
             }
-
-            itBlock->second.pBufferObject = new UniformBufferObject(vkContext);
-            itBlock->second.pBufferObject->Allocate(uniBlock.memorySize, srcData);
-
-            if(srcSize) {
-                delete[] srcData;
-            }
-        }
-
-        for (auto &u : uniformInterfaceDirty) {
-            itBlock->second.pBufferObject->UpdateData(u.size, u.offset, u.data);
         }
 
-        ++blockIndex;
+        blockData.dirtyBegin         = 0;
+        blockData.dirtyEnd           = 0;
+        blockData.clientDataDirty    = false;
+        blockData.pBufferObject->SetUsed(vkContext->vkQueueTracker->GetEpoch());
     }
 
     return true;
-}
\ No newline at end of file
+}
@@ -26,7 +26,7 @@
 
 #include "shaderReflection.h"
 #include "bufferObject.h"
-#include "utils/cacheManager.h"
+#include "retireList.h"
 #include <vector>
 
 class ShaderResourceInterface {
@@ -69,29 +69,27 @@ public:
     typedef struct uniform uniform;
     typedef vector<uniform>                 uniformInterface;
 
-    struct uniformData {
-        uint8_t                    *pClientData;
-        bool                        clientDataDirty;
-
-        uniformData()
-         : pClientData(nullptr),
-           clientDataDirty(false)
-        {
-            FUN_ENTRY(GL_LOG_TRACE);
-        }
-
-        ~uniformData()
+    struct uniformLocation {
+        const uniform              *pUniform;
+        uint32_t                    blockIndex;
+        size_t                      offset;
+        size_t                      stride;
+        size_t                      elementSize;
+        bool                        isBuildIn;
+
+        uniformLocation()
+         : pUniform(nullptr),
+           blockIndex(0),
+           offset(0),
+           stride(0),
+           elementSize(0),
+           isBuildIn(false)
         {
             FUN_ENTRY(GL_LOG_TRACE);
-
-            if(pClientData) {
-                delete[] pClientData;
-                pClientData = nullptr;
-            }
         }
     };
-    typedef struct uniformData              uniformData;
-    typedef map<string, uniformData>        uniformDataInterface;
+    typedef struct uniformLocation          uniformLocation;
+    typedef vector<uniformLocation>         uniformLocationInterface;
 
     struct uniformBlock {
         string                      name;
@@ -115,25 +113,25 @@ public:
 
     struct uniformBlockData {
         UniformBufferObject *       pBufferObject;
+        uint8_t                    *pClientData;
+        size_t                      clientDataSize;
+        size_t                      dirtyBegin;
+        size_t                      dirtyEnd;
+        bool                        clientDataDirty;
 
         uniformBlockData()
-         : pBufferObject(nullptr)
-        {
-            FUN_ENTRY(GL_LOG_TRACE);
-        }
-
-        ~uniformBlockData()
+         : pBufferObject(nullptr),
+           pClientData(nullptr),
+           clientDataSize(0),
+           dirtyBegin(0),
+           dirtyEnd(0),
+           clientDataDirty(false)
         {
             FUN_ENTRY(GL_LOG_TRACE);
-
-            if(pBufferObject) {
-                delete pBufferObject;
-                pBufferObject = nullptr;
-            }
         }
     };
     typedef struct uniformBlockData         uniformBlockData;
-    typedef map<string, uniformBlockData>   uniformBlockDataInterface;
+    typedef vector<uniformBlockData>        uniformBlockDataInterface;
 
     typedef map<string, uint32_t>           attribsLayout_t;
 
@@ -151,15 +149,16 @@ private:
     attributeInterface                      mAttributeInterface;
 
     uniformInterface                        mUniformInterface;
-    uniformDataInterface                    mUniformDataInterface;
+    uniformLocationInterface                mUniformLocationInterface;
 
     uniformBlockInterface                   mUniformBlockInterface;
     uniformBlockDataInterface               mUniformBlockDataInterface;
 
     attribsLayout_t                         mCustomAttributesLayout;
-    CacheManager*                           mCacheManager;
+    RetireList*                             mRetireList;
 
     void                                    Reset(void);
+    void                                    ReleaseUniformData(bool cacheBufferObjects);
 
 public:
     ShaderResourceInterface();
@@ -198,13 +197,13 @@ public:
     inline shader_type_t                    GetUniformBlockStage(uint32_t index)   const { FUN_ENTRY(GL_LOG_TRACE); return mUniformBlockInterface[index].stage; }
     inline bool                             IsUniformBlockOpaque(uint32_t index)   const { FUN_ENTRY(GL_LOG_TRACE); return mUniformBlockInterface[index].isOpaque; }
 
-    const uniform                          *GetUniformAtLocation(uint32_t loc)     const;
+    const uniform                          *GetUniformAtLocation(uint32_t loc)     const { FUN_ENTRY(GL_LOG_TRACE); return loc < mUniformLocationInterface.size() ? mUniformLocationInterface[loc].pUniform : nullptr; }
     const uniform                          *GetUniform(uint32_t index)             const { FUN_ENTRY(GL_LOG_TRACE); return index < mUniformInterface.size() ? mUniformInterface.data() + index : nullptr; }
 
     const attribute                        *GetVertexAttribute(int index)          const { FUN_ENTRY(GL_LOG_TRACE); return &(*(mAttributeInterface.cbegin() + index)); }
 
 /// Set Functions
-    inline void                             SetCacheManager(CacheManager *cacheManager)          { FUN_ENTRY(GL_LOG_TRACE); mCacheManager     = cacheManager; }
+    inline void                             SetRetireList(RetireList *retireList)                { FUN_ENTRY(GL_LOG_TRACE); mRetireList       = retireList; }
     inline void                             SetReflection(ShaderReflection* reflection)          { FUN_ENTRY(GL_LOG_TRACE); mShaderReflection = reflection; };
     inline void                             SetReflectionSize(void)                              { FUN_ENTRY(GL_LOG_TRACE); mReflectionSize   = mShaderReflection->GetReflectionSize(); }
     inline void                             SetCustomAttribsLayout(const char *name, int index)  { FUN_ENTRY(GL_LOG_TRACE); mCustomAttributesLayout[std::string(name)] = index; }    
@@ -225,7 +224,8 @@ public:
 
 /// Update Functions    
     bool                                    UpdateUniformBufferData(const vulkanAPI::vkContext_t *vkContext,
-                                                                    bool *allocatedNewBufferObject);
+                                                                    bool *allocatedNewBufferObject,
+                                                                    size_t *bytesCopied);
     void                                    UpdateAttributeInterface(void);
 
 
@@ -0,0 +1,60 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       shareGroup.cpp
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Objects shared among the contexts of an EGL share group
+ *
+ *  @section
+ *
+ *  A deleted object may still be referenced by command buffers that another
+ *  context of the share group has already submitted. Instead of finishing all
+ *  contexts, the object is stamped with the epoch of the queue tracker once it
+ *  is no longer bound anywhere, and it is deleted after that epoch completes.
+ */
+
+#include "shareGroup.h"
+#include "glslang/glslangShaderCompiler.h"
+
+ShareGroup::ShareGroup(const vulkanAPI::vkContext_t *vkContext):
+    mVkContext(vkContext),
+    mContextCount(1),
+    mShadingObjectCount(1),
+    mRetireList(vkContext)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    mShaderCompiler = new GlslangShaderCompiler();
+}
+
+ShareGroup::~ShareGroup()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // the names of these objects are already released, so they are not owned by the object arrays
+    for(auto &entry : mPurgeListBufferObject) {
+        delete entry.object;
+    }
+    for(auto &entry : mPurgeListTexture) {
+        delete entry.object;
+    }
+    for(auto &entry : mPurgeListRenderbuffers) {
+        delete entry.object;
+    }
+
+    delete mShaderCompiler;
+}
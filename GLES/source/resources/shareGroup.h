@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       shareGroup.h
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Objects shared among the contexts of an EGL share group
+ *
+ */
+
+#ifndef __SHAREGROUP_H__
+#define __SHAREGROUP_H__
+
+#include <atomic>
+#include <mutex>
+#include "resources/bufferObject.h"
+#include "resources/shaderProgram.h"
+#include "resources/renderbuffer.h"
+#include "resources/shader.h"
+#include "resources/texture.h"
+#include "resources/shaderCompiler.h"
+#include "resources/retireList.h"
+
+typedef enum {
+    NO_ID,
+    SHADER_ID,
+    SHADER_PROGRAM_ID
+} shadingNamespaceType_t;
+
+typedef struct {
+    shadingNamespaceType_t                 type;
+    uint32_t                               arrayIndex;
+} ShadingNamespace_t;
+
+/// An object deleted by the application, waiting for its last reference
+template <class OBJECT>
+struct purgeEntry_t {
+    OBJECT                                *object;
+    uint64_t                               releaseEpoch;  /**< The queue epoch that has to complete before the deletion, 0 if not yet known */
+};
+
+/**
+ * @brief Buffers, renderbuffers, textures, shaders and programs, together
+ * with their names, are owned by the share group rather than by a context.
+ *
+ * Every context creates or joins a share group through its ResourceManager,
+ * which is the only user of the share group data and serializes all accesses
+ * with the share group mutex. The share group is destroyed along with its
+ * last context.
+ */
+class ShareGroup {
+private:
+    friend class ResourceManager;
+
+    typedef ObjectArray<Texture>               TextureArray;
+    typedef ObjectArray<BufferObject>          BufferArray;
+    typedef ObjectArray<Shader>                ShaderArray;
+    typedef ObjectArray<ShaderProgram>         ShaderProgramArray;
+    typedef ObjectArray<Renderbuffer>          RenderbufferArray;
+    typedef map<uint32_t, ShadingNamespace_t>  shadingPoolIDs_t;
+
+    const vulkanAPI::vkContext_t              *mVkContext;
+    std::atomic<uint32_t>                      mContextCount;
+    std::recursive_mutex                       mMutex;
+
+    BufferArray                                mBuffers;
+    RenderbufferArray                          mRenderbuffers;
+    TextureArray                               mTextures;
+
+    uint32_t                                   mShadingObjectCount;
+    shadingPoolIDs_t                           mShadingObjectPool;
+    ShaderArray                                mShaders;
+    ShaderProgramArray                         mShaderPrograms;
+    ShaderCompiler                            *mShaderCompiler;
+
+    std::vector<purgeEntry_t<BufferObject>>    mPurgeListBufferObject;
+    std::vector<purgeEntry_t<Texture>>         mPurgeListTexture;
+    std::vector<purgeEntry_t<Shader>>          mPurgeListShaders;
+    std::vector<purgeEntry_t<ShaderProgram>>   mPurgeListShaderPrograms;
+    std::vector<purgeEntry_t<Renderbuffer>>    mPurgeListRenderbuffers;
+
+    RetireList                                 mRetireList;
+
+public:
+    ShareGroup(const vulkanAPI::vkContext_t *vkContext);
+    ~ShareGroup();
+
+    inline void                                Acquire(void)                    { FUN_ENTRY(GL_LOG_TRACE); ++mContextCount; }
+    inline bool                                Release(void)                    { FUN_ENTRY(GL_LOG_TRACE); return --mContextCount == 0; }
+    inline bool                                IsShared(void)             const { FUN_ENTRY(GL_LOG_TRACE); return mContextCount > 1; }
+};
+
+#endif //__SHAREGROUP_H__
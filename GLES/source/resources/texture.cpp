@@ -30,6 +30,7 @@
 #include "texture.h"
 #include "utils/VkToGlConverter.h"
 #include "utils/glUtils.h"
+#include "utils/etc1Decoder.h"
 #include "context/context.h"
 
 #define NUMBER_OF_MIP_LEVELS(w, h)                      (std::floor(std::log2(std::max((w),(h)))) + 1)
@@ -42,7 +43,8 @@ Texture::Texture(const vulkanAPI::vkContext_t *vkContext, const VkFlags vkFlags)
 mFormat(GL_INVALID_VALUE), mTarget(GL_INVALID_VALUE), mType(GL_INVALID_VALUE), mInternalFormat(GL_INVALID_VALUE),
 mExplicitType(GL_INVALID_VALUE), mExplicitInternalFormat(GL_INVALID_VALUE),
 mMipLevelsCount(1), mLayersCount(1), mState(nullptr), mDataUpdated(false), mDataNoInvertion(false), mFboColorAttached(false),
-mDepthStencilTexture(nullptr), mDepthStencilTextureRefCount(0u)
+mImmutable(false), mAllocationPending(false),
+mDepthStencilTexture(nullptr), mDepthStencilTextureRefCount(0u), mRenderTargetTexture(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
@@ -60,6 +62,7 @@ Texture::~Texture()
     delete mImageView;
     delete mImage;
     delete mMemory;
+    delete mRenderTargetTexture;
 
     if(mState != nullptr) {
         delete [] mState;
@@ -107,6 +110,11 @@ Texture::IsCompleted(void)
         return false;
     }
 
+    // immutable textures have all their levels specified at once
+    if(mImmutable) {
+        return true;
+    }
+
     State_t *state = &mState[0][0];
     if(state->format == GL_INVALID_VALUE || state->width <= 0 || state->height <= 0) {
         return false;
@@ -209,7 +217,32 @@ Texture::CreateVkTexture(void)
 }
 
 bool
-Texture::Allocate(void)
+Texture::AllocateRenderTargetTexture(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mRenderTargetTexture == nullptr) {
+        mRenderTargetTexture = new Texture(mVkContext);
+        mRenderTargetTexture->SetTarget(GL_TEXTURE_2D);
+        mRenderTargetTexture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
+        mRenderTargetTexture->SetVkImageTarget(vulkanAPI::Image::VK_IMAGE_TARGET_2D);
+        mRenderTargetTexture->InitState();
+    }
+
+    mRenderTargetTexture->SetVkFormat(mImage->GetFormat());
+    mRenderTargetTexture->SetVkImageLayout(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+    mRenderTargetTexture->SetVkImageTiling();
+    mRenderTargetTexture->SetState(GetWidth(), GetHeight(), 0, 0, GlInternalFormatToGlFormat(mExplicitInternalFormat),
+                                   mExplicitType, Texture::GetDefaultInternalAlignment(), nullptr);
+
+    // framebuffers using the previous attachment have to be recreated
+    SetDataUpdated(true);
+
+    return mRenderTargetTexture->Allocate();
+}
+
+void
+Texture::ApplyState(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -223,11 +256,49 @@ Texture::Allocate(void)
 
     mExplicitInternalFormat = VkFormatToGlInternalformat(mImage->GetFormat());
     mExplicitType           = GlInternalFormatToGlType(mExplicitInternalFormat);
+}
+
+void
+Texture::DeferAllocation(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // dimensions and formats are visible right away, the image is created on first use
+    ApplyState();
+    mAllocationPending = true;
+}
+
+bool
+Texture::FlushAllocation(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!mAllocationPending) {
+        return true;
+    }
+
+    // framebuffers using the previous image have to be recreated
+    SetDataUpdated(true);
+
+    return Allocate();
+}
+
+bool
+Texture::Allocate(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    mAllocationPending = false;
+    ApplyState();
 
     if(!CreateVkTexture()) {
         return false;
     }
 
+    if(IsDepthTexture()) {
+        return AllocateRenderTargetTexture();
+    }
+
     // NOTE:: there is an implicit conversion of all textures to GL_RGBA
     // TODO:: this should definitely NOT be the case
     GLenum srcInternalFormat = mInternalFormat;
@@ -235,8 +306,10 @@ Texture::Allocate(void)
     GLenum dstType = mExplicitType;
     for(GLint layer = 0; layer < mLayersCount; ++layer) {
         for(GLint level = 0; level < mMipLevelsCount; ++level) {
-            state = &mState[layer][level];
-            if(state->data) {
+            State_t *state = &mState[layer][level];
+            if(state->data && mFormat == GL_ETC1_RGB8_OES) {
+                CopyEtc1PixelsFromHost(level, layer, state);
+            } else if(state->data) {
                 ImageRect srcRect(0, 0, state->width, state->height,
                                   GlInternalFormatTypeToNumElements(srcInternalFormat, state->type),
                                   GlTypeToElementSize(state->type),
@@ -290,6 +363,28 @@ Texture::SetState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenu
     }
 }
 
+void
+Texture::SetCompressedState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum format, GLsizei imageSize, const void *data)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    mState[layer][level].width  = width;
+    mState[layer][level].height = height;
+    mState[layer][level].format = format;
+    mState[layer][level].type   = GL_UNSIGNED_BYTE;
+
+    if(mState[layer][level].data) {
+        delete [] (uint8_t *)mState[layer][level].data;
+        mState[layer][level].data = nullptr;
+    }
+
+    // the blocks are kept compressed until the image is allocated
+    if(data) {
+        mState[layer][level].data = new uint8_t[imageSize];
+        memcpy(mState[layer][level].data, data, imageSize);
+    }
+}
+
 void
 Texture::SetSubState(ImageRect *srcRect, ImageRect *dstRect, GLint level, GLint layer, GLenum srcFormat, const void *srcData)
 {
@@ -347,6 +442,8 @@ void Texture::CopyPixelsToHost(ImageRect *srcRect, ImageRect *dstRect, GLint mip
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    FlushAllocation();
+
     const GLenum srcFormat = mExplicitInternalFormat;
 
     // create a buffer at the size of the requested subrectangle
@@ -427,6 +524,57 @@ void Texture::CopyPixelsFromHost(ImageRect *srcRect, ImageRect *dstRect, GLint m
  #endif
 }
 
+void
+Texture::UpdateSubImage(ImageRect *srcRect, GLint xoffset, GLint yoffset, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    ImageRect dstRect(xoffset, yoffset, srcRect->width, srcRect->height,
+                      GlInternalFormatTypeToNumElements(mExplicitInternalFormat, mExplicitType),
+                      GlTypeToElementSize(mExplicitType),
+                      Texture::GetDefaultInternalAlignment());
+
+    if(!mFboColorAttached) {
+        CopyPixelsFromHost(srcRect, &dstRect, miplevel, layer, srcFormat, srcData);
+        return;
+    }
+    mFboColorAttached = false;
+
+    // rendered images are stored upside down
+    const size_t srcSize = srcRect->GetRectBufferSize();
+    uint8_t *srcInverted = new uint8_t[srcSize];
+    memcpy(srcInverted, srcData, srcSize);
+    InvertImageYAxis(srcInverted, srcRect);
+
+    dstRect.y = GetInvertedYOrigin(&dstRect);
+    CopyPixelsFromHost(srcRect, &dstRect, miplevel, layer, srcFormat, srcInverted);
+
+    delete[] srcInverted;
+}
+
+void Texture::CopyEtc1PixelsFromHost(GLint miplevel, GLint layer, const State_t *state)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Rect rect(0, 0, state->width, state->height);
+
+    if(mExplicitInternalFormat == GL_ETC1_RGB8_OES) {
+        // ETC2 images accept ETC1 blocks as they are
+        BufferObject *tbo = new TransferSrcBufferObject(mVkContext);
+        tbo->Allocate(Etc1ImageSize(state->width, state->height), state->data);
+        SubmitCopyPixels(&rect, tbo, miplevel, layer, GL_ETC1_RGB8_OES, true);
+        delete tbo;
+        return;
+    }
+
+    // otherwise the blocks are decoded once to RGBA8
+    ImageRect dstRect(rect, 4, 1, Texture::GetDefaultInternalAlignment());
+    uint8_t *decoded = new uint8_t[dstRect.GetRectBufferSize()];
+    Etc1DecodeImage(state->data, state->width, state->height, decoded, dstRect.GetRectAlignedRowInBytes());
+    CopyPixelsFromHost(&dstRect, &dstRect, miplevel, layer, GL_RGBA8_OES, decoded);
+    delete[] decoded;
+}
+
 void Texture::SubmitCopyPixels(const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, GLenum srcFormat, bool copyToImage)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
@@ -475,6 +623,62 @@ Texture::PrepareVkImageLayout(VkImageLayout newImageLayout)
     commandBufferManager->WaitVkAuxCommandBuffer();
 }
 
+void
+Texture::CopyImageInvertedY(vulkanAPI::Image *srcImage)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    VkImageLayout srcImageLayout = srcImage->GetImageLayout();
+
+    assert(GetCurrentContext());
+    vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
+    commandBufferManager->BeginVkAuxCommandBuffer();
+    VkCommandBuffer activeCmdBuffer = commandBufferManager->GetAuxCommandBuffer();
+    {
+        srcImage->ModifyImageLayout(&activeCmdBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        mImage->ModifyImageSubresourceRange(0, mMipLevelsCount, 0, mLayersCount);
+        mImage->ModifyImageLayout(&activeCmdBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        // rendered rows are stored upside down, as for the color attachments
+        mImage->CopyImageInvertedY(&activeCmdBuffer, srcImage->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        mImage->ModifyImageLayout(&activeCmdBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        srcImage->ModifyImageLayout(&activeCmdBuffer, srcImageLayout);
+    }
+    commandBufferManager->EndVkAuxCommandBuffer();
+    commandBufferManager->SubmitVkAuxCommandBuffer();
+    commandBufferManager->WaitVkAuxCommandBuffer();
+}
+
+void
+Texture::UpdateFromRenderTargetTexture(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    CopyImageInvertedY(mRenderTargetTexture->GetImage());
+}
+
+bool
+Texture::UpdateFromSurfaceTexture(Texture *surfaceTexture)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // eglBindTexImage redefines level 0 with the size and format of the pbuffer,
+    // whose color buffer is then copied image to image, without going through the host
+    GLenum glformat = surfaceTexture->GetExplicitInternalFormat();
+    SetState(surfaceTexture->GetWidth(), surfaceTexture->GetHeight(), 0, 0,
+             GlInternalFormatToGlFormat(glformat), GlInternalFormatToGlType(glformat),
+             Texture::GetDefaultInternalAlignment(), nullptr);
+    SetVkFormat(surfaceTexture->GetVkFormat());
+    SetDataUpdated(true);
+
+    if(!Allocate()) {
+        return false;
+    }
+
+    CopyImageInvertedY(surfaceTexture->GetImage());
+
+    return true;
+}
+
 void
 Texture::InvertPixels()
 {
@@ -503,29 +707,34 @@ Texture::GenerateMipmaps(GLenum hintMipmapMode)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    int numElements = GlInternalFormatTypeToNumElements(GetExplicitInternalFormat(), GetExplicitType());
-    int sizeElement = GlTypeToElementSize(GetExplicitType());
-    int alignment   = Texture::GetDefaultInternalAlignment();
-    ImageRect srcRect(0, 0, GetWidth(), GetHeight(), numElements, sizeElement, alignment);
-    ImageRect dstRect(0, 0, GetWidth(), GetHeight(), numElements, sizeElement, alignment);
-
-    const size_t     baseLevel  = 0;
-    const size_t     baseSize   = dstRect.GetRectBufferSize();
-    std::vector<uint8_t*> basePixels(mLayersCount);
-    for(GLint layer = 0; layer < mLayersCount; ++layer) {
-        basePixels[layer] = new uint8_t[baseSize];
-        CopyPixelsToHost(&srcRect, &dstRect, baseLevel, layer, GetExplicitInternalFormat(), basePixels[layer]);
-    }
+    FlushAllocation();
+
+    // immutable textures already own all of their levels
+    if(!mImmutable) {
+        int numElements = GlInternalFormatTypeToNumElements(GetExplicitInternalFormat(), GetExplicitType());
+        int sizeElement = GlTypeToElementSize(GetExplicitType());
+        int alignment   = Texture::GetDefaultInternalAlignment();
+        ImageRect srcRect(0, 0, GetWidth(), GetHeight(), numElements, sizeElement, alignment);
+        ImageRect dstRect(0, 0, GetWidth(), GetHeight(), numElements, sizeElement, alignment);
+
+        const size_t     baseLevel  = 0;
+        const size_t     baseSize   = dstRect.GetRectBufferSize();
+        std::vector<uint8_t*> basePixels(mLayersCount);
+        for(GLint layer = 0; layer < mLayersCount; ++layer) {
+            basePixels[layer] = new uint8_t[baseSize];
+            CopyPixelsToHost(&srcRect, &dstRect, baseLevel, layer, GetExplicitInternalFormat(), basePixels[layer]);
+        }
 
-    // create Mipmapped Texture
-    mMipLevelsCount = NUMBER_OF_MIP_LEVELS(GetWidth(), GetHeight());
-    CreateVkTexture();
+        // create Mipmapped Texture
+        mMipLevelsCount = NUMBER_OF_MIP_LEVELS(GetWidth(), GetHeight());
+        CreateVkTexture();
 
-    // set back base mipLevel for all layers
-    for(GLint layer = 0; layer < mLayersCount; ++layer) {
-        InvertImageYAxis(static_cast<uint8_t *>(basePixels[layer]), &srcRect);
-        CopyPixelsFromHost(&srcRect, &dstRect, baseLevel, layer, GetExplicitInternalFormat(), basePixels[layer]);
-        delete[] basePixels[layer];
+        // set back base mipLevel for all layers
+        for(GLint layer = 0; layer < mLayersCount; ++layer) {
+            InvertImageYAxis(static_cast<uint8_t *>(basePixels[layer]), &srcRect);
+            CopyPixelsFromHost(&srcRect, &dstRect, baseLevel, layer, GetExplicitInternalFormat(), basePixels[layer]);
+            delete[] basePixels[layer];
+        }
     }
 
     // Blit LoD Level '0' to rest layers
@@ -71,10 +71,15 @@ private:
     bool                        mDataUpdated;
     bool                        mDataNoInvertion;
     bool                        mFboColorAttached;
+    bool                        mImmutable;
+    bool                        mAllocationPending;
 
     Texture                    *mDepthStencilTexture;
     uint32_t                    mDepthStencilTextureRefCount;
 
+    // Depth textures are rendered into this attachment and copied back when sampled
+    Texture                    *mRenderTargetTexture;
+
     vulkanAPI::Image*           mImage;
     vulkanAPI::Memory*          mMemory;
     vulkanAPI::Sampler*         mSampler;
@@ -83,6 +88,10 @@ private:
     static int                  mDefaultInternalAlignment;
 
     bool                        AllocateVkMemory(void);
+    bool                        AllocateRenderTargetTexture(void);
+    void                        ApplyState(void);
+    void                        CopyEtc1PixelsFromHost(GLint miplevel, GLint layer, const State_t *state);
+    void                        CopyImageInvertedY(vulkanAPI::Image *srcImage);
     void                        ReleaseVkResources(void);
 
 public:
@@ -92,7 +101,10 @@ public:
 
 // Generate Functions
     bool                    Allocate();
+    void                    DeferAllocation(void);
+    bool                    FlushAllocation(void);
     void                    SetState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum format, GLenum type, GLint unpackAlignment, const void *pixels);
+    void                    SetCompressedState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum format, GLsizei imageSize, const void *data);
     void                    SetSubState(ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData);
     void                    GenerateMipmaps(GLenum hintMipmapMode);
 
@@ -117,6 +129,9 @@ public:
      void                   CopyPixelsToHost   (ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum dstFormat, void *dstData);
      void                   SubmitCopyPixels   (const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, GLenum dstFormat, bool copyToImage);
      void                   InvertPixels       (void);
+     void                   UpdateFromRenderTargetTexture(void);
+     bool                   UpdateFromSurfaceTexture(Texture *surfaceTexture);
+     void                   UpdateSubImage     (ImageRect *srcRect, GLint xoffset, GLint yoffset, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData);
 
 // Get Functions
     inline GLenum           GetWrapS(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mParameters.GetWrapS(); }
@@ -137,6 +152,7 @@ public:
     
     inline Texture         *GetDepthStencilTexture(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mDepthStencilTexture;}
     inline uint32_t         GetDepthStencilTextureRefCount(void)        const   { FUN_ENTRY(GL_LOG_TRACE); return mDepthStencilTextureRefCount; }
+    inline Texture         *GetRenderTargetTexture(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mRenderTargetTexture; }
 
     inline vulkanAPI::Image* GetImage(void)                                     { FUN_ENTRY(GL_LOG_TRACE); return mImage; }
 
@@ -174,6 +190,8 @@ public:
     inline void             SetDataNoInvertion(bool updated)                    { FUN_ENTRY(GL_LOG_TRACE); mDataNoInvertion = updated; }
     inline void             SetFboColorAttached(bool updated)                   { FUN_ENTRY(GL_LOG_TRACE); mFboColorAttached = updated; }
     inline void             SetDepthStencilTexture(Texture *tex)                { FUN_ENTRY(GL_LOG_TRACE); mDepthStencilTexture = tex;}
+    inline void             SetImmutable(GLint levels)                          { FUN_ENTRY(GL_LOG_TRACE); mImmutable = true;
+                                                                                                           mMipLevelsCount = levels; }
 
     inline void             SetImageBufferCopyStencil(bool copy)                { FUN_ENTRY(GL_LOG_TRACE); mImage->SetCopyStencil(copy);   }
     inline void             SetVkFormat(VkFormat format)                        { FUN_ENTRY(GL_LOG_TRACE); mImage->SetFormat(format);      }
@@ -196,7 +214,11 @@ public:
                                                                                                                    mFormat != GL_RGBA            &&
                                                                                                                    mFormat != GL_LUMINANCE       &&
                                                                                                                    mFormat != GL_LUMINANCE_ALPHA &&
+                                                                                                                   mFormat != GL_DEPTH_COMPONENT &&
                                                                                                                    mFormat != GL_BGRA8_EXT); }
+    inline bool             IsDepthTexture(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mFormat  == GL_DEPTH_COMPONENT; }
+    inline bool             IsImmutable(void)                           const   { FUN_ENTRY(GL_LOG_TRACE); return mImmutable; }
+    inline bool             IsAllocationPending(void)                   const   { FUN_ENTRY(GL_LOG_TRACE); return mAllocationPending; }
            bool             IsNPOT(void);
            bool             IsNPOTAccessCompleted(void);
            bool             IsCompleted(void);
@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       vertexArrayObject.cpp
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Vertex Array Object Functionality in GLOVE
+ *
+ *  @scope
+ *
+ *  A Vertex Array Object (OES_vertex_array_object) encapsulates the generic
+ *  vertex attribute arrays and the element array buffer binding. Name 0 is
+ *  the default object owned by the resource manager.
+ *
+ *  Once a draw has validated the attribute arrays against the active program
+ *  and they are all sourced from buffer objects, the resulting vertex input
+ *  layout and binding table are kept here. Subsequent draws with the same
+ *  program only refresh the VkBuffer handles, instead of walking the
+ *  attribute state again. Any change to the attribute arrays invalidates it.
+ */
+
+#include "vertexArrayObject.h"
+
+VertexArrayObject::VertexArrayObject(const vulkanAPI::vkContext_t *vkContext, CacheManager *cacheManager)
+: mGenericVertexAttributes(GLOVE_MAX_VERTEX_ATTRIBS), mElementArrayBuffer(nullptr),
+  mResolved(false), mResolvedProgram(nullptr), mResolvedProgramStamp(0),
+  mVertexInputLayout(nullptr), mBindingCount(0)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    SetVkContext(vkContext);
+    SetCacheManager(cacheManager);
+}
+
+VertexArrayObject::~VertexArrayObject()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    Release();
+}
+
+void
+VertexArrayObject::Release(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(auto& gva : mGenericVertexAttributes) {
+        gva.Release();
+    }
+    mElementArrayBuffer = nullptr;
+    Invalidate();
+
+    vulkanAPI::VertexInputCache::ReleaseLayout(mVertexInputLayout);
+    mVertexInputLayout = nullptr;
+}
+
+void
+VertexArrayObject::Resolve(const ShaderProgram *program, uint32_t programStamp,
+                           const vulkanAPI::vertexInputLayout_t *vertexInputLayout,
+                           uint32_t bindingCount, BufferObject * const *bindingBufferObjects)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    assert(bindingCount <= GLOVE_MAX_VERTEX_ATTRIBS);
+
+    mResolved             = true;
+    mResolvedProgram      = program;
+    mResolvedProgramStamp = programStamp;
+
+    // the layout may be evicted from the cache while the vertex array still uses it
+    vulkanAPI::VertexInputCache::AcquireLayout(vertexInputLayout);
+    vulkanAPI::VertexInputCache::ReleaseLayout(mVertexInputLayout);
+    mVertexInputLayout    = vertexInputLayout;
+    mBindingCount         = bindingCount;
+    memcpy(mBindingBufferObjects, bindingBufferObjects, sizeof(BufferObject *) * bindingCount);
+}
+
+uint32_t
+VertexArrayObject::GetVkBuffers(VkBuffer *buffers, BufferObject **bufferObjects) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the handles are read every time, as glBufferData may have replaced the VkBuffer
+    for(uint32_t i = 0; i < mBindingCount; ++i) {
+        buffers[i]       = mBindingBufferObjects[i]->GetVkBuffer();
+        bufferObjects[i] = mBindingBufferObjects[i];
+    }
+    return mBindingCount;
+}
+
+void
+VertexArrayObject::SetVkContext(const vulkanAPI::vkContext_t *vkContext)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    for(auto& gva : mGenericVertexAttributes) {
+        gva.SetVkContext(vkContext);
+    }
+}
+
+void
+VertexArrayObject::SetCacheManager(CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    for(auto& gva : mGenericVertexAttributes) {
+        gva.SetCacheManager(cacheManager);
+    }
+}
+
+void
+VertexArrayObject::SetGenericValues(const VertexArrayObject *vao)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // current generic attribute values are context state and follow the bound object
+    GLfloat genericValue[4];
+    for(size_t i = 0; i < mGenericVertexAttributes.size(); ++i) {
+        vao->mGenericVertexAttributes[i].GetGenericValue(genericValue);
+        mGenericVertexAttributes[i].SetGenericValue(genericValue);
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       vertexArrayObject.h
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Vertex Array Object Functionality in GLOVE
+ *
+ */
+
+#ifndef __VERTEXARRAYOBJECT_H__
+#define __VERTEXARRAYOBJECT_H__
+
+#include "genericVertexAttribute.h"
+#include "refObject.h"
+#include "vulkan/vertexInputCache.h"
+
+class ShaderProgram;
+
+class VertexArrayObject : public refObject
+{
+private:
+    std::vector<GenericVertexAttribute>   mGenericVertexAttributes;
+    BufferObject                         *mElementArrayBuffer;
+
+    // vertex input bindings already validated against a linked program
+    bool                                  mResolved;
+    const ShaderProgram                  *mResolvedProgram;
+    uint32_t                              mResolvedProgramStamp;
+    const vulkanAPI::vertexInputLayout_t *mVertexInputLayout;
+    uint32_t                              mBindingCount;
+    BufferObject                         *mBindingBufferObjects[GLOVE_MAX_VERTEX_ATTRIBS];
+
+public:
+    VertexArrayObject(const vulkanAPI::vkContext_t *vkContext = nullptr, CacheManager *cacheManager = nullptr);
+    ~VertexArrayObject();
+
+// Release Functions
+           void                                  Release(void);
+
+// Resolve Functions
+           void                                  Resolve(const ShaderProgram *program, uint32_t programStamp,
+                                                         const vulkanAPI::vertexInputLayout_t *vertexInputLayout,
+                                                         uint32_t bindingCount, BufferObject * const *bindingBufferObjects);
+    inline void                                  Invalidate(void)                                                   { FUN_ENTRY(GL_LOG_TRACE); mResolved = false; }
+    inline bool                                  IsResolved(const ShaderProgram *program, uint32_t programStamp) const { FUN_ENTRY(GL_LOG_TRACE); return mResolved && mResolvedProgram == program && mResolvedProgramStamp == programStamp; }
+
+// Get Functions
+           uint32_t                              GetVkBuffers(VkBuffer *buffers, BufferObject **bufferObjects)  const;
+    inline const vulkanAPI::vertexInputLayout_t *GetVertexInputLayout(void)                                  const { FUN_ENTRY(GL_LOG_TRACE); return mVertexInputLayout; }
+    inline std::vector<GenericVertexAttribute>  &GetGenericVertexAttributes(void)                                  { FUN_ENTRY(GL_LOG_TRACE); return mGenericVertexAttributes; }
+    inline GenericVertexAttribute               *GetGenericVertexAttribute(size_t index)                           { FUN_ENTRY(GL_LOG_TRACE); return &mGenericVertexAttributes[index]; }
+    inline BufferObject                         *GetElementArrayBuffer(void)                                 const { FUN_ENTRY(GL_LOG_TRACE); return mElementArrayBuffer; }
+
+// Set Functions
+           void                                  SetVkContext(const vulkanAPI::vkContext_t *vkContext);
+           void                                  SetCacheManager(CacheManager *cacheManager);
+           void                                  SetGenericValues(const VertexArrayObject *vao);
+    inline void                                  SetElementArrayBuffer(BufferObject *bo)                           { FUN_ENTRY(GL_LOG_TRACE); mElementArrayBuffer = bo; }
+};
+
+#endif // __VERTEXARRAYOBJECT_H__
@@ -22,8 +22,8 @@
  *  @section
  *
  *  State Manager must include the active (a) buffer object, (b) shader program,
- *  (c) framebuffer, (d) renderbuffer and (e) textures for both 2D and CUBEMAP
- *  types.
+ *  (c) framebuffer, (d) renderbuffer, (e) textures for both 2D and CUBEMAP
+ *  types and (f) vertex array object.
  *
  */
 
@@ -31,6 +31,7 @@
 
 StateActiveObjects::StateActiveObjects()
 : mActiveShaderProgram(nullptr),
+mActiveVertexArray(nullptr),
 mActiveFramebufferObjectID(0),
 mActiveRenderbufferObjectID(0),
 mActiveTextureUnit(GL_TEXTURE0)
@@ -25,6 +25,7 @@
 #define __STATEACTIVEOBJECTS_H__
 
 #include "resources/shaderProgram.h"
+#include "resources/vertexArrayObject.h"
 #include "resources/bufferObject.h"
 #include "resources/texture.h"
 
@@ -42,6 +43,7 @@ private:
 
       BufferObject*             mActiveBufferObjects[BUFFER_OBJECT_TARGET_ALL];
       ShaderProgram*            mActiveShaderProgram;
+      VertexArrayObject*        mActiveVertexArray;
       GLuint                    mActiveFramebufferObjectID;
       GLuint                    mActiveRenderbufferObjectID;
       GLenum                    mActiveTextureUnit;
@@ -55,6 +57,7 @@ public:
       inline Texture*           GetActiveTexture(GLenum target)                            { FUN_ENTRY(GL_LOG_TRACE); return mActiveTextures[GL_TEXTURE_TARGET_TO_TYPE(target)][GL_TEXTURE_ENUM_TO_UNIT(mActiveTextureUnit)]; }
       inline Texture*           GetActiveTexture(GLenum target, int j)                     { FUN_ENTRY(GL_LOG_TRACE); return mActiveTextures[GL_TEXTURE_TARGET_TO_TYPE(target)][j]; }
       inline ShaderProgram*     GetActiveShaderProgram(void)                               { FUN_ENTRY(GL_LOG_TRACE); return mActiveShaderProgram; }
+      inline VertexArrayObject* GetActiveVertexArray(void)                                 { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexArray; }
       inline BufferObject*      GetActiveBufferObject(BufferObjectTarget_t target)         { FUN_ENTRY(GL_LOG_TRACE); return mActiveBufferObjects[target]; }
       inline BufferObject*      GetActiveBufferObject(GLenum target)                       { FUN_ENTRY(GL_LOG_TRACE); return GetActiveBufferObject(GL_BUFFER_TARGET_TO_TYPE(target)); }
       inline uint32_t           GetActiveFramebufferObjectID(void)                  const  { FUN_ENTRY(GL_LOG_TRACE); return mActiveFramebufferObjectID; }
@@ -68,6 +71,7 @@ public:
       inline void               SetActiveFramebufferObjectID(GLuint id)                    { FUN_ENTRY(GL_LOG_TRACE); mActiveFramebufferObjectID  = id; }
       inline void               SetActiveRenderbufferObjectID(GLuint id)                   { FUN_ENTRY(GL_LOG_TRACE); mActiveRenderbufferObjectID = id; }
       inline void               SetActiveShaderProgram(ShaderProgram *program)             { FUN_ENTRY(GL_LOG_TRACE); mActiveShaderProgram = program; }
+      inline void               SetActiveVertexArray(VertexArrayObject *vao)               { FUN_ENTRY(GL_LOG_TRACE); mActiveVertexArray = vao; }
       inline void               SetActiveBufferObject(BufferObjectTarget_t target,
                                                       BufferObject *bo)                    { FUN_ENTRY(GL_LOG_TRACE); mActiveBufferObjects[target] = bo; }
       inline void               SetActiveBufferObject(GLenum target,
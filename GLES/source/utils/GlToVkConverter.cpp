@@ -322,6 +322,12 @@ GlInternalFormatToVkFormat(GLenum internalformat)
     case GL_BGRA8_EXT:
     case GL_BGRA_EXT:                         return VK_FORMAT_B8G8R8A8_UNORM;
 
+    case GL_ALPHA16F_EXT:
+    case GL_LUMINANCE16F_EXT:
+    case GL_LUMINANCE_ALPHA16F_EXT:
+    case GL_RGB16F_EXT:
+    case GL_RGBA16F_EXT:                      return VK_FORMAT_R16G16B16A16_SFLOAT;
+
     case GL_DEPTH_COMPONENT16:                return VK_FORMAT_D16_UNORM;
     case GL_DEPTH24_STENCIL8_OES:
     case GL_UNSIGNED_INT_24_8_OES:            return VK_FORMAT_D24_UNORM_S8_UINT;
@@ -363,6 +369,9 @@ VkFormat GlColorFormatToVkColorFormat(GLenum format, GLenum type)
             assert( format == GL_RGBA );
             return          VK_FORMAT_R5G5B5A1_UNORM_PACK16;
         }
+        case GL_HALF_FLOAT_OES: {
+            return          VK_FORMAT_R16G16B16A16_SFLOAT;
+        }
         default: {
             return VK_FORMAT_R8G8B8A8_UNORM;
         }
@@ -385,6 +394,15 @@ GlAttribPointerToVkFormat(GLint nElements, GLenum type, GLboolean normalized)
         default: { NOT_REACHED();           return VK_FORMAT_UNDEFINED; }
         }
 
+    case GL_HALF_FLOAT_OES:
+        switch(nElements) {
+        case 1:                             return VK_FORMAT_R16_SFLOAT;
+        case 2:                             return VK_FORMAT_R16G16_SFLOAT;
+        case 3:                             return VK_FORMAT_R16G16B16_SFLOAT;
+        case 4:                             return VK_FORMAT_R16G16B16A16_SFLOAT;
+        default: { NOT_REACHED();           return VK_FORMAT_UNDEFINED; }
+        }
+
     case GL_INT:
         switch(nElements) {
         case 1:                             return VK_FORMAT_R32_SINT;
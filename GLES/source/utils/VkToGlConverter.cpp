@@ -44,6 +44,10 @@ VkFormatToGlInternalformat(VkFormat format)
     case VK_FORMAT_B8G8R8A8_SRGB:
     case VK_FORMAT_B8G8R8A8_UNORM:          return GL_BGRA8_EXT;
 
+    case VK_FORMAT_R16G16B16A16_SFLOAT:     return GL_RGBA16F_EXT;
+
+    case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK: return GL_ETC1_RGB8_OES;
+
     case VK_FORMAT_D16_UNORM:               return GL_DEPTH_COMPONENT16;
     case VK_FORMAT_D16_UNORM_S8_UINT:
     case VK_FORMAT_D24_UNORM_S8_UINT:
@@ -18,36 +18,173 @@
  *  @version    1.0
  *
  *  @brief      A simple interface is provided for handling all the accesses to
- *              the arrays of classes needed in GLOVE using the map container.
+ *              the arrays of classes needed in GLOVE using a slot table.
  *
  */
 
 #ifndef __ARRAYS_HPP__
 #define __ARRAYS_HPP__
 
-#include <map>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+
+#define OBJECT_ARRAY_MIN_SLOTS              64
 
 /**
  * @brief A templated class for handling the memory allocation, indexing and
  * searching of all the different arrays of classes.
  *
- * A separate map container is created for every class that the GLOVE supports.
- * This map is used later for the creation of the various new objects,
- * their indexing and searching. The key value of the map is used as the GL
- * handle, therefore the 0 value is not permitted. The mapped value is the
- * generated object.
+ * A separate container is created for every class that the GLOVE supports.
+ * It is used later for the creation of the various new objects, their
+ * indexing and searching. The GL handle is used as an index into a dense
+ * slot table, therefore the 0 value is not permitted. Handles that are far
+ * beyond the end of the table (e.g. chosen by the user without a glGen* call)
+ * are kept in a hash map instead, so that the table does not grow unbounded.
+ *
+ * Each object stores its own GL handle (see refObject::GetObjectId), so the
+ * reverse lookup from an object to its handle does not need a search.
  */
 template <class ELEMENT>
 class ObjectArray {
 private:
-    uint32_t mCounter;                 /**< The id (key-value of the map)
-                                          reserved during the creation of a new
-                                          object. */
-    std::map<uint32_t, ELEMENT *> mObjects; /**< The templated map container (one
-                                          for each different class that maps
-                                          id to a specific object). */
+    struct slot_t {
+        ELEMENT *object;               /**< The object using this handle, if any. */
+        bool     free;                 /**< The handle is in the free list. */
+
+        slot_t() : object(nullptr), free(false) { }
+    };
+
+    uint32_t mCounter;                 /**< The largest id handed out by the
+                                          allocate method or used by an
+                                          object of the slot table. */
+    std::vector<slot_t> mObjects;      /**< The slot table, indexed by the GL
+                                          handle. */
+    std::unordered_map<uint32_t, ELEMENT *> mSparseObjects; /**< Objects with
+                                          handles outside of the slot table. */
+    std::vector<uint32_t> mFreeIds;    /**< Handles of the slot table that have
+                                          been released and can be reused. */
+
+    /**
+    * @brief Returns the object using the given GL handle, or nullptr.
+    */
+    ELEMENT *Find(uint32_t index) const
+    {
+        if(index < mObjects.size()) {
+            return mObjects[index].object;
+        }
+
+        typename std::unordered_map<uint32_t, ELEMENT *>::const_iterator it = mSparseObjects.find(index);
+        return it == mSparseObjects.end() ? nullptr : it->second;
+    }
+
+    /**
+    * @brief Grows the slot table so that it covers index. Sparse objects that
+    * fall inside the new table are moved into it.
+    */
+    void Grow(uint32_t index)
+    {
+        size_t size = std::max(std::max(2 * mObjects.size(), static_cast<size_t>(OBJECT_ARRAY_MIN_SLOTS)),
+                               static_cast<size_t>(index) + 1);
+        mObjects.resize(size);
+
+        typename std::unordered_map<uint32_t, ELEMENT *>::iterator it = mSparseObjects.begin();
+        while(it != mSparseObjects.end()) {
+            if(it->first < size) {
+                mObjects[it->first].object = it->second;
+                mCounter = std::max(mCounter, it->first);
+                it = mSparseObjects.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    /**
+    * @brief Detaches the object using the given GL handle from the container.
+    * @return The detached object, or nullptr if the handle is not used.
+    */
+    ELEMENT *Remove(uint32_t index)
+    {
+        ELEMENT *element = nullptr;
+
+        if(index < mObjects.size()) {
+            slot_t &slot = mObjects[index];
+            element      = slot.object;
+            slot.object  = nullptr;
+
+            if(element && !slot.free) {
+                slot.free = true;
+                mFreeIds.push_back(index);
+            }
+        } else {
+            typename std::unordered_map<uint32_t, ELEMENT *>::iterator it = mSparseObjects.find(index);
+            if(it != mSparseObjects.end()) {
+                element = it->second;
+                mSparseObjects.erase(it);
+            }
+        }
+
+        return element;
+    }
+
 public:
 
+    /**
+    * @brief Iterates over the objects of the container, first those of the
+    * slot table in handle order and then the sparse ones. Dereferencing
+    * yields a (GL handle, object) pair.
+    */
+    class const_iterator {
+    private:
+        friend class ObjectArray;
+
+        const ObjectArray *mArray;
+        size_t             mSlot;
+        typename std::unordered_map<uint32_t, ELEMENT *>::const_iterator mSparseIt;
+        std::pair<uint32_t, ELEMENT *> mValue;
+
+        const_iterator(const ObjectArray *array, size_t slot,
+                       typename std::unordered_map<uint32_t, ELEMENT *>::const_iterator sparseIt)
+        : mArray(array), mSlot(slot), mSparseIt(sparseIt)
+        {
+            Settle();
+        }
+
+        void Settle(void)
+        {
+            while(mSlot < mArray->mObjects.size() && !mArray->mObjects[mSlot].object) {
+                ++mSlot;
+            }
+
+            if(mSlot < mArray->mObjects.size()) {
+                mValue = std::make_pair(static_cast<uint32_t>(mSlot), mArray->mObjects[mSlot].object);
+            } else if(mSparseIt != mArray->mSparseObjects.end()) {
+                mValue = *mSparseIt;
+            }
+        }
+
+    public:
+        const std::pair<uint32_t, ELEMENT *> &operator*()  const { return mValue;  }
+        const std::pair<uint32_t, ELEMENT *> *operator->() const { return &mValue; }
+
+        const_iterator &operator++()
+        {
+            if(mSlot < mArray->mObjects.size()) {
+                ++mSlot;
+            } else {
+                ++mSparseIt;
+            }
+            Settle();
+
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const { return mSlot == other.mSlot && mSparseIt == other.mSparseIt; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
     /**
     * @brief The constructor initializes the key value to a non-usable value in
     * order to be assigned later to a correct one, through the allocate method.
@@ -58,39 +195,57 @@ public:
     }
 
     /**
-    * @brief The destructor removes all elements from the map container (which
+    * @brief The destructor removes all elements from the container (which
     * are destroyed), leaving the container with a size of 0.
     */
     ~ObjectArray()
     {
-        typename std::map<uint32_t, ELEMENT *>::iterator it;
-        for(it = mObjects.begin(); it != mObjects.end(); it++) {
-            delete it->second;
+        for(typename std::vector<slot_t>::iterator it = mObjects.begin(); it != mObjects.end(); it++) {
+            delete it->object;
         }
         mObjects.clear();
+
+        typename std::unordered_map<uint32_t, ELEMENT *>::iterator it;
+        for(it = mSparseObjects.begin(); it != mSparseObjects.end(); it++) {
+            delete it->second;
+        }
+        mSparseObjects.clear();
     }
 
     /**
-    * @brief Returns the GL handle and reserves this as the new key value.
+    * @brief Returns a GL handle that is not in use. Released handles are
+    * reused first.
     * @return The GL handle.
     */
     uint32_t Allocate()
     {
-        return ++mCounter;
+        while(!mFreeIds.empty()) {
+            uint32_t index = mFreeIds.back();
+            mFreeIds.pop_back();
+
+            mObjects[index].free = false;
+            if(!mObjects[index].object) {
+                return index;
+            }
+        }
+
+        do {
+            ++mCounter;
+        } while(Find(mCounter));
+
+        return mCounter;
     }
 
     /**
-    * @brief Removes from the map container a single element with the given
+    * @brief Removes from the container a single element with the given
     * key value (element is  destroyed).
     * @param index: The GL handle of the element to be destroyed.
     */
     bool Deallocate(uint32_t index)
     {
-        typename std::map<uint32_t, ELEMENT *>::iterator it = mObjects.find(index);
-        if(it != mObjects.end()) {
-            delete it->second;
-            mObjects.erase(it);
-
+        ELEMENT *element = Remove(index);
+        if(element) {
+            delete element;
             return true;
         }
 
@@ -98,40 +253,46 @@ public:
     }
 
     /**
-    * @brief Removes from the map container a single element with the given
+    * @brief Removes from the container a single element with the given
     * key value (element is NOT destroyed).
     */
     bool RemoveFromList(uint32_t index)
     {
-        typename std::map<uint32_t, ELEMENT *>::iterator it = mObjects.find(index);
-        if(it != mObjects.end()) {
-            mObjects.erase(it);
-            return true;
-        }
-        return false;
+        return Remove(index) != nullptr;
     }
 
     /**
      * @brief Searches the container for an element with a key equivalent to
      * index and returns it.
      * @param index: The GL handle of the element to be found or to be created.
-     * @return A pointer to the element in the map.
+     * @return A pointer to the element in the container.
      *
      * In case the key value is not found (thus, the element does not exist)
      * a new object is created. Consequently this method is the only way to
-     * insert a new element in the map.
+     * insert a new element in the container.
      */
     ELEMENT *GetObject(uint32_t index)
     {
-        if(mCounter < index) {
-            mCounter = index;
+        ELEMENT *element = Find(index);
+        if(element) {
+            return element;
         }
-        typename std::map<uint32_t, ELEMENT *>::iterator it = mObjects.find(index);
-        if(it != mObjects.end()) {
-            return it->second;
+
+        element = new ELEMENT();
+        element->SetObjectId(index);
+
+        if(index >= mObjects.size() && index < std::max(2 * mObjects.size(), static_cast<size_t>(OBJECT_ARRAY_MIN_SLOTS))) {
+            Grow(index);
+        }
+
+        if(index < mObjects.size()) {
+            mObjects[index].object = element;
+            mCounter = std::max(mCounter, index);
         } else {
-            return mObjects[index] = new ELEMENT();
+            mSparseObjects[index] = element;
         }
+
+        return element;
     }
 
     /**
@@ -142,8 +303,7 @@ public:
      */
     bool ObjectExists(uint32_t index) const
     {
-        typename std::map<uint32_t, ELEMENT *>::const_iterator it = mObjects.find(index);
-        return it == mObjects.end() ? false : true;
+        return Find(index) != nullptr;
     }
 
     /**
@@ -151,16 +311,15 @@ public:
      * @param *element: The element to be searched in the container.
      * @return The GL handle of the element.
      *
-     * The container is traversed using the mapped value as the search value.
-     * The GL handle is returned in case the wanted element exists, else the
-     * returned value is 0.
+     * The handle stored in the element is returned in case the element is
+     * still in the container under that handle, else the returned value is ~0.
      */
     uint32_t GetObjectId(const ELEMENT * element) const
     {
-        typename std::map<uint32_t, ELEMENT *>::const_iterator it;
-        for(it = mObjects.begin(); it != mObjects.end(); it++) {
-            if(it->second == element) {
-                return it->first;
+        if(element) {
+            uint32_t index = element->GetObjectId();
+            if(Find(index) == element) {
+                return index;
             }
         }
 
@@ -168,12 +327,16 @@ public:
     }
 
     /**
-     * @brief Returns the map container for a specific class.
-     * @return The map container.
+     * @brief Returns iterators over the elements of the container.
      */
-    std::map<uint32_t, ELEMENT *> *GetObjects(void)
+    const_iterator begin(void) const
+    {
+        return const_iterator(this, 0, mSparseObjects.begin());
+    }
+
+    const_iterator end(void) const
     {
-        return &mObjects;
+        return const_iterator(this, mObjects.size(), mSparseObjects.end());
     }
 };
 
@@ -22,6 +22,7 @@
  */
 
 #include "cacheManager.h"
+#include "vulkan/samplerCache.h"
 
 void
 CacheManager::CleanUpUBOCache(void)
@@ -132,4 +133,13 @@ CacheManager::CleanUpCaches()
     CleanUpVBOCache();
     CleanUpTextureCache();
     CleanUpVkPipelineObjectCache();
+
+    if(mVkContext->vkSamplerCache) {
+        mVkContext->vkSamplerCache->CleanUpUnusedSamplers();
+    }
+
+    GLOVE_PRINT(GL_LOG_DEBUG, "Uniform bytes copied: %zu", mUniformBytesCopied);
+
+    mFrameUniformBytesCopied = mUniformBytesCopied;
+    mUniformBytesCopied      = 0;
 }
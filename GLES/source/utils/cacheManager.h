@@ -39,13 +39,16 @@ private:
     std::vector<Texture *>              mTextureCache;
     std::vector<VkPipeline>             mVkPipelineObjectCache;
 
+    size_t                              mUniformBytesCopied;
+    size_t                              mFrameUniformBytesCopied;
+
     void                                CleanUpUBOCache();
     void                                CleanUpVBOCache();
     void                                CleanUpTextureCache();
     void                                CleanUpVkPipelineObjectCache();
 
 public:
-     CacheManager(const vulkanAPI::vkContext_t *vkContext) : mVkContext(vkContext) { }
+     CacheManager(const vulkanAPI::vkContext_t *vkContext) : mVkContext(vkContext), mUniformBytesCopied(0), mFrameUniformBytesCopied(0) { }
     ~CacheManager() { }
 
     void                                CacheUBO(UniformBufferObject *uniformBufferObject);
@@ -53,6 +56,11 @@ public:
     void                                CacheTexture(Texture *tex);
     void                                CacheVkPipelineObject(VkPipeline pipeline);
     void                                CleanUpCaches();
+
+    /// Uniform data copied into buffer objects since the last clean up, and up to it. eglSwapBuffers finishes
+    /// the context, which cleans up the caches, so the latter is the amount copied during the previous frame.
+    inline void                         AddUniformBytesCopied(size_t bytes)           { FUN_ENTRY(GL_LOG_TRACE); mUniformBytesCopied += bytes; }
+    inline size_t                       GetFrameUniformBytesCopied(void)        const { FUN_ENTRY(GL_LOG_TRACE); return mFrameUniformBytesCopied; }
 };
 
 #endif //__CACHEMANAGER_H__
@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <algorithm>
 
 template<typename T>
@@ -36,6 +37,38 @@ CLAMP(const T x, const T minVal, const T maxVal) {
 
 #define CLAMPF_01(x)                                    CLAMP(x, 0.0f, 1.0f)
 
+#define HALF_FLOAT_ONE                                  0x3C00u
+
+// decodes an IEEE 754 binary16 value
+inline float
+HalfToFloat(uint16_t h)
+{
+    const uint32_t sign     = (h & 0x8000u) << 16;
+    const uint32_t exponent = (h & 0x7C00u) >> 10;
+    uint32_t       mantissa = (h & 0x03FFu);
+    uint32_t       bits;
+
+    if(exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else if(exponent) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if(mantissa) {
+        // denormal, normalize it
+        uint32_t e = 113;
+        while(!(mantissa & 0x0400u)) {
+            mantissa <<= 1;
+            --e;
+        }
+        bits = sign | (e << 23) | ((mantissa & 0x03FFu) << 13);
+    } else {
+        bits = sign;
+    }
+
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
 // TODO:: check and reimplement/optimize conversions for packed image formats if needed
 struct Color {
     unsigned char r, g, b, a;
@@ -317,6 +350,20 @@ struct Color {
         return color;
     }
 
+    static Color
+    FromRGBA16F(const uint8_t* rgba16f_ptr)
+    {
+        const uint16_t *h = reinterpret_cast<const uint16_t *>(rgba16f_ptr);
+
+        Color color;
+        color.r = static_cast<unsigned char>(CLAMPF_01(HalfToFloat(h[0])) * 255.0f + 0.5f);
+        color.g = static_cast<unsigned char>(CLAMPF_01(HalfToFloat(h[1])) * 255.0f + 0.5f);
+        color.b = static_cast<unsigned char>(CLAMPF_01(HalfToFloat(h[2])) * 255.0f + 0.5f);
+        color.a = static_cast<unsigned char>(CLAMPF_01(HalfToFloat(h[3])) * 255.0f + 0.5f);
+
+        return color;
+    }
+
     static Color
     FromYUV(const uint8_t* yuv_ptr)
     {
@@ -336,4 +383,85 @@ struct Color {
     }
 };
 
+// Half-float color, channels hold the binary16 bits as they are, so that
+// conversions between half-float formats do not lose any precision
+struct ColorHalf {
+    uint16_t r, g, b, a;
+
+    ColorHalf():
+    r(0), g(0), b(0), a(0) { }
+
+    static ColorHalf
+    FromRGBA16F(const uint8_t* ptr)
+    {
+        const uint16_t *h = reinterpret_cast<const uint16_t *>(ptr);
+
+        ColorHalf color;
+        color.r = h[0];
+        color.g = h[1];
+        color.b = h[2];
+        color.a = h[3];
+        return color;
+    }
+
+    static void
+    ConvertToRGBA16F(ColorHalf& c, uint8_t* ptr)
+    {
+        uint16_t *h = reinterpret_cast<uint16_t *>(ptr);
+        h[0] = c.r;
+        h[1] = c.g;
+        h[2] = c.b;
+        h[3] = c.a;
+    }
+
+    static ColorHalf
+    FromRGB16F(const uint8_t* ptr)
+    {
+        const uint16_t *h = reinterpret_cast<const uint16_t *>(ptr);
+
+        ColorHalf color;
+        color.r = h[0];
+        color.g = h[1];
+        color.b = h[2];
+        color.a = HALF_FLOAT_ONE;
+        return color;
+    }
+
+    static ColorHalf
+    FromLuminanceAlpha16F(const uint8_t* ptr)
+    {
+        const uint16_t *h = reinterpret_cast<const uint16_t *>(ptr);
+
+        ColorHalf color;
+        color.r = h[0];
+        color.g = h[0];
+        color.b = h[0];
+        color.a = h[1];
+        return color;
+    }
+
+    static ColorHalf
+    FromLuminance16F(const uint8_t* ptr)
+    {
+        const uint16_t *h = reinterpret_cast<const uint16_t *>(ptr);
+
+        ColorHalf color;
+        color.r = h[0];
+        color.g = h[0];
+        color.b = h[0];
+        color.a = HALF_FLOAT_ONE;
+        return color;
+    }
+
+    static ColorHalf
+    FromAlpha16F(const uint8_t* ptr)
+    {
+        const uint16_t *h = reinterpret_cast<const uint16_t *>(ptr);
+
+        ColorHalf color;
+        color.a = h[0];
+        return color;
+    }
+};
+
 #endif // __COLOR_HPP__
@@ -0,0 +1,132 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       etc1Decoder.cpp
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      ETC1 (GL_ETC1_RGB8_OES) block decoder
+ *
+ *  @scope
+ *
+ *  Used when the device cannot sample ETC2 images, of which ETC1 is a subset.
+ *  Each 64-bit block holds two base colors and two modifier tables, one per
+ *  2x4 or 4x2 subblock, plus a 2-bit modifier index per texel. Decoding first
+ *  builds the 4 possible colors of each subblock, so that every texel is a
+ *  single 4-byte copy from that palette. The output is RGBA8 with opaque alpha.
+ *
+ */
+
+#include "etc1Decoder.h"
+#include <cstring>
+
+static const int32_t sModifierTable[8][4] = {
+    {  2,   8,   -2,   -8 },
+    {  5,  17,   -5,  -17 },
+    {  9,  29,   -9,  -29 },
+    { 13,  42,  -13,  -42 },
+    { 18,  60,  -18,  -60 },
+    { 24,  80,  -24,  -80 },
+    { 33, 106,  -33, -106 },
+    { 47, 183,  -47, -183 }
+};
+
+static inline uint8_t
+Clamp(int32_t value)
+{
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+static void
+DecodeBlock(const uint8_t *block, uint8_t texels[ETC1_BLOCK_DIM * ETC1_BLOCK_DIM][4])
+{
+    const uint32_t hi = (static_cast<uint32_t>(block[0]) << 24) | (static_cast<uint32_t>(block[1]) << 16) |
+                        (static_cast<uint32_t>(block[2]) <<  8) |  static_cast<uint32_t>(block[3]);
+    const uint32_t lo = (static_cast<uint32_t>(block[4]) << 24) | (static_cast<uint32_t>(block[5]) << 16) |
+                        (static_cast<uint32_t>(block[6]) <<  8) |  static_cast<uint32_t>(block[7]);
+
+    int32_t base[2][3];
+    if(hi & 0x2) {
+        // differential mode: 5-bit base color and a signed 3-bit delta for the second subblock
+        for(uint32_t c = 0; c < 3; ++c) {
+            const int32_t color = (hi >> (27 - 8 * c)) & 0x1f;
+            const int32_t delta = static_cast<int32_t>(((hi >> (24 - 8 * c)) & 0x7) ^ 0x4) - 0x4;
+            const int32_t color2 = (color + delta) & 0x1f;
+            base[0][c] = (color  << 3) | (color  >> 2);
+            base[1][c] = (color2 << 3) | (color2 >> 2);
+        }
+    } else {
+        // individual mode: two 4-bit base colors
+        for(uint32_t c = 0; c < 3; ++c) {
+            const int32_t color  = (hi >> (28 - 8 * c)) & 0xf;
+            const int32_t color2 = (hi >> (24 - 8 * c)) & 0xf;
+            base[0][c] = color  | (color  << 4);
+            base[1][c] = color2 | (color2 << 4);
+        }
+    }
+
+    const int32_t *modifiers[2] = { sModifierTable[(hi >> 5) & 0x7], sModifierTable[(hi >> 2) & 0x7] };
+
+    uint8_t palette[2][4][4];
+    for(uint32_t s = 0; s < 2; ++s) {
+        for(uint32_t i = 0; i < 4; ++i) {
+            palette[s][i][0] = Clamp(base[s][0] + modifiers[s][i]);
+            palette[s][i][1] = Clamp(base[s][1] + modifiers[s][i]);
+            palette[s][i][2] = Clamp(base[s][2] + modifiers[s][i]);
+            palette[s][i][3] = 0xff;
+        }
+    }
+
+    // texel indices are stored column by column
+    const bool flip = hi & 0x1;
+    for(uint32_t x = 0; x < ETC1_BLOCK_DIM; ++x) {
+        for(uint32_t y = 0; y < ETC1_BLOCK_DIM; ++y) {
+            const uint32_t bit      = x * ETC1_BLOCK_DIM + y;
+            const uint32_t index    = (((lo >> (16 + bit)) & 0x1) << 1) | ((lo >> bit) & 0x1);
+            const uint32_t subblock = flip ? (y >> 1) : (x >> 1);
+            memcpy(texels[y * ETC1_BLOCK_DIM + x], palette[subblock][index], 4);
+        }
+    }
+}
+
+size_t
+Etc1ImageSize(uint32_t width, uint32_t height)
+{
+    return static_cast<size_t>((width  + ETC1_BLOCK_DIM - 1) / ETC1_BLOCK_DIM) *
+                              ((height + ETC1_BLOCK_DIM - 1) / ETC1_BLOCK_DIM) * ETC1_BLOCK_SIZE;
+}
+
+void
+Etc1DecodeImage(const void *src, uint32_t width, uint32_t height, uint8_t *dst, size_t dstRowStride)
+{
+    const uint8_t *block = static_cast<const uint8_t *>(src);
+    uint8_t texels[ETC1_BLOCK_DIM * ETC1_BLOCK_DIM][4];
+
+    for(uint32_t by = 0; by < height; by += ETC1_BLOCK_DIM) {
+        const uint32_t rows = height - by < ETC1_BLOCK_DIM ? height - by : ETC1_BLOCK_DIM;
+
+        for(uint32_t bx = 0; bx < width; bx += ETC1_BLOCK_DIM) {
+            const uint32_t columns = width - bx < ETC1_BLOCK_DIM ? width - bx : ETC1_BLOCK_DIM;
+
+            DecodeBlock(block, texels);
+            block += ETC1_BLOCK_SIZE;
+
+            // blocks at the right and bottom edges may be partially used
+            for(uint32_t y = 0; y < rows; ++y) {
+                memcpy(dst + (by + y) * dstRowStride + bx * 4, texels[y * ETC1_BLOCK_DIM], columns * 4);
+            }
+        }
+    }
+}
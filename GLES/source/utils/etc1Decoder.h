@@ -0,0 +1,36 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       etc1Decoder.h
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      ETC1 (GL_ETC1_RGB8_OES) block decoder
+ *
+ */
+
+#ifndef __ETC1DECODER_H__
+#define __ETC1DECODER_H__
+
+#include <cstddef>
+#include <stdint.h>
+
+#define ETC1_BLOCK_DIM                                  4
+#define ETC1_BLOCK_SIZE                                 8
+
+size_t                  Etc1ImageSize(uint32_t width, uint32_t height);
+void                    Etc1DecodeImage(const void *src, uint32_t width, uint32_t height, uint8_t *dst, size_t dstRowStride);
+
+#endif // __ETC1DECODER_H__
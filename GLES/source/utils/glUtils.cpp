@@ -89,6 +89,13 @@ GlFormatToGlInternalFormat(GLenum format, GLenum type)
     case GL_DEPTH_COMPONENT32_OES:          return GL_DEPTH_COMPONENT32_OES;
     case GL_STENCIL_INDEX8:                 return GL_STENCIL_INDEX8;
     case GL_STENCIL_INDEX4_OES:             return GL_STENCIL_INDEX4_OES;
+    case GL_ETC1_RGB8_OES:                  return GL_ETC1_RGB8_OES;
+    case GL_DEPTH_COMPONENT:
+        switch(type) {
+        case GL_UNSIGNED_SHORT:             return GL_DEPTH_COMPONENT16;
+        case GL_UNSIGNED_INT:               return GL_DEPTH_COMPONENT24_OES;
+        default: NOT_FOUND_ENUM(type);      return GL_INVALID_VALUE;
+        }
     case GL_BGRA_EXT:
     case GL_BGRA8_EXT:
         switch(type) {
@@ -100,6 +107,7 @@ GlFormatToGlInternalFormat(GLenum format, GLenum type)
         case GL_UNSIGNED_SHORT_4_4_4_4:     return GL_RGBA4;
         case GL_UNSIGNED_SHORT_5_5_5_1:     return GL_RGB5_A1;
         case GL_UNSIGNED_BYTE:              return GL_RGBA8_OES;
+        case GL_HALF_FLOAT_OES:             return GL_RGBA16F_EXT;
         default: NOT_FOUND_ENUM(type);      return GL_INVALID_VALUE;
         }
 
@@ -107,24 +115,28 @@ GlFormatToGlInternalFormat(GLenum format, GLenum type)
         switch(type) {
         case GL_UNSIGNED_SHORT_5_6_5:       return GL_RGB565;
         case GL_UNSIGNED_BYTE:              return GL_RGB8_OES;
+        case GL_HALF_FLOAT_OES:             return GL_RGB16F_EXT;
         default: NOT_FOUND_ENUM(type);      return GL_INVALID_VALUE;
         }
 
     case GL_LUMINANCE_ALPHA:
         switch(type) {
         case GL_UNSIGNED_BYTE:              return GL_LUMINANCE_ALPHA;
+        case GL_HALF_FLOAT_OES:             return GL_LUMINANCE_ALPHA16F_EXT;
         default: NOT_FOUND_ENUM(type);      return GL_INVALID_VALUE;
         }
 
     case GL_LUMINANCE:
         switch(type) {
         case GL_UNSIGNED_BYTE:              return GL_LUMINANCE;
+        case GL_HALF_FLOAT_OES:             return GL_LUMINANCE16F_EXT;
         default: NOT_FOUND_ENUM(type);      return GL_INVALID_VALUE;
         }
 
     case GL_ALPHA:
         switch(type) {
         case GL_UNSIGNED_BYTE:              return GL_ALPHA;
+        case GL_HALF_FLOAT_OES:             return GL_ALPHA16F_EXT;
         default: NOT_FOUND_ENUM(type);      return GL_INVALID_VALUE;
         }
 
@@ -150,17 +162,23 @@ GlInternalFormatToGlType(GLenum internalformat)
     case GL_ALPHA     :
     case GL_LUMINANCE :
     case GL_LUMINANCE_ALPHA :
-    case GL_DEPTH_COMPONENT16:
-    case GL_DEPTH_COMPONENT24_OES:
-    case GL_DEPTH_COMPONENT32_OES:
     case GL_STENCIL_INDEX8:
     case GL_STENCIL_INDEX4_OES:
     case GL_RGB:
     case GL_RGBA:
     case GL_RGB8_OES  :
     case GL_BGRA8_EXT :
+    case GL_ETC1_RGB8_OES:
     case GL_RGBA8_OES :                     return GL_UNSIGNED_BYTE;
+    case GL_DEPTH_COMPONENT16:              return GL_UNSIGNED_SHORT;
+    case GL_DEPTH_COMPONENT24_OES:
+    case GL_DEPTH_COMPONENT32_OES:          return GL_UNSIGNED_INT;
     case GL_DEPTH24_STENCIL8_OES:           return GL_UNSIGNED_INT_24_8_OES;
+    case GL_ALPHA16F_EXT:
+    case GL_LUMINANCE16F_EXT:
+    case GL_LUMINANCE_ALPHA16F_EXT:
+    case GL_RGB16F_EXT:
+    case GL_RGBA16F_EXT:                    return GL_HALF_FLOAT_OES;
     default: NOT_FOUND_ENUM(internalformat);return GL_INVALID_VALUE;
     }
 }
@@ -171,14 +189,20 @@ GlInternalFormatToGlFormat(GLenum internalFormat)
     FUN_ENTRY(GL_LOG_DEBUG);
 
     switch(internalFormat) {
+    case GL_ALPHA16F_EXT:
     case GL_ALPHA:                            return GL_ALPHA;
+    case GL_LUMINANCE16F_EXT:
     case GL_LUMINANCE:                        return GL_LUMINANCE;
+    case GL_LUMINANCE_ALPHA16F_EXT:
     case GL_LUMINANCE_ALPHA:                  return GL_LUMINANCE_ALPHA;
     case GL_RGB:
     case GL_RGB565:
+    case GL_RGB16F_EXT:
+    case GL_ETC1_RGB8_OES:
     case GL_RGB8_OES:                         return GL_RGB;
     case GL_BGRA8_EXT:                        return GL_BGRA8_EXT;
     case GL_RGBA:
+    case GL_RGBA16F_EXT:
     case GL_RGBA8_OES:
     case GL_RGBA4:
     case GL_RGB5_A1:                          return GL_RGBA;
@@ -239,11 +263,38 @@ GlInternalFormatTypeToNumElements(GLenum internalFormat, GLenum type)
         case GL_RGB:                               return 1;
         default: { NOT_FOUND_ENUM(internalFormat); return 1; }
         }
+    case GL_UNSIGNED_SHORT:
+        switch(internalFormat) {
+        case GL_DEPTH_COMPONENT:
+        case GL_DEPTH_COMPONENT16:                 return 1;
+        default: { NOT_FOUND_ENUM(internalFormat); return 1; }
+        }
+    case GL_UNSIGNED_INT:
+        switch(internalFormat) {
+        case GL_DEPTH_COMPONENT:
+        case GL_DEPTH_COMPONENT24_OES:
+        case GL_DEPTH_COMPONENT32_OES:             return 1;
+        default: { NOT_FOUND_ENUM(internalFormat); return 1; }
+        }
     case GL_UNSIGNED_INT_24_8_OES:
         switch(internalFormat) {
         case GL_DEPTH24_STENCIL8_OES:              return 1;
         default: { NOT_FOUND_ENUM(internalFormat); return 1; }
         }
+    case GL_HALF_FLOAT_OES:
+        switch(internalFormat) {
+        case GL_ALPHA16F_EXT:
+        case GL_ALPHA:
+        case GL_LUMINANCE16F_EXT:
+        case GL_LUMINANCE:                         return 1;
+        case GL_LUMINANCE_ALPHA16F_EXT:
+        case GL_LUMINANCE_ALPHA:                   return 2;
+        case GL_RGB16F_EXT:
+        case GL_RGB:                               return 3;
+        case GL_RGBA16F_EXT:
+        case GL_RGBA:                              return 4;
+        default: { NOT_FOUND_ENUM(internalFormat); return 1; }
+        }
     default: { NOT_FOUND_ENUM(type);               return 1; }
     }
 }
@@ -260,6 +311,7 @@ GlAttribTypeToElementSize(GLenum type)
         case GL_UNSIGNED_SHORT:                 return sizeof(GLushort);
         case GL_FIXED:                          return sizeof(GLfixed);
         case GL_FLOAT:                          return sizeof(GLfloat);
+        case GL_HALF_FLOAT_OES:                 return sizeof(GLushort);
         default: { NOT_FOUND_ENUM(type);        return sizeof(GLubyte); }
     }
 }
@@ -273,7 +325,10 @@ GlTypeToElementSize(GLenum type)
         case GL_UNSIGNED_BYTE:                  return sizeof(GLubyte);
         case GL_UNSIGNED_SHORT_4_4_4_4:
         case GL_UNSIGNED_SHORT_5_5_5_1:
-        case GL_UNSIGNED_SHORT_5_6_5:           return sizeof(GLushort);
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT_OES:                 return sizeof(GLushort);
+        case GL_UNSIGNED_INT:
         case GL_UNSIGNED_INT_24_8_OES:          return sizeof(GLuint);
         default: { NOT_FOUND_ENUM(type);        return sizeof(GLubyte); }
     }
@@ -336,6 +391,24 @@ GlFormatToStorageBits(GLenum format, GLint *r_, GLint *g_, GLint *b_, GLint *a_,
         s = 0;
         break;
 
+    case GL_RGB16F_EXT:
+        r = 16;
+        g = 16;
+        b = 16;
+        a = 0;
+        d = 0;
+        s = 0;
+        break;
+
+    case GL_RGBA16F_EXT:
+        r = 16;
+        g = 16;
+        b = 16;
+        a = 16;
+        d = 0;
+        s = 0;
+        break;
+
     case GL_DEPTH_COMPONENT16:
         r = 0;
         g = 0;
@@ -460,6 +533,24 @@ GlFormatToStorageBits(GLenum format, GLfloat *r_, GLfloat *g_, GLfloat *b_, GLfl
         s = 0.0f;
         break;
 
+    case GL_RGB16F_EXT:
+        r = 16.0f;
+        g = 16.0f;
+        b = 16.0f;
+        a = 0.0f;
+        d = 0.0f;
+        s = 0.0f;
+        break;
+
+    case GL_RGBA16F_EXT:
+        r = 16.0f;
+        g = 16.0f;
+        b = 16.0f;
+        a = 16.0f;
+        d = 0.0f;
+        s = 0.0f;
+        break;
+
     case GL_DEPTH_COMPONENT16:
         r = 0.0f;
         g = 0.0f;
@@ -582,6 +673,24 @@ GlFormatToStorageBits(GLenum format, GLboolean *r_, GLboolean *g_, GLboolean *b_
         s = GL_FALSE;
         break;
 
+    case GL_RGB16F_EXT:
+        r = GL_TRUE;
+        g = GL_TRUE;
+        b = GL_TRUE;
+        a = GL_FALSE;
+        d = GL_FALSE;
+        s = GL_FALSE;
+        break;
+
+    case GL_RGBA16F_EXT:
+        r = GL_TRUE;
+        g = GL_TRUE;
+        b = GL_TRUE;
+        a = GL_TRUE;
+        d = GL_FALSE;
+        s = GL_FALSE;
+        break;
+
     case GL_DEPTH_COMPONENT16:
         r = GL_FALSE;
         g = GL_FALSE;
@@ -685,7 +794,9 @@ GlFormatIsColorRenderable(GLenum format)
     case GL_RGBA8_OES:
     case GL_RGB565:
     case GL_RGBA4:
-    case GL_RGB5_A1:                    return true;
+    case GL_RGB5_A1:
+    case GL_RGB16F_EXT:
+    case GL_RGBA16F_EXT:                return true;
     default:                            return false;
     }
 }
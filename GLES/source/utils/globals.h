@@ -72,6 +72,7 @@
 
 #define GLOVE_NUM_SHADER_BINARY_FORMATS                 0
 #define GLOVE_NUM_PROGRAM_BINARY_FORMATS                1
+#define GLOVE_NUM_COMPRESSED_TEXTURE_FORMATS            1
 
 /// Global switches
 #define GLOVE_SAVE_SHADER_SOURCES_TO_FILES              false
@@ -90,6 +91,10 @@
 
 #define GLOVE_INVALID_OFFSET                            UINT32_MAX
 
+#define GLOVE_INDIRECT_BUFFER_SIZE                      16384 // initial size in bytes of the streamed indirect draw commands
+
+#define GLOVE_MAX_VERTEX_INPUT_LAYOUTS                  256   // vertex input layouts cached per context
+
 #define GLOVE_VULKAN_DEPTH_RANGE                        vulkan_DepthRange
 
 #endif // __GLOBALS_H__
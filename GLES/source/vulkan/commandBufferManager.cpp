@@ -32,6 +32,7 @@
  */
 
 #include "commandBufferManager.h"
+#include "queueTracker.h"
 
 namespace vulkanAPI {
 
@@ -46,10 +47,12 @@ CommandBufferManager::CommandBufferManager(const vkContext_t *context)
 
     mActiveCmdBuffer    = 0;
     mLastSubmittedBuffer= GLOVE_NO_BUFFER_TO_WAIT;
+    mWaitPreviousSubmissions = false;
+    mTracked            = false;
+    mTrackedEpoch       = 0;
 
     mVkCmdPool          = VK_NULL_HANDLE;
     mVkAuxCommandBuffer = VK_NULL_HANDLE;
-    mVkAuxFence         = VK_NULL_HANDLE;
 
     if(!AllocateVkCmdPool()) {
         assert(false);
@@ -61,6 +64,7 @@ CommandBufferManager::CommandBufferManager(const vkContext_t *context)
         return ;
     }
 
+    mVkContext->vkQueueTracker->AddClient();
 }
 
 CommandBufferManager::~CommandBufferManager()
@@ -71,7 +75,13 @@ CommandBufferManager::~CommandBufferManager()
 
     if(mVkContext->vkDevice != VK_NULL_HANDLE ) {
 
-        vkDeviceWaitIdle(mVkContext->vkDevice);
+        {
+            std::lock_guard<std::mutex> lock(mVkContext->vkQueueMutex);
+            vkDeviceWaitIdle(mVkContext->vkDevice);
+        }
+
+        EndTracking();
+        mVkContext->vkQueueTracker->RemoveClient();
 
         DestroyVkCmdBuffers();
 
@@ -101,6 +111,7 @@ CommandBufferManager::DestroyVkCmdBuffers(void)
         vkFreeCommandBuffers(mVkContext->vkDevice, mVkCmdPool, 1, &mVkAuxCommandBuffer);
         mVkAuxCommandBuffer = VK_NULL_HANDLE;
     }
+    mVkAuxFence.Release();
 
     uint32_t secondaryBuffersPoolSize = mSecondaryCmdBufferPool.GetSize();
 
@@ -158,6 +169,39 @@ CommandBufferManager::FreeResources(void)
     mSecondaryCmdBufferPool.UnbindAllBuffers();
 }
 
+void
+CommandBufferManager::BeginTracking(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(!mTracked) {
+        mTrackedEpoch = mVkContext->vkQueueTracker->BeginRecording();
+        mTracked      = true;
+    }
+}
+
+void
+CommandBufferManager::EndTracking(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(mTracked) {
+        mVkContext->vkQueueTracker->EndRecording(mTrackedEpoch);
+        mTracked = false;
+    }
+}
+
+uint64_t
+CommandBufferManager::GetUseEpoch(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // the objects used by the commands that are about to be recorded stay in use until these are submitted
+    BeginTracking();
+
+    return mVkContext->vkQueueTracker->GetEpoch();
+}
+
 bool
 CommandBufferManager::AllocateVkCmdPool(void)
 {
@@ -211,6 +255,11 @@ CommandBufferManager::AllocateVkCmdBuffers(void)
         return false;
     }
 
+    mVkAuxFence.SetContext(mVkContext);
+    if(!mVkAuxFence.Create(false)) {
+        return false;
+    }
+
     for(uint32_t i = 0; i < GLOVE_NUM_COMMAND_BUFFERS; ++i) {
         mVkCommandBuffers.commandBufferState[i] = CMD_BUFFER_INITIAL_STATE;
 
@@ -228,6 +277,8 @@ CommandBufferManager::BeginVkDrawCommandBuffer(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    BeginTracking();
+
     if(mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] == CMD_BUFFER_RECORDING_STATE) {
         return true;
     }
@@ -247,6 +298,21 @@ CommandBufferManager::BeginVkDrawCommandBuffer(void)
 
     mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] = CMD_BUFFER_RECORDING_STATE;
 
+    // The first synchronization scope of a barrier covers all the commands submitted earlier to the queue
+    if(mWaitPreviousSubmissions) {
+        VkMemoryBarrier memoryBarrier;
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext         = nullptr;
+        memoryBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+        vkCmdPipelineBarrier(mVkCommandBuffers.commandBuffer[mActiveCmdBuffer],
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+        mWaitPreviousSubmissions = false;
+    }
+
     return true;
 }
 
@@ -305,22 +371,23 @@ CommandBufferManager::EndVkSecondaryCommandBuffer(const VkCommandBuffer *cmdBuff
 }
 
 bool
-CommandBufferManager::SubmitVkDrawCommandBuffer(void)
+CommandBufferManager::SubmitVkDrawCommandBuffer(vkSyncItems_t *vkSyncItems)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     if(mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] == CMD_BUFFER_INITIAL_STATE) {
+        EndTracking();
         return true;
     }
 
     vector<VkSemaphore> pSems;
     vector<VkPipelineStageFlags> pFlags;
-    if(mVkContext->vkSyncItems->acquireSemaphoreFlag) {
-        pSems.push_back(mVkContext->vkSyncItems->vkAcquireSemaphore);
+    if(vkSyncItems && vkSyncItems->acquireSemaphoreFlag) {
+        pSems.push_back(vkSyncItems->vkAcquireSemaphore);
         pFlags.push_back(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
     }
-    if(mVkContext->vkSyncItems->drawSemaphoreFlag) {
-        pSems.push_back(mVkContext->vkSyncItems->vkDrawSemaphore);
+    if(vkSyncItems && vkSyncItems->drawSemaphoreFlag) {
+        pSems.push_back(vkSyncItems->vkDrawSemaphore);
         pFlags.push_back(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
     }
 
@@ -332,13 +399,24 @@ CommandBufferManager::SubmitVkDrawCommandBuffer(void)
     submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(pSems.size());
     submitInfo.pWaitSemaphores      = pSems.data();
     submitInfo.pWaitDstStageMask    = pFlags.data();
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores    = &mVkContext->vkSyncItems->vkDrawSemaphore;
-
-    mVkContext->vkSyncItems->drawSemaphoreFlag    = true;
-    mVkContext->vkSyncItems->acquireSemaphoreFlag = false;
+    // the last submission before a present signals the semaphore of the presented image, which the presentation
+    // waits on, instead of the draw semaphore, so that no separate submission is needed to hand the frame over
+    bool present = vkSyncItems && vkSyncItems->presentPending && vkSyncItems->vkPresentSemaphore != VK_NULL_HANDLE;
+    submitInfo.signalSemaphoreCount = vkSyncItems ? 1 : 0;
+    submitInfo.pSignalSemaphores    = vkSyncItems ? (present ? &vkSyncItems->vkPresentSemaphore : &vkSyncItems->vkDrawSemaphore) : nullptr;
+
+    if(vkSyncItems) {
+        vkSyncItems->drawSemaphoreFlag    = !present;
+        vkSyncItems->presentSemaphoreFlag = present;
+        vkSyncItems->presentPending       = false;
+        vkSyncItems->acquireSemaphoreFlag = false;
+    }
 
-    VkResult err = vkQueueSubmit(mVkContext->vkQueue, 1, &submitInfo, mVkCommandBuffers.fence[mActiveCmdBuffer].GetFence());
+    VkResult err;
+    {
+        std::lock_guard<std::mutex> lock(mVkContext->vkQueueMutex);
+        err = vkQueueSubmit(mVkContext->vkQueue, 1, &submitInfo, mVkCommandBuffers.fence[mActiveCmdBuffer].GetFence());
+    }
     assert(!err);
 
     if(err != VK_SUCCESS) {
@@ -346,6 +424,7 @@ CommandBufferManager::SubmitVkDrawCommandBuffer(void)
     }
 
     mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] = CMD_BUFFER_SUBMITED_STATE;
+    EndTracking();
 
     mLastSubmittedBuffer = mActiveCmdBuffer;
 
@@ -356,6 +435,22 @@ CommandBufferManager::SubmitVkDrawCommandBuffer(void)
     return true;
 }
 
+bool
+CommandBufferManager::SubmitVkFence(VkFence fence)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // An empty submission signals the fence once all the work submitted so far to the queue has completed
+    VkResult err;
+    {
+        std::lock_guard<std::mutex> lock(mVkContext->vkQueueMutex);
+        err = vkQueueSubmit(mVkContext->vkQueue, 0, nullptr, fence);
+    }
+    assert(!err);
+
+    return err == VK_SUCCESS;
+}
+
 bool
 CommandBufferManager::WaitLastSubmition(void)
 {
@@ -371,6 +466,7 @@ CommandBufferManager::WaitLastSubmition(void)
         }
 
         FreeResources();
+        mVkContext->vkQueueTracker->LastSubmissionCompleted();
 
         mLastSubmittedBuffer = GLOVE_NO_BUFFER_TO_WAIT;
         return true;
@@ -418,7 +514,11 @@ CommandBufferManager::SubmitVkAuxCommandBuffer(void)
     info.commandBufferCount     = 1;
     info.pCommandBuffers        = &mVkAuxCommandBuffer;
 
-    VkResult err = vkQueueSubmit(mVkContext->vkQueue, 1, &info, mVkAuxFence);
+    VkResult err;
+    {
+        std::lock_guard<std::mutex> lock(mVkContext->vkQueueMutex);
+        err = vkQueueSubmit(mVkContext->vkQueue, 1, &info, mVkAuxFence.GetFence());
+    }
     assert(!err);
 
     return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY && err != VK_ERROR_DEVICE_LOST);
@@ -429,10 +529,13 @@ CommandBufferManager::WaitVkAuxCommandBuffer(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkResult err = vkQueueWaitIdle(mVkContext->vkQueue);
-    assert(!err);
+    // the fence also covers the submissions that precede the auxiliary one in the queue,
+    // so waiting on it needs neither the queue lock nor the queue to go idle
+    if(!mVkAuxFence.Wait(VK_TRUE, GLOVE_FENCE_WAIT_TIMEOUT)) {
+        return false;
+    }
 
-    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY && err != VK_ERROR_DEVICE_LOST);
+    return mVkAuxFence.Reset();
 }
 
 }
@@ -55,14 +55,21 @@ private:
 
     uint32_t                        mActiveCmdBuffer;
     int32_t                         mLastSubmittedBuffer;
+    bool                            mWaitPreviousSubmissions;
+
+    // set while the queue tracker waits for the submission of the commands being recorded
+    bool                            mTracked;
+    uint64_t                        mTrackedEpoch;
 
     State                           mVkCommandBuffers;
 
     VkCommandBuffer                 mVkAuxCommandBuffer;
-    VkFence                         mVkAuxFence;
+    Fence                           mVkAuxFence;
     CommandBufferPool               mSecondaryCmdBufferPool;
 
     void FreeResources(void);
+    void BeginTracking(void);
+    void EndTracking(void);
 
 public:
 // Constructor
@@ -93,14 +100,17 @@ public:
     void EndVkSecondaryCommandBuffer(const VkCommandBuffer *cmdBuffer);
 
 // Submit Functions
-    bool SubmitVkDrawCommandBuffer(void);
+    bool SubmitVkDrawCommandBuffer(vkSyncItems_t *vkSyncItems);
     bool SubmitVkAuxCommandBuffer(void);
+    bool SubmitVkFence(VkFence fence);
 
 // Wait Functions
     bool WaitLastSubmition(void);
     bool WaitVkAuxCommandBuffer(void);
+    inline void WaitPreviousSubmissions(void)                                   { FUN_ENTRY(GL_LOG_TRACE); mWaitPreviousSubmissions = true; }
 
 // Get Functions
+    uint64_t GetUseEpoch(void);
     inline VkCommandBuffer GetActiveCommandBuffer(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mVkCommandBuffers.commandBuffer[mActiveCmdBuffer]; }
     inline VkCommandBuffer GetAuxCommandBuffer(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mVkAuxCommandBuffer; }
 };
@@ -27,35 +27,56 @@
  *
  */
 
+#include <cstdlib>
 #include "context.h"
+#include "samplerCache.h"
+#include "queueTracker.h"
 
 namespace vulkanAPI {
 
 #define GLOVE_VK_VALIDATION_LAYERS                      false
+// forces ETC1 textures through the RGBA8 decode path, e.g. to compare it against native ETC2 sampling
+#define GLOVE_ETC1_DECODE_ENV                           "GLOVE_ETC1_DECODE"
 
+// WSI extensions are only needed by window surfaces, headless drivers can still render into pbuffers
 #ifdef VK_USE_PLATFORM_XCB_KHR
-static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
+static const std::vector<const char*> wsiInstanceExtensions     = {VK_KHR_SURFACE_EXTENSION_NAME,
                                                                     VK_KHR_XCB_SURFACE_EXTENSION_NAME};
 #elif defined (VK_USE_PLATFORM_WAYLAND_KHR)
-static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
+static const std::vector<const char*> wsiInstanceExtensions     = {VK_KHR_SURFACE_EXTENSION_NAME,
                                                                     VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME};
 #elif defined (VK_USE_PLATFORM_ANDROID_KHR)
-static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
+static const std::vector<const char*> wsiInstanceExtensions     = {VK_KHR_SURFACE_EXTENSION_NAME,
                                                                     VK_KHR_ANDROID_SURFACE_EXTENSION_NAME};
 #elif defined (VK_USE_PLATFORM_MACOS_MVK)
-static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
+static const std::vector<const char*> wsiInstanceExtensions     = {VK_KHR_SURFACE_EXTENSION_NAME,
                                                                     VK_MVK_MACOS_SURFACE_EXTENSION_NAME};
 #elif defined (VK_USE_PLATFORM_WIN32_KHR)
-static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
+static const std::vector<const char*> wsiInstanceExtensions     = {VK_KHR_SURFACE_EXTENSION_NAME,
                                                                     VK_KHR_WIN32_SURFACE_EXTENSION_NAME};
 #else // native
-static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
+static const std::vector<const char*> wsiInstanceExtensions     = {VK_KHR_SURFACE_EXTENSION_NAME,
                                                                     VK_KHR_DISPLAY_EXTENSION_NAME};
 #endif
 
-static const std::vector<const char*> requiredDeviceExtensions   = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+static const std::vector<const char*> wsiDeviceExtensions        = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
-static const std::vector<const char*> usefulDeviceExtensions     = {"VK_KHR_maintenance1"};
+static const std::vector<const char*> usefulInstanceExtensions   = {"VK_KHR_get_physical_device_properties2"};
+
+static const std::vector<const char*> usefulDeviceExtensions     = {"VK_KHR_maintenance1",
+                                                                    "VK_KHR_descriptor_update_template",
+                                                                    "VK_KHR_push_descriptor",
+                                                                    "VK_EXT_vertex_attribute_divisor",
+                                                                    "VK_KHR_incremental_present",
+                                                                    "VK_GOOGLE_display_timing"};
+
+static std::vector<const char*> enabledUsefulInstanceExtensions;
+static std::vector<const char*> enabledUsefulDeviceExtensions;
+
+#define GET_DEVICE_FUNCTION_PTR(callbackstr, entrypoint)                                                  \
+{                                                                                                        \
+    callbackstr.fp##entrypoint = (PFN_vk##entrypoint) vkGetDeviceProcAddr(GloveVkContext.vkDevice, "vk"#entrypoint); \
+}
 
 static       char **enabledInstanceLayers           = nullptr;
 
@@ -68,8 +89,12 @@ bool CreateVkInstance(void);
 bool EnumerateVkGpus(void);
 bool InitVkQueueFamilyIndex(void);
 bool CreateVkDevice(void);
+void InitVkDeviceFeatures(VkPhysicalDeviceFeatures *enabledFeatures);
+#ifdef VK_EXT_vertex_attribute_divisor
+void InitVkVertexAttributeDivisor(VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT *divisorFeatures);
+#endif
+void InitVkExtCallbacks(void);
 bool CreateVkCommandPool(void);
-bool CreateVkSemaphores(void);
 void InitVkQueue(void);
 
 bool
@@ -138,11 +163,23 @@ CheckVkInstanceExtensions(void)
         res = vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, vkExtensionProperties);
     } while(res == VK_INCOMPLETE);
 
-    std::vector<bool> requiredExtensionsAvailable(requiredInstanceExtensions.size(), false);
+    std::vector<bool> wsiExtensionsAvailable(wsiInstanceExtensions.size(), false);
+    for(uint32_t i = 0; i < extensionCount; ++i) {
+        for(uint32_t j = 0; j < wsiInstanceExtensions.size(); ++j) {
+            if(!strcmp(wsiInstanceExtensions[j], vkExtensionProperties[i].extensionName)) {
+                wsiExtensionsAvailable[j] = true;
+                break;
+            }
+        }
+    }
+
+    enabledUsefulInstanceExtensions.clear();
+    GetContext()->mIsPhysicalDeviceProperties2ExtSupported = false;
     for(uint32_t i = 0; i < extensionCount; ++i) {
-        for(uint32_t j = 0; j < requiredInstanceExtensions.size(); ++j) {
-            if(!strcmp(requiredInstanceExtensions[j], vkExtensionProperties[i].extensionName)) {
-                requiredExtensionsAvailable[j] = true;
+        for(uint32_t j = 0; j < usefulInstanceExtensions.size(); ++j) {
+            if(!strcmp(usefulInstanceExtensions[j], vkExtensionProperties[i].extensionName)) {
+                enabledUsefulInstanceExtensions.push_back(usefulInstanceExtensions[j]);
+                GetContext()->mIsPhysicalDeviceProperties2ExtSupported = true;
                 break;
             }
         }
@@ -153,9 +190,10 @@ CheckVkInstanceExtensions(void)
         vkExtensionProperties = nullptr;
     }
 
-    for(uint32_t j = 0; j < requiredInstanceExtensions.size(); ++j) {
-        if(!requiredExtensionsAvailable[j]) {
-            return false;
+    GetContext()->mIsWSIExtSupported = true;
+    for(uint32_t j = 0; j < wsiInstanceExtensions.size(); ++j) {
+        if(!wsiExtensionsAvailable[j]) {
+            GetContext()->mIsWSIExtSupported = false;
         }
     }
 
@@ -186,21 +224,56 @@ CheckVkDeviceExtensions(void)
         res = vkEnumerateDeviceExtensionProperties(GloveVkContext.vkGpus[0], nullptr, &extensionCount, vkExtensionProperties);
     } while(res == VK_INCOMPLETE);
 
-    std::vector<bool> requiredExtensionsAvailable(requiredDeviceExtensions.size(), false);
+    std::vector<bool> wsiExtensionsAvailable(wsiDeviceExtensions.size(), false);
     for(uint32_t i = 0; i < extensionCount; ++i) {
-        for(uint32_t j = 0; j < requiredDeviceExtensions.size(); ++j) {
-            if(!strcmp(requiredDeviceExtensions[j], vkExtensionProperties[i].extensionName)) {
-                requiredExtensionsAvailable[j] = true;
+        for(uint32_t j = 0; j < wsiDeviceExtensions.size(); ++j) {
+            if(!strcmp(wsiDeviceExtensions[j], vkExtensionProperties[i].extensionName)) {
+                wsiExtensionsAvailable[j] = true;
                 break;
             }
         }
     }
 
-    GetContext()->mIsMaintenanceExtSupported = false;
+    enabledUsefulDeviceExtensions.clear();
+    GetContext()->mIsMaintenanceExtSupported             = false;
+    GetContext()->mIsDescriptorUpdateTemplateExtSupported = false;
+    GetContext()->mIsPushDescriptorExtSupported          = false;
+    GetContext()->mIsVertexAttributeDivisorExtSupported  = false;
+    GetContext()->mIsIncrementalPresentExtSupported      = false;
+    GetContext()->mIsDisplayTimingExtSupported           = false;
     for(uint32_t i = 0; i < extensionCount; ++i) {
         for(uint32_t j = 0; j < usefulDeviceExtensions.size(); ++j) {
             if(!strcmp(usefulDeviceExtensions[j], vkExtensionProperties[i].extensionName)) {
-                GetContext()->mIsMaintenanceExtSupported = true;
+                if(!strcmp(usefulDeviceExtensions[j], "VK_KHR_maintenance1")) {
+                    GetContext()->mIsMaintenanceExtSupported = true;
+                } else if(!strcmp(usefulDeviceExtensions[j], "VK_KHR_descriptor_update_template")) {
+                    GetContext()->mIsDescriptorUpdateTemplateExtSupported = true;
+                } else if(!strcmp(usefulDeviceExtensions[j], "VK_KHR_push_descriptor")) {
+                    // VK_KHR_push_descriptor depends on VK_KHR_get_physical_device_properties2
+                    if(!GetContext()->mIsPhysicalDeviceProperties2ExtSupported) {
+                        break;
+                    }
+                    GetContext()->mIsPushDescriptorExtSupported = true;
+                } else if(!strcmp(usefulDeviceExtensions[j], "VK_EXT_vertex_attribute_divisor")) {
+                    // its features are queried through VK_KHR_get_physical_device_properties2
+                    if(!GetContext()->mIsPhysicalDeviceProperties2ExtSupported) {
+                        break;
+                    }
+                    GetContext()->mIsVertexAttributeDivisorExtSupported = true;
+                } else if(!strcmp(usefulDeviceExtensions[j], "VK_KHR_incremental_present")) {
+                    // VK_KHR_incremental_present extends the presentation of VK_KHR_swapchain
+                    if(!GetContext()->mIsWSIExtSupported || !wsiExtensionsAvailable[0]) {
+                        break;
+                    }
+                    GetContext()->mIsIncrementalPresentExtSupported = true;
+                } else if(!strcmp(usefulDeviceExtensions[j], "VK_GOOGLE_display_timing")) {
+                    // VK_GOOGLE_display_timing reports the refresh cycle of the display of a swapchain
+                    if(!GetContext()->mIsWSIExtSupported || !wsiExtensionsAvailable[0]) {
+                        break;
+                    }
+                    GetContext()->mIsDisplayTimingExtSupported = true;
+                }
+                enabledUsefulDeviceExtensions.push_back(usefulDeviceExtensions[j]);
                 break;
             }
         }
@@ -211,11 +284,10 @@ CheckVkDeviceExtensions(void)
         vkExtensionProperties = nullptr;
     }
 
-    for(uint32_t j = 0; j < requiredDeviceExtensions.size(); ++j) {
-        if(!requiredExtensionsAvailable[j]) {
-            printf("\n%s extension is mandatory for GLOVE\n", requiredDeviceExtensions[j]);
-            printf("Please link GLOVE to a Vulkan driver which supports the latter\n");
-            return false;
+    for(uint32_t j = 0; j < wsiDeviceExtensions.size(); ++j) {
+        if(!wsiExtensionsAvailable[j] && GetContext()->mIsWSIExtSupported) {
+            printf("\n%s extension is not supported, only pbuffer surfaces are available\n", wsiDeviceExtensions[j]);
+            GetContext()->mIsWSIExtSupported = false;
         }
     }
 
@@ -243,6 +315,12 @@ CreateVkInstance(void)
     applicationInfo.engineVersion     = 1;
     applicationInfo.apiVersion        = VK_API_VERSION_1_0;
 
+    std::vector<const char*> enabledExtensions;
+    if(GloveVkContext.mIsWSIExtSupported) {
+        enabledExtensions.insert(enabledExtensions.end(), wsiInstanceExtensions.begin(), wsiInstanceExtensions.end());
+    }
+    enabledExtensions.insert(enabledExtensions.end(), enabledUsefulInstanceExtensions.begin(), enabledUsefulInstanceExtensions.end());
+
     VkInstanceCreateInfo instanceInfo;
     memset(static_cast<void *>(&instanceInfo), 0 ,sizeof(instanceInfo));
     instanceInfo.sType                    = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -251,8 +329,8 @@ CreateVkInstance(void)
     instanceInfo.pApplicationInfo         = &applicationInfo;
     instanceInfo.enabledLayerCount        = enabledLayerCount;
     instanceInfo.ppEnabledLayerNames      = enabledInstanceLayers;
-    instanceInfo.enabledExtensionCount    = static_cast<uint32_t>(requiredInstanceExtensions.size());
-    instanceInfo.ppEnabledExtensionNames  = requiredInstanceExtensions.data();
+    instanceInfo.enabledExtensionCount    = static_cast<uint32_t>(enabledExtensions.size());
+    instanceInfo.ppEnabledExtensionNames  = enabledExtensions.data();
 
     VkResult err = vkCreateInstance(&instanceInfo, nullptr, &GloveVkContext.vkInstance);
     assert(!err);
@@ -335,11 +413,11 @@ CreateVkDevice(void)
     queueInfo.pQueuePriorities = queue_priorities;
     queueInfo.queueFamilyIndex = GloveVkContext.vkGraphicsQueueNodeIndex;
 
-    std::vector<const char*> enabledExtensions(requiredDeviceExtensions);
-
-    if(true == GetContext()->mIsMaintenanceExtSupported) {
-        enabledExtensions.insert(enabledExtensions.end(), usefulDeviceExtensions.begin(), usefulDeviceExtensions.end());
+    std::vector<const char*> enabledExtensions;
+    if(GloveVkContext.mIsWSIExtSupported) {
+        enabledExtensions.insert(enabledExtensions.end(), wsiDeviceExtensions.begin(), wsiDeviceExtensions.end());
     }
+    enabledExtensions.insert(enabledExtensions.end(), enabledUsefulDeviceExtensions.begin(), enabledUsefulDeviceExtensions.end());
 
     VkDeviceCreateInfo deviceInfo;
     deviceInfo.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -351,7 +429,20 @@ CreateVkDevice(void)
     deviceInfo.ppEnabledLayerNames     = nullptr;
     deviceInfo.enabledExtensionCount   = enabledExtensions.size();
     deviceInfo.ppEnabledExtensionNames = enabledExtensions.data();
-    deviceInfo.pEnabledFeatures        = nullptr;
+
+    VkPhysicalDeviceFeatures enabledFeatures;
+    InitVkDeviceFeatures(&enabledFeatures);
+    deviceInfo.pEnabledFeatures        = &enabledFeatures;
+
+#ifdef VK_EXT_vertex_attribute_divisor
+    VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT divisorFeatures;
+    InitVkVertexAttributeDivisor(&divisorFeatures);
+    if(GloveVkContext.mIsVertexAttributeDivisorExtSupported) {
+        deviceInfo.pNext = &divisorFeatures;
+    }
+#else
+    GloveVkContext.mIsVertexAttributeDivisorExtSupported = false;
+#endif
 
     VkResult err = vkCreateDevice(GloveVkContext.vkGpus[0], &deviceInfo, nullptr, &GloveVkContext.vkDevice);
     assert(!err);
@@ -359,38 +450,167 @@ CreateVkDevice(void)
     return (err == VK_SUCCESS);
 }
 
-bool
-CreateVkSemaphores(void)
+void
+InitVkDeviceFeatures(VkPhysicalDeviceFeatures *enabledFeatures)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkResult err;
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(GloveVkContext.vkGpus[0], &supportedFeatures);
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(GloveVkContext.vkGpus[0], &deviceProperties);
+
+    // only the features that GLOVE makes use of are enabled
+    memset(static_cast<void *>(enabledFeatures), 0, sizeof(*enabledFeatures));
+    enabledFeatures->multiDrawIndirect      = supportedFeatures.multiDrawIndirect;
+    enabledFeatures->textureCompressionETC2 = supportedFeatures.textureCompressionETC2;
+
+    GloveVkContext.mIsMultiDrawIndirectSupported      = supportedFeatures.multiDrawIndirect == VK_TRUE;
+    GloveVkContext.vkMaxDrawIndirectCount             = GloveVkContext.mIsMultiDrawIndirectSupported ? deviceProperties.limits.maxDrawIndirectCount : 1;
+    GloveVkContext.mIsTextureCompressionETC2Supported = supportedFeatures.textureCompressionETC2 == VK_TRUE &&
+                                                        getenv(GLOVE_ETC1_DECODE_ENV) == nullptr;
+
+    // 3-component 16-bit formats are optional for vertex buffers
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(GloveVkContext.vkGpus[0], VK_FORMAT_R16G16B16_SFLOAT, &formatProperties);
+    GloveVkContext.mIsVertexFormatRGB16FSupported     = (formatProperties.bufferFeatures & VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT) != 0;
+}
+
+#ifdef VK_EXT_vertex_attribute_divisor
+void
+InitVkVertexAttributeDivisor(VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT *divisorFeatures)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    GloveVkContext.vkMaxVertexAttribDivisor = 1;
+
+    if(!GloveVkContext.mIsVertexAttributeDivisorExtSupported) {
+        return;
+    }
 
-    GloveVkContext.vkSyncItems = new vkSyncItems_t;
+    PFN_vkGetPhysicalDeviceFeatures2KHR   fpGetPhysicalDeviceFeatures2KHR   = (PFN_vkGetPhysicalDeviceFeatures2KHR)
+                                                                              vkGetInstanceProcAddr(GloveVkContext.vkInstance, "vkGetPhysicalDeviceFeatures2KHR");
+    PFN_vkGetPhysicalDeviceProperties2KHR fpGetPhysicalDeviceProperties2KHR = (PFN_vkGetPhysicalDeviceProperties2KHR)
+                                                                              vkGetInstanceProcAddr(GloveVkContext.vkInstance, "vkGetPhysicalDeviceProperties2KHR");
+    if(!fpGetPhysicalDeviceFeatures2KHR || !fpGetPhysicalDeviceProperties2KHR) {
+        GloveVkContext.mIsVertexAttributeDivisorExtSupported = false;
+        return;
+    }
+
+    memset(static_cast<void *>(divisorFeatures), 0, sizeof(*divisorFeatures));
+    divisorFeatures->sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VERTEX_ATTRIBUTE_DIVISOR_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2KHR deviceFeatures;
+    memset(static_cast<void *>(&deviceFeatures), 0, sizeof(deviceFeatures));
+    deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+    deviceFeatures.pNext = divisorFeatures;
+    fpGetPhysicalDeviceFeatures2KHR(GloveVkContext.vkGpus[0], &deviceFeatures);
+
+    VkPhysicalDeviceVertexAttributeDivisorPropertiesEXT divisorProperties;
+    memset(static_cast<void *>(&divisorProperties), 0, sizeof(divisorProperties));
+    divisorProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VERTEX_ATTRIBUTE_DIVISOR_PROPERTIES_EXT;
+
+    VkPhysicalDeviceProperties2KHR deviceProperties;
+    memset(static_cast<void *>(&deviceProperties), 0, sizeof(deviceProperties));
+    deviceProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+    deviceProperties.pNext = &divisorProperties;
+    fpGetPhysicalDeviceProperties2KHR(GloveVkContext.vkGpus[0], &deviceProperties);
+
+    // only the divisor feature is requested when the device is created
+    divisorFeatures->vertexAttributeInstanceRateZeroDivisor = VK_FALSE;
+    if(divisorFeatures->vertexAttributeInstanceRateDivisor == VK_TRUE && divisorProperties.maxVertexAttribDivisor > 1) {
+        GloveVkContext.vkMaxVertexAttribDivisor = divisorProperties.maxVertexAttribDivisor;
+    } else {
+        GloveVkContext.mIsVertexAttributeDivisorExtSupported = false;
+    }
+}
+#endif
+
+void
+InitVkExtCallbacks(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    memset(static_cast<void*>(&GloveVkContext.vkExtCallbacks), 0, sizeof(vkExtCallbacks_t));
+
+    if(GloveVkContext.mIsDescriptorUpdateTemplateExtSupported) {
+        // VK_KHR_descriptor_update_template functions
+        GET_DEVICE_FUNCTION_PTR(GloveVkContext.vkExtCallbacks, CreateDescriptorUpdateTemplateKHR);
+        GET_DEVICE_FUNCTION_PTR(GloveVkContext.vkExtCallbacks, DestroyDescriptorUpdateTemplateKHR);
+        GET_DEVICE_FUNCTION_PTR(GloveVkContext.vkExtCallbacks, UpdateDescriptorSetWithTemplateKHR);
+
+        GloveVkContext.mIsDescriptorUpdateTemplateExtSupported = GloveVkContext.vkExtCallbacks.fpCreateDescriptorUpdateTemplateKHR  != nullptr &&
+                                                                 GloveVkContext.vkExtCallbacks.fpDestroyDescriptorUpdateTemplateKHR != nullptr &&
+                                                                 GloveVkContext.vkExtCallbacks.fpUpdateDescriptorSetWithTemplateKHR != nullptr;
+    }
+
+    // vkCmdPushDescriptorSetWithTemplateKHR is only exposed when both extensions are present
+    if(GloveVkContext.mIsPushDescriptorExtSupported && GloveVkContext.mIsDescriptorUpdateTemplateExtSupported) {
+        // VK_KHR_push_descriptor functions
+        GET_DEVICE_FUNCTION_PTR(GloveVkContext.vkExtCallbacks, CmdPushDescriptorSetWithTemplateKHR);
+    }
+
+    GloveVkContext.mIsPushDescriptorExtSupported = GloveVkContext.vkExtCallbacks.fpCmdPushDescriptorSetWithTemplateKHR != nullptr;
+}
+
+vkSyncItems_t *
+CreateVkSyncItems(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
 
     VkSemaphoreCreateInfo semaphoreCreateInfo;
     semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
     semaphoreCreateInfo.pNext = nullptr;
     semaphoreCreateInfo.flags = 0;
 
-    err = vkCreateSemaphore(GloveVkContext.vkDevice, &semaphoreCreateInfo, nullptr, &GloveVkContext.vkSyncItems->vkDrawSemaphore);
+    VkSemaphore drawSemaphore = VK_NULL_HANDLE;
+    VkResult err = vkCreateSemaphore(GloveVkContext.vkDevice, &semaphoreCreateInfo, nullptr, &drawSemaphore);
     assert(!err);
 
     if(err != VK_SUCCESS) {
-        return false;
+        return nullptr;
     }
 
-    err = vkCreateSemaphore(GloveVkContext.vkDevice, &semaphoreCreateInfo, nullptr, &GloveVkContext.vkSyncItems->vkAcquireSemaphore);
-    assert(!err);
+    // the acquire semaphore belongs to the swapchain image acquired last, it is set by EGL
+    vkSyncItems_t *vkSyncItems        = new vkSyncItems_t;
+    vkSyncItems->vkDrawSemaphore      = drawSemaphore;
+    vkSyncItems->drawSemaphoreFlag    = false;
+    vkSyncItems->vkAcquireSemaphore   = VK_NULL_HANDLE;
+    vkSyncItems->acquireSemaphoreFlag = false;
+    vkSyncItems->vkPresentSemaphore   = VK_NULL_HANDLE;
+    vkSyncItems->presentSemaphoreFlag = false;
+    vkSyncItems->presentPending       = false;
+
+    return vkSyncItems;
+}
 
-    if(err != VK_SUCCESS) {
-        return false;
+void
+DestroyVkSyncItems(vkSyncItems_t *vkSyncItems)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(vkSyncItems == nullptr) {
+        return;
     }
 
-    GloveVkContext.vkSyncItems->acquireSemaphoreFlag = true;
-    GloveVkContext.vkSyncItems->drawSemaphoreFlag = false;
+    // the draw semaphore may still be signaled by a pending submission, an empty batch
+    // signals the fence once it has completed and the wait is done outside the queue lock
+    Fence fence(&GloveVkContext);
+    VkResult err = VK_ERROR_INITIALIZATION_FAILED;
+    if(fence.Create(false)) {
+        std::lock_guard<std::mutex> lock(GloveVkContext.vkQueueMutex);
+        err = vkQueueSubmit(GloveVkContext.vkQueue, 0, nullptr, fence.GetFence());
+    }
+    assert(!err);
 
-    return true;
+    if(err != VK_SUCCESS || !fence.Wait(VK_TRUE, UINT64_MAX)) {
+        std::lock_guard<std::mutex> lock(GloveVkContext.vkQueueMutex);
+        vkDeviceWaitIdle(GloveVkContext.vkDevice);
+    }
+
+    vkDestroySemaphore(GloveVkContext.vkDevice, vkSyncItems->vkDrawSemaphore, nullptr);
+    delete vkSyncItems;
 }
 
 void
@@ -420,11 +640,26 @@ ResetContextResources()
     GloveVkContext.vkQueue                      = VK_NULL_HANDLE;
     GloveVkContext.vkGraphicsQueueNodeIndex     = 0;
     GloveVkContext.vkDevice                     = VK_NULL_HANDLE;
-    GloveVkContext.vkSyncItems                  = nullptr;
+    GloveVkContext.vkSamplerCache               = nullptr;
+    GloveVkContext.vkQueueTracker               = nullptr;
+    GloveVkContext.mIsWSIExtSupported           = false;
     GloveVkContext.mIsMaintenanceExtSupported   = false;
+    GloveVkContext.mIsPhysicalDeviceProperties2ExtSupported = false;
+    GloveVkContext.mIsDescriptorUpdateTemplateExtSupported  = false;
+    GloveVkContext.mIsPushDescriptorExtSupported            = false;
+    GloveVkContext.mIsVertexAttributeDivisorExtSupported    = false;
+    GloveVkContext.mIsIncrementalPresentExtSupported        = false;
+    GloveVkContext.mIsDisplayTimingExtSupported             = false;
+    GloveVkContext.vkMaxVertexAttribDivisor                 = 1;
+    GloveVkContext.mIsMultiDrawIndirectSupported            = false;
+    GloveVkContext.vkMaxDrawIndirectCount                   = 1;
+    GloveVkContext.mIsTextureCompressionETC2Supported       = false;
+    GloveVkContext.mIsVertexFormatRGB16FSupported           = false;
     GloveVkContext.mInitialized                 = false;
     memset(static_cast<void*>(&GloveVkContext.vkDeviceMemoryProperties), 0,
            sizeof(VkPhysicalDeviceMemoryProperties));
+    memset(static_cast<void*>(&GloveVkContext.vkExtCallbacks), 0,
+           sizeof(vkExtCallbacks_t));
 }
 
 bool
@@ -443,13 +678,16 @@ InitContext()
         !EnumerateVkGpus()            ||
         !InitVkQueueFamilyIndex()     ||
         !CheckVkDeviceExtensions()    ||
-        !CreateVkDevice()             ||
-        !CreateVkSemaphores()
+        !CreateVkDevice()
       ) {
         assert(false);
         return false;
     }
     InitVkQueue();
+    InitVkExtCallbacks();
+
+    GloveVkContext.vkSamplerCache = new SamplerCache(&GloveVkContext);
+    GloveVkContext.vkQueueTracker = new QueueTracker(&GloveVkContext);
 
     GloveVkContext.mInitialized = true;
 
@@ -465,24 +703,17 @@ TerminateContext()
         return;
     }
 
-    if(GloveVkContext.vkSyncItems->vkAcquireSemaphore != VK_NULL_HANDLE) {
-        vkDestroySemaphore(GloveVkContext.vkDevice, GloveVkContext.vkSyncItems->vkAcquireSemaphore, nullptr);
-        GloveVkContext.vkSyncItems->vkAcquireSemaphore = VK_NULL_HANDLE;
-    }
-
-    if(GloveVkContext.vkSyncItems->vkDrawSemaphore != VK_NULL_HANDLE) {
-        vkDestroySemaphore(GloveVkContext.vkDevice, GloveVkContext.vkSyncItems->vkDrawSemaphore, nullptr);
-        GloveVkContext.vkSyncItems->vkDrawSemaphore = VK_NULL_HANDLE;
-    }
-
     if(GloveVkContext.vkDevice != VK_NULL_HANDLE ) {
-        vkDeviceWaitIdle(GloveVkContext.vkDevice);
+        {
+            std::lock_guard<std::mutex> lock(GloveVkContext.vkQueueMutex);
+            vkDeviceWaitIdle(GloveVkContext.vkDevice);
+        }
+        SafeDelete(GloveVkContext.vkSamplerCache);
+        SafeDelete(GloveVkContext.vkQueueTracker);
         vkDestroyDevice(GloveVkContext.vkDevice, nullptr);
         vkDestroyInstance(GloveVkContext.vkInstance, nullptr);
     }
 
-    SafeDelete(GloveVkContext.vkSyncItems);
-
     ResetContextResources();
 }
 
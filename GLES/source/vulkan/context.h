@@ -25,6 +25,7 @@
 #define __VKCONTEXT_H__
 
 #include <map>
+#include <mutex>
 #include <vector>
 #include "utils/glLogger.h"
 #include "vulkan/vulkan.h"
@@ -34,6 +35,18 @@ using namespace std;
 
 namespace vulkanAPI {
 
+    class SamplerCache;
+    class QueueTracker;
+
+    typedef struct vkExtCallbacks_t {
+        // VK_KHR_descriptor_update_template functions
+        PFN_vkCreateDescriptorUpdateTemplateKHR             fpCreateDescriptorUpdateTemplateKHR;
+        PFN_vkDestroyDescriptorUpdateTemplateKHR            fpDestroyDescriptorUpdateTemplateKHR;
+        PFN_vkUpdateDescriptorSetWithTemplateKHR            fpUpdateDescriptorSetWithTemplateKHR;
+        // VK_KHR_push_descriptor functions
+        PFN_vkCmdPushDescriptorSetWithTemplateKHR           fpCmdPushDescriptorSetWithTemplateKHR;
+    } vkExtCallbacks_t;
+
     typedef struct vkContext_t {
         vkContext_t() {
             vkInstance            = VK_NULL_HANDLE;
@@ -41,11 +54,26 @@ namespace vulkanAPI {
             mInitialized          = false;
             vkGraphicsQueueNodeIndex = 0;
             vkDevice = VK_NULL_HANDLE;
-            vkSyncItems             = nullptr;
+            vkSamplerCache          = nullptr;
+            vkQueueTracker          = nullptr;
+            mIsWSIExtSupported         = false;
             mIsMaintenanceExtSupported = false;
+            mIsPhysicalDeviceProperties2ExtSupported = false;
+            mIsDescriptorUpdateTemplateExtSupported  = false;
+            mIsPushDescriptorExtSupported            = false;
+            mIsVertexAttributeDivisorExtSupported    = false;
+            mIsIncrementalPresentExtSupported        = false;
+            mIsDisplayTimingExtSupported             = false;
+            vkMaxVertexAttribDivisor                 = 1;
+            mIsMultiDrawIndirectSupported            = false;
+            vkMaxDrawIndirectCount                   = 1;
+            mIsTextureCompressionETC2Supported       = false;
+            mIsVertexFormatRGB16FSupported           = false;
             mInitialized            = false;
             memset(static_cast<void*>(&vkDeviceMemoryProperties), 0,
                    sizeof(VkPhysicalDeviceMemoryProperties));
+            memset(static_cast<void*>(&vkExtCallbacks), 0,
+                   sizeof(vkExtCallbacks_t));
         }
 
         VkInstance                                          vkInstance;
@@ -53,9 +81,25 @@ namespace vulkanAPI {
         VkQueue                                             vkQueue;
         uint32_t                                            vkGraphicsQueueNodeIndex;
         VkDevice                                            vkDevice;
+        // guards vkQueue, which is shared by the contexts of all rendering threads and EGL
+        mutable std::mutex                                  vkQueueMutex;
         VkPhysicalDeviceMemoryProperties                    vkDeviceMemoryProperties;
-        vkSyncItems_t                                       *vkSyncItems;
+        SamplerCache                                        *vkSamplerCache;
+        QueueTracker                                        *vkQueueTracker;
+        vkExtCallbacks_t                                    vkExtCallbacks;
+        bool                                                mIsWSIExtSupported;
         bool                                                mIsMaintenanceExtSupported;
+        bool                                                mIsPhysicalDeviceProperties2ExtSupported;
+        bool                                                mIsDescriptorUpdateTemplateExtSupported;
+        bool                                                mIsPushDescriptorExtSupported;
+        bool                                                mIsVertexAttributeDivisorExtSupported;
+        bool                                                mIsIncrementalPresentExtSupported;
+        bool                                                mIsDisplayTimingExtSupported;
+        uint32_t                                            vkMaxVertexAttribDivisor;
+        bool                                                mIsMultiDrawIndirectSupported;
+        uint32_t                                            vkMaxDrawIndirectCount;
+        bool                                                mIsTextureCompressionETC2Supported;
+        bool                                                mIsVertexFormatRGB16FSupported;
         bool                                                mInitialized;
     } vkContext_t;
 
@@ -63,6 +107,8 @@ namespace vulkanAPI {
     bool                              InitContext();
     void                              TerminateContext();
     void                              ClearContextResources();
+    vkSyncItems_t *                   CreateVkSyncItems();
+    void                              DestroyVkSyncItems(vkSyncItems_t *vkSyncItems);
 
     template<typename T>  inline void SafeDelete(T*& ptr)                       { FUN_ENTRY(GL_LOG_TRACE); delete ptr; ptr = nullptr; }
 };
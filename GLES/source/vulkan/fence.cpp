@@ -81,6 +81,14 @@ Fence::Wait(VkBool32 waitAll, uint64_t timeout)
     return true;
 }
 
+bool
+Fence::IsSignaled(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return vkGetFenceStatus(mVkContext->vkDevice, mVkFence) == VK_SUCCESS;
+}
+
 bool
 Fence::Create(bool signaled)
 {
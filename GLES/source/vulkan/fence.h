@@ -56,6 +56,9 @@ public:
 // Wait Functions
     bool                              Wait(VkBool32  waitAll, uint64_t timeout);
 
+// Is Functions
+    bool                              IsSignaled(void)                    const;
+
 // Get Functions
     inline VkFence                    GetFence(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mVkFence; }
 
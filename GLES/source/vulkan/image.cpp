@@ -181,6 +181,34 @@ Image::CopyImageToBuffer(VkCommandBuffer *activeCmdBuffer, VkBuffer srcBuffer)
     vkCmdCopyImageToBuffer(*activeCmdBuffer, mVkImage, mVkImageLayout, srcBuffer, 1, &mVkBufferImageCopy);
 }
 
+void
+Image::CopyImageInvertedY(VkCommandBuffer *activeCmdBuffer, VkImage srcImage, VkImageLayout srcImageLayout)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // one region per row, as image copies cannot mirror
+    vector<VkImageCopy> regions(mHeight);
+    for(uint32_t row = 0; row < mHeight; ++row) {
+        VkImageCopy &region = regions[row];
+        region.srcSubresource.aspectMask     = mVkImageSubresourceRange.aspectMask;
+        region.srcSubresource.mipLevel       = 0;
+        region.srcSubresource.baseArrayLayer = 0;
+        region.srcSubresource.layerCount     = 1;
+        region.srcOffset.x                   = 0;
+        region.srcOffset.y                   = static_cast<int32_t>(row);
+        region.srcOffset.z                   = 0;
+        region.dstSubresource                = region.srcSubresource;
+        region.dstOffset.x                   = 0;
+        region.dstOffset.y                   = static_cast<int32_t>(mHeight - 1 - row);
+        region.dstOffset.z                   = 0;
+        region.extent.width                  = mWidth;
+        region.extent.height                 = 1;
+        region.extent.depth                  = 1;
+    }
+
+    vkCmdCopyImage(*activeCmdBuffer, srcImage, srcImageLayout, mVkImage, mVkImageLayout, static_cast<uint32_t>(regions.size()), regions.data());
+}
+
 void
 Image::BlitImage(VkCommandBuffer *activeCmdBuffer, VkImageLayout srcImageLayout, VkImage dstImage, VkImageLayout dstImageLayout, const VkImageBlit* imageBlit, VkFilter imageFilter)
 {
@@ -384,6 +412,11 @@ Image::FindSupportedVkColorFormat(VkFormat format)
         if(formatDeviceProps.linearTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT) {
             return format;
         }
+        // e.g. half-float formats are commonly renderable with optimal tiling only
+        if(formatDeviceProps.optimalTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT) {
+            mVkImageTiling = VK_IMAGE_TILING_OPTIMAL;
+            return format;
+        }
         break;
 
     default:
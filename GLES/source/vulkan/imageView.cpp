@@ -63,6 +63,9 @@ ImageView::Create(vulkanAPI::Image *image)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    // sampled depth is returned as luminance (OES_depth_texture)
+    bool sampledDepth = VkFormatIsDepth(image->GetFormat()) && (image->GetImageUsage() & VK_IMAGE_USAGE_SAMPLED_BIT);
+
     VkImageViewCreateInfo info;
     info.sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     info.pNext            = nullptr;
@@ -71,10 +74,13 @@ ImageView::Create(vulkanAPI::Image *image)
     info.image            = image->GetImage();
     info.format           = image->GetFormat();
     info.components.r     = VK_COMPONENT_SWIZZLE_R;
-    info.components.g     = VK_COMPONENT_SWIZZLE_G;
-    info.components.b     = VK_COMPONENT_SWIZZLE_B;
+    info.components.g     = sampledDepth ? VK_COMPONENT_SWIZZLE_R : VK_COMPONENT_SWIZZLE_G;
+    info.components.b     = sampledDepth ? VK_COMPONENT_SWIZZLE_R : VK_COMPONENT_SWIZZLE_B;
     info.components.a     = VK_COMPONENT_SWIZZLE_A;
     info.subresourceRange = image->GetImageSubresourceRange();
+    if(sampledDepth) {
+        info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
 
     VkResult err = vkCreateImageView(mVkContext->vkDevice, &info, nullptr, &mVkImageView);
     assert(!err);
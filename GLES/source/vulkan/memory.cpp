@@ -33,7 +33,8 @@
 namespace vulkanAPI {
 
 Memory::Memory(const vkContext_t *vkContext, VkFlags flags)
-: mVkContext(vkContext), mVkMemory (VK_NULL_HANDLE), mVkMemoryFlags(0), mVkFlags(flags)
+: mVkContext(vkContext), mVkMemory (VK_NULL_HANDLE), mVkMemoryFlags(0), mVkFlags(flags),
+mVkMemoryPropertyFlags(0), mMappedData(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -50,29 +51,80 @@ Memory::Release(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    Unmap();
+
     if(mVkMemory != VK_NULL_HANDLE) {
         vkFreeMemory(mVkContext->vkDevice, mVkMemory, nullptr);
         mVkMemory = VK_NULL_HANDLE;
     }
 }
 
-bool
-Memory::GetData(VkDeviceSize size, VkDeviceSize offset, void *data) const
+uint8_t *
+Memory::Map(void) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    void *pData;
-    VkResult err = vkMapMemory(mVkContext->vkDevice, mVkMemory, offset, size, mVkMemoryFlags, &pData);
-    assert(!err);
+    // host visible memory stays mapped until it is released, so that reads,
+    // writes and glMapBuffer do not pay a vkMapMemory/vkUnmapMemory pair each
+    if(mMappedData == nullptr) {
+        void *pData = nullptr;
+        VkResult err = vkMapMemory(mVkContext->vkDevice, mVkMemory, 0, VK_WHOLE_SIZE, mVkMemoryFlags, &pData);
+        assert(!err);
+
+        if(err == VK_SUCCESS) {
+            mMappedData = static_cast<uint8_t *>(pData);
+        }
+    }
 
-    if(err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY && err != VK_ERROR_MEMORY_MAP_FAILED)
-    {
-        memcpy(data, pData, size);
+    return mMappedData;
+}
+
+void
+Memory::Unmap(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mMappedData != nullptr) {
         vkUnmapMemory(mVkContext->vkDevice, mVkMemory);
+        mMappedData = nullptr;
+    }
+}
+
+bool
+Memory::FlushMappedData(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
 
+    if(mMappedData == nullptr || (mVkMemoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
         return true;
     }
-    return false;
+
+    VkMappedMemoryRange range;
+    range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.pNext  = nullptr;
+    range.memory = mVkMemory;
+    range.offset = 0;
+    range.size   = VK_WHOLE_SIZE;
+
+    VkResult err = vkFlushMappedMemoryRanges(mVkContext->vkDevice, 1, &range);
+    assert(!err);
+
+    return (err == VK_SUCCESS);
+}
+
+bool
+Memory::GetData(VkDeviceSize size, VkDeviceSize offset, void *data) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    uint8_t *pData = Map();
+    if(pData == nullptr) {
+        return false;
+    }
+
+    memcpy(data, pData + offset, size);
+
+    return true;
 }
 
 void
@@ -88,20 +140,18 @@ Memory::SetData(VkDeviceSize size, VkDeviceSize offset, const void *data)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    void *pData = nullptr;
-
-    VkResult err = vkMapMemory(mVkContext->vkDevice, mVkMemory, offset, size ? size : mVkRequirements.size, mVkMemoryFlags, &pData);
-    assert(!err);
+    uint8_t *pData = Map();
+    if(pData == nullptr) {
+        return false;
+    }
 
     if(data) {
-        memcpy(pData, data, size);
+        memcpy(pData + offset, data, size);
     } else {
-        memset(pData, 0x0, size);
+        memset(pData + offset, 0x0, size);
     }
 
-    vkUnmapMemory(mVkContext->vkDevice, mVkMemory);
-
-    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
+    return FlushMappedData();
 }
 
 bool
@@ -137,6 +187,7 @@ Memory::GetMemoryTypeIndexFromProperties(uint32_t *typeIndex)
             // Type is available, does it match user properties?
             if ((mVkContext->vkDeviceMemoryProperties.memoryTypes[i].propertyFlags & mVkFlags) == mVkFlags) {
                 *typeIndex = i;
+                mVkMemoryPropertyFlags = mVkContext->vkDeviceMemoryProperties.memoryTypes[i].propertyFlags;
                 return VK_SUCCESS;
             }
         }
@@ -151,6 +202,7 @@ Memory::GetMemoryTypeIndexFromProperties(uint32_t *typeIndex)
             // Type is available, does it match user properties?
             if ((mVkContext->vkDeviceMemoryProperties.memoryTypes[i].propertyFlags & 0) == 0) {
                 *typeIndex = i;
+                mVkMemoryPropertyFlags = mVkContext->vkDeviceMemoryProperties.memoryTypes[i].propertyFlags;
                 return VK_SUCCESS;
             }
         }
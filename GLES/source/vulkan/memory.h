@@ -42,6 +42,9 @@ private:
     VkMemoryMapFlags                  mVkMemoryFlags;
     VkFlags                           mVkFlags;
     VkMemoryRequirements              mVkRequirements;
+    VkMemoryPropertyFlags             mVkMemoryPropertyFlags;
+    mutable
+    uint8_t *                         mMappedData;
 
 public:
 // Constructor
@@ -56,6 +59,11 @@ public:
 // Release Functions
     void                              Release(void);
 
+// Map Functions
+    uint8_t *                         Map(void)                                           const;
+    void                              Unmap(void);
+    bool                              FlushMappedData(void);
+
 // Bind Functions
     bool                              BindBufferMemory(VkBuffer &buffer);
     bool                              BindImageMemory(VkImage &image);
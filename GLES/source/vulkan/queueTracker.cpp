@@ -0,0 +1,209 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       queueTracker.cpp
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Tracks the completion of the work of all contexts on the shared queue
+ *
+ *  @scope
+ *
+ *  All contexts submit to the same VkQueue, so an object that is used by one
+ *  context may be released by another one, while the first still has work
+ *  pending for it. Instead of each context waiting on its own submissions,
+ *  objects are stamped with a queue wide epoch when they are used or released,
+ *  and they are known to be idle once that epoch has completed.
+ *
+ *  An epoch is submitted once every command buffer that was being recorded at
+ *  that epoch has been submitted. It is completed once a fence, submitted to
+ *  the queue after it with an empty batch, has signaled. A single such fence
+ *  is in flight at any time. When only one context exists, its wait on its
+ *  last submission completes all the epochs submitted so far.
+ *
+ */
+
+#include "queueTracker.h"
+
+namespace vulkanAPI {
+
+QueueTracker::QueueTracker(const vkContext_t *vkContext)
+: mVkContext(vkContext), mEpoch(1), mCompletedEpoch(0), mClientCount(0),
+  mFence(vkContext), mFenceSubmitted(false), mFenceEpoch(0)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+QueueTracker::~QueueTracker()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(mFenceSubmitted) {
+        mFence.Wait(VK_TRUE, UINT64_MAX);
+    }
+}
+
+void
+QueueTracker::AddClient(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    ++mClientCount;
+}
+
+void
+QueueTracker::RemoveClient(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    assert(mClientCount > 0);
+    --mClientCount;
+}
+
+uint64_t
+QueueTracker::BeginRecording(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    uint64_t epoch = mEpoch;
+    mRecordingEpochs.insert(epoch);
+
+    return epoch;
+}
+
+void
+QueueTracker::EndRecording(uint64_t recordingEpoch)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mRecordingEpochs.find(recordingEpoch);
+    if(it != mRecordingEpochs.end()) {
+        mRecordingEpochs.erase(it);
+    }
+}
+
+void
+QueueTracker::LastSubmissionCompleted(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // the work of other contexts may still be pending
+    if(mClientCount != 1) {
+        return;
+    }
+
+    uint64_t epoch = GetSubmittedEpoch();
+    if(epoch > mCompletedEpoch) {
+        mCompletedEpoch = epoch;
+        if(epoch == mEpoch) {
+            ++mEpoch;
+        }
+    }
+}
+
+uint64_t
+QueueTracker::GetSubmittedEpoch(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return mRecordingEpochs.empty() ? mEpoch.load() : *mRecordingEpochs.begin() - 1;
+}
+
+void
+QueueTracker::UpdateFence(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(mFenceSubmitted && mFence.IsSignaled()) {
+        if(mFenceEpoch > mCompletedEpoch) {
+            mCompletedEpoch = mFenceEpoch;
+        }
+        mFenceSubmitted = false;
+    }
+}
+
+void
+QueueTracker::SubmitFence(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    uint64_t epoch = GetSubmittedEpoch();
+    if(mFenceSubmitted || epoch <= mCompletedEpoch) {
+        return;
+    }
+
+    if(mFence.GetFence() == VK_NULL_HANDLE) {
+        if(!mFence.Create(false)) {
+            return;
+        }
+    } else if(!mFence.Reset()) {
+        return;
+    }
+
+    // An empty submission signals the fence once all the work submitted so far to the queue has completed
+    VkResult err;
+    {
+        std::lock_guard<std::mutex> lock(mVkContext->vkQueueMutex);
+        err = vkQueueSubmit(mVkContext->vkQueue, 0, nullptr, mFence.GetFence());
+    }
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        return;
+    }
+
+    mFenceSubmitted = true;
+    mFenceEpoch     = epoch;
+
+    // objects used or released from now on are stamped after the fence
+    if(epoch == mEpoch) {
+        ++mEpoch;
+    }
+}
+
+bool
+QueueTracker::IsCompleted(uint64_t epoch)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(epoch <= mCompletedEpoch) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    UpdateFence();
+    if(epoch <= mCompletedEpoch) {
+        return true;
+    }
+
+    if(epoch <= GetSubmittedEpoch()) {
+        SubmitFence();
+    }
+
+    return false;
+}
+
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       queueTracker.h
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Tracks the completion of the work of all contexts on the shared queue
+ *
+ */
+
+#ifndef __VKQUEUETRACKER_H__
+#define __VKQUEUETRACKER_H__
+
+#include <atomic>
+#include <set>
+#include "context.h"
+#include "fence.h"
+
+namespace vulkanAPI {
+
+class QueueTracker {
+
+private:
+    const
+    vkContext_t *                     mVkContext;
+
+    std::mutex                        mMutex;
+
+    std::atomic<uint64_t>             mEpoch;
+    std::atomic<uint64_t>             mCompletedEpoch;
+
+    /// The epochs at which the command buffers that are being recorded were started
+    std::multiset<uint64_t>           mRecordingEpochs;
+    uint32_t                          mClientCount;
+
+    Fence                             mFence;
+    bool                              mFenceSubmitted;
+    uint64_t                          mFenceEpoch;
+
+    uint64_t                          GetSubmittedEpoch(void)           const;
+    void                              UpdateFence(void);
+    void                              SubmitFence(void);
+
+public:
+// Constructor
+    QueueTracker(const vkContext_t *vkContext = nullptr);
+
+// Destructor
+    ~QueueTracker();
+
+// Client Functions
+    void                              AddClient(void);
+    void                              RemoveClient(void);
+
+// Recording Functions
+    uint64_t                          BeginRecording(void);
+    void                              EndRecording(uint64_t recordingEpoch);
+    void                              LastSubmissionCompleted(void);
+
+// Get Functions
+    /// An object used by recorded work, or released by it, is no longer in use once the current epoch has completed
+    inline uint64_t                   GetEpoch(void)                    const   { FUN_ENTRY(GL_LOG_TRACE); return mEpoch; }
+
+// Is Functions
+    bool                              IsCompleted(uint64_t epoch);
+};
+
+}
+
+#endif // __VKQUEUETRACKER_H__
@@ -37,7 +37,7 @@ RenderPass::RenderPass(const vkContext_t *vkContext)
 : mVkContext(vkContext),
   mVkPipelineBindPoint(VK_PIPELINE_BIND_POINT_GRAPHICS),
   mVkRenderPass(VK_NULL_HANDLE),
-  mColorClearEnabled(false), mDepthClearEnabled(false), mStencilClearEnabled(false),
+  mColorClearEnabled(false), mDepthClearEnabled(false), mStencilClearEnabled(false), mColorLoadEnabled(false),
   mColorWriteEnabled(true), mDepthWriteEnabled(true), mStencilWriteEnabled(false),
   mStarted(false)
 {
@@ -82,7 +82,11 @@ RenderPass::Create(VkFormat colorFormat, VkFormat depthstencilFormat)
         attachmentColor.flags           = 0;
         attachmentColor.format          = colorFormat;
         attachmentColor.samples         = VK_SAMPLE_COUNT_1_BIT;
-        attachmentColor.loadOp          = (mColorClearEnabled && mColorWriteEnabled) ? VK_ATTACHMENT_LOAD_OP_CLEAR  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        // color that is drawn over is loaded only when requested, i.e. for surfaces whose frames update a part of
+        // the previous contents (EGL_BUFFER_AGE_KHR, EGL_KHR_partial_update)
+        attachmentColor.loadOp          = !mColorWriteEnabled ? VK_ATTACHMENT_LOAD_OP_DONT_CARE :
+                                          (mColorClearEnabled ? VK_ATTACHMENT_LOAD_OP_CLEAR     :
+                                          (mColorLoadEnabled  ? VK_ATTACHMENT_LOAD_OP_LOAD      : VK_ATTACHMENT_LOAD_OP_DONT_CARE));
         attachmentColor.storeOp         = mColorWriteEnabled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
         attachmentColor.stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         attachmentColor.stencilStoreOp  = VK_ATTACHMENT_STORE_OP_DONT_CARE;
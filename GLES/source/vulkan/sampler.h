@@ -71,13 +71,13 @@ public:
 
 // Set Functions
     inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext      = vkContext;                  }
-    inline void                       SetMinFilter(VkFilter filter)             { FUN_ENTRY(GL_LOG_TRACE); mVkMinFilter    = filter; mUpdated = VK_TRUE; }
-    inline void                       SetMagFilter(VkFilter filter)             { FUN_ENTRY(GL_LOG_TRACE); mVkMagFilter    = filter; mUpdated = VK_TRUE; }
-    inline void                       SetAddressModeU(VkSamplerAddressMode mode){ FUN_ENTRY(GL_LOG_TRACE); mVkAddressModeU = mode;   mUpdated = VK_TRUE; }
-    inline void                       SetAddressModeV(VkSamplerAddressMode mode){ FUN_ENTRY(GL_LOG_TRACE); mVkAddressModeV = mode;   mUpdated = VK_TRUE; }
-    inline void                       SetAddressModeW(VkSamplerAddressMode mode){ FUN_ENTRY(GL_LOG_TRACE); mVkAddressModeW = mode;   mUpdated = VK_TRUE; }
-    inline void                       SetMipmapMode(VkSamplerMipmapMode mode)   { FUN_ENTRY(GL_LOG_TRACE); mVkMipmapMode   = mode;   mUpdated = VK_TRUE; }
-    inline void                       SetMaxLod(float lod)                      { FUN_ENTRY(GL_LOG_TRACE); mMaxLod         = lod;    mUpdated = VK_TRUE; }
+    inline void                       SetMinFilter(VkFilter filter)             { FUN_ENTRY(GL_LOG_TRACE); if(mVkMinFilter    != filter) { mVkMinFilter    = filter; mUpdated = VK_TRUE; } }
+    inline void                       SetMagFilter(VkFilter filter)             { FUN_ENTRY(GL_LOG_TRACE); if(mVkMagFilter    != filter) { mVkMagFilter    = filter; mUpdated = VK_TRUE; } }
+    inline void                       SetAddressModeU(VkSamplerAddressMode mode){ FUN_ENTRY(GL_LOG_TRACE); if(mVkAddressModeU != mode)   { mVkAddressModeU = mode;   mUpdated = VK_TRUE; } }
+    inline void                       SetAddressModeV(VkSamplerAddressMode mode){ FUN_ENTRY(GL_LOG_TRACE); if(mVkAddressModeV != mode)   { mVkAddressModeV = mode;   mUpdated = VK_TRUE; } }
+    inline void                       SetAddressModeW(VkSamplerAddressMode mode){ FUN_ENTRY(GL_LOG_TRACE); if(mVkAddressModeW != mode)   { mVkAddressModeW = mode;   mUpdated = VK_TRUE; } }
+    inline void                       SetMipmapMode(VkSamplerMipmapMode mode)   { FUN_ENTRY(GL_LOG_TRACE); if(mVkMipmapMode   != mode)   { mVkMipmapMode   = mode;   mUpdated = VK_TRUE; } }
+    inline void                       SetMaxLod(float lod)                      { FUN_ENTRY(GL_LOG_TRACE); if(mMaxLod         != lod)    { mMaxLod         = lod;    mUpdated = VK_TRUE; } }
 };
 
 }
@@ -0,0 +1,162 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       samplerCache.cpp
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Cache of VkSampler objects shared by all textures
+ *
+ *  @scope
+ *
+ *  Textures rarely use more than a handful of distinct filter/wrap/LOD
+ *  combinations, so a single VkSampler is created per distinct sampler state
+ *  and reference counted by the textures that use it. This keeps the number
+ *  of live samplers well below maxSamplerAllocationCount. Samplers that are
+ *  no longer referenced are kept around, as command buffers of any context
+ *  may still use them. CleanUpUnusedSamplers() destroys them once the queue
+ *  has completed the work up to their release.
+ *
+ */
+
+#include "samplerCache.h"
+#include "queueTracker.h"
+
+namespace vulkanAPI {
+
+SamplerCache::samplerKey_t::samplerKey_t(const VkSamplerCreateInfo *info)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    memset(static_cast<void *>(this), 0, sizeof(*this));
+
+    magFilter               = info->magFilter;
+    minFilter               = info->minFilter;
+    mipmapMode              = info->mipmapMode;
+    addressModeU            = info->addressModeU;
+    addressModeV            = info->addressModeV;
+    addressModeW            = info->addressModeW;
+    mipLodBias              = info->mipLodBias;
+    anisotropyEnable        = info->anisotropyEnable;
+    maxAnisotropy           = info->maxAnisotropy;
+    compareEnable           = info->compareEnable;
+    compareOp               = info->compareOp;
+    minLod                  = info->minLod;
+    maxLod                  = info->maxLod;
+    borderColor             = info->borderColor;
+    unnormalizedCoordinates = info->unnormalizedCoordinates;
+}
+
+SamplerCache::SamplerCache(const vkContext_t *vkContext)
+: mVkContext(vkContext)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+SamplerCache::~SamplerCache()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    Release();
+}
+
+VkSampler
+SamplerCache::AcquireSampler(const VkSamplerCreateInfo *samplerInfo)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const samplerKey_t key(samplerInfo);
+
+    auto it = mSamplers.find(key);
+    if(it != mSamplers.end()) {
+        ++it->second.refCount;
+        return it->second.sampler;
+    }
+
+    VkSampler sampler = VK_NULL_HANDLE;
+    VkResult err = vkCreateSampler(mVkContext->vkDevice, samplerInfo, nullptr, &sampler);
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    samplerEntry_t entry;
+    entry.sampler       = sampler;
+    entry.refCount      = 1;
+    entry.releasedEpoch = 0;
+
+    mSamplers.insert(std::make_pair(key, entry));
+    mSamplerKeys.insert(std::make_pair(sampler, key));
+
+    return sampler;
+}
+
+void
+SamplerCache::ReleaseSampler(VkSampler sampler)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto keyIt = mSamplerKeys.find(sampler);
+    if(keyIt == mSamplerKeys.end()) {
+        return;
+    }
+
+    auto it = mSamplers.find(keyIt->second);
+    assert(it != mSamplers.end() && it->second.refCount > 0);
+
+    if(--it->second.refCount == 0) {
+        it->second.releasedEpoch = mVkContext->vkQueueTracker->GetEpoch();
+    }
+}
+
+void
+SamplerCache::CleanUpUnusedSamplers(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for(auto it = mSamplers.begin(); it != mSamplers.end();) {
+        if(it->second.refCount == 0 && mVkContext->vkQueueTracker->IsCompleted(it->second.releasedEpoch)) {
+            vkDestroySampler(mVkContext->vkDevice, it->second.sampler, nullptr);
+            mSamplerKeys.erase(it->second.sampler);
+            it = mSamplers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void
+SamplerCache::Release(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for(auto it : mSamplers) {
+        vkDestroySampler(mVkContext->vkDevice, it.second.sampler, nullptr);
+    }
+
+    mSamplers.clear();
+    mSamplerKeys.clear();
+}
+
+}
@@ -0,0 +1,95 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       samplerCache.h
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Cache of VkSampler objects shared by all textures
+ *
+ */
+
+#ifndef __VKSAMPLERCACHE_H__
+#define __VKSAMPLERCACHE_H__
+
+#include "context.h"
+#include <mutex>
+
+namespace vulkanAPI {
+
+class SamplerCache {
+
+private:
+    typedef struct samplerKey_t {
+        VkFilter                      magFilter;
+        VkFilter                      minFilter;
+        VkSamplerMipmapMode           mipmapMode;
+        VkSamplerAddressMode          addressModeU;
+        VkSamplerAddressMode          addressModeV;
+        VkSamplerAddressMode          addressModeW;
+        float                         mipLodBias;
+        VkBool32                      anisotropyEnable;
+        float                         maxAnisotropy;
+        VkBool32                      compareEnable;
+        VkCompareOp                   compareOp;
+        float                         minLod;
+        float                         maxLod;
+        VkBorderColor                 borderColor;
+        VkBool32                      unnormalizedCoordinates;
+
+        samplerKey_t(const VkSamplerCreateInfo *info);
+        bool operator<(const samplerKey_t &other) const { return memcmp(this, &other, sizeof(samplerKey_t)) < 0; }
+    } samplerKey_t;
+
+    typedef struct samplerEntry_t {
+        VkSampler                     sampler;
+        uint32_t                      refCount;
+        uint64_t                      releasedEpoch;
+    } samplerEntry_t;
+
+    const
+    vkContext_t *                     mVkContext;
+
+    map<samplerKey_t, samplerEntry_t> mSamplers;
+    map<VkSampler, samplerKey_t>      mSamplerKeys;
+
+    // shared by the contexts of all rendering threads
+    std::mutex                        mMutex;
+
+public:
+// Constructor
+    SamplerCache(const vkContext_t *vkContext = nullptr);
+
+// Destructor
+    ~SamplerCache();
+
+// Acquire Functions
+    VkSampler                         AcquireSampler(const VkSamplerCreateInfo *samplerInfo);
+
+// Release Functions
+    void                              ReleaseSampler(VkSampler sampler);
+    void                              CleanUpUnusedSamplers(void);
+    void                              Release(void);
+
+// Get Functions
+    inline uint32_t                   GetSize(void)                     const   { FUN_ENTRY(GL_LOG_TRACE); return static_cast<uint32_t>(mSamplers.size()); }
+
+// Set Functions
+    inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; }
+};
+
+}
+
+#endif // __VKSAMPLERCACHE_H__
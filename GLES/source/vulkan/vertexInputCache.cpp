@@ -0,0 +1,183 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       vertexInputCache.cpp
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Cache of the vertex input layouts used by the draws of a context
+ *
+ *  @scope
+ *
+ *  A vertex input layout is the set of vertex input bindings (stride, input
+ *  rate, divisor) and attributes (location, binding, format, offset) that a
+ *  VkPipeline is created with. Layouts are interned by value, so two equal
+ *  layouts are always represented by the same object. Comparing layouts is
+ *  then a pointer comparison, and a VkPipeline only needs to be rebuilt when
+ *  the layout object of a draw differs from that of the previous one.
+ *
+ *  Each context has its own cache, so lookups need no locking. The cache
+ *  keeps the GLOVE_MAX_VERTEX_INPUT_LAYOUTS most recently used layouts.
+ *  Layouts are reference counted, since programs and vertex array objects
+ *  keep pointing to them, possibly from other contexts of a share group,
+ *  after they have been evicted.
+ *
+ */
+
+#include "vertexInputCache.h"
+
+namespace vulkanAPI {
+
+/// FNV-1a
+static inline uint64_t
+HashBytes(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for(size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+vertexInputLayout_t::vertexInputLayout_t()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    memset(static_cast<void *>(this), 0, sizeof(*this));
+}
+
+vertexInputLayout_t::vertexInputLayout_t(const vertexInputLayout_t &other)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    memcpy(static_cast<void *>(this), static_cast<const void *>(&other), sizeof(*this));
+    refCount = 0;
+}
+
+size_t
+vertexInputLayout_t::Hash(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    /// Only the used part of the layout is hashed
+    uint64_t hash = 14695981039346656037ULL;
+    hash = HashBytes(hash, &bindingCount,   sizeof(bindingCount));
+    hash = HashBytes(hash, &attributeCount, sizeof(attributeCount));
+    hash = HashBytes(hash, bindings,        bindingCount   * sizeof(VkVertexInputBindingDescription));
+    hash = HashBytes(hash, divisors,        bindingCount   * sizeof(uint32_t));
+    hash = HashBytes(hash, attributes,      attributeCount * sizeof(VkVertexInputAttributeDescription));
+
+    return static_cast<size_t>(hash);
+}
+
+bool
+vertexInputLayout_t::operator==(const vertexInputLayout_t &other) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return bindingCount   == other.bindingCount                                                                   &&
+           attributeCount == other.attributeCount                                                                 &&
+           !memcmp(bindings,   other.bindings,   bindingCount   * sizeof(VkVertexInputBindingDescription))        &&
+           !memcmp(divisors,   other.divisors,   bindingCount   * sizeof(uint32_t))                               &&
+           !memcmp(attributes, other.attributes, attributeCount * sizeof(VkVertexInputAttributeDescription));
+}
+
+VertexInputCache::VertexInputCache()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+VertexInputCache::~VertexInputCache()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    Release();
+}
+
+const vertexInputLayout_t *
+VertexInputCache::GetLayout(const vertexInputLayout_t *layout)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    const size_t hash = layout->Hash();
+
+    auto range = mLayouts.equal_range(hash);
+    for(auto it = range.first; it != range.second; ++it) {
+        if(*it->second->second == *layout) {
+            mLayoutList.splice(mLayoutList.begin(), mLayoutList, it->second);
+            return it->second->second;
+        }
+    }
+
+    vertexInputLayout_t *newLayout = new vertexInputLayout_t(*layout);
+    AcquireLayout(newLayout);
+    mLayoutList.push_front(std::make_pair(hash, newLayout));
+    mLayouts.insert(std::make_pair(hash, mLayoutList.begin()));
+
+    // the least recently used layout is dropped, its users keep their reference to it
+    if(mLayoutList.size() > GLOVE_MAX_VERTEX_INPUT_LAYOUTS) {
+        auto last = std::prev(mLayoutList.end());
+
+        range = mLayouts.equal_range(last->first);
+        for(auto it = range.first; it != range.second; ++it) {
+            if(it->second == last) {
+                mLayouts.erase(it);
+                break;
+            }
+        }
+
+        ReleaseLayout(last->second);
+        mLayoutList.erase(last);
+    }
+
+    return newLayout;
+}
+
+void
+VertexInputCache::Release(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(auto &entry : mLayoutList) {
+        ReleaseLayout(entry.second);
+    }
+
+    mLayoutList.clear();
+    mLayouts.clear();
+}
+
+void
+VertexInputCache::AcquireLayout(const vertexInputLayout_t *layout)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(layout) {
+        ++layout->refCount;
+    }
+}
+
+void
+VertexInputCache::ReleaseLayout(const vertexInputLayout_t *layout)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(layout && --layout->refCount == 0) {
+        delete layout;
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       vertexInputCache.h
+ *  @author     Think Silicon
+ *  @date       17/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Cache of the vertex input layouts used by the draws of a context
+ *
+ */
+
+#ifndef __VKVERTEXINPUTCACHE_H__
+#define __VKVERTEXINPUTCACHE_H__
+
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include "context.h"
+#include "utils/globals.h"
+
+namespace vulkanAPI {
+
+typedef struct vertexInputLayout_t {
+    uint32_t                          bindingCount;
+    uint32_t                          attributeCount;
+    VkVertexInputBindingDescription   bindings[GLOVE_MAX_VERTEX_ATTRIBS];
+    uint32_t                          divisors[GLOVE_MAX_VERTEX_ATTRIBS];
+    VkVertexInputAttributeDescription attributes[GLOVE_MAX_VERTEX_ATTRIBS];
+
+    // held by the caches, programs and vertex array objects that point to the layout
+    mutable std::atomic<uint32_t>     refCount;
+
+    vertexInputLayout_t();
+    vertexInputLayout_t(const vertexInputLayout_t &other);
+
+    size_t                            Hash(void)                                    const;
+    bool                              operator==(const vertexInputLayout_t &other)  const;
+} vertexInputLayout_t;
+
+class VertexInputCache {
+
+private:
+    typedef std::list<std::pair<size_t, const vertexInputLayout_t *>> layoutList_t;
+
+    /// Most recently used layouts first
+    layoutList_t                      mLayoutList;
+    unordered_multimap<size_t, layoutList_t::iterator> mLayouts;
+
+public:
+// Constructor
+    VertexInputCache();
+
+// Destructor
+    ~VertexInputCache();
+
+// Get Functions
+    const vertexInputLayout_t        *GetLayout(const vertexInputLayout_t *layout);
+    inline uint32_t                   GetSize(void)                     const   { FUN_ENTRY(GL_LOG_TRACE); return static_cast<uint32_t>(mLayouts.size()); }
+
+// Release Functions
+    void                              Release(void);
+
+// Reference Functions
+    static void                       AcquireLayout(const vertexInputLayout_t *layout);
+    static void                       ReleaseLayout(const vertexInputLayout_t *layout);
+};
+
+}
+
+#endif // __VKVERTEXINPUTCACHE_H__
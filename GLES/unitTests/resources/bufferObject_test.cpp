@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "bufferObject_test.h"
+
+#ifndef _WIN32
+// Orphaning allocates a new storage. These entry points are called by the library
+// through the Vulkan loader, so on ELF platforms the definitions of the test take
+// their place and hand out distinct handles without a device.
+static uint64_t handleCount = 0;
+
+VKAPI_ATTR VkResult VKAPI_CALL
+vkCreateBuffer(VkDevice device, const VkBufferCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkBuffer *pBuffer)
+{
+    *pBuffer = (VkBuffer)(++handleCount);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL
+vkDestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks *pAllocator)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL
+vkGetBufferMemoryRequirements(VkDevice device, VkBuffer buffer, VkMemoryRequirements *pMemoryRequirements)
+{
+    pMemoryRequirements->size           = 256;
+    pMemoryRequirements->alignment      = 1;
+    pMemoryRequirements->memoryTypeBits = 1;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL
+vkAllocateMemory(VkDevice device, const VkMemoryAllocateInfo *pAllocateInfo, const VkAllocationCallbacks *pAllocator, VkDeviceMemory *pMemory)
+{
+    *pMemory = (VkDeviceMemory)(++handleCount);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL
+vkFreeMemory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks *pAllocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL
+vkBindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset)
+{
+    return VK_SUCCESS;
+}
+#endif // _WIN32
+
+namespace Testing {
+
+void bufferObjectTest::SetUp(void) {
+    Buffer = new VertexBufferObject(&Stub.VkContext);
+}
+
+void bufferObjectTest::TearDown() {
+    delete Buffer;
+}
+
+TEST_F(bufferObjectTest, NotUsed)
+{
+    ASSERT_FALSE(Buffer->IsInUse());
+}
+
+TEST_F(bufferObjectTest, InUseUntilCompleted)
+{
+    Buffer->SetUsed(Stub.Tracker.GetEpoch());
+    ASSERT_TRUE(Buffer->IsInUse());
+
+    Stub.Complete();
+    ASSERT_FALSE(Buffer->IsInUse());
+}
+
+TEST_F(bufferObjectTest, LaterUseKept)
+{
+    uint64_t earlierEpoch = Stub.Tracker.GetEpoch();
+    Stub.Complete();
+
+    // a context that drew earlier may stamp after one that drew later
+    Buffer->SetUsed(Stub.Tracker.GetEpoch());
+    Buffer->SetUsed(earlierEpoch);
+    ASSERT_TRUE(Buffer->IsInUse());
+
+    Stub.Complete();
+    ASSERT_FALSE(Buffer->IsInUse());
+}
+
+#ifndef _WIN32
+TEST_F(bufferObjectTest, Orphan)
+{
+    ASSERT_TRUE(Buffer->Orphan(64, false));
+    ASSERT_TRUE(Buffer->HasData());
+    ASSERT_EQ(64u, Buffer->GetSize());
+
+    VkBuffer usedBuffer = Buffer->GetVkBuffer();
+    uint64_t version    = Buffer->GetDataVersion();
+    Buffer->SetUsed(Stub.Tracker.GetEpoch());
+
+    // the storage read by pending commands is retired, the new one is not in use yet
+    ASSERT_TRUE(Buffer->Orphan(64, false));
+    ASSERT_NE(usedBuffer, Buffer->GetVkBuffer());
+    ASSERT_EQ(version + 1, Buffer->GetDataVersion());
+    ASSERT_FALSE(Buffer->IsInUse());
+
+    // a retired storage of the same size is recycled only once its last use has completed
+    ASSERT_TRUE(Buffer->Orphan(64, false));
+    ASSERT_NE(usedBuffer, Buffer->GetVkBuffer());
+
+    Stub.Complete();
+    ASSERT_TRUE(Buffer->Orphan(64, false));
+    ASSERT_EQ(usedBuffer, Buffer->GetVkBuffer());
+}
+#endif // _WIN32
+
+} //end of namespace
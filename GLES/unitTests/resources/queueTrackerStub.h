@@ -0,0 +1,64 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __QUEUETRACKERSTUB_H__
+#define __QUEUETRACKERSTUB_H__
+
+#include "vulkan/queueTracker.h"
+
+namespace Testing {
+
+/**
+ * @brief The queue tracker of a single context without a device.
+ *
+ * The context is always recording, so the epochs stamped by a test are never
+ * submitted and the tracker never submits its fence. They complete only when
+ * the test completes the current recording.
+ */
+class queueTrackerStub {
+public:
+    queueTrackerStub()
+    : Tracker(&VkContext)
+    {
+        VkContext.vkQueueTracker = &Tracker;
+        VkContext.vkDeviceMemoryProperties.memoryTypeCount = 1;
+        VkContext.vkDeviceMemoryProperties.memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+        Tracker.AddClient();
+        mRecordingEpoch = Tracker.BeginRecording();
+    }
+
+    ~queueTrackerStub()
+    {
+        Tracker.EndRecording(mRecordingEpoch);
+        Tracker.RemoveClient();
+    }
+
+    /// Submits the current recording, waits for it and starts the next one
+    void Complete(void)
+    {
+        Tracker.EndRecording(mRecordingEpoch);
+        Tracker.LastSubmissionCompleted();
+        mRecordingEpoch = Tracker.BeginRecording();
+    }
+
+    vulkanAPI::vkContext_t    VkContext;
+    vulkanAPI::QueueTracker   Tracker;
+
+private:
+    uint64_t                  mRecordingEpoch;
+};
+
+} //end of namespace
+
+#endif // __QUEUETRACKERSTUB_H__
@@ -12,6 +12,8 @@
  */
 
 #include "refObject_test.h"
+#include <thread>
+#include <vector>
 
 namespace Testing {
 
@@ -39,4 +41,26 @@ TEST_F(refObjectTest, Unbind)
     ASSERT_EQ(0, RefObject.Unbind());
 }
 
+TEST_F(refObjectTest, ConcurrentBindUnbind)
+{
+    const int threadCount = 8;
+    const int iterations  = 10000;
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([this, iterations]() {
+            for(int i = 0; i < iterations; ++i) {
+                RefObject.Bind();
+                RefObject.Unbind();
+            }
+            RefObject.Bind();
+        });
+    }
+    for(auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(threadCount, RefObject.GetRefCount());
+}
+
 } //end of namespace
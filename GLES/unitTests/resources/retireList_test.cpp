@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "retireList_test.h"
+
+namespace Testing {
+
+void retireListTest::SetUp(void) {
+    List = new RetireList(&Stub.VkContext);
+}
+
+void retireListTest::TearDown() {
+    delete List;
+}
+
+TEST_F(retireListTest, KeptWhileRecording)
+{
+    bool deleted;
+    List->Retire(new retiredBufferObject(&Stub.VkContext, &deleted));
+
+    List->CleanUp();
+    ASSERT_FALSE(deleted);
+}
+
+TEST_F(retireListTest, DeletedOnceCompleted)
+{
+    bool deleted;
+    List->Retire(new retiredBufferObject(&Stub.VkContext, &deleted));
+
+    Stub.Complete();
+    ASSERT_FALSE(deleted);
+
+    List->CleanUp();
+    ASSERT_TRUE(deleted);
+}
+
+TEST_F(retireListTest, LaterEpochKept)
+{
+    bool deletedFirst;
+    bool deletedSecond;
+    List->Retire(new retiredBufferObject(&Stub.VkContext, &deletedFirst));
+    Stub.Complete();
+    List->Retire(new retiredBufferObject(&Stub.VkContext, &deletedSecond));
+
+    List->CleanUp();
+    ASSERT_TRUE(deletedFirst);
+    ASSERT_FALSE(deletedSecond);
+
+    Stub.Complete();
+    List->CleanUp();
+    ASSERT_TRUE(deletedSecond);
+}
+
+TEST_F(retireListTest, DeletedWithList)
+{
+    bool deleted;
+    List->Retire(new retiredBufferObject(&Stub.VkContext, &deleted));
+
+    delete List;
+    List = nullptr;
+    ASSERT_TRUE(deleted);
+}
+
+} //end of namespace
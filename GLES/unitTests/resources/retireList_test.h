@@ -0,0 +1,45 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __RETIRELIST_TESTS_H__
+#define __RETIRELIST_TESTS_H__
+
+#include "gtest/gtest.h"
+#include "resources/retireList.h"
+#include "queueTrackerStub.h"
+
+namespace Testing {
+
+/// Reports its deletion, which the retire list performs once the queue has completed its last use
+class retiredBufferObject : public BufferObject {
+public:
+    retiredBufferObject(const vulkanAPI::vkContext_t *vkContext, bool *deleted)
+    : BufferObject(vkContext), mDeleted(deleted) { *mDeleted = false; }
+    ~retiredBufferObject() { *mDeleted = true; }
+
+private:
+    bool *mDeleted;
+};
+
+class retireListTest : public :: testing :: Test {
+protected:
+    void SetUp(void);
+    void TearDown(void);
+
+    queueTrackerStub                     Stub;
+    RetireList                          *List;
+};
+
+} //end of namespace
+
+#endif // __RETIRELIST_TESTS_H__
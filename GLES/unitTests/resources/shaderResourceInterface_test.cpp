@@ -0,0 +1,150 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "shaderResourceInterface_test.h"
+#include <chrono>
+#include <iostream>
+
+namespace Testing {
+
+// Uniform layout used by all tests:
+//   block 0 (UBO, 208 bytes): vec4 u_color @0, mat4 u_mvp @16, float u_weights[8] @80
+//   block 1 (opaque)        : sampler2D u_tex
+// Locations: u_color 0, u_mvp 1, u_weights 2..9, u_tex 10
+void shaderResourceInterfaceTest::SetUp(void) {
+    Reflection.Reset();
+
+    Reflection.SetLiveUniforms(4);
+    Reflection.SetLiveUniformBlocks(2);
+
+    Reflection.SetUniformBlockGlslBlockName("uniform_buffer_vert", 0);
+    Reflection.SetUniformBlockBinding(0, 0);
+    Reflection.SetUniformBlockBlockSize(208, 0);
+    Reflection.SetUniformBlockBlockStage(SHADER_TYPE_VERTEX, 0);
+    Reflection.SetUniformBlockOpaque(false, 0);
+
+    Reflection.SetUniformBlockGlslBlockName("u_tex", 1);
+    Reflection.SetUniformBlockBinding(1, 1);
+    Reflection.SetUniformBlockBlockSize(0, 1);
+    Reflection.SetUniformBlockBlockStage(SHADER_TYPE_FRAGMENT, 1);
+    Reflection.SetUniformBlockOpaque(true, 1);
+
+    const char   *names[]   = { "u_color",     "u_mvp",       "u_weights", "u_tex"       };
+    const GLenum  types[]   = { GL_FLOAT_VEC4, GL_FLOAT_MAT4, GL_FLOAT,    GL_SAMPLER_2D };
+    const int     arrays[]  = { 1,             1,             8,           1             };
+    const int     locs[]    = { 0,             1,             2,           10            };
+    const int     blocks[]  = { 0,             0,             0,           1             };
+    const GLenum  offsets[] = { 0,             16,            80,          0             };
+
+    for(uint32_t i = 0; i < 4; ++i) {
+        Reflection.SetUniformReflectionName(names[i], i);
+        Reflection.SetUniformType(types[i], i);
+        Reflection.SetUniformArraySize(arrays[i], i);
+        Reflection.SetUniformLocation(locs[i], i);
+        Reflection.SetUniformBlockIndex(blocks[i], i);
+        Reflection.SetUniformOffset(offsets[i], i);
+    }
+
+    ResourceInterface.SetReflection(&Reflection);
+    ResourceInterface.CreateInterface();
+    ResourceInterface.SetReflection(nullptr);
+    ResourceInterface.AllocateUniformClientData();
+}
+
+// Code here will be called immediately after each test (right
+// before the destructor).
+void shaderResourceInterfaceTest::TearDown() {
+    return;
+}
+
+TEST_F(shaderResourceInterfaceTest, UniformAtLocation)
+{
+    ASSERT_STREQ("u_color",   ResourceInterface.GetUniformAtLocation(0)->name.c_str());
+    ASSERT_STREQ("u_mvp",     ResourceInterface.GetUniformAtLocation(1)->name.c_str());
+    ASSERT_STREQ("u_weights", ResourceInterface.GetUniformAtLocation(2)->name.c_str());
+    ASSERT_STREQ("u_weights", ResourceInterface.GetUniformAtLocation(9)->name.c_str());
+    ASSERT_STREQ("u_tex",     ResourceInterface.GetUniformAtLocation(10)->name.c_str());
+    ASSERT_EQ(nullptr, ResourceInterface.GetUniformAtLocation(11));
+    ASSERT_EQ(nullptr, ResourceInterface.GetUniformAtLocation(1000));
+}
+
+TEST_F(shaderResourceInterfaceTest, UniformArrayData)
+{
+    float weights[6] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    ResourceInterface.SetUniformClientData(4, sizeof(weights), weights);
+
+    float readback[6] = { 0.0f };
+    ResourceInterface.GetUniformClientData(4, sizeof(readback), readback);
+    for(int i = 0; i < 6; ++i) {
+        ASSERT_EQ(weights[i], readback[i]);
+    }
+
+    /// Array elements keep the 16 byte stride of the uniform buffer
+    const float *shadow = reinterpret_cast<const float *>(ResourceInterface.GetUniformClientData(2));
+    ASSERT_EQ(0.0f, shadow[0]);
+    ASSERT_EQ(1.0f, shadow[2 * 4]);
+    ASSERT_EQ(6.0f, shadow[7 * 4]);
+}
+
+TEST_F(shaderResourceInterfaceTest, UniformSampler)
+{
+    int unit = GL_TEXTURE3;
+    ResourceInterface.SetUniformSampler(10, 1, &unit);
+    ASSERT_EQ(3u, *reinterpret_cast<const glsl_sampler_t *>(ResourceInterface.GetUniformClientData(3)));
+}
+
+TEST_F(shaderResourceInterfaceTest, UniformRepeatedUpdates)
+{
+    float color[4] = { 0.0f, 0.25f, 0.5f, 1.0f };
+    float mvp[16]  = { 0.0f };
+
+    for(uint32_t i = 0; i < 16; ++i) {
+        color[0] = static_cast<float>(i);
+        mvp[15]  = static_cast<float>(i);
+        ResourceInterface.SetUniformClientData(0, sizeof(color), color);
+        ResourceInterface.SetUniformClientData(1, sizeof(mvp), mvp);
+    }
+
+    float readback[16];
+    ResourceInterface.GetUniformClientData(0, sizeof(color), readback);
+    ASSERT_EQ(15.0f, readback[0]);
+    ASSERT_EQ(1.0f,  readback[3]);
+    ResourceInterface.GetUniformClientData(1, sizeof(readback), readback);
+    ASSERT_EQ(15.0f, readback[15]);
+}
+
+// disabled by default, run with --gtest_also_run_disabled_tests
+TEST_F(shaderResourceInterfaceTest, DISABLED_UniformThroughput)
+{
+    const uint32_t calls = 1000000;
+    float color[4]       = { 0.0f, 0.25f, 0.5f, 1.0f };
+    float mvp[16]        = { 0.0f };
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < calls; ++i) {
+        color[0] = static_cast<float>(i);
+        mvp[15]  = static_cast<float>(i);
+        ResourceInterface.SetUniformClientData(0, sizeof(color), color);
+        ResourceInterface.SetUniformClientData(1, sizeof(mvp), mvp);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "[ BENCH    ] " << (2.0 * calls) / seconds / 1.0e6 << " M glUniform updates/sec" << std::endl;
+
+    float readback[16];
+    ResourceInterface.GetUniformClientData(1, sizeof(readback), readback);
+    ASSERT_EQ(static_cast<float>(calls - 1), readback[15]);
+}
+
+} //end of namespace
@@ -0,0 +1,71 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "shareGroup_test.h"
+#include <thread>
+#include <vector>
+
+namespace Testing {
+
+// The share group is created along with its first context
+void shareGroupTest::SetUp(void) {
+    Group = new ShareGroup(&Stub.VkContext);
+}
+
+void shareGroupTest::TearDown() {
+    delete Group;
+}
+
+TEST_F(shareGroupTest, FirstContext)
+{
+    ASSERT_FALSE(Group->IsShared());
+}
+
+TEST_F(shareGroupTest, AcquireRelease)
+{
+    Group->Acquire();
+    ASSERT_TRUE(Group->IsShared());
+
+    ASSERT_FALSE(Group->Release());
+    ASSERT_FALSE(Group->IsShared());
+
+    ASSERT_TRUE(Group->Release());
+}
+
+TEST_F(shareGroupTest, ConcurrentAcquireRelease)
+{
+    const int threadCount = 8;
+    const int iterations  = 10000;
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([this, iterations]() {
+            for(int i = 0; i < iterations; ++i) {
+                Group->Acquire();
+                Group->Release();
+            }
+            Group->Acquire();
+        });
+    }
+    for(auto &thread : threads) {
+        thread.join();
+    }
+
+    // only the release of the last context destroys the share group
+    for(int t = 0; t < threadCount; ++t) {
+        ASSERT_FALSE(Group->Release());
+    }
+    ASSERT_TRUE(Group->Release());
+}
+
+} //end of namespace
@@ -0,0 +1,34 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __SHAREGROUP_TESTS_H__
+#define __SHAREGROUP_TESTS_H__
+
+#include "gtest/gtest.h"
+#include "resources/shareGroup.h"
+#include "queueTrackerStub.h"
+
+namespace Testing {
+
+class shareGroupTest : public :: testing :: Test {
+protected:
+    void SetUp(void);
+    void TearDown(void);
+
+    queueTrackerStub                     Stub;
+    ShareGroup                          *Group;
+};
+
+} //end of namespace
+
+#endif // __SHAREGROUP_TESTS_H__
@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "vertexArrayObject_test.h"
+
+namespace Testing {
+
+// The program is only used as a key, so any address will do
+static int programKey;
+static const ShaderProgram *program = reinterpret_cast<const ShaderProgram *>(&programKey);
+
+void vertexArrayObjectTest::SetUp(void) {
+    BufferObject *bindingBufferObjects[2] = {&Buffers[0], &Buffers[1]};
+
+    // the layout is not owned by a cache, the test keeps its own reference
+    vulkanAPI::VertexInputCache::AcquireLayout(&Layout);
+    VertexArray.Resolve(program, 1, &Layout, 2, bindingBufferObjects);
+}
+
+void vertexArrayObjectTest::TearDown() {
+    VertexArray.Release();
+}
+
+TEST_F(vertexArrayObjectTest, Resolve)
+{
+    ASSERT_TRUE(VertexArray.IsResolved(program, 1));
+    ASSERT_EQ(&Layout, VertexArray.GetVertexInputLayout());
+
+    VkBuffer      buffers[GLOVE_MAX_VERTEX_ATTRIBS];
+    BufferObject *bufferObjects[GLOVE_MAX_VERTEX_ATTRIBS];
+    ASSERT_EQ(2u, VertexArray.GetVkBuffers(buffers, bufferObjects));
+    ASSERT_EQ(&Buffers[1], bufferObjects[1]);
+}
+
+TEST_F(vertexArrayObjectTest, RelinkedProgram)
+{
+    ASSERT_FALSE(VertexArray.IsResolved(program, 2));
+    ASSERT_FALSE(VertexArray.IsResolved(nullptr, 1));
+}
+
+TEST_F(vertexArrayObjectTest, Invalidate)
+{
+    VertexArray.Invalidate();
+    ASSERT_FALSE(VertexArray.IsResolved(program, 1));
+}
+
+TEST_F(vertexArrayObjectTest, GenericValues)
+{
+    const GLfloat value[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    VertexArray.GetGenericVertexAttribute(3)->SetGenericValue(value);
+
+    VertexArrayObject vao;
+    vao.SetGenericValues(&VertexArray);
+
+    GLfloat result[4];
+    vao.GetGenericVertexAttribute(3)->GetGenericValue(result);
+    ASSERT_EQ(0, memcmp(value, result, sizeof(value)));
+
+    vao.GetGenericVertexAttribute(0)->GetGenericValue(result);
+    ASSERT_EQ(1.0f, result[3]);
+}
+
+TEST_F(vertexArrayObjectTest, AttachedBufferReferenced)
+{
+    VertexArray.GetGenericVertexAttribute(0)->Set(4, GL_FLOAT, GL_FALSE, 0, nullptr, &Buffers[0], false);
+    ASSERT_EQ(1, Buffers[0].GetRefCount());
+
+    VertexArray.GetGenericVertexAttribute(0)->Set(4, GL_FLOAT, GL_FALSE, 0, nullptr, &Buffers[1], false);
+    ASSERT_EQ(0, Buffers[0].GetRefCount());
+    ASSERT_EQ(1, Buffers[1].GetRefCount());
+
+    VertexArray.Release();
+    ASSERT_EQ(0, Buffers[1].GetRefCount());
+}
+
+} //end of namespace
@@ -12,6 +12,9 @@
  */
 
 #include "arrays_tests.h"
+#include <vector>
+#include <chrono>
+#include <iostream>
 
 namespace Testing {
 
@@ -67,4 +70,128 @@ TEST_F(ObjectArrayTest, DeleteShaders)
 
 }
 
+TEST_F(ObjectArrayTest, ReuseShaderIds)
+{
+    for(size_t i=1; i<11; i++) {
+        ASSERT_EQ(i, ShaderArray.Allocate());
+        ShaderArray.GetObject(i);
+    }
+
+    ASSERT_TRUE(ShaderArray.Deallocate(3));
+    ASSERT_TRUE(ShaderArray.Deallocate(7));
+
+    ASSERT_EQ((size_t)7, ShaderArray.Allocate());
+    ASSERT_EQ((size_t)3, ShaderArray.Allocate());
+    ASSERT_EQ((size_t)11, ShaderArray.Allocate());
+
+    /// Released ids that have been taken by the user are not handed out
+    ASSERT_TRUE(ShaderArray.Deallocate(5));
+    ShaderArray.GetObject(5);
+    ASSERT_EQ((size_t)12, ShaderArray.Allocate());
+}
+
+TEST_F(ObjectArrayTest, SparseShaderIds)
+{
+    const uint32_t sparseId = 1000000;
+
+    Shader *shader = ShaderArray.GetObject(sparseId);
+    ASSERT_TRUE(ShaderArray.ObjectExists(sparseId));
+    ASSERT_EQ(sparseId, ShaderArray.GetObjectId(shader));
+    ASSERT_EQ((size_t)1, ShaderArray.Allocate());
+
+    ShaderArray.GetObject(1);
+
+    size_t count = 0;
+    for(ObjectArray<Shader>::const_iterator it = ShaderArray.begin(); it != ShaderArray.end(); ++it) {
+        ASSERT_EQ(it->first, ShaderArray.GetObjectId(it->second));
+        ++count;
+    }
+    ASSERT_EQ((size_t)2, count);
+
+    ASSERT_TRUE(ShaderArray.Deallocate(sparseId));
+    ASSERT_FALSE(ShaderArray.ObjectExists(sparseId));
+}
+
+TEST_F(ObjectArrayTest, RemovedShaderId)
+{
+    ASSERT_EQ((size_t)1, ShaderArray.Allocate());
+
+    Shader *shader = ShaderArray.GetObject(1);
+    ASSERT_EQ((uint32_t)1, ShaderArray.GetObjectId(shader));
+
+    ASSERT_TRUE(ShaderArray.RemoveFromList(1));
+    ASSERT_EQ((uint32_t)~0, ShaderArray.GetObjectId(shader));
+    ASSERT_EQ((uint32_t)~0, ShaderArray.GetObjectId(nullptr));
+
+    delete shader;
+}
+
+TEST_F(ObjectArrayTest, ManyObjects)
+{
+    const uint32_t count = 10000;
+    ObjectArray<arrayElement> elementArray;
+    std::vector<arrayElement *> elements(count);
+
+    for(uint32_t i = 0; i < count; ++i) {
+        elements[i] = elementArray.GetObject(elementArray.Allocate());
+    }
+
+    for(uint32_t i = 0; i < count; ++i) {
+        ASSERT_EQ(i + 1, elementArray.GetObjectId(elements[i]));
+    }
+
+    for(uint32_t i = 1; i <= count; ++i) {
+        ASSERT_TRUE(elementArray.Deallocate(i));
+    }
+    ASSERT_FALSE(elementArray.ObjectExists(count));
+}
+
+void ObjectArrayScalingTest::Run(uint32_t count)
+{
+    ObjectArray<arrayElement> *elementArray = new ObjectArray<arrayElement>();
+    std::vector<arrayElement *> elements(count);
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < count; ++i) {
+        elements[i] = elementArray->GetObject(elementArray->Allocate());
+    }
+    auto created = std::chrono::steady_clock::now();
+
+    uint64_t idSum = 0;
+    for(uint32_t i = 0; i < count; ++i) {
+        idSum += elementArray->GetObjectId(elements[i]);
+    }
+    auto searched = std::chrono::steady_clock::now();
+
+    for(uint32_t i = 1; i <= count; ++i) {
+        elementArray->Deallocate(i);
+    }
+    auto deleted = std::chrono::steady_clock::now();
+
+    ASSERT_EQ((uint64_t)count * (count + 1) / 2, idSum);
+    ASSERT_FALSE(elementArray->ObjectExists(count));
+
+    std::cout << "[ BENCH    ] " << count << " objects: "
+              << std::chrono::duration<double, std::milli>(created  - start).count()    << " ms create, "
+              << std::chrono::duration<double, std::milli>(searched - created).count()  << " ms id lookup, "
+              << std::chrono::duration<double, std::milli>(deleted  - searched).count() << " ms delete" << std::endl;
+
+    delete elementArray;
+}
+
+TEST_F(ObjectArrayScalingTest, DISABLED_Objects10K)
+{
+    Run(10000);
+}
+
+TEST_F(ObjectArrayScalingTest, DISABLED_Objects100K)
+{
+    Run(100000);
+}
+
+TEST_F(ObjectArrayScalingTest, DISABLED_Objects1M)
+{
+    Run(1000000);
+}
+
 } //end of namespace
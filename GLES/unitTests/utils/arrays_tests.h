@@ -16,10 +16,17 @@
 
 #include "gtest/gtest.h"
 #include "resources/shader.h"
+#include "resources/refObject.h"
 #include "utils/arrays.hpp"
 
 namespace Testing {
 
+class arrayElement : public refObject {
+public:
+    arrayElement() = default;
+    ~arrayElement() = default;
+};
+
 class ObjectArrayTest : public ::testing::Test {
 protected:
     void SetUp(void);
@@ -28,6 +35,12 @@ protected:
     class ObjectArray<Shader> ShaderArray;
 };
 
+/// Times ObjectArray at growing sizes, disabled by default and run with --gtest_also_run_disabled_tests
+class ObjectArrayScalingTest : public ::testing::Test {
+protected:
+    void Run(uint32_t count);
+};
+
 } //end of namespace
 
 #endif // __ARRAYS_TESTS_H__
@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "etc1Decoder_test.h"
+#include <random>
+#include <vector>
+
+namespace Testing {
+
+void Etc1DecoderTest::ExpectTexel(const uint8_t *texel, uint8_t r, uint8_t g, uint8_t b)
+{
+    EXPECT_EQ(r,    texel[0]);
+    EXPECT_EQ(g,    texel[1]);
+    EXPECT_EQ(b,    texel[2]);
+    EXPECT_EQ(0xff, texel[3]);
+}
+
+TEST_F(Etc1DecoderTest, ImageSize)
+{
+    ASSERT_EQ((size_t)8,   Etc1ImageSize(1, 1));
+    ASSERT_EQ((size_t)8,   Etc1ImageSize(4, 4));
+    ASSERT_EQ((size_t)32,  Etc1ImageSize(5, 5));
+    ASSERT_EQ((size_t)128, Etc1ImageSize(16, 16));
+}
+
+TEST_F(Etc1DecoderTest, IndividualMode)
+{
+    // all zero: black base colors with the smallest positive modifier
+    const uint8_t block[ETC1_BLOCK_SIZE] = { 0 };
+    uint8_t texels[4 * 4 * 4];
+
+    Etc1DecodeImage(block, 4, 4, texels, 4 * 4);
+    for(uint32_t i = 0; i < 4 * 4; ++i) {
+        ExpectTexel(&texels[i * 4], 2, 2, 2);
+    }
+}
+
+TEST_F(Etc1DecoderTest, DifferentialMode)
+{
+    // red 16 with a +1 delta, texel (1,0) uses the negative small modifier
+    const uint8_t block[ETC1_BLOCK_SIZE] = { 0x81, 0x00, 0x00, 0x02, 0x00, 0x10, 0x00, 0x00 };
+    uint8_t texels[4 * 4 * 4];
+
+    Etc1DecodeImage(block, 4, 4, texels, 4 * 4);
+    ExpectTexel(&texels[0 * 4], 134, 2, 2);
+    ExpectTexel(&texels[1 * 4], 130, 0, 0);
+    ExpectTexel(&texels[3 * 4], 142, 2, 2);
+    ExpectTexel(&texels[(3 * 4 + 2) * 4], 142, 2, 2);
+}
+
+TEST_F(Etc1DecoderTest, FlippedSubblocks)
+{
+    const uint8_t block[ETC1_BLOCK_SIZE] = { 0x81, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t texels[4 * 4 * 4];
+
+    Etc1DecodeImage(block, 4, 4, texels, 4 * 4);
+    ExpectTexel(&texels[(1 * 4 + 3) * 4], 134, 2, 2);
+    ExpectTexel(&texels[(2 * 4 + 0) * 4], 142, 2, 2);
+}
+
+TEST_F(Etc1DecoderTest, PartialBlocks)
+{
+    // a 5x3 image spans 2x1 blocks, the second of which contributes one column
+    const uint8_t blocks[2 * ETC1_BLOCK_SIZE] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                                  0x81, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00 };
+    const size_t stride = 5 * 4 + 4;
+    std::vector<uint8_t> texels(stride * 3, 0xcd);
+
+    Etc1DecodeImage(blocks, 5, 3, texels.data(), stride);
+    for(uint32_t y = 0; y < 3; ++y) {
+        ExpectTexel(&texels[y * stride + 3 * 4], 2, 2, 2);
+        ExpectTexel(&texels[y * stride + 4 * 4], 134, 2, 2);
+        // row padding is left untouched
+        EXPECT_EQ(0xcd, texels[y * stride + 5 * 4]);
+    }
+}
+
+TEST_F(Etc1DecoderTest, RandomBlocksAreOpaque)
+{
+    const uint32_t dim = 64;
+    std::vector<uint8_t> blocks(Etc1ImageSize(dim, dim));
+    std::mt19937 generator(dim);
+    for(size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i] = static_cast<uint8_t>(generator());
+    }
+
+    const size_t decodedSize = static_cast<size_t>(dim) * dim * 4;
+    std::vector<uint8_t> texels(decodedSize, 0);
+
+    Etc1DecodeImage(blocks.data(), dim, dim, texels.data(), dim * 4);
+    for(size_t i = 3; i < decodedSize; i += 4) {
+        ASSERT_EQ(0xff, texels[i]);
+    }
+}
+
+} //end of namespace
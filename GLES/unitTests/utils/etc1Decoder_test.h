@@ -0,0 +1,29 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __ETC1DECODER_TEST_H__
+#define __ETC1DECODER_TEST_H__
+
+#include "gtest/gtest.h"
+#include "utils/etc1Decoder.h"
+
+namespace Testing {
+
+class Etc1DecoderTest : public ::testing::Test {
+protected:
+    void ExpectTexel(const uint8_t *texel, uint8_t r, uint8_t g, uint8_t b);
+};
+
+} //end of namespace
+
+#endif // __ETC1DECODER_TEST_H__
@@ -87,6 +87,7 @@ LOCAL_SRC_FILES :=  $(SRC_PATH)/GLES/source/api/gl.cpp \
                     $(SRC_PATH)/GLES/source/utils/glLogger.cpp \
                     $(SRC_PATH)/GLES/source/utils/glUtils.cpp \
                     $(SRC_PATH)/GLES/source/utils/cacheManager.cpp \
+                    $(SRC_PATH)/GLES/source/utils/etc1Decoder.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/cbManager.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/clearPass.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/commandBufferPool.cpp \
@@ -144,6 +145,7 @@ LOCAL_SRC_FILES := $(SRC_PATH)/EGL/source/api/eglContext.cpp \
                    $(SRC_PATH)/EGL/source/api/eglConfig.cpp \
                    $(SRC_PATH)/EGL/source/api/egl.cpp \
                    $(SRC_PATH)/EGL/source/api/eglSurface.cpp \
+                   $(SRC_PATH)/EGL/source/api/eglSync.cpp \
                    $(SRC_PATH)/EGL/source/api/eglDisplay.cpp \
                    $(SRC_PATH)/EGL/source/display/displayDriver.cpp \
                    $(SRC_PATH)/EGL/source/display/displayDriversContainer.cpp \